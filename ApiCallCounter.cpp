@@ -0,0 +1,82 @@
+#include "pch.h"
+#include "ApiCallCounter.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>Gets the process wide API call counter.</summary>
+		///
+		/// <returns>The API call counter.</returns>
+		ApiCallCounter& ApiCallCounter::get() {
+			static ApiCallCounter counter;
+			return counter;
+		}
+
+		/// <summary>Adds one invocation of an operation with the number of API calls it made.</summary>
+		///
+		/// <param name="operation">The operation name.</param>
+		/// <param name="calls">	The API calls.</param>
+		void ApiCallCounter::record(std::string_view operation, uint64_t calls) {
+			std::lock_guard<std::mutex> lock(mutex_);
+			auto it = stats_.find(operation);
+			if (it == stats_.end()) {
+				it = stats_.emplace(std::string(operation), ApiCallStats()).first;
+			}
+			ApiCallStats& stats = it->second;
+			++stats.invocations;
+			stats.totalCalls += calls;
+			stats.lastCalls = calls;
+			stats.maxCalls = (std::max)(stats.maxCalls, calls);
+		}
+
+		/// <summary>Forgets all recorded operations.</summary>
+		void ApiCallCounter::reset() {
+			std::lock_guard<std::mutex> lock(mutex_);
+			stats_.clear();
+		}
+
+		/// <summary>Gets the statistics of one operation.</summary>
+		///
+		/// <param name="operation">The operation name.</param>
+		/// <param name="stats">	[out] The statistics.</param>
+		///
+		/// <returns>True if the operation was recorded, false if not.</returns>
+		bool ApiCallCounter::getStats(std::string_view operation, ApiCallStats& stats) const {
+			std::lock_guard<std::mutex> lock(mutex_);
+			auto it = stats_.find(operation);
+			if (it == stats_.end()) {
+				return false;
+			}
+			stats = it->second;
+			return true;
+		}
+
+		/// <summary>Gets the statistics of all recorded operations, ordered by name.</summary>
+		///
+		/// <returns>The statistics.</returns>
+		std::vector<std::pair<std::string, ApiCallStats>> ApiCallCounter::getAllStats() const {
+			std::lock_guard<std::mutex> lock(mutex_);
+			return std::vector<std::pair<std::string, ApiCallStats>>(stats_.begin(), stats_.end());
+		}
+
+		/// <summary>Prints one line per operation with invocations and last, average and maximum API calls.</summary>
+		///
+		/// <returns>The report.</returns>
+		std::string ApiCallCounter::getReport() const {
+			std::string report;
+			char line[160];
+			std::snprintf(line, sizeof(line), "%-26s %8s %10s %10s %10s\n", "Operation", "Calls", "last API", "avg API", "max API");
+			report.append(line);
+
+			for (const auto& [operation, stats] : getAllStats()) {
+				std::snprintf(line, sizeof(line), "%-26s %8llu %10llu %10.1f %10llu\n",
+					operation.c_str(),
+					(unsigned long long)stats.invocations,
+					(unsigned long long)stats.lastCalls,
+					stats.invocations > 0 ? (double)stats.totalCalls / (double)stats.invocations : 0.0,
+					(unsigned long long)stats.maxCalls);
+				report.append(line);
+			}
+			return report;
+		}
+	}
+}
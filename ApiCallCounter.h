@@ -0,0 +1,90 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>The Fusion API calls made by one kind of operation, e.g. clicking a table row.</summary>
+		struct ApiCallStats {
+			uint64_t invocations = 0;
+			uint64_t totalCalls = 0;
+			uint64_t lastCalls = 0;
+			uint64_t maxCalls = 0;
+		};
+
+		/// <summary>
+		/// <para>ApiCallCounter counts Fusion API round trips per add-in operation. Every call into the API reports</para>
+		/// <para>itself through add(), which charges it to the innermost ApiOperation open on the calling thread;</para>
+		/// <para>calls outside any operation are not counted. The Fusion SDK offers no hook for this, so add() is</para>
+		/// <para>called by the recording stand-in of the API that the add-in code is built against on Linux,</para>
+		/// <para>which enables the counter; in Fusion it stays disabled and counts nothing.</para>
+		/// </summary>
+		class ApiCallCounter
+		{
+		public:
+			static ApiCallCounter& get();
+
+			ApiCallCounter(const ApiCallCounter&) = delete;
+			ApiCallCounter& operator=(const ApiCallCounter&) = delete;
+
+			/// <summary>Counts API calls made by the calling thread.</summary>
+			static void add(uint64_t calls = 1) {
+				if (currentCalls_ != nullptr) {
+					*currentCalls_ += calls;
+				}
+			}
+
+			/// <summary>Marks that API calls are reported through add(), called by whoever installs the hook.</summary>
+			void enable() { isEnabled_ = true; }
+			bool isEnabled() const { return isEnabled_; }
+
+			void record(std::string_view operation, uint64_t calls);
+			void reset();
+
+			bool getStats(std::string_view operation, ApiCallStats& stats) const;
+			std::vector<std::pair<std::string, ApiCallStats>> getAllStats() const;
+			std::string getReport() const;
+
+		private:
+			friend class ApiOperation;
+
+			ApiCallCounter() = default;
+
+			static inline thread_local uint64_t* currentCalls_ = nullptr;
+
+			std::atomic<bool> isEnabled_ = false;
+
+			mutable std::mutex mutex_;
+			std::map<std::string, ApiCallStats, std::less<>> stats_;
+		};
+
+		/// <summary>
+		/// <para>ApiOperation counts the API calls made while it is open, e.g. during one handler invocation, and</para>
+		/// <para>records them under its name when closed. Calls of nested operations count for the outer one too.</para>
+		/// </summary>
+		class ApiOperation
+		{
+		public:
+			explicit ApiOperation(std::string_view name)
+				: name_(name), outerCalls_(ApiCallCounter::currentCalls_) {
+				ApiCallCounter::currentCalls_ = &calls_;
+			}
+
+			~ApiOperation() {
+				ApiCallCounter::currentCalls_ = outerCalls_;
+				if (outerCalls_ != nullptr) {
+					*outerCalls_ += calls_;
+				}
+				ApiCallCounter::get().record(name_, calls_);
+			}
+
+			ApiOperation(const ApiOperation&) = delete;
+			ApiOperation& operator=(const ApiOperation&) = delete;
+
+			uint64_t getCalls() const { return calls_; }
+
+		private:
+			std::string name_;
+			uint64_t calls_ = 0;
+			uint64_t* outerCalls_;
+		};
+	}
+}
@@ -46,6 +46,17 @@ namespace implicatex {
             return "Settings.json";
         }
 
+        std::string getUserLogPath() {
+            std::string settingsPath = getUserSettingsPath();
+            size_t separator = settingsPath.find_last_of("/\\");
+            return (separator == std::string::npos ? std::string() : settingsPath.substr(0, separator + 1)) + "ImplicateX.log";
+        }
+
+        std::string getUserTracePath() {
+            std::string logPath = getUserLogPath();
+            return logPath.substr(0, logPath.size() - 4) + ".trace.json";
+        }
+
 #if __cplusplus >= 201703L
         void ensureUserSettingsDirectoryExists() {
             fs::path settingsPath(getUserSettingsPath());
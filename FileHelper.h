@@ -6,6 +6,8 @@ namespace implicatex {
         std::string getEnvVar(const char* name);
 #endif
         std::string getUserSettingsPath();
+        std::string getUserLogPath();
+        std::string getUserTracePath();
 #if __cplusplus >= 201703L
         void ensureUserSettingsDirectoryExists();
 #endif
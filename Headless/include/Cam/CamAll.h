@@ -0,0 +1,6 @@
+#pragma once
+// The add-in uses no CAM API; the namespace exists for its using directives.
+namespace adsk {
+	namespace cam {
+	}
+}
@@ -0,0 +1,191 @@
+#pragma once
+#include <Core/Base.h>
+#include <Core/Enums.h>
+#include <Core/Geometry.h>
+#include <Core/Events.h>
+#include <Core/UserInterface.h>
+
+namespace adsk {
+	namespace core {
+		class Camera : public Base
+		{
+		public:
+			static Ptr<Camera> create();
+
+			Ptr<Point3D> eye() const;
+			bool eye(const Ptr<Point3D>& value);
+			Ptr<Point3D> target() const;
+			bool target(const Ptr<Point3D>& value);
+			Ptr<Vector3D> upVector() const;
+			bool upVector(const Ptr<Vector3D>& value);
+			CameraTypes cameraType() const;
+			bool cameraType(CameraTypes value);
+			ViewOrientations viewOrientation() const;
+			bool viewOrientation(ViewOrientations value);
+			double perspectiveAngle() const;
+			bool perspectiveAngle(double value);
+			bool isSmoothTransition() const;
+			bool isSmoothTransition(bool value);
+			bool isFitView() const;
+			bool isFitView(bool value);
+			bool getExtents(double& width, double& height) const;
+			bool setExtents(double width, double height);
+
+		private:
+			Ptr<Point3D> eye_;
+			Ptr<Point3D> target_;
+			Ptr<Vector3D> upVector_;
+			CameraTypes cameraType_ = PerspectiveCameraType;
+			ViewOrientations viewOrientation_ = ArbitraryViewOrientation;
+			double perspectiveAngle_ = 0.5;
+			double width_ = 0.0;
+			double height_ = 0.0;
+			bool isSmoothTransition_ = true;
+			bool isFitView_ = false;
+		};
+
+		/// <summary>A viewport keeps copies of the cameras assigned to it, as Fusion does.</summary>
+		class Viewport : public Base
+		{
+		public:
+			Viewport();
+
+			Ptr<Camera> camera() const;
+			bool camera(const Ptr<Camera>& value);
+			bool refresh();
+			bool setCurrentAsHome(bool isFitToView);
+			bool goHome(bool isTransition);
+
+			#pragma region Stand-in
+			size_t getRefreshCount() const { return refreshCount_; }
+			#pragma endregion
+
+		private:
+			Ptr<Camera> camera_;
+			Ptr<Camera> home_;
+			size_t refreshCount_ = 0;
+		};
+
+		class GeneralPreferences : public Base
+		{
+		public:
+			UserLanguages userLanguage() const;
+			bool userLanguage(UserLanguages value);
+
+		private:
+			UserLanguages userLanguage_ = EnglishLanguage;
+		};
+
+		class Preferences : public Base
+		{
+		public:
+			Preferences();
+			Ptr<GeneralPreferences> generalPreferences() const;
+
+		private:
+			Ptr<GeneralPreferences> generalPreferences_;
+		};
+
+		class Document;
+
+		class Product : public Base
+		{
+		public:
+			~Product() override;
+			Ptr<Document> parentDocument() const;
+
+			#pragma region Stand-in
+			void attach(Document* document) { document_ = document; }
+			#pragma endregion
+
+		private:
+			Document* document_ = nullptr;
+		};
+
+		class Document : public Base
+		{
+		public:
+			Document(const std::string& name, const Ptr<Product>& product);
+
+			std::string name() const;
+			std::string creationId() const;
+			bool isActive() const;
+			Ptr<Product> products() const;
+
+			#pragma region Stand-in
+			Ptr<Product> getProduct() const { return product_; }
+			#pragma endregion
+
+		private:
+			std::string name_;
+			std::string creationId_;
+			Ptr<Product> product_;
+		};
+
+		class Documents : public Base
+		{
+		public:
+			size_t count() const;
+			Ptr<Document> item(size_t index) const;
+
+			#pragma region Stand-in
+			void add(const Ptr<Document>& document);
+			bool remove(const Ptr<Document>& document);
+			#pragma endregion
+
+		private:
+			std::vector<Ptr<Document>> items_;
+		};
+
+		/// <summary>
+		/// <para>Application is the root of the stand-in. The host of the headless build creates the application,</para>
+		/// <para>usually the ToolsApp of the add-in, and registers it with the runtime, which Application::get returns.</para>
+		/// </summary>
+		class Application : public Base
+		{
+		public:
+			using ClassType = Application;
+
+			Application();
+			~Application() override;
+
+			static Ptr<Application> get();
+
+			Ptr<UserInterface> userInterface() const;
+			Ptr<Preferences> preferences() const;
+			Ptr<Documents> documents() const;
+			Ptr<Document> activeDocument() const;
+			Ptr<Product> activeProduct() const;
+			Ptr<Viewport> activeViewport() const;
+
+			bool log(const std::string& message, LogLevels level = InfoLogLevel, LogTypes type = ConsoleLogType);
+			int getLastError(std::string* description = nullptr) const;
+
+			Ptr<CustomEvent> registerCustomEvent(const std::string& eventId);
+			bool unregisterCustomEvent(const std::string& eventId);
+			bool fireCustomEvent(const std::string& eventId, const std::string& additionalInfo = "");
+
+			Ptr<DocumentEvent> documentActivated() const;
+			Ptr<DocumentEvent> documentClosed() const;
+			Ptr<DocumentEvent> documentOpened() const;
+			std::string executeTextCommand(const std::string& command);
+
+			#pragma region Stand-in
+			void openDocument(const Ptr<Document>& document);
+			void activateDocument(const Ptr<Document>& document);
+			void closeDocument(const Ptr<Document>& document);
+			#pragma endregion
+
+		private:
+			Ptr<UserInterface> userInterface_;
+			Ptr<Preferences> preferences_;
+			Ptr<Documents> documents_;
+			Ptr<Document> activeDocument_;
+			Ptr<Viewport> activeViewport_;
+			Ptr<DocumentEvent> documentActivated_;
+			Ptr<DocumentEvent> documentClosed_;
+			Ptr<DocumentEvent> documentOpened_;
+			std::map<std::string, Ptr<CustomEvent>, std::less<>> customEvents_;
+		};
+	}
+}
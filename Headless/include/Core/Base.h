@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+// The stand-in is never built for Windows, so XI_WIN stays undefined and the DllMain of the add-in is skipped.
+#define XI_EXPORT __attribute__((visibility("default")))
+
+namespace adsk {
+	namespace core {
+		/// <summary>
+		/// <para>Base is the root of all objects of the headless stand-in of the Fusion API. Like the objects of the</para>
+		/// <para>Fusion API they are reference counted by Ptr; deleteMe only invalidates them.</para>
+		/// </summary>
+		class Base
+		{
+		public:
+			virtual ~Base() = default;
+
+			bool isValid() const;
+			std::string objectType() const;
+
+			#pragma region Stand-in
+			void addReference() const { references_.fetch_add(1, std::memory_order_relaxed); }
+			void releaseReference() const {
+				if (references_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					delete this;
+				}
+			}
+			void invalidate() { isValid_ = false; }
+			#pragma endregion
+
+		protected:
+			Base() = default;
+			Base(const Base&) : references_(0) {}
+			Base& operator=(const Base&) { return *this; }
+
+		private:
+			mutable std::atomic<int> references_ { 0 };
+			bool isValid_ = true;
+		};
+
+		/// <summary>
+		/// <para>Ptr is the intrusive smart pointer of the Fusion API. Converting between pointer types queries the</para>
+		/// <para>object for the requested type and yields an empty pointer if it is of another type.</para>
+		/// <para>Fusion compares class types in that query, and a class derived without data of its own inherits</para>
+		/// <para>the class type of its base. The add-in relies on this for its toolbar classes, so the stand-in</para>
+		/// <para>accepts such classes too for the API classes that declare their ClassType.</para>
+		/// </summary>
+		template<class T> class Ptr
+		{
+		public:
+			Ptr() = default;
+			Ptr(std::nullptr_t) {}
+			Ptr(T* object) : object_(object) { acquire(); }
+			Ptr(const Ptr& other) : object_(other.object_) { acquire(); }
+			Ptr(Ptr&& other) noexcept : object_(other.object_) { other.object_ = nullptr; }
+			template<class U> Ptr(const Ptr<U>& other) : object_(query(other.get())) { acquire(); }
+			~Ptr() { release(); }
+
+			Ptr& operator=(const Ptr& other) {
+				Ptr(other).swap(*this);
+				return *this;
+			}
+			Ptr& operator=(Ptr&& other) noexcept {
+				Ptr(std::move(other)).swap(*this);
+				return *this;
+			}
+			Ptr& operator=(std::nullptr_t) {
+				reset();
+				return *this;
+			}
+
+			T* operator->() const { return object_; }
+			T& operator*() const { return *object_; }
+			T* get() const { return object_; }
+			explicit operator bool() const { return object_ != nullptr; }
+			bool operator!() const { return object_ == nullptr; }
+
+			void reset() { Ptr().swap(*this); }
+			void swap(Ptr& other) noexcept { std::swap(object_, other.object_); }
+
+			bool operator==(std::nullptr_t) const { return object_ == nullptr; }
+			template<class U> bool operator==(const Ptr<U>& other) const {
+				return static_cast<const Base*>(object_) == static_cast<const Base*>(other.get());
+			}
+
+		private:
+			template<class U> static T* query(U* object) {
+				if (T* result = dynamic_cast<T*>(object)) {
+					return result;
+				}
+				if constexpr (requires { typename T::ClassType; }) {
+					using ClassType = typename T::ClassType;
+					if constexpr (!std::is_same_v<T, ClassType> && sizeof(T) == sizeof(ClassType)) {
+						ClassType* classObject = dynamic_cast<ClassType*>(object);
+						if (classObject && typeid(*classObject) == typeid(ClassType)) {
+							return static_cast<T*>(classObject);
+						}
+					}
+				}
+				return nullptr;
+			}
+
+			void acquire() {
+				if (object_) {
+					object_->addReference();
+				}
+			}
+			void release() {
+				if (object_) {
+					object_->releaseReference();
+				}
+			}
+
+			T* object_ = nullptr;
+		};
+	}
+}
@@ -0,0 +1,374 @@
+#pragma once
+#include <Core/Base.h>
+#include <Core/Enums.h>
+
+namespace adsk {
+	namespace core {
+		class Command;
+		class CommandInputs;
+		class ListItems;
+
+		class ListItem : public Base
+		{
+		public:
+			ListItem(ListItems* parent, const std::string& name, bool isSelected);
+
+			std::string name() const;
+			bool isSelected() const;
+			bool isSelected(bool value);
+			size_t index() const;
+
+			#pragma region Stand-in
+			void detach() { parent_ = nullptr; }
+			#pragma endregion
+
+		private:
+			friend class ListItems;
+
+			ListItems* parent_;
+			std::string name_;
+			bool isSelected_;
+		};
+
+		/// <summary>The items of a drop down or button row; single selection unless created for check boxes.</summary>
+		class ListItems : public Base
+		{
+		public:
+			explicit ListItems(bool isMultiSelect);
+			~ListItems() override;
+
+			Ptr<ListItem> add(const std::string& name, bool isSelected, const std::string& icon = "", int beforeIndex = -1);
+			bool clear();
+			size_t count() const;
+			Ptr<ListItem> item(size_t index) const;
+
+			#pragma region Stand-in
+			Ptr<ListItem> selectedItem() const;
+			void select(ListItem* item, bool isSelected);
+			size_t indexOf(const ListItem* item) const;
+			#pragma endregion
+
+		private:
+			bool isMultiSelect_;
+			std::vector<Ptr<ListItem>> items_;
+		};
+
+		class ValueInput : public Base
+		{
+		public:
+			static Ptr<ValueInput> createByReal(double realValue);
+			static Ptr<ValueInput> createByString(const std::string& stringValue);
+
+			#pragma region Stand-in
+			bool isString() const { return isString_; }
+			double realValue() const { return realValue_; }
+			const std::string& stringValue() const { return stringValue_; }
+			#pragma endregion
+
+		private:
+			bool isString_ = false;
+			double realValue_ = 0.0;
+			std::string stringValue_;
+		};
+
+		/// <summary>
+		/// <para>CommandInput is the base of all inputs of a command dialog. Every input is registered with its</para>
+		/// <para>command by id, so that itemById finds it from any input collection of the command.</para>
+		/// </summary>
+		class CommandInput : public Base
+		{
+		public:
+			std::string id() const;
+			std::string name() const;
+			Ptr<Command> parentCommand() const;
+			Ptr<CommandInput> parentCommandInput() const;
+			bool isVisible() const;
+			bool isVisible(bool value);
+			bool isEnabled() const;
+			bool isEnabled(bool value);
+			std::string tooltip() const;
+			bool tooltip(const std::string& value);
+			bool deleteMe();
+
+			#pragma region Stand-in
+			void attach(Command* command, CommandInputs* collection, CommandInput* parent, const std::string& id, const std::string& name);
+			void deleteInput();
+			virtual void deleteChildren() {}
+			Command* getCommand() const { return command_; }
+			const std::string& getId() const { return id_; }
+			#pragma endregion
+
+		protected:
+			CommandInput() = default;
+
+		private:
+			Command* command_ = nullptr;
+			CommandInputs* collection_ = nullptr;
+			CommandInput* parent_ = nullptr;
+			std::string id_;
+			std::string name_;
+			std::string tooltip_;
+			bool isVisible_ = true;
+			bool isEnabled_ = true;
+		};
+
+		class TabCommandInput : public CommandInput
+		{
+		public:
+			Ptr<CommandInputs> children() const;
+			bool activate();
+
+			#pragma region Stand-in
+			void initialize(const std::string& resourceFolder);
+			void deleteChildren() override;
+			#pragma endregion
+
+		private:
+			Ptr<CommandInputs> children_;
+			std::string resourceFolder_;
+		};
+
+		class GroupCommandInput : public CommandInput
+		{
+		public:
+			Ptr<CommandInputs> children() const;
+			bool isExpanded() const;
+			bool isExpanded(bool value);
+
+			#pragma region Stand-in
+			void initialize();
+			void deleteChildren() override;
+			#pragma endregion
+
+		private:
+			Ptr<CommandInputs> children_;
+			bool isExpanded_ = true;
+		};
+
+		class DropDownCommandInput : public CommandInput
+		{
+		public:
+			Ptr<ListItem> selectedItem() const;
+			Ptr<ListItems> listItems() const;
+
+			#pragma region Stand-in
+			void initialize(DropDownStyles dropDownStyle);
+			#pragma endregion
+
+		private:
+			DropDownStyles dropDownStyle_ = TextListDropDownStyle;
+			Ptr<ListItems> listItems_;
+		};
+
+		class ButtonRowCommandInput : public CommandInput
+		{
+		public:
+			Ptr<ListItem> selectedItem() const;
+			Ptr<ListItems> listItems() const;
+
+			#pragma region Stand-in
+			void initialize(bool isMultiSelectEnabled);
+			#pragma endregion
+
+		private:
+			Ptr<ListItems> listItems_;
+		};
+
+		class TextBoxCommandInput : public CommandInput
+		{
+		public:
+			std::string text() const;
+			bool text(const std::string& value);
+			std::string formattedText() const;
+			bool formattedText(const std::string& value);
+			int numRows() const;
+			bool numRows(int value);
+			bool isReadOnly() const;
+			bool isReadOnly(bool value);
+
+		private:
+			std::string text_;
+			int numRows_ = 1;
+			bool isReadOnly_ = false;
+		};
+
+		/// <summary>A value with unit; value() is in Fusion internal units (cm), the expression as entered.</summary>
+		class ValueCommandInput : public CommandInput
+		{
+		public:
+			double value() const;
+			bool value(double value);
+			std::string expression() const;
+			bool expression(const std::string& value);
+			std::string unitType() const;
+
+			#pragma region Stand-in
+			void initialize(const std::string& unitType, const Ptr<ValueInput>& initialValue);
+			#pragma endregion
+
+		private:
+			std::string unitType_;
+			std::string expression_;
+			double value_ = 0.0;
+		};
+
+		class StringValueCommandInput : public CommandInput
+		{
+		public:
+			std::string value() const;
+			bool value(const std::string& value);
+			bool isReadOnly() const;
+			bool isReadOnly(bool value);
+			bool isPassword() const;
+			bool isPassword(bool value);
+
+		private:
+			std::string value_;
+			bool isReadOnly_ = false;
+			bool isPassword_ = false;
+		};
+
+		class BoolValueCommandInput : public CommandInput
+		{
+		public:
+			bool value() const;
+			bool value(bool value);
+			std::string text() const;
+			bool text(const std::string& value);
+			std::string resourceFolder() const;
+			bool resourceFolder(const std::string& value);
+			bool isCheckBox() const;
+
+			#pragma region Stand-in
+			void initialize(bool isCheckBox, const std::string& resourceFolder, bool initialValue);
+			#pragma endregion
+
+		private:
+			bool value_ = false;
+			bool isCheckBox_ = false;
+			std::string text_;
+			std::string resourceFolder_;
+		};
+
+		class IntegerSpinnerCommandInput : public CommandInput
+		{
+		public:
+			int value() const;
+			bool value(int value);
+
+			#pragma region Stand-in
+			void initialize(int minimumValue, int maximumValue, int spinStep, int initialValue);
+			#pragma endregion
+
+		private:
+			int value_ = 0;
+			int minimumValue_ = 0;
+			int maximumValue_ = 0;
+			int spinStep_ = 1;
+		};
+
+		class FloatSliderCommandInput : public CommandInput
+		{
+		public:
+			double valueOne() const;
+			bool valueOne(double value);
+			double valueTwo() const;
+			bool valueTwo(double value);
+
+			#pragma region Stand-in
+			void initialize(const std::string& unitType, double minimumValue, double maximumValue, bool hasTwoSliders);
+			#pragma endregion
+
+		private:
+			std::string unitType_;
+			double minimumValue_ = 0.0;
+			double maximumValue_ = 0.0;
+			double valueOne_ = 0.0;
+			double valueTwo_ = 0.0;
+			bool hasTwoSliders_ = false;
+		};
+
+		class SeparatorCommandInput : public CommandInput {};
+
+		/// <summary>
+		/// <para>TableCommandInput arranges inputs in rows and columns. Cells are created through commandInputs()</para>
+		/// <para>and placed by addCommandInput; deleting a row or clearing the table deletes its inputs.</para>
+		/// </summary>
+		class TableCommandInput : public CommandInput
+		{
+		public:
+			bool hasGrid(bool value);
+			bool tablePresentationStyle(TablePresentationStyles value);
+			bool columnSpacing(int value);
+			bool rowSpacing(int value);
+			bool maximumVisibleRows(int value);
+			bool minimumVisibleRows(int value);
+
+			bool addCommandInput(const Ptr<CommandInput>& input, int row, int column, int rowSpan = 0, int columnSpan = 0);
+			bool addToolbarCommandInput(const Ptr<CommandInput>& input);
+			Ptr<CommandInput> getInputAtPosition(int row, int column) const;
+			bool deleteRow(int row);
+			bool clear();
+			int rowCount() const;
+			int selectedRow() const;
+			bool selectedRow(int value);
+			Ptr<CommandInputs> commandInputs() const;
+
+			#pragma region Stand-in
+			void initialize(int numberOfColumns, const std::string& columnRatio);
+			void deleteChildren() override;
+			void removeCell(const CommandInput* input);
+			#pragma endregion
+
+		private:
+			int numberOfColumns_ = 0;
+			std::string columnRatio_;
+			int selectedRow_ = -1;
+			int maximumVisibleRows_ = 4;
+			int minimumVisibleRows_ = 1;
+			bool hasGrid_ = true;
+			TablePresentationStyles presentationStyle_ = nameValueTablePresentationStyle;
+			std::vector<std::vector<Ptr<CommandInput>>> rows_;
+			Ptr<CommandInputs> cellInputs_;
+			std::vector<Ptr<CommandInput>> toolbarInputs_;
+		};
+
+		/// <summary>A collection of inputs: the top level inputs of a command or the children of a tab, group or table.</summary>
+		class CommandInputs : public Base
+		{
+		public:
+			CommandInputs(Command* command, CommandInput* parent);
+			~CommandInputs() override;
+
+			Ptr<TabCommandInput> addTabCommandInput(const std::string& id, const std::string& name, const std::string& resourceFolder = "");
+			Ptr<GroupCommandInput> addGroupCommandInput(const std::string& id, const std::string& name);
+			Ptr<DropDownCommandInput> addDropDownCommandInput(const std::string& id, const std::string& name, DropDownStyles dropDownStyle);
+			Ptr<TextBoxCommandInput> addTextBoxCommandInput(const std::string& id, const std::string& name, const std::string& formattedText, int numRows, bool isReadOnly);
+			Ptr<ValueCommandInput> addValueInput(const std::string& id, const std::string& name, const std::string& unitType, const Ptr<ValueInput>& initialValue);
+			Ptr<StringValueCommandInput> addStringValueInput(const std::string& id, const std::string& name, const std::string& initialValue = "");
+			Ptr<BoolValueCommandInput> addBoolValueInput(const std::string& id, const std::string& name, bool isCheckBox, const std::string& resourceFolder = "", bool initialValue = false);
+			Ptr<IntegerSpinnerCommandInput> addIntegerSpinnerCommandInput(const std::string& id, const std::string& name, int min, int max, int spinStep, int initialValue);
+			Ptr<FloatSliderCommandInput> addFloatSliderCommandInput(const std::string& id, const std::string& name, const std::string& unitType, double min, double max, bool hasTwoSliders = false);
+			Ptr<TableCommandInput> addTableCommandInput(const std::string& id, const std::string& name, int numberOfColumns, const std::string& columnRatio);
+			Ptr<SeparatorCommandInput> addSeparatorCommandInput(const std::string& id);
+			Ptr<ButtonRowCommandInput> addButtonRowCommandInput(const std::string& id, const std::string& name, bool isMultiSelectEnabled);
+
+			Ptr<CommandInput> itemById(const std::string& id) const;
+			size_t count() const;
+			Ptr<CommandInput> item(size_t index) const;
+			Ptr<Command> command() const;
+
+			#pragma region Stand-in
+			void remove(const CommandInput* input);
+			void deleteAll();
+			#pragma endregion
+
+		private:
+			template<class T> Ptr<T> addInput(const std::string& id, const std::string& name);
+
+			Command* command_;
+			CommandInput* parent_;
+			std::vector<Ptr<CommandInput>> items_;
+		};
+	}
+}
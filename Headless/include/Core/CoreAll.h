@@ -0,0 +1,9 @@
+#pragma once
+// Headless stand-in for the subset of the Fusion core API used by the add-in.
+#include <Core/Base.h>
+#include <Core/Enums.h>
+#include <Core/Geometry.h>
+#include <Core/Events.h>
+#include <Core/CommandInputs.h>
+#include <Core/UserInterface.h>
+#include <Core/Application.h>
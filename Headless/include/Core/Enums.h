@@ -0,0 +1,32 @@
+#pragma once
+
+namespace adsk {
+	namespace core {
+		enum LogLevels { InfoLogLevel, WarningLogLevel, ErrorLogLevel };
+		enum LogTypes { ConsoleLogType, FileLogType };
+		enum UserLanguages {
+			ChinesePRCLanguage, ChineseTaiwanLanguage, CzechLanguage, EnglishLanguage, FrenchLanguage, GermanLanguage,
+			HungarianLanguage, ItalianLanguage, JapaneseLanguage, KoreanLanguage, PolishLanguage,
+			PortugueseBrazilianLanguage, RussianLanguage, SpanishLanguage, TurkishLanguage
+		};
+		enum ViewOrientations {
+			ArbitraryViewOrientation, BackViewOrientation, BottomViewOrientation, FrontViewOrientation,
+			IsoBottomLeftViewOrientation, IsoBottomRightViewOrientation, IsoTopLeftViewOrientation,
+			IsoTopRightViewOrientation, LeftViewOrientation, RightViewOrientation, TopViewOrientation
+		};
+		enum HorizontalAlignments { LeftHorizontalAlignment, CenterHorizontalAlignment, RightHorizontalAlignment };
+		enum VerticalAlignments { TopVerticalAlignment, MiddleVerticalAlignment, BottomVerticalAlignment };
+		enum CameraTypes { OrthographicCameraType, PerspectiveCameraType, PerspectiveWithOrthoFacesCameraType };
+		enum DropDownStyles { LabeledIconDropDownStyle, TextListDropDownStyle, CheckBoxDropDownStyle };
+		enum TablePresentationStyles {
+			nameValueTablePresentationStyle, itemBorderTablePresentationStyle, transparentBackgroundTablePresentationStyle
+		};
+		enum DialogResults { DialogError = -1, DialogOK = 0, DialogCancel = 1, DialogNo = 2, DialogYes = 3 };
+		enum MessageBoxButtonTypes { OKButtonType, OKCancelButtonType, RetryCancelButtonType, YesNoButtonType, YesNoCancelButtonType };
+		enum MessageBoxIconTypes { NoIconIconType, InformationIconType, WarningIconType, CriticalIconType, QuestionIconType };
+		enum CommandTerminationReason {
+			UnknownTerminationReason, CompletedTerminationReason, CancelledTerminationReason,
+			AbortedTerminationReason, PreEmptedTerminationReason, SessionEndingTerminationReason
+		};
+	}
+}
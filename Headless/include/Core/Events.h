@@ -0,0 +1,142 @@
+#pragma once
+#include <Core/Base.h>
+#include <Core/Enums.h>
+#include <algorithm>
+
+namespace adsk {
+	namespace core {
+		class Command;
+		class CommandInput;
+		class CommandInputs;
+		class Document;
+
+		class EventArgs : public Base {};
+
+		template<class Args> class EventHandlerT
+		{
+		public:
+			virtual ~EventHandlerT() = default;
+			virtual void notify(const Ptr<Args>& eventArgs) = 0;
+		};
+
+		/// <summary>
+		/// <para>EventT keeps the handlers of one event. As in Fusion the handlers are not owned by the event.</para>
+		/// <para>The stand-in fires the event itself through notify.</para>
+		/// </summary>
+		template<class Handler> class EventT : public Base
+		{
+		public:
+			bool add(Handler* handler) {
+				if (!handler || std::find(handlers_.begin(), handlers_.end(), handler) != handlers_.end()) {
+					return false;
+				}
+				handlers_.push_back(handler);
+				return true;
+			}
+			bool remove(Handler* handler) {
+				auto it = std::find(handlers_.begin(), handlers_.end(), handler);
+				if (it == handlers_.end()) {
+					return false;
+				}
+				handlers_.erase(it);
+				return true;
+			}
+
+			#pragma region Stand-in
+			template<class Args> void notify(const Ptr<Args>& eventArgs) {
+				// Handlers may add or remove handlers while being notified
+				std::vector<Handler*> handlers = handlers_;
+				for (Handler* handler : handlers) {
+					handler->notify(eventArgs);
+				}
+			}
+			size_t handlerCount() const { return handlers_.size(); }
+			#pragma endregion
+
+		private:
+			std::vector<Handler*> handlers_;
+		};
+
+		class CommandCreatedEventArgs : public EventArgs
+		{
+		public:
+			explicit CommandCreatedEventArgs(const Ptr<Command>& command);
+			~CommandCreatedEventArgs() override;
+			Ptr<Command> command() const;
+
+		private:
+			Ptr<Command> command_;
+		};
+		class CommandCreatedEventHandler : public EventHandlerT<CommandCreatedEventArgs> {};
+		class CommandCreatedEvent : public EventT<CommandCreatedEventHandler> {};
+
+		class InputChangedEventArgs : public EventArgs
+		{
+		public:
+			InputChangedEventArgs(const Ptr<CommandInput>& input, const Ptr<CommandInputs>& inputs);
+			~InputChangedEventArgs() override;
+			Ptr<CommandInput> input() const;
+			Ptr<CommandInputs> inputs() const;
+
+		private:
+			Ptr<CommandInput> input_;
+			Ptr<CommandInputs> inputs_;
+		};
+		class InputChangedEventHandler : public EventHandlerT<InputChangedEventArgs> {};
+		class InputChangedEvent : public EventT<InputChangedEventHandler> {};
+
+		class CommandEventArgs : public EventArgs
+		{
+		public:
+			CommandEventArgs(const Ptr<Command>& command, CommandTerminationReason terminationReason);
+			~CommandEventArgs() override;
+			Ptr<Command> command() const;
+			CommandTerminationReason terminationReason() const;
+
+		private:
+			Ptr<Command> command_;
+			CommandTerminationReason terminationReason_;
+		};
+		class CommandEventHandler : public EventHandlerT<CommandEventArgs> {};
+		class CommandEvent : public EventT<CommandEventHandler> {};
+
+		class CustomEventArgs : public EventArgs
+		{
+		public:
+			explicit CustomEventArgs(const std::string& additionalInfo);
+			std::string additionalInfo() const;
+
+		private:
+			std::string additionalInfo_;
+		};
+		class CustomEventHandler : public EventHandlerT<CustomEventArgs> {};
+		class CustomEvent : public EventT<CustomEventHandler> {};
+
+		class DocumentEventArgs : public EventArgs
+		{
+		public:
+			explicit DocumentEventArgs(const Ptr<Document>& document);
+			~DocumentEventArgs() override;
+			Ptr<Document> document() const;
+
+		private:
+			Ptr<Document> document_;
+		};
+		class DocumentEventHandler : public EventHandlerT<DocumentEventArgs> {};
+		class DocumentEvent : public EventT<DocumentEventHandler> {};
+
+		class ApplicationCommandEventArgs : public EventArgs
+		{
+		public:
+			ApplicationCommandEventArgs(const std::string& commandId, CommandTerminationReason terminationReason);
+			std::string commandId() const;
+			CommandTerminationReason terminationReason() const;
+
+		private:
+			std::string commandId_;
+			CommandTerminationReason terminationReason_;
+		};
+		class ApplicationCommandEventHandler : public EventHandlerT<ApplicationCommandEventArgs> {};
+		class ApplicationCommandEvent : public EventT<ApplicationCommandEventHandler> {};
+	}
+}
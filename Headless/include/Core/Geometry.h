@@ -0,0 +1,68 @@
+#pragma once
+#include <Core/Base.h>
+
+namespace adsk {
+	namespace core {
+		class Point3D : public Base
+		{
+		public:
+			static Ptr<Point3D> create(double x = 0.0, double y = 0.0, double z = 0.0);
+
+			double x() const;
+			bool x(double value);
+			double y() const;
+			bool y(double value);
+			double z() const;
+			bool z(double value);
+			double distanceTo(const Ptr<Point3D>& point) const;
+
+		private:
+			double x_ = 0.0;
+			double y_ = 0.0;
+			double z_ = 0.0;
+		};
+
+		class Vector3D : public Base
+		{
+		public:
+			static Ptr<Vector3D> create(double x = 0.0, double y = 0.0, double z = 0.0);
+
+			double x() const;
+			double y() const;
+			double z() const;
+			Ptr<Vector3D> crossProduct(const Ptr<Vector3D>& vector) const;
+
+		private:
+			double x_ = 0.0;
+			double y_ = 0.0;
+			double z_ = 0.0;
+		};
+
+		class Matrix3D : public Base {};
+
+		class BoundingBox3D : public Base
+		{
+		public:
+			static Ptr<BoundingBox3D> create(const Ptr<Point3D>& minPoint, const Ptr<Point3D>& maxPoint);
+
+			Ptr<Point3D> minPoint() const;
+			Ptr<Point3D> maxPoint() const;
+
+		private:
+			Ptr<Point3D> minPoint_;
+			Ptr<Point3D> maxPoint_;
+		};
+
+		class Color : public Base
+		{
+		public:
+			static Ptr<Color> create(int red, int green, int blue, int opacity);
+
+		private:
+			int red_ = 0;
+			int green_ = 0;
+			int blue_ = 0;
+			int opacity_ = 255;
+		};
+	}
+}
@@ -0,0 +1,338 @@
+#pragma once
+#include <Core/Base.h>
+#include <Core/Enums.h>
+#include <Core/Events.h>
+#include <Core/CommandInputs.h>
+#include <map>
+
+namespace adsk {
+	/// <summary>Lets Fusion process pending events; the stand-in delivers its queued events.</summary>
+	void doEvents();
+
+	namespace core {
+		class CommandDefinition;
+		class CommandDefinitions;
+
+		/// <summary>
+		/// <para>Command is the running instance of a command definition. It owns the top level inputs and knows</para>
+		/// <para>every input of the dialog by id.</para>
+		/// </summary>
+		class Command : public Base
+		{
+		public:
+			explicit Command(CommandDefinition* parent);
+			~Command() override;
+
+			Ptr<CommandInputs> commandInputs() const;
+			Ptr<InputChangedEvent> inputChanged() const;
+			Ptr<CommandEvent> destroy() const;
+			Ptr<CommandEvent> execute() const;
+			Ptr<CommandEvent> executePreview() const;
+			bool doExecute(bool terminate);
+			bool isOKButtonVisible() const;
+			bool isOKButtonVisible(bool value);
+			std::string okButtonText() const;
+			bool okButtonText(const std::string& value);
+			Ptr<CommandDefinition> parentCommandDefinition() const;
+
+			#pragma region Stand-in
+			bool registerInput(CommandInput* input);
+			void unregisterInput(const CommandInput* input);
+			CommandInput* findInput(std::string_view id) const;
+			void terminate(CommandTerminationReason reason);
+			bool isTerminated() const { return isTerminated_; }
+			#pragma endregion
+
+		private:
+			CommandDefinition* parent_;
+			Ptr<CommandInputs> commandInputs_;
+			Ptr<InputChangedEvent> inputChanged_;
+			Ptr<CommandEvent> destroy_;
+			Ptr<CommandEvent> execute_;
+			Ptr<CommandEvent> executePreview_;
+			std::map<std::string, CommandInput*, std::less<>> inputsById_;
+			std::string okButtonText_ = "OK";
+			bool isOKButtonVisible_ = true;
+			bool isTerminated_ = false;
+		};
+
+		class ControlDefinition : public Base
+		{
+		public:
+			std::string name() const;
+			bool name(const std::string& value);
+			bool isEnabled() const;
+			bool isEnabled(bool value);
+			bool isVisible() const;
+			bool isVisible(bool value);
+
+		private:
+			std::string name_;
+			bool isEnabled_ = true;
+			bool isVisible_ = true;
+		};
+
+		class CommandDefinition : public Base
+		{
+		public:
+			CommandDefinition(const std::string& id, const std::string& name, const std::string& tooltip, const std::string& resourceFolder);
+			~CommandDefinition() override;
+
+			std::string id() const;
+			std::string name() const;
+			std::string tooltip() const;
+			std::string resourceFolder() const;
+			Ptr<ControlDefinition> controlDefinition() const;
+			Ptr<CommandCreatedEvent> commandCreated() const;
+			bool execute();
+			bool deleteMe();
+
+			#pragma region Stand-in
+			Ptr<Command> createCommand();
+			Ptr<Command> getActiveCommand() const { return activeCommand_; }
+			#pragma endregion
+
+		private:
+			friend class CommandDefinitions;
+
+			CommandDefinitions* parent_ = nullptr;
+			std::string id_;
+			std::string tooltip_;
+			std::string resourceFolder_;
+			Ptr<ControlDefinition> controlDefinition_;
+			Ptr<CommandCreatedEvent> commandCreated_;
+			Ptr<Command> activeCommand_;
+		};
+
+		class CommandDefinitions : public Base
+		{
+		public:
+			Ptr<CommandDefinition> addButtonDefinition(const std::string& id, const std::string& name, const std::string& tooltip, const std::string& resourceFolder = "");
+			Ptr<CommandDefinition> itemById(const std::string& id) const;
+			size_t count() const;
+			Ptr<CommandDefinition> item(size_t index) const;
+
+			#pragma region Stand-in
+			void remove(const CommandDefinition* definition);
+			#pragma endregion
+
+		private:
+			std::vector<Ptr<CommandDefinition>> items_;
+		};
+
+		class Palette : public Base
+		{
+		public:
+			explicit Palette(const std::string& id);
+
+			std::string id() const;
+			bool isVisible() const;
+			bool isVisible(bool value);
+
+		private:
+			std::string id_;
+			bool isVisible_ = false;
+		};
+
+		/// <summary>The text commands palette; the stand-in echoes what is written to standard output.</summary>
+		class TextCommandPalette : public Palette
+		{
+		public:
+			using Palette::Palette;
+			bool writeText(const std::string& text);
+		};
+
+		class Palettes : public Base
+		{
+		public:
+			Palettes();
+			Ptr<Palette> itemById(const std::string& id) const;
+
+		private:
+			std::vector<Ptr<Palette>> items_;
+		};
+
+		class ToolbarControls;
+
+		class ToolbarControl : public Base
+		{
+		public:
+			using ClassType = ToolbarControl;
+
+			std::string id() const;
+			bool isVisible() const;
+			bool isVisible(bool value);
+			bool deleteMe();
+
+			#pragma region Stand-in
+			void attach(ToolbarControls* parent, const std::string& id);
+			#pragma endregion
+
+		private:
+			ToolbarControls* parent_ = nullptr;
+			std::string id_;
+			bool isVisible_ = true;
+		};
+
+		class CommandControl : public ToolbarControl
+		{
+		public:
+			using ClassType = CommandControl;
+
+			Ptr<CommandDefinition> commandDefinition() const;
+
+			#pragma region Stand-in
+			void initialize(const Ptr<CommandDefinition>& commandDefinition);
+			#pragma endregion
+
+		private:
+			Ptr<CommandDefinition> commandDefinition_;
+		};
+
+		class DropDownControl : public ToolbarControl
+		{
+		public:
+			using ClassType = DropDownControl;
+
+			Ptr<ToolbarControls> controls() const;
+
+			#pragma region Stand-in
+			void initialize(const std::string& text, const std::string& resourceFolder);
+			#pragma endregion
+
+		private:
+			std::string text_;
+			std::string resourceFolder_;
+			Ptr<ToolbarControls> controls_;
+		};
+
+		class ToolbarControls : public Base
+		{
+		public:
+			Ptr<CommandControl> addCommand(const Ptr<CommandDefinition>& commandDefinition, const std::string& positionId = "", bool isBefore = true);
+			Ptr<DropDownControl> addDropDown(const std::string& text, const std::string& resourceFolder, const std::string& id = "", const std::string& positionId = "", bool isBefore = true);
+			Ptr<ToolbarControl> itemById(const std::string& id) const;
+			size_t count() const;
+			Ptr<ToolbarControl> item(size_t index) const;
+
+			#pragma region Stand-in
+			void remove(const ToolbarControl* control);
+			#pragma endregion
+
+		private:
+			std::vector<Ptr<ToolbarControl>> items_;
+		};
+
+		class ToolbarPanels;
+
+		class ToolbarPanel : public Base
+		{
+		public:
+			using ClassType = ToolbarPanel;
+
+			std::string id() const;
+			std::string name() const;
+			Ptr<ToolbarControls> controls() const;
+			bool deleteMe();
+
+			#pragma region Stand-in
+			void initialize(ToolbarPanels* parent, const std::string& id, const std::string& name);
+			#pragma endregion
+
+		private:
+			ToolbarPanels* parent_ = nullptr;
+			std::string id_;
+			std::string name_;
+			Ptr<ToolbarControls> controls_;
+		};
+
+		class ToolbarPanels : public Base
+		{
+		public:
+			Ptr<ToolbarPanel> add(const std::string& id, const std::string& name, const std::string& positionId = "", bool isBefore = true);
+			Ptr<ToolbarPanel> itemById(const std::string& id) const;
+			size_t count() const;
+			Ptr<ToolbarPanel> item(size_t index) const;
+
+			#pragma region Stand-in
+			void remove(const ToolbarPanel* panel);
+			#pragma endregion
+
+		private:
+			std::vector<Ptr<ToolbarPanel>> items_;
+		};
+
+		class Workspace : public Base
+		{
+		public:
+			explicit Workspace(const std::string& id);
+
+			std::string id() const;
+			Ptr<ToolbarPanels> toolbarPanels() const;
+
+		private:
+			std::string id_;
+			Ptr<ToolbarPanels> toolbarPanels_;
+		};
+
+		class Workspaces : public Base
+		{
+		public:
+			Workspaces();
+
+			Ptr<Workspace> itemById(const std::string& id) const;
+			size_t count() const;
+			Ptr<Workspace> item(size_t index) const;
+
+		private:
+			std::vector<Ptr<Workspace>> items_;
+		};
+
+		/// <summary>A file dialog that answers with the file name set up in the headless runtime, or is cancelled.</summary>
+		class FileDialog : public Base
+		{
+		public:
+			std::string title() const;
+			bool title(const std::string& value);
+			std::string filter() const;
+			bool filter(const std::string& value);
+			int filterIndex() const;
+			bool filterIndex(int value);
+			std::string initialFilename() const;
+			bool initialFilename(const std::string& value);
+			std::string filename() const;
+			DialogResults showSave();
+			DialogResults showOpen();
+
+		private:
+			DialogResults show();
+
+			std::string title_;
+			std::string filter_;
+			int filterIndex_ = 0;
+			std::string initialFilename_;
+			std::string filename_;
+		};
+
+		class UserInterface : public Base
+		{
+		public:
+			UserInterface();
+			~UserInterface() override;
+
+			Ptr<Palettes> palettes() const;
+			Ptr<CommandDefinitions> commandDefinitions() const;
+			Ptr<Workspaces> workspaces() const;
+			Ptr<Command> activeCommand() const;
+			Ptr<ApplicationCommandEvent> commandTerminated() const;
+			Ptr<FileDialog> createFileDialog();
+			DialogResults messageBox(const std::string& text, const std::string& title = "", MessageBoxButtonTypes buttons = OKButtonType, MessageBoxIconTypes icon = NoIconIconType);
+
+		private:
+			Ptr<Palettes> palettes_;
+			Ptr<CommandDefinitions> commandDefinitions_;
+			Ptr<Workspaces> workspaces_;
+			Ptr<ApplicationCommandEvent> commandTerminated_;
+		};
+	}
+}
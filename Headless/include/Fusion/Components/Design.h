@@ -0,0 +1,53 @@
+#pragma once
+#include <Core/CoreAll.h>
+#include <Fusion/Sketch/SketchTexts.h>
+#include <Fusion/Graphics/CustomGraphics.h>
+
+namespace adsk {
+	namespace fusion {
+		class Component : public Base
+		{
+		public:
+			explicit Component(const std::string& name);
+			~Component() override;
+
+			std::string name() const;
+			Ptr<Sketches> sketches() const;
+			Ptr<CustomGraphicsGroups> customGraphicsGroups() const;
+
+		private:
+			std::string name_;
+			Ptr<Sketches> sketches_;
+			Ptr<CustomGraphicsGroups> customGraphicsGroups_;
+		};
+
+		class Components : public Base
+		{
+		public:
+			size_t count() const;
+			Ptr<Component> item(size_t index) const;
+
+			#pragma region Stand-in
+			void add(const Ptr<Component>& component);
+			#pragma endregion
+
+		private:
+			std::vector<Ptr<Component>> items_;
+		};
+
+		/// <summary>A design with a single root component, as replayed from a recording.</summary>
+		class Design : public adsk::core::Product
+		{
+		public:
+			explicit Design(const std::string& rootComponentName);
+
+			Ptr<Component> rootComponent() const;
+			Ptr<Components> allComponents() const;
+			std::vector<Ptr<Base>> findEntityByToken(const std::string& entityToken) const;
+
+		private:
+			Ptr<Component> rootComponent_;
+			Ptr<Components> allComponents_;
+		};
+	}
+}
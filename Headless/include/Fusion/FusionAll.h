@@ -0,0 +1,8 @@
+#pragma once
+// Headless stand-in for the subset of the Fusion design API used by the add-in.
+#include <Core/CoreAll.h>
+#include <Fusion/Sketch/Sketch.h>
+#include <Fusion/Sketch/SketchText.h>
+#include <Fusion/Sketch/SketchTexts.h>
+#include <Fusion/Graphics/CustomGraphics.h>
+#include <Fusion/Components/Design.h>
@@ -0,0 +1,124 @@
+#pragma once
+#include <Core/CoreAll.h>
+
+namespace adsk {
+	namespace fusion {
+		using adsk::core::Color;
+
+		class CustomGraphicsGroups;
+
+		class CustomGraphicsCoordinates : public Base
+		{
+		public:
+			static Ptr<CustomGraphicsCoordinates> create(const std::vector<double>& coordinates);
+
+			std::vector<double> coordinates() const;
+			size_t coordinateCount() const;
+
+		private:
+			std::vector<double> coordinates_;
+		};
+
+		class CustomGraphicsColorEffect : public Base {};
+
+		class CustomGraphicsSolidColorEffect : public CustomGraphicsColorEffect
+		{
+		public:
+			static Ptr<CustomGraphicsSolidColorEffect> create(const Ptr<Color>& color);
+
+		private:
+			Ptr<Color> color_;
+		};
+
+		class CustomGraphicsGroup;
+
+		class CustomGraphicsEntity : public Base
+		{
+		public:
+			std::string id() const;
+			bool id(const std::string& value);
+			bool color(const Ptr<CustomGraphicsColorEffect>& value);
+			bool isVisible() const;
+			bool isVisible(bool value);
+			bool isSelectable() const;
+			bool isSelectable(bool value);
+			bool setOpacity(double opacity, bool isScreenSpace);
+			virtual bool deleteMe();
+
+			#pragma region Stand-in
+			void attach(CustomGraphicsGroup* group) { group_ = group; }
+			#pragma endregion
+
+		private:
+			CustomGraphicsGroup* group_ = nullptr;
+			std::string id_;
+			Ptr<CustomGraphicsColorEffect> color_;
+			double opacity_ = 1.0;
+			bool isVisible_ = true;
+			bool isSelectable_ = true;
+		};
+
+		class CustomGraphicsLines : public CustomGraphicsEntity
+		{
+		public:
+			double weight() const;
+			bool weight(double value);
+			bool isScreenSpaceLineStyle() const;
+			bool isScreenSpaceLineStyle(bool value);
+			Ptr<CustomGraphicsCoordinates> coordinates() const;
+
+			#pragma region Stand-in
+			void initialize(const Ptr<CustomGraphicsCoordinates>& coordinates, const std::vector<int>& indexList,
+				bool isLineStrip, const std::vector<int>& lineStripLengths);
+			size_t getSegmentCount() const;
+			#pragma endregion
+
+		private:
+			Ptr<CustomGraphicsCoordinates> coordinates_;
+			std::vector<int> indexList_;
+			std::vector<int> lineStripLengths_;
+			double weight_ = 1.0;
+			bool isLineStrip_ = false;
+			bool isScreenSpaceLineStyle_ = true;
+		};
+
+		/// <summary>A group of custom graphics entities; deleting the group deletes its entities.</summary>
+		class CustomGraphicsGroup : public CustomGraphicsEntity
+		{
+		public:
+			~CustomGraphicsGroup() override;
+
+			Ptr<CustomGraphicsLines> addLines(const Ptr<CustomGraphicsCoordinates>& coordinates, const std::vector<int>& indexList,
+				bool isLineStrip, const std::vector<int>& lineStripLengths = std::vector<int>());
+			size_t count() const;
+			Ptr<CustomGraphicsEntity> item(size_t index) const;
+			bool deleteMe() override;
+
+			#pragma region Stand-in
+			void attach(CustomGraphicsGroups* groups) { groups_ = groups; }
+			void remove(const CustomGraphicsEntity* entity);
+			#pragma endregion
+
+		private:
+			CustomGraphicsGroups* groups_ = nullptr;
+			std::vector<Ptr<CustomGraphicsEntity>> items_;
+		};
+
+		class CustomGraphicsGroups : public Base
+		{
+		public:
+			~CustomGraphicsGroups() override;
+
+			Ptr<CustomGraphicsGroup> add();
+			size_t count() const;
+			Ptr<CustomGraphicsGroup> item(size_t index) const;
+
+			#pragma region Stand-in
+			void remove(const CustomGraphicsGroup* group);
+			#pragma endregion
+
+		private:
+			std::vector<Ptr<CustomGraphicsGroup>> items_;
+		};
+	}
+}
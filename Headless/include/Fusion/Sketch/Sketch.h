@@ -0,0 +1,120 @@
+#pragma once
+#include <Core/CoreAll.h>
+
+namespace adsk {
+	namespace fusion {
+		using adsk::core::Base;
+		using adsk::core::BoundingBox3D;
+		using adsk::core::Point3D;
+		using adsk::core::Ptr;
+		using adsk::core::Vector3D;
+
+		class Component;
+		class Sketch;
+		class SketchText;
+		class SketchTexts;
+
+		/// <summary>A point of a sketch; geometry() is in sketch space, worldGeometry() in model space.</summary>
+		class SketchPoint : public Base
+		{
+		public:
+			SketchPoint(const Ptr<Sketch>& sketch, double x, double y);
+			~SketchPoint() override;
+
+			Ptr<Point3D> geometry() const;
+			Ptr<Point3D> worldGeometry() const;
+
+		private:
+			Ptr<Sketch> sketch_;
+			double x_;
+			double y_;
+		};
+
+		class SketchLine : public Base
+		{
+		public:
+			SketchLine(const Ptr<SketchPoint>& startPoint, const Ptr<SketchPoint>& endPoint);
+
+			Ptr<SketchPoint> startSketchPoint() const;
+			Ptr<SketchPoint> endSketchPoint() const;
+
+		private:
+			Ptr<SketchPoint> startPoint_;
+			Ptr<SketchPoint> endPoint_;
+		};
+
+		class SketchTextDefinition : public Base {};
+
+		/// <summary>The definition of a text laid out in a rectangle, which the stand-in takes from the text's bounding box.</summary>
+		class MultiLineTextDefinition : public SketchTextDefinition
+		{
+		public:
+			explicit MultiLineTextDefinition(const Ptr<SketchText>& text);
+			~MultiLineTextDefinition() override;
+
+			std::vector<Ptr<SketchLine>> rectangleLines() const;
+			adsk::core::HorizontalAlignments horizontalAlignment() const;
+			adsk::core::VerticalAlignments verticalAlignment() const;
+
+		private:
+			Ptr<SketchText> text_;
+		};
+
+		/// <summary>
+		/// <para>Sketch holds the sketch texts of a replayed design. The sketch plane is described by origin and</para>
+		/// <para>directions, which default to the XY plane of the model.</para>
+		/// </summary>
+		class Sketch : public Base
+		{
+		public:
+			Sketch(const std::string& name, const std::string& entityToken);
+			~Sketch() override;
+
+			std::string name() const;
+			bool name(const std::string& value);
+			std::string entityToken() const;
+			std::string revisionId() const;
+			Ptr<SketchTexts> sketchTexts() const;
+			Ptr<Point3D> origin() const;
+			Ptr<Vector3D> xDirection() const;
+			Ptr<Vector3D> yDirection() const;
+			Ptr<BoundingBox3D> boundingBox() const;
+			bool isComputeDeferred() const;
+			bool isComputeDeferred(bool value);
+			Ptr<Component> parentComponent() const;
+
+			#pragma region Stand-in
+			void attach(Component* component) { component_ = component; }
+			void setPlane(double originX, double originY, double originZ,
+				double xDirectionX, double xDirectionY, double xDirectionZ,
+				double yDirectionX, double yDirectionY, double yDirectionZ);
+			void toWorld(double x, double y, double& worldX, double& worldY, double& worldZ) const;
+			void touch() { ++revision_; }
+			#pragma endregion
+
+		private:
+			std::string name_;
+			std::string entityToken_;
+			Ptr<SketchTexts> sketchTexts_;
+			Component* component_ = nullptr;
+			double plane_[9] = { 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+			uint64_t revision_ = 0;
+			bool isComputeDeferred_ = false;
+		};
+
+		class Sketches : public Base
+		{
+		public:
+			size_t count() const;
+			Ptr<Sketch> item(size_t index) const;
+			Ptr<Sketch> itemByName(const std::string& name) const;
+
+			#pragma region Stand-in
+			void add(const Ptr<Sketch>& sketch);
+			#pragma endregion
+
+		private:
+			std::vector<Ptr<Sketch>> items_;
+		};
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <Fusion/Sketch/Sketch.h>
+
+namespace adsk {
+	namespace fusion {
+		/// <summary>
+		/// <para>A text of a sketch with its height and bounding box in model space. Changing the height scales the</para>
+		/// <para>bounding box about its minimum point, the anchor of the default alignment that its definition reports.</para>
+		/// </summary>
+		class SketchText : public Base
+		{
+		public:
+			SketchText(Sketch* sketch, const std::string& text, double height,
+				const Ptr<Point3D>& minPoint, const Ptr<Point3D>& maxPoint, const std::string& entityToken);
+
+			std::string text() const;
+			bool text(const std::string& value);
+			double height() const;
+			bool height(double value);
+			Ptr<BoundingBox3D> boundingBox() const;
+			Ptr<SketchTextDefinition> definition() const;
+			std::string entityToken() const;
+			Ptr<Sketch> parentSketch() const;
+			bool deleteMe();
+
+			#pragma region Stand-in
+			void detach() { sketch_ = nullptr; }
+			void getBounds(double& minX, double& minY, double& maxX, double& maxY) const;
+			#pragma endregion
+
+		private:
+			Sketch* sketch_;
+			std::string text_;
+			double height_;
+			double min_[3];
+			double max_[3];
+			std::string entityToken_;
+		};
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <Fusion/Sketch/SketchText.h>
+
+namespace adsk {
+	namespace fusion {
+		class SketchTexts : public Base
+		{
+		public:
+			explicit SketchTexts(Sketch* sketch);
+			~SketchTexts() override;
+
+			size_t count() const;
+			Ptr<SketchText> item(size_t index) const;
+
+			#pragma region Stand-in
+			Ptr<SketchText> add(const std::string& text, double height,
+				const Ptr<Point3D>& minPoint, const Ptr<Point3D>& maxPoint, const std::string& entityToken);
+			void remove(const SketchText* text);
+			#pragma endregion
+
+		private:
+			Sketch* sketch_;
+			std::vector<Ptr<SketchText>> items_;
+		};
+	}
+}
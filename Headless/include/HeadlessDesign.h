@@ -0,0 +1,20 @@
+#pragma once
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+namespace implicatex {
+	namespace headless {
+		/// <summary>
+		/// <para>DesignRecording creates the documents the stand-in replays. Recordings are the JSON Lines files</para>
+		/// <para>written by the export of the Sketch Text panel: one text per line with its sketch, height and</para>
+		/// <para>bounding box in millimeters and its entity token. Designs can also be generated for benchmarks.</para>
+		/// </summary>
+		class DesignRecording
+		{
+		public:
+			static bool load(const std::string& path, adsk::core::Ptr<adsk::core::Document>& document, std::string& error);
+			static bool save(const adsk::core::Ptr<adsk::fusion::Design>& design, const std::string& path);
+			static adsk::core::Ptr<adsk::core::Document> generate(const std::string& name, size_t sketchCount, size_t textsPerSketch, uint32_t seed);
+		};
+	}
+}
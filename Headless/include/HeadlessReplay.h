@@ -0,0 +1,118 @@
+#pragma once
+#include <Core/CoreAll.h>
+#include <functional>
+#include <variant>
+
+namespace implicatex {
+	namespace headless {
+		/// <summary>
+		/// <para>What the panel or the design must show after a replayed event: the value of an input, the number of</para>
+		/// <para>line segments of the custom graphics, or the content (a string) or height (a number) of a sketch text.</para>
+		/// </summary>
+		struct ReplayExpectation {
+			enum class Kind { Input, Segments, Text };
+
+			Kind kind = Kind::Input;
+			std::string inputId;
+			std::string sketchName;
+			int textIndex = 0;
+			std::variant<std::monostate, bool, double, std::string> value;
+		};
+
+		/// <summary>
+		/// <para>One user interaction of a replay script: the input it changes, the new value and the latency budget.</para>
+		/// <para>A row sets the selected row of a table and changes the cell at row and column instead.</para>
+		/// <para>A sketch name makes it an edit of that sketch's text at textIndex by another Fusion command.</para>
+		/// <para>A document name switches to that document, generating it with sketchCount sketches first if isOpen.</para>
+		/// </summary>
+		struct ReplayEvent {
+			size_t line = 0;
+			std::string inputId;
+			std::string sketchName;
+			int textIndex = 0;
+			std::string documentName;
+			bool isOpen = false;
+			size_t sketchCount = 0;
+			size_t textsPerSketch = 0;
+			std::variant<std::monostate, bool, double, std::string> value;
+			int row = -1;
+			int column = 0;
+			double budgetMs = 0.0;
+			std::vector<ReplayExpectation> expectations;
+		};
+
+		/// <summary>The end-to-end latency of a replayed event and the API calls and heap allocations it made.</summary>
+		struct ReplayResult {
+			const ReplayEvent* event = nullptr;
+			std::string eventType;
+			std::string error;
+			uint64_t nanoseconds = 0;
+			uint64_t apiCalls = 0;
+			uint64_t allocations = 0;
+			double budgetMs = 0.0;
+
+			bool isFailed() const { return !error.empty() || (budgetMs > 0.0 && (double)nanoseconds > budgetMs * 1e6); }
+		};
+
+		/// <summary>
+		/// <para>InputReplay feeds a script of input changes into the active command as Fusion does when the user edits</para>
+		/// <para>the dialog: it sets the input's value, then notifies the command's inputChanged handlers and delivers</para>
+		/// <para>the events they queue. The latency of each event covers both; setting the value is not counted.</para>
+		/// <para>Scripts are JSON Lines, one event per line:</para>
+		/// <para>  {"input":"dropdownSelectSketch","value":"Sketch2"}       select a list item by name</para>
+		/// <para>  {"input":"textHeightMin","value":"2.5 mm"}              the expression of a value input</para>
+		/// <para>  {"input":"textFind","value":"T-1"}                      a string value or text box</para>
+		/// <para>  {"input":"allSketches","value":true}                    a check box; true presses a button</para>
+		/// <para>  {"input":"textZoomFactor","value":5}                     a slider or spinner, in API units</para>
+		/// <para>  {"input":"textHeightTable","row":2,"column":0}          a click into a table cell</para>
+		/// <para>  {"input":"textHeightTable","row":2,"column":3,"value":true} a value set in a table cell, e.g. a check box</para>
+		/// <para>  {"edit":"Sketch2","text":3,"value":"X-1"}               another command sets a text; a number sets its height</para>
+		/// <para>  {"open":"Other","sketches":50,"texts":20}              generates a design in a new document and activates it</para>
+		/// <para>  {"activate":"Generated"}                               switches to an open document</para>
+		/// <para>Each line may set "budget_ms", which overrides the budget of its event type, and "expect", which the</para>
+		/// <para>event must leave behind; the event fails on the first mismatch:</para>
+		/// <para>  "expect":{"textHeightMatch":"12","textHeightTable":12}  a text box, string, value input, check box or</para>
+		/// <para>                                                          drop down shows the value, a table the row count</para>
+		/// <para>  "expect":{"segments":8}                                 the custom graphics draw 8 line segments</para>
+		/// <para>  "expect":{"texts":[{"sketch":"Sketch2","text":3,"value":"X-1"}]} a text of the design; a number is its height</para>
+		/// <para>An event also fails if the add-in logs an error while it runs, see setErrorCounter.</para>
+		/// </summary>
+		class InputReplay
+		{
+		public:
+			/// <summary>The event type of edits and the id of the command that makes them.</summary>
+			static constexpr const char* EDIT_EVENT_TYPE = "edit";
+			static constexpr const char* EDIT_COMMAND_ID = "EditSketchTextCommand";
+			/// <summary>The event types of opening and activating documents.</summary>
+			static constexpr const char* OPEN_EVENT_TYPE = "open";
+			static constexpr const char* ACTIVATE_EVENT_TYPE = "activate";
+
+			bool load(const std::string& path, std::string& error);
+
+			/// <summary>Sets the budget of an event type: the input id, or the cell id without row for table cells.</summary>
+			void setBudget(const std::string& eventType, double budgetMs) { budgets_[eventType] = budgetMs; }
+			/// <summary>Sets the function that counts the errors the add-in logged so far; an event that raises it fails.</summary>
+			void setErrorCounter(std::function<uint64_t()> errorCounter) { errorCounter_ = std::move(errorCounter); }
+
+			std::vector<ReplayResult> run(const adsk::core::Ptr<adsk::core::Command>& command, size_t repeatCount = 1) const;
+
+			static std::string getEventType(const std::string& inputId);
+			static std::string getReport(const std::vector<ReplayResult>& results);
+
+			#pragma region Getters
+			const std::vector<ReplayEvent>& getEvents() const { return events_; }
+			#pragma endregion
+
+		private:
+			ReplayResult replay(const adsk::core::Ptr<adsk::core::Command>& command, const ReplayEvent& event) const;
+			ReplayResult replayInput(const adsk::core::Ptr<adsk::core::Command>& command, const ReplayEvent& event) const;
+			ReplayResult replayEdit(const ReplayEvent& event) const;
+			ReplayResult replayDocument(const ReplayEvent& event) const;
+			double getBudget(const ReplayEvent& event, const std::string& eventType) const;
+
+			std::vector<ReplayEvent> events_;
+			std::map<std::string, double, std::less<>> budgets_;
+			std::function<uint64_t()> errorCounter_;
+		};
+	}
+}
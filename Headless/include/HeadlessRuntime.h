@@ -0,0 +1,101 @@
+#pragma once
+#include <Core/CoreAll.h>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+
+namespace implicatex {
+	namespace headless {
+		/// <summary>
+		/// <para>Runtime drives the headless stand-in of the Fusion API: it holds the application, delivers queued</para>
+		/// <para>events on the main thread and charges every API call with a configurable latency, so that code paths</para>
+		/// <para>can be measured against the cost of real Fusion round trips.</para>
+		/// <para>Latencies and the call hook are meant to be set up before the add-in runs; they are not synchronized.</para>
+		/// </summary>
+		class Runtime
+		{
+		public:
+			static Runtime& get();
+
+			Runtime(const Runtime&) = delete;
+			Runtime& operator=(const Runtime&) = delete;
+
+			/// <summary>Called by every method of the stand-in; counts the call, runs the hook and waits out the latency.</summary>
+			void call(std::string_view method);
+
+			void setLatency(std::chrono::nanoseconds latency);
+			void setLatency(std::string_view method, std::chrono::nanoseconds latency);
+			void clearLatencies();
+			void setCallHook(std::function<void(std::string_view)> hook);
+
+			uint64_t getCallCount() const { return callCount_.load(std::memory_order_relaxed); }
+			void resetCallCount() { callCount_.store(0, std::memory_order_relaxed); }
+
+			/// <summary>Gets the number of heap allocations of the process so far, counted by the global operator new.</summary>
+			static uint64_t getAllocationCount();
+
+			void setApplication(const adsk::core::Ptr<adsk::core::Application>& application);
+			adsk::core::Ptr<adsk::core::Application> getApplication();
+			void shutdown();
+
+			void post(std::function<void()> task);
+			size_t processEvents();
+
+			bool changeInput(const adsk::core::Ptr<adsk::core::CommandInput>& input);
+			bool terminateCommand(const adsk::core::Ptr<adsk::core::Command>& command,
+				adsk::core::CommandTerminationReason reason = adsk::core::CompletedTerminationReason);
+			void notifyCommandTerminated(const std::string& commandId, adsk::core::CommandTerminationReason reason);
+			bool runDesignCommand(const std::string& commandId, const std::function<bool()>& change);
+			adsk::core::Ptr<adsk::core::Command> getActiveCommand() const { return activeCommand_; }
+			void setActiveCommand(const adsk::core::Ptr<adsk::core::Command>& command) { activeCommand_ = command; }
+
+			void setDialogResult(adsk::core::DialogResults result, const std::string& filename = "");
+			adsk::core::DialogResults getDialogResult(std::string& filename) const;
+
+			/// <summary>Sets the stream Application::log writes to; standard output by default, nullptr to discard.</summary>
+			void setLogOutput(std::ostream* output) { logOutput_ = output; }
+			void writeLog(const std::string& message, adsk::core::LogLevels level);
+
+		private:
+			friend class ScopedUntracked;
+
+			Runtime();
+
+			std::chrono::nanoseconds getLatency(std::string_view method) const;
+
+			static inline thread_local int untrackedDepth_ = 0;
+
+			std::atomic<uint64_t> callCount_ { 0 };
+			std::chrono::nanoseconds latency_ { 0 };
+			std::map<std::string, std::chrono::nanoseconds, std::less<>> latencies_;
+			std::function<void(std::string_view)> hook_;
+
+			adsk::core::Ptr<adsk::core::Application> application_;
+			adsk::core::Ptr<adsk::core::Command> activeCommand_;
+
+			std::mutex eventMutex_;
+			std::deque<std::function<void()>> events_;
+
+			adsk::core::DialogResults dialogResult_ = adsk::core::DialogCancel;
+			std::string dialogFilename_;
+			std::ostream* logOutput_ = nullptr;
+			std::mutex logMutex_;
+		};
+
+		/// <summary>
+		/// <para>ScopedUntracked exempts the API calls of the calling thread from counting and latency while it is open,</para>
+		/// <para>for hosts that set up or inspect the model around the measured code.</para>
+		/// </summary>
+		class ScopedUntracked
+		{
+		public:
+			ScopedUntracked() { ++Runtime::untrackedDepth_; }
+			~ScopedUntracked() { --Runtime::untrackedDepth_; }
+
+			ScopedUntracked(const ScopedUntracked&) = delete;
+			ScopedUntracked& operator=(const ScopedUntracked&) = delete;
+		};
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+// The few Windows types that appear in declarations of the add-in, for the headless build only.
+typedef unsigned int UINT;
+typedef unsigned long DWORD;
+typedef DWORD LCTYPE;
+typedef int BOOL;
+typedef void* HMODULE;
+typedef void* LPVOID;
+
+#define APIENTRY
+#define TRUE 1
+#define FALSE 0
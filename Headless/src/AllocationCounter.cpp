@@ -0,0 +1,46 @@
+#include "StandIn.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions to count heap allocations, so that the replay can report them per event.
+// All other forms of operator new and delete forward to these.
+
+namespace {
+	std::atomic<uint64_t> allocationCount{ 0 };
+
+	void* allocate(std::size_t size, std::size_t alignment) {
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		if (size == 0) {
+			size = 1;
+		}
+		void* memory = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+			? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+			: std::malloc(size);
+		if (!memory) {
+			throw std::bad_alloc();
+		}
+		return memory;
+	}
+}
+
+void* operator new(std::size_t size) { return allocate(size, 0); }
+void* operator new[](std::size_t size) { return allocate(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocate(size, (std::size_t)alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocate(size, (std::size_t)alignment); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+namespace implicatex {
+	namespace headless {
+		uint64_t Runtime::getAllocationCount() {
+			return allocationCount.load(std::memory_order_relaxed);
+		}
+	}
+}
@@ -0,0 +1,266 @@
+#include "StandIn.h"
+
+using implicatex::headless::Runtime;
+
+namespace adsk {
+	namespace core {
+		namespace {
+			/// <summary>Copies a point, as Fusion hands out copies of the points held by its objects.</summary>
+			Ptr<Point3D> copyPoint(const Ptr<Point3D>& point) {
+				ScopedUntracked untracked;
+				return point ? Point3D::create(point->x(), point->y(), point->z()) : nullptr;
+			}
+		}
+
+		#pragma region Camera
+		Ptr<Camera> Camera::create() {
+			apiCall("Camera::create");
+			ScopedUntracked untracked;
+			Ptr<Camera> camera = new Camera();
+			camera->eye_ = Point3D::create(0.0, 0.0, 100.0);
+			camera->target_ = Point3D::create(0.0, 0.0, 0.0);
+			camera->upVector_ = Vector3D::create(0.0, 1.0, 0.0);
+			camera->width_ = 100.0;
+			camera->height_ = 100.0;
+			return camera;
+		}
+
+		Ptr<Point3D> Camera::eye() const { apiCall("Camera::eye"); return copyPoint(eye_); }
+		bool Camera::eye(const Ptr<Point3D>& value) { apiCall("Camera::eye"); eye_ = copyPoint(value); return (bool)eye_; }
+		Ptr<Point3D> Camera::target() const { apiCall("Camera::target"); return copyPoint(target_); }
+		bool Camera::target(const Ptr<Point3D>& value) { apiCall("Camera::target"); target_ = copyPoint(value); return (bool)target_; }
+		Ptr<Vector3D> Camera::upVector() const { apiCall("Camera::upVector"); return upVector_; }
+		bool Camera::upVector(const Ptr<Vector3D>& value) { apiCall("Camera::upVector"); upVector_ = value; return (bool)value; }
+		CameraTypes Camera::cameraType() const { apiCall("Camera::cameraType"); return cameraType_; }
+		bool Camera::cameraType(CameraTypes value) { apiCall("Camera::cameraType"); cameraType_ = value; return true; }
+		ViewOrientations Camera::viewOrientation() const { apiCall("Camera::viewOrientation"); return viewOrientation_; }
+		bool Camera::viewOrientation(ViewOrientations value) { apiCall("Camera::viewOrientation"); viewOrientation_ = value; return true; }
+		double Camera::perspectiveAngle() const { apiCall("Camera::perspectiveAngle"); return perspectiveAngle_; }
+		bool Camera::perspectiveAngle(double value) { apiCall("Camera::perspectiveAngle"); perspectiveAngle_ = value; return true; }
+		bool Camera::isSmoothTransition() const { apiCall("Camera::isSmoothTransition"); return isSmoothTransition_; }
+		bool Camera::isSmoothTransition(bool value) { apiCall("Camera::isSmoothTransition"); isSmoothTransition_ = value; return true; }
+		bool Camera::isFitView() const { apiCall("Camera::isFitView"); return isFitView_; }
+		bool Camera::isFitView(bool value) { apiCall("Camera::isFitView"); isFitView_ = value; return true; }
+
+		bool Camera::getExtents(double& width, double& height) const {
+			apiCall("Camera::getExtents");
+			width = width_;
+			height = height_;
+			return true;
+		}
+
+		bool Camera::setExtents(double width, double height) {
+			apiCall("Camera::setExtents");
+			if (width <= 0.0 || height <= 0.0) {
+				return false;
+			}
+			width_ = width;
+			height_ = height;
+			return true;
+		}
+		#pragma endregion
+
+		#pragma region Viewport
+		Viewport::Viewport() {
+			camera_ = Camera::create();
+		}
+
+		/// <summary>Gets a copy of the camera; changes take effect only when the camera is assigned again.</summary>
+		Ptr<Camera> Viewport::camera() const {
+			apiCall("Viewport::camera");
+			return new Camera(*camera_);
+		}
+
+		bool Viewport::camera(const Ptr<Camera>& value) {
+			apiCall("Viewport::camera");
+			if (!value) {
+				return false;
+			}
+			camera_ = new Camera(*value);
+			return true;
+		}
+
+		bool Viewport::refresh() {
+			apiCall("Viewport::refresh");
+			++refreshCount_;
+			return true;
+		}
+
+		bool Viewport::setCurrentAsHome(bool isFitToView) {
+			apiCall("Viewport::setCurrentAsHome");
+			home_ = new Camera(*camera_);
+			return true;
+		}
+
+		bool Viewport::goHome(bool isTransition) {
+			apiCall("Viewport::goHome");
+			if (home_) {
+				camera_ = new Camera(*home_);
+			}
+			return true;
+		}
+		#pragma endregion
+
+		#pragma region Preferences
+		UserLanguages GeneralPreferences::userLanguage() const { apiCall("GeneralPreferences::userLanguage"); return userLanguage_; }
+		bool GeneralPreferences::userLanguage(UserLanguages value) { apiCall("GeneralPreferences::userLanguage"); userLanguage_ = value; return true; }
+
+		Preferences::Preferences() : generalPreferences_(new GeneralPreferences()) {}
+		Ptr<GeneralPreferences> Preferences::generalPreferences() const { apiCall("Preferences::generalPreferences"); return generalPreferences_; }
+		#pragma endregion
+
+		#pragma region Documents
+		Product::~Product() = default;
+		Ptr<Document> Product::parentDocument() const { apiCall("Product::parentDocument"); return document_; }
+
+		Document::Document(const std::string& name, const Ptr<Product>& product)
+			: name_(name), creationId_(name), product_(product) {
+			if (product_) {
+				product_->attach(this);
+			}
+		}
+
+		std::string Document::name() const { apiCall("Document::name"); return name_; }
+		std::string Document::creationId() const { apiCall("Document::creationId"); return creationId_; }
+		Ptr<Product> Document::products() const { apiCall("Document::products"); return product_; }
+
+		bool Document::isActive() const {
+			apiCall("Document::isActive");
+			Ptr<Application> application = Runtime::get().getApplication();
+			ScopedUntracked untracked;
+			return application && application->activeDocument().get() == this;
+		}
+
+		size_t Documents::count() const { apiCall("Documents::count"); return items_.size(); }
+
+		Ptr<Document> Documents::item(size_t index) const {
+			apiCall("Documents::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		void Documents::add(const Ptr<Document>& document) {
+			items_.push_back(document);
+		}
+
+		bool Documents::remove(const Ptr<Document>& document) {
+			return std::erase_if(items_, [&document](const Ptr<Document>& item) { return item == document; }) > 0;
+		}
+		#pragma endregion
+
+		#pragma region Application
+		Application::Application()
+			: userInterface_(new UserInterface()),
+			preferences_(new Preferences()),
+			documents_(new Documents()),
+			activeViewport_(new Viewport()),
+			documentActivated_(new DocumentEvent()),
+			documentClosed_(new DocumentEvent()),
+			documentOpened_(new DocumentEvent()) {}
+
+		Application::~Application() = default;
+
+		Ptr<Application> Application::get() {
+			apiCall("Application::get");
+			return Runtime::get().getApplication();
+		}
+
+		Ptr<UserInterface> Application::userInterface() const { apiCall("Application::userInterface"); return userInterface_; }
+		Ptr<Preferences> Application::preferences() const { apiCall("Application::preferences"); return preferences_; }
+		Ptr<Documents> Application::documents() const { apiCall("Application::documents"); return documents_; }
+		Ptr<Document> Application::activeDocument() const { apiCall("Application::activeDocument"); return activeDocument_; }
+		Ptr<Viewport> Application::activeViewport() const { apiCall("Application::activeViewport"); return activeViewport_; }
+		Ptr<DocumentEvent> Application::documentActivated() const { apiCall("Application::documentActivated"); return documentActivated_; }
+		Ptr<DocumentEvent> Application::documentClosed() const { apiCall("Application::documentClosed"); return documentClosed_; }
+		Ptr<DocumentEvent> Application::documentOpened() const { apiCall("Application::documentOpened"); return documentOpened_; }
+
+		Ptr<Product> Application::activeProduct() const {
+			apiCall("Application::activeProduct");
+			return activeDocument_ ? activeDocument_->getProduct() : nullptr;
+		}
+
+		bool Application::log(const std::string& message, LogLevels level, LogTypes type) {
+			apiCall("Application::log");
+			Runtime::get().writeLog(message, level);
+			return true;
+		}
+
+		int Application::getLastError(std::string* description) const {
+			apiCall("Application::getLastError");
+			if (description) {
+				description->clear();
+			}
+			return 0;
+		}
+
+		Ptr<CustomEvent> Application::registerCustomEvent(const std::string& eventId) {
+			apiCall("Application::registerCustomEvent");
+			if (customEvents_.contains(eventId)) {
+				return nullptr;
+			}
+			Ptr<CustomEvent> customEvent = new CustomEvent();
+			customEvents_.emplace(eventId, customEvent);
+			return customEvent;
+		}
+
+		bool Application::unregisterCustomEvent(const std::string& eventId) {
+			apiCall("Application::unregisterCustomEvent");
+			return customEvents_.erase(eventId) > 0;
+		}
+
+		/// <summary>
+		/// <para>Queues a custom event for the main thread, as Fusion does. May be called from any thread;</para>
+		/// <para>the event is looked up on delivery, so it is dropped if unregistered in between.</para>
+		/// </summary>
+		bool Application::fireCustomEvent(const std::string& eventId, const std::string& additionalInfo) {
+			apiCall("Application::fireCustomEvent");
+			Ptr<Application> self = this;
+			Runtime::get().post([self, eventId, additionalInfo]() {
+				auto it = self->customEvents_.find(eventId);
+				if (it != self->customEvents_.end()) {
+					Ptr<CustomEvent> customEvent = it->second;
+					customEvent->notify(Ptr<CustomEventArgs>(new CustomEventArgs(additionalInfo)));
+				}
+			});
+			return true;
+		}
+
+		std::string Application::executeTextCommand(const std::string& command) {
+			apiCall("Application::executeTextCommand");
+			return "";
+		}
+
+		/// <summary>Adds the document and makes it the active one, notifying the opened and activated handlers.</summary>
+		void Application::openDocument(const Ptr<Document>& document) {
+			if (!document) {
+				return;
+			}
+			documents_->add(document);
+			activeDocument_ = document;
+			documentOpened_->notify(Ptr<DocumentEventArgs>(new DocumentEventArgs(document)));
+			documentActivated_->notify(Ptr<DocumentEventArgs>(new DocumentEventArgs(document)));
+		}
+
+		/// <summary>Makes an open document the active one, as the user switching tabs, and notifies the activated handlers.</summary>
+		void Application::activateDocument(const Ptr<Document>& document) {
+			if (!document || document == activeDocument_) {
+				return;
+			}
+			activeDocument_ = document;
+			documentActivated_->notify(Ptr<DocumentEventArgs>(new DocumentEventArgs(document)));
+		}
+
+		void Application::closeDocument(const Ptr<Document>& document) {
+			if (!document || !documents_->remove(document)) {
+				return;
+			}
+			if (activeDocument_ == document) {
+				activeDocument_ = documents_->count() > 0 ? documents_->item(documents_->count() - 1) : nullptr;
+			}
+			documentClosed_->notify(Ptr<DocumentEventArgs>(new DocumentEventArgs(document)));
+			if (activeDocument_) {
+				documentActivated_->notify(Ptr<DocumentEventArgs>(new DocumentEventArgs(activeDocument_)));
+			}
+		}
+		#pragma endregion
+	}
+}
@@ -0,0 +1,608 @@
+#include "StandIn.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+namespace adsk {
+	namespace core {
+		namespace {
+			/// <summary>Gets the factor from the given length unit to Fusion internal units (cm); 1 for unknown units.</summary>
+			double getUnitFactor(std::string_view unit) {
+				if (unit == "mm") return 0.1;
+				if (unit == "cm") return 1.0;
+				if (unit == "m") return 100.0;
+				if (unit == "in") return 2.54;
+				if (unit == "ft") return 30.48;
+				return 1.0;
+			}
+
+			/// <summary>Parses an expression of a number and an optional unit, e.g. "2.5 mm", into internal units.</summary>
+			bool parseExpression(const std::string& expression, const std::string& unitType, double& value) {
+				const char* begin = expression.c_str();
+				char* end = nullptr;
+				double number = std::strtod(begin, &end);
+				if (end == begin) {
+					return false;
+				}
+				std::string unit(end);
+				unit.erase(std::remove_if(unit.begin(), unit.end(), [](unsigned char c) { return std::isspace(c); }), unit.end());
+				value = number * getUnitFactor(unit.empty() ? unitType : unit);
+				return true;
+			}
+
+			/// <summary>Formats a value in internal units as expression in the given unit.</summary>
+			std::string formatExpression(double value, const std::string& unitType) {
+				char expression[64];
+				std::snprintf(expression, sizeof(expression), "%g", value / getUnitFactor(unitType));
+				return unitType.empty() ? expression : std::string(expression) + " " + unitType;
+			}
+		}
+
+		#pragma region ListItems
+		ListItem::ListItem(ListItems* parent, const std::string& name, bool isSelected)
+			: parent_(parent), name_(name), isSelected_(isSelected) {}
+
+		std::string ListItem::name() const { apiCall("ListItem::name"); return name_; }
+		bool ListItem::isSelected() const { apiCall("ListItem::isSelected"); return isSelected_; }
+
+		bool ListItem::isSelected(bool value) {
+			apiCall("ListItem::isSelected");
+			if (parent_) {
+				parent_->select(this, value);
+			}
+			else {
+				isSelected_ = value;
+			}
+			return true;
+		}
+
+		size_t ListItem::index() const {
+			apiCall("ListItem::index");
+			return parent_ ? parent_->indexOf(this) : 0;
+		}
+
+		ListItems::ListItems(bool isMultiSelect) : isMultiSelect_(isMultiSelect) {}
+
+		ListItems::~ListItems() {
+			for (const auto& item : items_) {
+				item->detach();
+			}
+		}
+
+		Ptr<ListItem> ListItems::add(const std::string& name, bool isSelected, const std::string& icon, int beforeIndex) {
+			apiCall("ListItems::add");
+			Ptr<ListItem> item = new ListItem(this, name, false);
+			if (beforeIndex >= 0 && (size_t)beforeIndex < items_.size()) {
+				items_.insert(items_.begin() + beforeIndex, item);
+			}
+			else {
+				items_.push_back(item);
+			}
+			if (isSelected) {
+				select(item.get(), true);
+			}
+			return item;
+		}
+
+		bool ListItems::clear() {
+			apiCall("ListItems::clear");
+			for (const auto& item : items_) {
+				item->detach();
+				item->invalidate();
+			}
+			items_.clear();
+			return true;
+		}
+
+		size_t ListItems::count() const { apiCall("ListItems::count"); return items_.size(); }
+
+		Ptr<ListItem> ListItems::item(size_t index) const {
+			apiCall("ListItems::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		Ptr<ListItem> ListItems::selectedItem() const {
+			for (const auto& item : items_) {
+				if (item->isSelected_) {
+					return item;
+				}
+			}
+			return nullptr;
+		}
+
+		void ListItems::select(ListItem* item, bool isSelected) {
+			if (isSelected && !isMultiSelect_) {
+				for (const auto& other : items_) {
+					other->isSelected_ = false;
+				}
+			}
+			item->isSelected_ = isSelected;
+		}
+
+		size_t ListItems::indexOf(const ListItem* item) const {
+			for (size_t i = 0; i < items_.size(); ++i) {
+				if (items_[i].get() == item) {
+					return i;
+				}
+			}
+			return 0;
+		}
+
+		Ptr<ValueInput> ValueInput::createByReal(double realValue) {
+			apiCall("ValueInput::createByReal");
+			Ptr<ValueInput> valueInput = new ValueInput();
+			valueInput->realValue_ = realValue;
+			return valueInput;
+		}
+
+		Ptr<ValueInput> ValueInput::createByString(const std::string& stringValue) {
+			apiCall("ValueInput::createByString");
+			Ptr<ValueInput> valueInput = new ValueInput();
+			valueInput->isString_ = true;
+			valueInput->stringValue_ = stringValue;
+			return valueInput;
+		}
+		#pragma endregion
+
+		#pragma region CommandInput
+		std::string CommandInput::id() const { apiCall("CommandInput::id"); return id_; }
+		std::string CommandInput::name() const { apiCall("CommandInput::name"); return name_; }
+		Ptr<Command> CommandInput::parentCommand() const { apiCall("CommandInput::parentCommand"); return command_; }
+		Ptr<CommandInput> CommandInput::parentCommandInput() const { apiCall("CommandInput::parentCommandInput"); return parent_; }
+		bool CommandInput::isVisible() const { apiCall("CommandInput::isVisible"); return isVisible_; }
+		bool CommandInput::isVisible(bool value) { apiCall("CommandInput::isVisible"); isVisible_ = value; return true; }
+		bool CommandInput::isEnabled() const { apiCall("CommandInput::isEnabled"); return isEnabled_; }
+		bool CommandInput::isEnabled(bool value) { apiCall("CommandInput::isEnabled"); isEnabled_ = value; return true; }
+		std::string CommandInput::tooltip() const { apiCall("CommandInput::tooltip"); return tooltip_; }
+		bool CommandInput::tooltip(const std::string& value) { apiCall("CommandInput::tooltip"); tooltip_ = value; return true; }
+
+		bool CommandInput::deleteMe() {
+			apiCall("CommandInput::deleteMe");
+			if (!command_) {
+				return false;
+			}
+			deleteInput();
+			return true;
+		}
+
+		void CommandInput::attach(Command* command, CommandInputs* collection, CommandInput* parent, const std::string& id, const std::string& name) {
+			command_ = command;
+			collection_ = collection;
+			parent_ = parent;
+			id_ = id;
+			name_ = name;
+		}
+
+		/// <summary>Deletes the input with its children and removes it from its command, table and collection.</summary>
+		void CommandInput::deleteInput() {
+			if (!command_) {
+				return;
+			}
+			Ptr<CommandInput> self = this;
+			deleteChildren();
+			if (auto table = dynamic_cast<TableCommandInput*>(parent_)) {
+				table->removeCell(this);
+			}
+			command_->unregisterInput(this);
+			if (collection_) {
+				collection_->remove(this);
+			}
+			command_ = nullptr;
+			collection_ = nullptr;
+			parent_ = nullptr;
+			invalidate();
+		}
+
+		Ptr<CommandInputs> TabCommandInput::children() const { apiCall("TabCommandInput::children"); return children_; }
+		bool TabCommandInput::activate() { apiCall("TabCommandInput::activate"); return true; }
+
+		void TabCommandInput::initialize(const std::string& resourceFolder) {
+			resourceFolder_ = resourceFolder;
+			children_ = new CommandInputs(getCommand(), this);
+		}
+
+		void TabCommandInput::deleteChildren() {
+			if (children_) {
+				children_->deleteAll();
+			}
+		}
+
+		Ptr<CommandInputs> GroupCommandInput::children() const { apiCall("GroupCommandInput::children"); return children_; }
+		bool GroupCommandInput::isExpanded() const { apiCall("GroupCommandInput::isExpanded"); return isExpanded_; }
+		bool GroupCommandInput::isExpanded(bool value) { apiCall("GroupCommandInput::isExpanded"); isExpanded_ = value; return true; }
+
+		void GroupCommandInput::initialize() {
+			children_ = new CommandInputs(getCommand(), this);
+		}
+
+		void GroupCommandInput::deleteChildren() {
+			if (children_) {
+				children_->deleteAll();
+			}
+		}
+
+		Ptr<ListItem> DropDownCommandInput::selectedItem() const { apiCall("DropDownCommandInput::selectedItem"); return listItems_->selectedItem(); }
+		Ptr<ListItems> DropDownCommandInput::listItems() const { apiCall("DropDownCommandInput::listItems"); return listItems_; }
+
+		void DropDownCommandInput::initialize(DropDownStyles dropDownStyle) {
+			dropDownStyle_ = dropDownStyle;
+			listItems_ = new ListItems(dropDownStyle == CheckBoxDropDownStyle);
+		}
+
+		Ptr<ListItem> ButtonRowCommandInput::selectedItem() const { apiCall("ButtonRowCommandInput::selectedItem"); return listItems_->selectedItem(); }
+		Ptr<ListItems> ButtonRowCommandInput::listItems() const { apiCall("ButtonRowCommandInput::listItems"); return listItems_; }
+
+		void ButtonRowCommandInput::initialize(bool isMultiSelectEnabled) {
+			listItems_ = new ListItems(isMultiSelectEnabled);
+		}
+
+		std::string TextBoxCommandInput::text() const { apiCall("TextBoxCommandInput::text"); return text_; }
+		bool TextBoxCommandInput::text(const std::string& value) { apiCall("TextBoxCommandInput::text"); text_ = value; return true; }
+		std::string TextBoxCommandInput::formattedText() const { apiCall("TextBoxCommandInput::formattedText"); return text_; }
+		bool TextBoxCommandInput::formattedText(const std::string& value) { apiCall("TextBoxCommandInput::formattedText"); text_ = value; return true; }
+		int TextBoxCommandInput::numRows() const { apiCall("TextBoxCommandInput::numRows"); return numRows_; }
+		bool TextBoxCommandInput::numRows(int value) { apiCall("TextBoxCommandInput::numRows"); numRows_ = value; return true; }
+		bool TextBoxCommandInput::isReadOnly() const { apiCall("TextBoxCommandInput::isReadOnly"); return isReadOnly_; }
+		bool TextBoxCommandInput::isReadOnly(bool value) { apiCall("TextBoxCommandInput::isReadOnly"); isReadOnly_ = value; return true; }
+
+		double ValueCommandInput::value() const { apiCall("ValueCommandInput::value"); return value_; }
+
+		bool ValueCommandInput::value(double value) {
+			apiCall("ValueCommandInput::value");
+			value_ = value;
+			expression_ = formatExpression(value, unitType_);
+			return true;
+		}
+
+		std::string ValueCommandInput::expression() const { apiCall("ValueCommandInput::expression"); return expression_; }
+
+		bool ValueCommandInput::expression(const std::string& value) {
+			apiCall("ValueCommandInput::expression");
+			double parsed = 0.0;
+			if (!parseExpression(value, unitType_, parsed)) {
+				return false;
+			}
+			expression_ = value;
+			value_ = parsed;
+			return true;
+		}
+
+		std::string ValueCommandInput::unitType() const { apiCall("ValueCommandInput::unitType"); return unitType_; }
+
+		void ValueCommandInput::initialize(const std::string& unitType, const Ptr<ValueInput>& initialValue) {
+			unitType_ = unitType;
+			if (!initialValue) {
+				return;
+			}
+			if (initialValue->isString()) {
+				expression_ = initialValue->stringValue();
+				parseExpression(expression_, unitType_, value_);
+			}
+			else {
+				value_ = initialValue->realValue();
+				expression_ = formatExpression(value_, unitType_);
+			}
+		}
+
+		std::string StringValueCommandInput::value() const { apiCall("StringValueCommandInput::value"); return value_; }
+		bool StringValueCommandInput::value(const std::string& value) { apiCall("StringValueCommandInput::value"); value_ = value; return true; }
+		bool StringValueCommandInput::isReadOnly() const { apiCall("StringValueCommandInput::isReadOnly"); return isReadOnly_; }
+		bool StringValueCommandInput::isReadOnly(bool value) { apiCall("StringValueCommandInput::isReadOnly"); isReadOnly_ = value; return true; }
+		bool StringValueCommandInput::isPassword() const { apiCall("StringValueCommandInput::isPassword"); return isPassword_; }
+		bool StringValueCommandInput::isPassword(bool value) { apiCall("StringValueCommandInput::isPassword"); isPassword_ = value; return true; }
+
+		bool BoolValueCommandInput::value() const { apiCall("BoolValueCommandInput::value"); return value_; }
+		bool BoolValueCommandInput::value(bool value) { apiCall("BoolValueCommandInput::value"); value_ = value; return true; }
+		std::string BoolValueCommandInput::text() const { apiCall("BoolValueCommandInput::text"); return text_; }
+		bool BoolValueCommandInput::text(const std::string& value) { apiCall("BoolValueCommandInput::text"); text_ = value; return true; }
+		std::string BoolValueCommandInput::resourceFolder() const { apiCall("BoolValueCommandInput::resourceFolder"); return resourceFolder_; }
+		bool BoolValueCommandInput::resourceFolder(const std::string& value) { apiCall("BoolValueCommandInput::resourceFolder"); resourceFolder_ = value; return true; }
+		bool BoolValueCommandInput::isCheckBox() const { apiCall("BoolValueCommandInput::isCheckBox"); return isCheckBox_; }
+
+		void BoolValueCommandInput::initialize(bool isCheckBox, const std::string& resourceFolder, bool initialValue) {
+			isCheckBox_ = isCheckBox;
+			resourceFolder_ = resourceFolder;
+			value_ = initialValue;
+		}
+
+		int IntegerSpinnerCommandInput::value() const { apiCall("IntegerSpinnerCommandInput::value"); return value_; }
+
+		bool IntegerSpinnerCommandInput::value(int value) {
+			apiCall("IntegerSpinnerCommandInput::value");
+			if (value < minimumValue_ || value > maximumValue_) {
+				return false;
+			}
+			value_ = value;
+			return true;
+		}
+
+		void IntegerSpinnerCommandInput::initialize(int minimumValue, int maximumValue, int spinStep, int initialValue) {
+			minimumValue_ = minimumValue;
+			maximumValue_ = maximumValue;
+			spinStep_ = spinStep;
+			value_ = (std::clamp)(initialValue, minimumValue, maximumValue);
+		}
+
+		double FloatSliderCommandInput::valueOne() const { apiCall("FloatSliderCommandInput::valueOne"); return valueOne_; }
+		bool FloatSliderCommandInput::valueOne(double value) { apiCall("FloatSliderCommandInput::valueOne"); valueOne_ = (std::clamp)(value, minimumValue_, maximumValue_); return true; }
+		double FloatSliderCommandInput::valueTwo() const { apiCall("FloatSliderCommandInput::valueTwo"); return valueTwo_; }
+		bool FloatSliderCommandInput::valueTwo(double value) { apiCall("FloatSliderCommandInput::valueTwo"); valueTwo_ = (std::clamp)(value, minimumValue_, maximumValue_); return true; }
+
+		void FloatSliderCommandInput::initialize(const std::string& unitType, double minimumValue, double maximumValue, bool hasTwoSliders) {
+			unitType_ = unitType;
+			minimumValue_ = minimumValue;
+			maximumValue_ = maximumValue;
+			valueOne_ = minimumValue;
+			valueTwo_ = maximumValue;
+			hasTwoSliders_ = hasTwoSliders;
+		}
+		#pragma endregion
+
+		#pragma region TableCommandInput
+		bool TableCommandInput::hasGrid(bool value) { apiCall("TableCommandInput::hasGrid"); hasGrid_ = value; return true; }
+		bool TableCommandInput::tablePresentationStyle(TablePresentationStyles value) { apiCall("TableCommandInput::tablePresentationStyle"); presentationStyle_ = value; return true; }
+		bool TableCommandInput::columnSpacing(int value) { apiCall("TableCommandInput::columnSpacing"); return value >= 0; }
+		bool TableCommandInput::rowSpacing(int value) { apiCall("TableCommandInput::rowSpacing"); return value >= 0; }
+		bool TableCommandInput::maximumVisibleRows(int value) { apiCall("TableCommandInput::maximumVisibleRows"); maximumVisibleRows_ = value; return true; }
+		bool TableCommandInput::minimumVisibleRows(int value) { apiCall("TableCommandInput::minimumVisibleRows"); minimumVisibleRows_ = value; return true; }
+
+		bool TableCommandInput::addCommandInput(const Ptr<CommandInput>& input, int row, int column, int rowSpan, int columnSpan) {
+			apiCall("TableCommandInput::addCommandInput");
+			if (!input || row < 0 || column < 0 || input->getCommand() != getCommand()) {
+				return false;
+			}
+			if ((size_t)row >= rows_.size()) {
+				rows_.resize(row + 1);
+			}
+			auto& cells = rows_[row];
+			if ((size_t)column >= cells.size()) {
+				cells.resize(column + 1);
+			}
+			cells[column] = input;
+			return true;
+		}
+
+		bool TableCommandInput::addToolbarCommandInput(const Ptr<CommandInput>& input) {
+			apiCall("TableCommandInput::addToolbarCommandInput");
+			if (!input || input->getCommand() != getCommand()) {
+				return false;
+			}
+			toolbarInputs_.push_back(input);
+			return true;
+		}
+
+		Ptr<CommandInput> TableCommandInput::getInputAtPosition(int row, int column) const {
+			apiCall("TableCommandInput::getInputAtPosition");
+			if (row < 0 || column < 0 || (size_t)row >= rows_.size() || (size_t)column >= rows_[row].size()) {
+				return nullptr;
+			}
+			return rows_[row][column];
+		}
+
+		bool TableCommandInput::deleteRow(int row) {
+			apiCall("TableCommandInput::deleteRow");
+			if (row < 0 || (size_t)row >= rows_.size()) {
+				return false;
+			}
+			std::vector<Ptr<CommandInput>> cells = std::move(rows_[row]);
+			rows_.erase(rows_.begin() + row);
+			for (const auto& cell : cells) {
+				if (cell) {
+					cell->deleteInput();
+				}
+			}
+			if (selectedRow_ >= (int)rows_.size()) {
+				selectedRow_ = -1;
+			}
+			return true;
+		}
+
+		bool TableCommandInput::clear() {
+			apiCall("TableCommandInput::clear");
+			rows_.clear();
+			if (cellInputs_) {
+				cellInputs_->deleteAll();
+			}
+			selectedRow_ = -1;
+			return true;
+		}
+
+		int TableCommandInput::rowCount() const { apiCall("TableCommandInput::rowCount"); return (int)rows_.size(); }
+		int TableCommandInput::selectedRow() const { apiCall("TableCommandInput::selectedRow"); return selectedRow_; }
+
+		bool TableCommandInput::selectedRow(int value) {
+			apiCall("TableCommandInput::selectedRow");
+			if (value < -1 || value >= (int)rows_.size()) {
+				return false;
+			}
+			selectedRow_ = value;
+			return true;
+		}
+
+		Ptr<CommandInputs> TableCommandInput::commandInputs() const { apiCall("TableCommandInput::commandInputs"); return cellInputs_; }
+
+		void TableCommandInput::initialize(int numberOfColumns, const std::string& columnRatio) {
+			numberOfColumns_ = numberOfColumns;
+			columnRatio_ = columnRatio;
+			cellInputs_ = new CommandInputs(getCommand(), this);
+		}
+
+		void TableCommandInput::deleteChildren() {
+			rows_.clear();
+			toolbarInputs_.clear();
+			if (cellInputs_) {
+				cellInputs_->deleteAll();
+			}
+		}
+
+		void TableCommandInput::removeCell(const CommandInput* input) {
+			for (auto& cells : rows_) {
+				for (auto& cell : cells) {
+					if (cell.get() == input) {
+						cell.reset();
+					}
+				}
+			}
+			std::erase_if(toolbarInputs_, [input](const Ptr<CommandInput>& item) { return item.get() == input; });
+		}
+		#pragma endregion
+
+		#pragma region CommandInputs
+		CommandInputs::CommandInputs(Command* command, CommandInput* parent) : command_(command), parent_(parent) {}
+		CommandInputs::~CommandInputs() = default;
+
+		template<class T> Ptr<T> CommandInputs::addInput(const std::string& id, const std::string& name) {
+			// Fusion refuses ids that are empty or already used within the command
+			if (!command_ || id.empty() || command_->findInput(id)) {
+				return nullptr;
+			}
+			Ptr<T> input = new T();
+			input->attach(command_, this, parent_, id, name);
+			command_->registerInput(input.get());
+			items_.push_back(input);
+			return input;
+		}
+
+		Ptr<TabCommandInput> CommandInputs::addTabCommandInput(const std::string& id, const std::string& name, const std::string& resourceFolder) {
+			apiCall("CommandInputs::addTabCommandInput");
+			Ptr<TabCommandInput> input = addInput<TabCommandInput>(id, name);
+			if (input) {
+				input->initialize(resourceFolder);
+			}
+			return input;
+		}
+
+		Ptr<GroupCommandInput> CommandInputs::addGroupCommandInput(const std::string& id, const std::string& name) {
+			apiCall("CommandInputs::addGroupCommandInput");
+			Ptr<GroupCommandInput> input = addInput<GroupCommandInput>(id, name);
+			if (input) {
+				input->initialize();
+			}
+			return input;
+		}
+
+		Ptr<DropDownCommandInput> CommandInputs::addDropDownCommandInput(const std::string& id, const std::string& name, DropDownStyles dropDownStyle) {
+			apiCall("CommandInputs::addDropDownCommandInput");
+			Ptr<DropDownCommandInput> input = addInput<DropDownCommandInput>(id, name);
+			if (input) {
+				input->initialize(dropDownStyle);
+			}
+			return input;
+		}
+
+		Ptr<TextBoxCommandInput> CommandInputs::addTextBoxCommandInput(const std::string& id, const std::string& name, const std::string& formattedText, int numRows, bool isReadOnly) {
+			apiCall("CommandInputs::addTextBoxCommandInput");
+			Ptr<TextBoxCommandInput> input = addInput<TextBoxCommandInput>(id, name);
+			if (input) {
+				ScopedUntracked untracked;
+				input->formattedText(formattedText);
+				input->numRows(numRows);
+				input->isReadOnly(isReadOnly);
+			}
+			return input;
+		}
+
+		Ptr<ValueCommandInput> CommandInputs::addValueInput(const std::string& id, const std::string& name, const std::string& unitType, const Ptr<ValueInput>& initialValue) {
+			apiCall("CommandInputs::addValueInput");
+			Ptr<ValueCommandInput> input = addInput<ValueCommandInput>(id, name);
+			if (input) {
+				input->initialize(unitType, initialValue);
+			}
+			return input;
+		}
+
+		Ptr<StringValueCommandInput> CommandInputs::addStringValueInput(const std::string& id, const std::string& name, const std::string& initialValue) {
+			apiCall("CommandInputs::addStringValueInput");
+			Ptr<StringValueCommandInput> input = addInput<StringValueCommandInput>(id, name);
+			if (input) {
+				ScopedUntracked untracked;
+				input->value(initialValue);
+			}
+			return input;
+		}
+
+		Ptr<BoolValueCommandInput> CommandInputs::addBoolValueInput(const std::string& id, const std::string& name, bool isCheckBox, const std::string& resourceFolder, bool initialValue) {
+			apiCall("CommandInputs::addBoolValueInput");
+			Ptr<BoolValueCommandInput> input = addInput<BoolValueCommandInput>(id, name);
+			if (input) {
+				input->initialize(isCheckBox, resourceFolder, initialValue);
+			}
+			return input;
+		}
+
+		Ptr<IntegerSpinnerCommandInput> CommandInputs::addIntegerSpinnerCommandInput(const std::string& id, const std::string& name, int min, int max, int spinStep, int initialValue) {
+			apiCall("CommandInputs::addIntegerSpinnerCommandInput");
+			Ptr<IntegerSpinnerCommandInput> input = addInput<IntegerSpinnerCommandInput>(id, name);
+			if (input) {
+				input->initialize(min, max, spinStep, initialValue);
+			}
+			return input;
+		}
+
+		Ptr<FloatSliderCommandInput> CommandInputs::addFloatSliderCommandInput(const std::string& id, const std::string& name, const std::string& unitType, double min, double max, bool hasTwoSliders) {
+			apiCall("CommandInputs::addFloatSliderCommandInput");
+			Ptr<FloatSliderCommandInput> input = addInput<FloatSliderCommandInput>(id, name);
+			if (input) {
+				input->initialize(unitType, min, max, hasTwoSliders);
+			}
+			return input;
+		}
+
+		Ptr<TableCommandInput> CommandInputs::addTableCommandInput(const std::string& id, const std::string& name, int numberOfColumns, const std::string& columnRatio) {
+			apiCall("CommandInputs::addTableCommandInput");
+			Ptr<TableCommandInput> input = addInput<TableCommandInput>(id, name);
+			if (input) {
+				input->initialize(numberOfColumns, columnRatio);
+			}
+			return input;
+		}
+
+		Ptr<SeparatorCommandInput> CommandInputs::addSeparatorCommandInput(const std::string& id) {
+			apiCall("CommandInputs::addSeparatorCommandInput");
+			return addInput<SeparatorCommandInput>(id, "");
+		}
+
+		Ptr<ButtonRowCommandInput> CommandInputs::addButtonRowCommandInput(const std::string& id, const std::string& name, bool isMultiSelectEnabled) {
+			apiCall("CommandInputs::addButtonRowCommandInput");
+			Ptr<ButtonRowCommandInput> input = addInput<ButtonRowCommandInput>(id, name);
+			if (input) {
+				input->initialize(isMultiSelectEnabled);
+			}
+			return input;
+		}
+
+		Ptr<CommandInput> CommandInputs::itemById(const std::string& id) const {
+			apiCall("CommandInputs::itemById");
+			return command_ ? command_->findInput(id) : nullptr;
+		}
+
+		size_t CommandInputs::count() const { apiCall("CommandInputs::count"); return items_.size(); }
+
+		Ptr<CommandInput> CommandInputs::item(size_t index) const {
+			apiCall("CommandInputs::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		Ptr<Command> CommandInputs::command() const { apiCall("CommandInputs::command"); return command_; }
+
+		void CommandInputs::remove(const CommandInput* input) {
+			// Inputs are mostly removed in reverse order of creation, e.g. when a table is cleared
+			auto it = std::find_if(items_.rbegin(), items_.rend(), [input](const Ptr<CommandInput>& item) { return item.get() == input; });
+			if (it != items_.rend()) {
+				items_.erase(std::next(it).base());
+			}
+		}
+
+		void CommandInputs::deleteAll() {
+			while (!items_.empty()) {
+				Ptr<CommandInput> input = items_.back();
+				input->deleteInput();
+				if (!items_.empty() && items_.back() == input) {
+					items_.pop_back();
+				}
+			}
+		}
+		#pragma endregion
+	}
+}
@@ -0,0 +1,130 @@
+#include "StandIn.h"
+#include <cmath>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <typeinfo>
+
+namespace adsk {
+	namespace core {
+		#pragma region Base
+		bool Base::isValid() const {
+			apiCall("Base::isValid");
+			return isValid_;
+		}
+
+		std::string Base::objectType() const {
+			apiCall("Base::objectType");
+			int status = 0;
+			char* name = abi::__cxa_demangle(typeid(*this).name(), nullptr, nullptr, &status);
+			std::string result = status == 0 && name ? name : typeid(*this).name();
+			std::free(name);
+			return result;
+		}
+		#pragma endregion
+
+		#pragma region Geometry
+		Ptr<Point3D> Point3D::create(double x, double y, double z) {
+			apiCall("Point3D::create");
+			Ptr<Point3D> point = new Point3D();
+			point->x_ = x;
+			point->y_ = y;
+			point->z_ = z;
+			return point;
+		}
+
+		double Point3D::x() const { apiCall("Point3D::x"); return x_; }
+		bool Point3D::x(double value) { apiCall("Point3D::x"); x_ = value; return true; }
+		double Point3D::y() const { apiCall("Point3D::y"); return y_; }
+		bool Point3D::y(double value) { apiCall("Point3D::y"); y_ = value; return true; }
+		double Point3D::z() const { apiCall("Point3D::z"); return z_; }
+		bool Point3D::z(double value) { apiCall("Point3D::z"); z_ = value; return true; }
+
+		double Point3D::distanceTo(const Ptr<Point3D>& point) const {
+			apiCall("Point3D::distanceTo");
+			if (!point) {
+				return 0.0;
+			}
+			return std::sqrt((point->x_ - x_) * (point->x_ - x_) + (point->y_ - y_) * (point->y_ - y_) + (point->z_ - z_) * (point->z_ - z_));
+		}
+
+		Ptr<Vector3D> Vector3D::create(double x, double y, double z) {
+			apiCall("Vector3D::create");
+			Ptr<Vector3D> vector = new Vector3D();
+			vector->x_ = x;
+			vector->y_ = y;
+			vector->z_ = z;
+			return vector;
+		}
+
+		double Vector3D::x() const { apiCall("Vector3D::x"); return x_; }
+		double Vector3D::y() const { apiCall("Vector3D::y"); return y_; }
+		double Vector3D::z() const { apiCall("Vector3D::z"); return z_; }
+
+		Ptr<Vector3D> Vector3D::crossProduct(const Ptr<Vector3D>& vector) const {
+			apiCall("Vector3D::crossProduct");
+			if (!vector) {
+				return nullptr;
+			}
+			Ptr<Vector3D> result = new Vector3D();
+			result->x_ = y_ * vector->z_ - z_ * vector->y_;
+			result->y_ = z_ * vector->x_ - x_ * vector->z_;
+			result->z_ = x_ * vector->y_ - y_ * vector->x_;
+			return result;
+		}
+
+		Ptr<BoundingBox3D> BoundingBox3D::create(const Ptr<Point3D>& minPoint, const Ptr<Point3D>& maxPoint) {
+			apiCall("BoundingBox3D::create");
+			if (!minPoint || !maxPoint) {
+				return nullptr;
+			}
+			Ptr<BoundingBox3D> boundingBox = new BoundingBox3D();
+			boundingBox->minPoint_ = minPoint;
+			boundingBox->maxPoint_ = maxPoint;
+			return boundingBox;
+		}
+
+		Ptr<Point3D> BoundingBox3D::minPoint() const { apiCall("BoundingBox3D::minPoint"); return minPoint_; }
+		Ptr<Point3D> BoundingBox3D::maxPoint() const { apiCall("BoundingBox3D::maxPoint"); return maxPoint_; }
+
+		Ptr<Color> Color::create(int red, int green, int blue, int opacity) {
+			apiCall("Color::create");
+			Ptr<Color> color = new Color();
+			color->red_ = red;
+			color->green_ = green;
+			color->blue_ = blue;
+			color->opacity_ = opacity;
+			return color;
+		}
+		#pragma endregion
+
+		#pragma region Event arguments
+		CommandCreatedEventArgs::CommandCreatedEventArgs(const Ptr<Command>& command) : command_(command) {}
+		CommandCreatedEventArgs::~CommandCreatedEventArgs() = default;
+		Ptr<Command> CommandCreatedEventArgs::command() const { apiCall("CommandCreatedEventArgs::command"); return command_; }
+
+		InputChangedEventArgs::InputChangedEventArgs(const Ptr<CommandInput>& input, const Ptr<CommandInputs>& inputs)
+			: input_(input), inputs_(inputs) {}
+		InputChangedEventArgs::~InputChangedEventArgs() = default;
+		Ptr<CommandInput> InputChangedEventArgs::input() const { apiCall("InputChangedEventArgs::input"); return input_; }
+		Ptr<CommandInputs> InputChangedEventArgs::inputs() const { apiCall("InputChangedEventArgs::inputs"); return inputs_; }
+
+		CommandEventArgs::CommandEventArgs(const Ptr<Command>& command, CommandTerminationReason terminationReason)
+			: command_(command), terminationReason_(terminationReason) {}
+		CommandEventArgs::~CommandEventArgs() = default;
+		Ptr<Command> CommandEventArgs::command() const { apiCall("CommandEventArgs::command"); return command_; }
+		CommandTerminationReason CommandEventArgs::terminationReason() const { apiCall("CommandEventArgs::terminationReason"); return terminationReason_; }
+
+		CustomEventArgs::CustomEventArgs(const std::string& additionalInfo) : additionalInfo_(additionalInfo) {}
+		std::string CustomEventArgs::additionalInfo() const { apiCall("CustomEventArgs::additionalInfo"); return additionalInfo_; }
+
+		DocumentEventArgs::DocumentEventArgs(const Ptr<Document>& document) : document_(document) {}
+		DocumentEventArgs::~DocumentEventArgs() = default;
+		Ptr<Document> DocumentEventArgs::document() const { apiCall("DocumentEventArgs::document"); return document_; }
+
+		ApplicationCommandEventArgs::ApplicationCommandEventArgs(const std::string& commandId, CommandTerminationReason terminationReason)
+			: commandId_(commandId), terminationReason_(terminationReason) {}
+		std::string ApplicationCommandEventArgs::commandId() const { apiCall("ApplicationCommandEventArgs::commandId"); return commandId_; }
+		CommandTerminationReason ApplicationCommandEventArgs::terminationReason() const { apiCall("ApplicationCommandEventArgs::terminationReason"); return terminationReason_; }
+		#pragma endregion
+	}
+}
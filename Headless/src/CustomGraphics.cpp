@@ -0,0 +1,171 @@
+#include "StandIn.h"
+#include <algorithm>
+
+namespace adsk {
+	namespace fusion {
+		#pragma region Coordinates and effects
+		Ptr<CustomGraphicsCoordinates> CustomGraphicsCoordinates::create(const std::vector<double>& coordinates) {
+			apiCall("CustomGraphicsCoordinates::create");
+			if (coordinates.size() % 3 != 0) {
+				return nullptr;
+			}
+			Ptr<CustomGraphicsCoordinates> result = new CustomGraphicsCoordinates();
+			result->coordinates_ = coordinates;
+			return result;
+		}
+
+		std::vector<double> CustomGraphicsCoordinates::coordinates() const { apiCall("CustomGraphicsCoordinates::coordinates"); return coordinates_; }
+		size_t CustomGraphicsCoordinates::coordinateCount() const { apiCall("CustomGraphicsCoordinates::coordinateCount"); return coordinates_.size() / 3; }
+
+		Ptr<CustomGraphicsSolidColorEffect> CustomGraphicsSolidColorEffect::create(const Ptr<Color>& color) {
+			apiCall("CustomGraphicsSolidColorEffect::create");
+			if (!color) {
+				return nullptr;
+			}
+			Ptr<CustomGraphicsSolidColorEffect> effect = new CustomGraphicsSolidColorEffect();
+			effect->color_ = color;
+			return effect;
+		}
+		#pragma endregion
+
+		#pragma region Entities
+		std::string CustomGraphicsEntity::id() const { apiCall("CustomGraphicsEntity::id"); return id_; }
+		bool CustomGraphicsEntity::id(const std::string& value) { apiCall("CustomGraphicsEntity::id"); id_ = value; return true; }
+		bool CustomGraphicsEntity::color(const Ptr<CustomGraphicsColorEffect>& value) { apiCall("CustomGraphicsEntity::color"); color_ = value; return true; }
+		bool CustomGraphicsEntity::isVisible() const { apiCall("CustomGraphicsEntity::isVisible"); return isVisible_; }
+		bool CustomGraphicsEntity::isVisible(bool value) { apiCall("CustomGraphicsEntity::isVisible"); isVisible_ = value; return true; }
+		bool CustomGraphicsEntity::isSelectable() const { apiCall("CustomGraphicsEntity::isSelectable"); return isSelectable_; }
+		bool CustomGraphicsEntity::isSelectable(bool value) { apiCall("CustomGraphicsEntity::isSelectable"); isSelectable_ = value; return true; }
+
+		bool CustomGraphicsEntity::setOpacity(double opacity, bool isScreenSpace) {
+			apiCall("CustomGraphicsEntity::setOpacity");
+			if (opacity < 0.0 || opacity > 1.0) {
+				return false;
+			}
+			opacity_ = opacity;
+			return true;
+		}
+
+		bool CustomGraphicsEntity::deleteMe() {
+			apiCall("CustomGraphicsEntity::deleteMe");
+			if (!group_) {
+				return false;
+			}
+			Ptr<CustomGraphicsEntity> self = this;
+			group_->remove(this);
+			invalidate();
+			return true;
+		}
+
+		double CustomGraphicsLines::weight() const { apiCall("CustomGraphicsLines::weight"); return weight_; }
+		bool CustomGraphicsLines::weight(double value) { apiCall("CustomGraphicsLines::weight"); weight_ = value; return true; }
+		bool CustomGraphicsLines::isScreenSpaceLineStyle() const { apiCall("CustomGraphicsLines::isScreenSpaceLineStyle"); return isScreenSpaceLineStyle_; }
+		bool CustomGraphicsLines::isScreenSpaceLineStyle(bool value) { apiCall("CustomGraphicsLines::isScreenSpaceLineStyle"); isScreenSpaceLineStyle_ = value; return true; }
+		Ptr<CustomGraphicsCoordinates> CustomGraphicsLines::coordinates() const { apiCall("CustomGraphicsLines::coordinates"); return coordinates_; }
+
+		void CustomGraphicsLines::initialize(const Ptr<CustomGraphicsCoordinates>& coordinates, const std::vector<int>& indexList,
+			bool isLineStrip, const std::vector<int>& lineStripLengths) {
+			coordinates_ = coordinates;
+			indexList_ = indexList;
+			isLineStrip_ = isLineStrip;
+			lineStripLengths_ = lineStripLengths;
+		}
+
+		/// <summary>Gets the number of line segments drawn, from the index list or else from the coordinates.</summary>
+		size_t CustomGraphicsLines::getSegmentCount() const {
+			size_t pointCount = indexList_.empty() ? (coordinates_ ? coordinates_->coordinateCount() : 0) : indexList_.size();
+			if (!isLineStrip_) {
+				return pointCount / 2;
+			}
+			if (lineStripLengths_.empty()) {
+				return pointCount > 0 ? pointCount - 1 : 0;
+			}
+			size_t count = 0;
+			for (int length : lineStripLengths_) {
+				count += length > 1 ? (size_t)length - 1 : 0;
+			}
+			return count;
+		}
+		#pragma endregion
+
+		#pragma region Groups
+		CustomGraphicsGroup::~CustomGraphicsGroup() {
+			for (const Ptr<CustomGraphicsEntity>& entity : items_) {
+				entity->attach(static_cast<CustomGraphicsGroup*>(nullptr));
+			}
+		}
+
+		Ptr<CustomGraphicsLines> CustomGraphicsGroup::addLines(const Ptr<CustomGraphicsCoordinates>& coordinates, const std::vector<int>& indexList,
+			bool isLineStrip, const std::vector<int>& lineStripLengths) {
+			apiCall("CustomGraphicsGroup::addLines");
+			if (!coordinates) {
+				return nullptr;
+			}
+			Ptr<CustomGraphicsLines> lines = new CustomGraphicsLines();
+			lines->initialize(coordinates, indexList, isLineStrip, lineStripLengths);
+			lines->attach(this);
+			items_.push_back(lines);
+			return lines;
+		}
+
+		size_t CustomGraphicsGroup::count() const { apiCall("CustomGraphicsGroup::count"); return items_.size(); }
+
+		Ptr<CustomGraphicsEntity> CustomGraphicsGroup::item(size_t index) const {
+			apiCall("CustomGraphicsGroup::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		/// <summary>Deletes the group with all of its entities.</summary>
+		bool CustomGraphicsGroup::deleteMe() {
+			apiCall("CustomGraphicsGroup::deleteMe");
+			if (!groups_) {
+				return false;
+			}
+			Ptr<CustomGraphicsGroup> self = this;
+			std::vector<Ptr<CustomGraphicsEntity>> entities;
+			entities.swap(items_);
+			for (const Ptr<CustomGraphicsEntity>& entity : entities) {
+				entity->attach(static_cast<CustomGraphicsGroup*>(nullptr));
+				entity->invalidate();
+			}
+			groups_->remove(this);
+			groups_ = nullptr;
+			invalidate();
+			return true;
+		}
+
+		void CustomGraphicsGroup::remove(const CustomGraphicsEntity* entity) {
+			auto it = std::find_if(items_.begin(), items_.end(), [entity](const Ptr<CustomGraphicsEntity>& item) { return item.get() == entity; });
+			if (it != items_.end()) {
+				(*it)->attach(static_cast<CustomGraphicsGroup*>(nullptr));
+				items_.erase(it);
+			}
+		}
+
+		CustomGraphicsGroups::~CustomGraphicsGroups() {
+			for (const Ptr<CustomGraphicsGroup>& group : items_) {
+				group->attach(static_cast<CustomGraphicsGroups*>(nullptr));
+			}
+		}
+
+		Ptr<CustomGraphicsGroup> CustomGraphicsGroups::add() {
+			apiCall("CustomGraphicsGroups::add");
+			Ptr<CustomGraphicsGroup> group = new CustomGraphicsGroup();
+			group->attach(this);
+			items_.push_back(group);
+			return group;
+		}
+
+		size_t CustomGraphicsGroups::count() const { apiCall("CustomGraphicsGroups::count"); return items_.size(); }
+
+		Ptr<CustomGraphicsGroup> CustomGraphicsGroups::item(size_t index) const {
+			apiCall("CustomGraphicsGroups::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		void CustomGraphicsGroups::remove(const CustomGraphicsGroup* group) {
+			std::erase_if(items_, [group](const Ptr<CustomGraphicsGroup>& item) { return item.get() == group; });
+		}
+		#pragma endregion
+	}
+}
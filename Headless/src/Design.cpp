@@ -0,0 +1,61 @@
+#include "StandIn.h"
+
+namespace adsk {
+	namespace fusion {
+		#pragma region Component
+		Component::Component(const std::string& name)
+			: name_(name), sketches_(new Sketches()), customGraphicsGroups_(new CustomGraphicsGroups()) {}
+
+		Component::~Component() = default;
+
+		std::string Component::name() const { apiCall("Component::name"); return name_; }
+		Ptr<Sketches> Component::sketches() const { apiCall("Component::sketches"); return sketches_; }
+		Ptr<CustomGraphicsGroups> Component::customGraphicsGroups() const { apiCall("Component::customGraphicsGroups"); return customGraphicsGroups_; }
+
+		size_t Components::count() const { apiCall("Components::count"); return items_.size(); }
+
+		Ptr<Component> Components::item(size_t index) const {
+			apiCall("Components::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		void Components::add(const Ptr<Component>& component) {
+			items_.push_back(component);
+		}
+		#pragma endregion
+
+		#pragma region Design
+		Design::Design(const std::string& rootComponentName)
+			: rootComponent_(new Component(rootComponentName)), allComponents_(new Components()) {
+			allComponents_->add(rootComponent_);
+		}
+
+		Ptr<Component> Design::rootComponent() const { apiCall("Design::rootComponent"); return rootComponent_; }
+		Ptr<Components> Design::allComponents() const { apiCall("Design::allComponents"); return allComponents_; }
+
+		/// <summary>Finds the sketches and sketch texts with the entity token; searches every sketch of every component.</summary>
+		std::vector<Ptr<Base>> Design::findEntityByToken(const std::string& entityToken) const {
+			apiCall("Design::findEntityByToken");
+			ScopedUntracked untracked;
+			std::vector<Ptr<Base>> entities;
+			for (size_t i = 0; i < allComponents_->count(); i++) {
+				Ptr<Sketches> sketches = allComponents_->item(i)->sketches();
+				for (size_t j = 0; j < sketches->count(); j++) {
+					Ptr<Sketch> sketch = sketches->item(j);
+					if (sketch->entityToken() == entityToken) {
+						entities.push_back(sketch);
+					}
+					Ptr<SketchTexts> texts = sketch->sketchTexts();
+					for (size_t k = 0; k < texts->count(); k++) {
+						Ptr<SketchText> text = texts->item(k);
+						if (text->entityToken() == entityToken) {
+							entities.push_back(text);
+						}
+					}
+				}
+			}
+			return entities;
+		}
+		#pragma endregion
+	}
+}
@@ -0,0 +1,139 @@
+#include "StandIn.h"
+#include "HeadlessDesign.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace implicatex {
+	namespace headless {
+		namespace {
+			/// <summary>Recordings are in millimeters like the export; the API works in centimeters.</summary>
+			constexpr double MM_PER_CM = 10.0;
+
+			Ptr<Sketch> addSketch(const Ptr<Component>& component, const std::string& name) {
+				Ptr<Sketch> sketch = new Sketch(name, "sketch:" + name);
+				sketch->attach(component.get());
+				component->sketches()->add(sketch);
+				return sketch;
+			}
+
+			Ptr<Document> createDocument(const std::string& name, const Ptr<Design>& design) {
+				return new Document(name, Ptr<Product>(design));
+			}
+		}
+
+		/// <summary>
+		/// <para>Loads a recording; texts are added to their sketch in file order and sketches are created as</para>
+		/// <para>they first appear. The document is named after the file. Returns false with the error on a bad line.</para>
+		/// </summary>
+		bool DesignRecording::load(const std::string& path, Ptr<Document>& document, std::string& error) {
+			ScopedUntracked untracked;
+			std::ifstream file(path);
+			if (!file) {
+				error = "Could not open " + path;
+				return false;
+			}
+
+			Ptr<Design> design = new Design("Root");
+			Ptr<Component> root = design->rootComponent();
+			std::string line;
+			size_t lineNumber = 0;
+			while (std::getline(file, line)) {
+				lineNumber++;
+				if (line.find_first_not_of(" \t\r") == std::string::npos) {
+					continue;
+				}
+				try {
+					nlohmann::json record = nlohmann::json::parse(line);
+					std::string sketchName = record.at("sketch").get<std::string>();
+					Ptr<Sketch> sketch = root->sketches()->itemByName(sketchName);
+					if (!sketch) {
+						sketch = addSketch(root, sketchName);
+					}
+					Ptr<Point3D> minPoint = Point3D::create(record.at("min_x_mm").get<double>() / MM_PER_CM,
+						record.at("min_y_mm").get<double>() / MM_PER_CM, record.at("min_z_mm").get<double>() / MM_PER_CM);
+					Ptr<Point3D> maxPoint = Point3D::create(record.at("max_x_mm").get<double>() / MM_PER_CM,
+						record.at("max_y_mm").get<double>() / MM_PER_CM, record.at("max_z_mm").get<double>() / MM_PER_CM);
+					sketch->sketchTexts()->add(record.at("text").get<std::string>(), record.at("height_mm").get<double>() / MM_PER_CM,
+						minPoint, maxPoint, record.value("entity_token", ""));
+				}
+				catch (const nlohmann::json::exception& exception) {
+					error = path + ":" + std::to_string(lineNumber) + ": " + exception.what();
+					return false;
+				}
+			}
+			document = createDocument(std::filesystem::path(path).stem().string(), design);
+			return true;
+		}
+
+		/// <summary>Saves the texts of all sketches of the design in the format of the JSON Lines export.</summary>
+		bool DesignRecording::save(const Ptr<Design>& design, const std::string& path) {
+			ScopedUntracked untracked;
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			if (!design || !file) {
+				return false;
+			}
+			Ptr<Components> components = design->allComponents();
+			for (size_t i = 0; i < components->count(); i++) {
+				Ptr<Sketches> sketches = components->item(i)->sketches();
+				for (size_t j = 0; j < sketches->count(); j++) {
+					Ptr<Sketch> sketch = sketches->item(j);
+					Ptr<SketchTexts> texts = sketch->sketchTexts();
+					for (size_t k = 0; k < texts->count(); k++) {
+						Ptr<SketchText> text = texts->item(k);
+						Ptr<BoundingBox3D> box = text->boundingBox();
+						nlohmann::ordered_json record = {
+							{ "sketch", sketch->name() },
+							{ "text", text->text() },
+							{ "height_mm", text->height() * MM_PER_CM },
+							{ "min_x_mm", box->minPoint()->x() * MM_PER_CM },
+							{ "min_y_mm", box->minPoint()->y() * MM_PER_CM },
+							{ "min_z_mm", box->minPoint()->z() * MM_PER_CM },
+							{ "max_x_mm", box->maxPoint()->x() * MM_PER_CM },
+							{ "max_y_mm", box->maxPoint()->y() * MM_PER_CM },
+							{ "max_z_mm", box->maxPoint()->z() * MM_PER_CM },
+							{ "entity_token", text->entityToken() }
+						};
+						file << record.dump() << '\n';
+					}
+				}
+			}
+			return (bool)file;
+		}
+
+		/// <summary>
+		/// <para>Generates a design of sketches with texts of typical heights laid out in rows, the same for a seed.</para>
+		/// <para>About a tenth of the texts repeat an earlier text of their sketch, so duplicates can be found.</para>
+		/// </summary>
+		Ptr<Document> DesignRecording::generate(const std::string& name, size_t sketchCount, size_t textsPerSketch, uint32_t seed) {
+			ScopedUntracked untracked;
+			static const double heightsMm[] = { 1.5, 2.0, 2.5, 3.0, 3.5, 5.0, 7.0, 10.0 };
+			std::mt19937 random(seed);
+			std::uniform_int_distribution<size_t> heightIndex(0, std::size(heightsMm) - 1);
+			std::uniform_int_distribution<int> percent(0, 99);
+
+			Ptr<Design> design = new Design("Root");
+			Ptr<Component> root = design->rootComponent();
+			size_t textNumber = 0;
+			for (size_t i = 0; i < sketchCount; i++) {
+				Ptr<Sketch> sketch = addSketch(root, "Sketch" + std::to_string(i + 1));
+				std::vector<std::string> texts;
+				for (size_t j = 0; j < textsPerSketch; j++) {
+					std::string text = !texts.empty() && percent(random) < 10
+						? texts[std::uniform_int_distribution<size_t>(0, texts.size() - 1)(random)]
+						: "T-" + std::to_string(++textNumber);
+					texts.push_back(text);
+
+					double height = heightsMm[heightIndex(random)] / MM_PER_CM;
+					double x = (double)(j % 10) * 4.0;
+					double y = (double)(j / 10) * 2.0;
+					double width = height * 0.6 * (double)text.size();
+					sketch->sketchTexts()->add(text, height, Point3D::create(x, y, 0.0), Point3D::create(x + width, y + height, 0.0),
+						"text:" + std::to_string(i + 1) + ":" + std::to_string(j + 1));
+				}
+			}
+			return createDocument(name, design);
+		}
+	}
+}
@@ -0,0 +1,517 @@
+#include "StandIn.h"
+#include "HeadlessReplay.h"
+#include "HeadlessDesign.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace implicatex {
+	namespace headless {
+		namespace {
+			/// <summary>Selects the list item with the name, or the item at the index for a number.</summary>
+			bool selectListItem(const Ptr<ListItems>& listItems, const ReplayEvent& event) {
+				for (size_t i = 0; i < listItems->count(); i++) {
+					Ptr<ListItem> item = listItems->item(i);
+					bool isMatch = std::holds_alternative<double>(event.value)
+						? (double)i == std::get<double>(event.value)
+						: std::holds_alternative<std::string>(event.value) && item->name() == std::get<std::string>(event.value);
+					if (isMatch) {
+						return item->isSelected(true);
+					}
+				}
+				return false;
+			}
+
+			/// <summary>Sets the value of the event to the input as the user would; returns false if it does not fit.</summary>
+			bool applyValue(const Ptr<CommandInput>& input, const ReplayEvent& event) {
+				const std::string* text = std::get_if<std::string>(&event.value);
+				const double* number = std::get_if<double>(&event.value);
+				const bool* flag = std::get_if<bool>(&event.value);
+
+				if (Ptr<DropDownCommandInput> dropDown = input) {
+					return selectListItem(dropDown->listItems(), event);
+				}
+				if (Ptr<ButtonRowCommandInput> buttonRow = input) {
+					return selectListItem(buttonRow->listItems(), event);
+				}
+				if (Ptr<ValueCommandInput> valueInput = input) {
+					return text ? valueInput->expression(*text) : number && valueInput->value(*number);
+				}
+				if (Ptr<StringValueCommandInput> stringInput = input) {
+					return text && stringInput->value(*text);
+				}
+				if (Ptr<TextBoxCommandInput> textBox = input) {
+					return text && textBox->text(*text);
+				}
+				if (Ptr<BoolValueCommandInput> boolInput = input) {
+					return flag && boolInput->value(*flag);
+				}
+				if (Ptr<IntegerSpinnerCommandInput> spinner = input) {
+					return number && spinner->value((int)*number);
+				}
+				if (Ptr<FloatSliderCommandInput> slider = input) {
+					return number && slider->valueOne(*number);
+				}
+				if (Ptr<TabCommandInput> tab = input) {
+					return tab->activate();
+				}
+				return false;
+			}
+
+			/// <summary>Reads the value of an event or an expectation: a check box state, a number or a text.</summary>
+			std::variant<std::monostate, bool, double, std::string> parseValue(const nlohmann::json& value) {
+				if (value.is_boolean()) {
+					return value.get<bool>();
+				}
+				if (value.is_number()) {
+					return value.get<double>();
+				}
+				return value.get<std::string>();
+			}
+
+			/// <summary>Formats a value for the message of a failed expectation.</summary>
+			std::string formatValue(const std::variant<std::monostate, bool, double, std::string>& value) {
+				if (const bool* flag = std::get_if<bool>(&value)) {
+					return *flag ? "true" : "false";
+				}
+				if (const double* number = std::get_if<double>(&value)) {
+					char digits[32];
+					auto result = std::to_chars(digits, digits + sizeof(digits), *number);
+					return std::string(digits, result.ptr);
+				}
+				if (const std::string* text = std::get_if<std::string>(&value)) {
+					return "\"" + *text + "\"";
+				}
+				return "nothing";
+			}
+
+			/// <summary>Compares an actual value with the expected one; numbers match within a rounding error.</summary>
+			bool isEqual(const std::variant<std::monostate, bool, double, std::string>& actual,
+				const std::variant<std::monostate, bool, double, std::string>& expected) {
+				const double* actualNumber = std::get_if<double>(&actual);
+				const double* expectedNumber = std::get_if<double>(&expected);
+				if (actualNumber && expectedNumber) {
+					return std::abs(*actualNumber - *expectedNumber) <= 1e-9 * std::max(1.0, std::abs(*expectedNumber));
+				}
+				return actual == expected;
+			}
+
+			/// <summary>Gets what an input shows in the form of the expected value, or nothing if it cannot show it.</summary>
+			std::variant<std::monostate, bool, double, std::string> getShownValue(const Ptr<CommandInput>& input,
+				const std::variant<std::monostate, bool, double, std::string>& expected) {
+				bool isNumber = std::holds_alternative<double>(expected);
+				if (Ptr<TableCommandInput> table = input) {
+					return (double)table->rowCount();
+				}
+				if (Ptr<TextBoxCommandInput> textBox = input) {
+					return textBox->text();
+				}
+				if (Ptr<StringValueCommandInput> stringInput = input) {
+					return stringInput->value();
+				}
+				if (Ptr<ValueCommandInput> valueInput = input) {
+					if (isNumber) {
+						return valueInput->value();
+					}
+					return valueInput->expression();
+				}
+				if (Ptr<BoolValueCommandInput> boolInput = input) {
+					return boolInput->value();
+				}
+				if (Ptr<DropDownCommandInput> dropDown = input) {
+					Ptr<ListItem> item = dropDown->selectedItem();
+					return item ? item->name() : std::string();
+				}
+				return std::monostate();
+			}
+
+			/// <summary>Counts the line segments of the visible custom graphics in a group and its subgroups.</summary>
+			size_t countSegments(const Ptr<CustomGraphicsGroup>& group) {
+				size_t count = 0;
+				for (size_t i = 0; i < group->count(); i++) {
+					Ptr<CustomGraphicsEntity> entity = group->item(i);
+					if (!entity || !entity->isVisible()) {
+						continue;
+					}
+					if (Ptr<CustomGraphicsLines> lines = entity) {
+						count += lines->getSegmentCount();
+					}
+					else if (Ptr<CustomGraphicsGroup> subgroup = entity) {
+						count += countSegments(subgroup);
+					}
+				}
+				return count;
+			}
+
+			/// <summary>Checks one expectation against the active command and design; returns the mismatch or an empty string.</summary>
+			std::string checkExpectation(const Ptr<Command>& command, const ReplayExpectation& expectation) {
+				Ptr<Design> design = Runtime::get().getApplication()->activeProduct();
+				std::variant<std::monostate, bool, double, std::string> actual;
+				std::string subject;
+				switch (expectation.kind) {
+				case ReplayExpectation::Kind::Input: {
+					subject = expectation.inputId;
+					Ptr<CommandInput> input = command->findInput(expectation.inputId);
+					if (!input) {
+						return "no input " + subject + " to check";
+					}
+					actual = getShownValue(input, expectation.value);
+					break;
+				}
+				case ReplayExpectation::Kind::Segments: {
+					subject = "segments";
+					Ptr<CustomGraphicsGroups> groups = design ? design->rootComponent()->customGraphicsGroups() : nullptr;
+					size_t count = 0;
+					for (size_t i = 0; groups && i < groups->count(); i++) {
+						count += countSegments(groups->item(i));
+					}
+					actual = (double)count;
+					break;
+				}
+				case ReplayExpectation::Kind::Text: {
+					subject = "text " + std::to_string(expectation.textIndex) + " of " + expectation.sketchName;
+					Ptr<Sketch> sketch = design ? design->rootComponent()->sketches()->itemByName(expectation.sketchName) : nullptr;
+					Ptr<SketchTexts> texts = sketch ? sketch->sketchTexts() : nullptr;
+					if (!texts || expectation.textIndex < 0 || (size_t)expectation.textIndex >= texts->count()) {
+						return "no " + subject + " to check";
+					}
+					Ptr<SketchText> text = texts->item((size_t)expectation.textIndex);
+					if (std::holds_alternative<double>(expectation.value)) {
+						actual = text->height();
+					}
+					else {
+						actual = text->text();
+					}
+					break;
+				}
+				}
+				if (isEqual(actual, expectation.value)) {
+					return std::string();
+				}
+				return subject + " is " + formatValue(actual) + ", expected " + formatValue(expectation.value);
+			}
+		}
+
+		/// <summary>Loads a replay script; returns false with the error at the first line that is not a valid event.</summary>
+		bool InputReplay::load(const std::string& path, std::string& error) {
+			std::ifstream file(path);
+			if (!file) {
+				error = "Could not open " + path;
+				return false;
+			}
+
+			events_.clear();
+			std::string line;
+			size_t lineNumber = 0;
+			while (std::getline(file, line)) {
+				lineNumber++;
+				if (line.find_first_not_of(" \t\r") == std::string::npos) {
+					continue;
+				}
+				try {
+					nlohmann::json record = nlohmann::json::parse(line);
+					ReplayEvent event;
+					event.line = lineNumber;
+					if (record.contains("edit")) {
+						event.sketchName = record["edit"].get<std::string>();
+						event.textIndex = record.value("text", 0);
+					}
+					else if (record.contains("open")) {
+						event.documentName = record["open"].get<std::string>();
+						event.isOpen = true;
+						event.sketchCount = record.value("sketches", (size_t)10);
+						event.textsPerSketch = record.value("texts", (size_t)10);
+					}
+					else if (record.contains("activate")) {
+						event.documentName = record["activate"].get<std::string>();
+					}
+					else {
+						event.inputId = record.at("input").get<std::string>();
+					}
+					event.row = record.value("row", -1);
+					event.column = record.value("column", 0);
+					event.budgetMs = record.value("budget_ms", 0.0);
+					if (record.contains("value")) {
+						event.value = parseValue(record["value"]);
+					}
+					if (record.contains("expect")) {
+						for (const auto& [key, value] : record["expect"].items()) {
+							if (key == "texts") {
+								for (const nlohmann::json& text : value) {
+									ReplayExpectation expectation;
+									expectation.kind = ReplayExpectation::Kind::Text;
+									expectation.sketchName = text.at("sketch").get<std::string>();
+									expectation.textIndex = text.value("text", 0);
+									expectation.value = parseValue(text.at("value"));
+									event.expectations.push_back(std::move(expectation));
+								}
+								continue;
+							}
+							ReplayExpectation expectation;
+							expectation.kind = key == "segments" ? ReplayExpectation::Kind::Segments : ReplayExpectation::Kind::Input;
+							expectation.inputId = key;
+							expectation.value = parseValue(value);
+							event.expectations.push_back(std::move(expectation));
+						}
+					}
+					events_.push_back(std::move(event));
+				}
+				catch (const nlohmann::json::exception& exception) {
+					error = path + ":" + std::to_string(lineNumber) + ": " + exception.what();
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/// <summary>Replays the script the given number of times; stops early when the command terminates.</summary>
+		std::vector<ReplayResult> InputReplay::run(const Ptr<Command>& command, size_t repeatCount) const {
+			std::vector<ReplayResult> results;
+			results.reserve(events_.size() * repeatCount);
+			for (size_t i = 0; i < repeatCount; i++) {
+				for (const ReplayEvent& event : events_) {
+					if (!command || command->isTerminated()) {
+						return results;
+					}
+					results.push_back(replay(command, event));
+				}
+			}
+			return results;
+		}
+
+		/// <summary>
+		/// <para>Replays one event, then fails it if the add-in logged an error meanwhile or if the panel or the design</para>
+		/// <para>does not show what the event expects. Neither check is counted in the latency or the API calls.</para>
+		/// </summary>
+		ReplayResult InputReplay::replay(const Ptr<Command>& command, const ReplayEvent& event) const {
+			uint64_t errorCount = errorCounter_ ? errorCounter_() : 0;
+			ReplayResult result = !event.sketchName.empty() ? replayEdit(event)
+				: !event.documentName.empty() ? replayDocument(event)
+				: replayInput(command, event);
+			if (!result.error.empty()) {
+				return result;
+			}
+
+			uint64_t loggedErrors = errorCounter_ ? errorCounter_() - errorCount : 0;
+			if (loggedErrors > 0) {
+				result.error = std::to_string(loggedErrors) + " errors logged";
+				return result;
+			}
+
+			ScopedUntracked untracked;
+			for (const ReplayExpectation& expectation : event.expectations) {
+				result.error = checkExpectation(command, expectation);
+				if (!result.error.empty()) {
+					break;
+				}
+			}
+			return result;
+		}
+
+		ReplayResult InputReplay::replayInput(const Ptr<Command>& command, const ReplayEvent& event) const {
+			Runtime& runtime = Runtime::get();
+			ReplayResult result;
+			result.event = &event;
+
+			Ptr<CommandInput> input;
+			{
+				ScopedUntracked untracked;
+				input = command->findInput(event.inputId);
+				if (input && event.row >= 0) {
+					Ptr<TableCommandInput> table = input;
+					input = table ? table->getInputAtPosition(event.row, event.column) : nullptr;
+					if (input) {
+						table->selectedRow(event.row);
+						if (!std::holds_alternative<std::monostate>(event.value) && !applyValue(input, event)) {
+							result.error = "value does not fit the cell";
+						}
+					}
+				}
+				else if (input && !applyValue(input, event)) {
+					result.error = "value does not fit the input";
+				}
+			}
+
+			result.eventType = getEventType(input ? input->getId() : event.inputId);
+			result.budgetMs = getBudget(event, result.eventType);
+			if (!input) {
+				result.error = event.row >= 0 ? "no cell at row " + std::to_string(event.row) : "no such input";
+			}
+			if (!result.error.empty()) {
+				return result;
+			}
+
+			uint64_t calls = runtime.getCallCount();
+			uint64_t allocations = Runtime::getAllocationCount();
+			auto start = std::chrono::steady_clock::now();
+			runtime.changeInput(input);
+			result.nanoseconds = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			result.apiCalls = runtime.getCallCount() - calls;
+			result.allocations = Runtime::getAllocationCount() - allocations;
+			return result;
+		}
+
+		/// <summary>
+		/// <para>Changes a text of the design as another Fusion command would, e.g. the user editing it while the panel</para>
+		/// <para>waits. The latency covers the commandTerminated handlers; the change itself is not counted.</para>
+		/// </summary>
+		ReplayResult InputReplay::replayEdit(const ReplayEvent& event) const {
+			Runtime& runtime = Runtime::get();
+			ReplayResult result;
+			result.event = &event;
+			result.eventType = EDIT_EVENT_TYPE;
+			result.budgetMs = getBudget(event, result.eventType);
+
+			Ptr<SketchText> text;
+			{
+				ScopedUntracked untracked;
+				Ptr<Design> design = runtime.getApplication()->activeProduct();
+				Ptr<Sketch> sketch = design ? design->rootComponent()->sketches()->itemByName(event.sketchName) : nullptr;
+				Ptr<SketchTexts> texts = sketch ? sketch->sketchTexts() : nullptr;
+				if (texts && event.textIndex >= 0 && (size_t)event.textIndex < texts->count()) {
+					text = texts->item((size_t)event.textIndex);
+				}
+			}
+			if (!text) {
+				result.error = "no text " + std::to_string(event.textIndex) + " in " + event.sketchName;
+				return result;
+			}
+
+			const std::string* value = std::get_if<std::string>(&event.value);
+			const double* height = std::get_if<double>(&event.value);
+			if (!value && !height) {
+				result.error = "value does not fit the text";
+				return result;
+			}
+
+			uint64_t calls = runtime.getCallCount();
+			uint64_t allocations = Runtime::getAllocationCount();
+			auto start = std::chrono::steady_clock::now();
+			runtime.runDesignCommand(EDIT_COMMAND_ID, [&]() { return value ? text->text(*value) : text->height(*height); });
+			result.nanoseconds = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			result.apiCalls = runtime.getCallCount() - calls;
+			result.allocations = Runtime::getAllocationCount() - allocations;
+			return result;
+		}
+
+		/// <summary>
+		/// <para>Opens or activates a document as the user switching designs would, while the panel stays open.</para>
+		/// <para>The latency covers the documentActivated handlers; generating a design is not counted.</para>
+		/// </summary>
+		ReplayResult InputReplay::replayDocument(const ReplayEvent& event) const {
+			Runtime& runtime = Runtime::get();
+			Ptr<Application> application = runtime.getApplication();
+			ReplayResult result;
+			result.event = &event;
+			result.eventType = event.isOpen ? OPEN_EVENT_TYPE : ACTIVATE_EVENT_TYPE;
+			result.budgetMs = getBudget(event, result.eventType);
+
+			Ptr<Document> document;
+			{
+				ScopedUntracked untracked;
+				if (event.isOpen) {
+					document = DesignRecording::generate(event.documentName, event.sketchCount, event.textsPerSketch, (uint32_t)event.line);
+				}
+				else {
+					Ptr<Documents> documents = application->documents();
+					for (size_t i = 0; !document && i < documents->count(); i++) {
+						if (documents->item(i)->name() == event.documentName) {
+							document = documents->item(i);
+						}
+					}
+				}
+			}
+			if (!document) {
+				result.error = "no document " + event.documentName;
+				return result;
+			}
+
+			uint64_t calls = runtime.getCallCount();
+			uint64_t allocations = Runtime::getAllocationCount();
+			auto start = std::chrono::steady_clock::now();
+			if (event.isOpen) {
+				application->openDocument(document);
+			}
+			else {
+				application->activateDocument(document);
+			}
+			runtime.processEvents();
+			result.nanoseconds = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			result.apiCalls = runtime.getCallCount() - calls;
+			result.allocations = Runtime::getAllocationCount() - allocations;
+			return result;
+		}
+
+		double InputReplay::getBudget(const ReplayEvent& event, const std::string& eventType) const {
+			if (event.budgetMs > 0.0) {
+				return event.budgetMs;
+			}
+			auto it = budgets_.find(eventType);
+			return it != budgets_.end() ? it->second : 0.0;
+		}
+
+		/// <summary>Gets the event type of an input: its id, without the row suffix ("_3") for the cells of a table.</summary>
+		std::string InputReplay::getEventType(const std::string& inputId) {
+			size_t separator = inputId.find_last_of('_');
+			if (separator == std::string::npos || separator + 1 == inputId.size() ||
+				!std::all_of(inputId.begin() + separator + 1, inputId.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+				return inputId;
+			}
+			return inputId.substr(0, separator);
+		}
+
+		/// <summary>Formats the results, one line per event with failures marked, then latencies and allocations per event type.</summary>
+		std::string InputReplay::getReport(const std::vector<ReplayResult>& results) {
+			std::string report;
+			char line[200];
+			std::snprintf(line, sizeof(line), "%-6s %-26s %10s %8s %8s %10s  %s\n", "Line", "Event", "ms", "API", "Allocs", "budget ms", "Result");
+			report.append(line);
+
+			struct TypeStats {
+				size_t count = 0;
+				size_t failures = 0;
+				uint64_t totalNanoseconds = 0;
+				uint64_t maxNanoseconds = 0;
+				uint64_t totalAllocations = 0;
+			};
+			std::map<std::string, TypeStats> typeStats;
+
+			for (const ReplayResult& result : results) {
+				std::string status = !result.error.empty() ? "error: " + result.error : result.isFailed() ? "OVER BUDGET" : "ok";
+				std::snprintf(line, sizeof(line), "%-6zu %-26s %10.3f %8llu %8llu %10.3f  %s\n",
+					result.event->line,
+					result.eventType.c_str(),
+					(double)result.nanoseconds / 1e6,
+					(unsigned long long)result.apiCalls,
+					(unsigned long long)result.allocations,
+					result.budgetMs,
+					status.c_str());
+				report.append(line);
+
+				TypeStats& stats = typeStats[result.eventType];
+				stats.count++;
+				stats.failures += result.isFailed() ? 1 : 0;
+				stats.totalNanoseconds += result.nanoseconds;
+				stats.maxNanoseconds = std::max(stats.maxNanoseconds, result.nanoseconds);
+				stats.totalAllocations += result.allocations;
+			}
+
+			std::snprintf(line, sizeof(line), "\n%-26s %8s %10s %10s %10s %8s\n", "Event type", "Events", "avg ms", "max ms", "avg allocs", "Failed");
+			report.append(line);
+			for (const auto& [eventType, stats] : typeStats) {
+				std::snprintf(line, sizeof(line), "%-26s %8zu %10.3f %10.3f %10.1f %8zu\n",
+					eventType.c_str(),
+					stats.count,
+					(double)stats.totalNanoseconds / 1e6 / (double)stats.count,
+					(double)stats.maxNanoseconds / 1e6,
+					(double)stats.totalAllocations / (double)stats.count,
+					stats.failures);
+				report.append(line);
+			}
+			return report;
+		}
+	}
+}
@@ -0,0 +1,250 @@
+#include "pch.h"
+#include "ImplicateXFusionToolsAddIn.h"
+#include "ApiCallCounter.h"
+#include "Profiler.h"
+#include "Logger.h"
+#include "HeadlessRuntime.h"
+#include "HeadlessDesign.h"
+#include "HeadlessReplay.h"
+
+using implicatex::headless::DesignRecording;
+using implicatex::headless::InputReplay;
+using implicatex::headless::Runtime;
+using implicatex::headless::ScopedUntracked;
+
+namespace implicatex {
+	namespace fusion {
+		extern "C" bool run(const char* context);
+		extern "C" bool stop(const char* context);
+	}
+}
+
+namespace {
+	/// <summary>The options of the host, see printUsage.</summary>
+	struct Options {
+		std::string designPath;
+		size_t sketchCount = 10;
+		size_t textsPerSketch = 100;
+		uint32_t seed = 1;
+		std::string localeId;
+		std::string savePath;
+		std::string replayPath;
+		std::vector<std::pair<std::string, double>> budgets;
+		std::vector<std::pair<std::string, uint64_t>> expectedCalls;
+		size_t repeatCount = 1;
+		bool isVerbose = false;
+	};
+
+	void printUsage() {
+		std::cerr <<
+			"Usage: ImplicateXHeadless [options]\n"
+			"  --design <file.jsonl>      Replays the design of a Sketch Text JSON Lines export\n"
+			"  --generate <sketches> <texts>\n"
+			"                             Generates a design (default 10 sketches of 100 texts)\n"
+			"  --seed <n>                 Seed of the generated design (default 1)\n"
+			"  --save <file.jsonl>        Saves the design in the export format and exits\n"
+			"  --latency-us <us>          Latency of every API call\n"
+			"  --latency <name>=<us>      Latency of a method (\"SketchText::height\") or class (\"SketchText\")\n"
+			"  --replay <script.jsonl>    Replays the input changes of the script in the opened panel\n"
+			"  --budget <event>=<ms>      Latency budget of an event type, e.g. textHeightMin=5 or textIdCell=20\n"
+			"  --expect-calls <event>=<n> Fails unless every replayed event of the type made exactly n API calls\n"
+			"  --repeat <n>               Replays the script n times (default 1)\n"
+			"  --locale <id>              Language of the add-in, e.g. de-DE (default from the preferences)\n"
+			"  --verbose                  Writes the log of the add-in to standard output\n";
+	}
+
+	bool parseOptions(int argc, char* argv[], Options& options) {
+		Runtime& runtime = Runtime::get();
+		for (int i = 1; i < argc; i++) {
+			std::string_view argument = argv[i];
+			bool hasValue = i + 1 < argc;
+			if (argument == "--design" && hasValue) {
+				options.designPath = argv[++i];
+			}
+			else if (argument == "--generate" && i + 2 < argc) {
+				options.sketchCount = std::strtoul(argv[++i], nullptr, 10);
+				options.textsPerSketch = std::strtoul(argv[++i], nullptr, 10);
+			}
+			else if (argument == "--seed" && hasValue) {
+				options.seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+			}
+			else if (argument == "--save" && hasValue) {
+				options.savePath = argv[++i];
+			}
+			else if (argument == "--latency-us" && hasValue) {
+				runtime.setLatency(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::duration<double, std::micro>(std::strtod(argv[++i], nullptr))));
+			}
+			else if (argument == "--latency" && hasValue) {
+				std::string_view value = argv[++i];
+				size_t equals = value.find('=');
+				if (equals == std::string_view::npos) {
+					return false;
+				}
+				runtime.setLatency(value.substr(0, equals), std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::duration<double, std::micro>(std::strtod(std::string(value.substr(equals + 1)).c_str(), nullptr))));
+			}
+			else if (argument == "--replay" && hasValue) {
+				options.replayPath = argv[++i];
+			}
+			else if (argument == "--budget" && hasValue) {
+				std::string value = argv[++i];
+				size_t equals = value.find('=');
+				if (equals == std::string::npos) {
+					return false;
+				}
+				options.budgets.emplace_back(value.substr(0, equals), std::strtod(value.c_str() + equals + 1, nullptr));
+			}
+			else if (argument == "--expect-calls" && hasValue) {
+				std::string value = argv[++i];
+				size_t equals = value.find('=');
+				if (equals == std::string::npos) {
+					return false;
+				}
+				options.expectedCalls.emplace_back(value.substr(0, equals), std::strtoull(value.c_str() + equals + 1, nullptr, 10));
+			}
+			else if (argument == "--repeat" && hasValue) {
+				options.repeatCount = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+			}
+			else if (argument == "--locale" && hasValue) {
+				options.localeId = argv[++i];
+			}
+			else if (argument == "--verbose") {
+				options.isVerbose = true;
+			}
+			else {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// <para>checkApiCalls compares the API calls the counter recorded per operation with the expected ones: each</para>
+	/// <para>replayed event of the type must be recorded exactly once, with exactly the expected number of calls.</para>
+	/// </summary>
+	///
+	/// <returns>The number of event types that do not match.</returns>
+	size_t checkApiCalls(const std::vector<std::pair<std::string, uint64_t>>& expectedCalls,
+		const std::vector<implicatex::headless::ReplayResult>& results) {
+		using namespace implicatex::fusion;
+
+		size_t mismatchCount = 0;
+		for (const auto& [eventType, calls] : expectedCalls) {
+			uint64_t eventCount = (uint64_t)std::count_if(results.begin(), results.end(), [&](const auto& result) { return result.eventType == eventType; });
+			ApiCallStats stats;
+			ApiCallCounter::get().getStats(eventType, stats); // Unrecorded operations keep zero counts
+			if (eventCount == 0 || stats.invocations != eventCount || stats.maxCalls != calls || stats.totalCalls != calls * eventCount) {
+				std::cerr << "API calls of " << eventType << ": expected " << eventCount << " x " << calls << ", recorded "
+					<< stats.invocations << " x " << (stats.invocations > 0 ? (double)stats.totalCalls / (double)stats.invocations : 0.0)
+					<< " (max " << stats.maxCalls << ")\n";
+				++mismatchCount;
+			}
+		}
+		return mismatchCount;
+	}
+}
+
+/// <summary>
+/// <para>Runs the add-in against the headless stand-in of the Fusion API: loads or generates a design, starts the</para>
+/// <para>add-in, opens the Sketch Text panel and prints the latency histograms and API calls per operation.</para>
+/// <para>With a replay script, the script's input changes follow and the exit code is 3 if an event failed, logged</para>
+/// <para>an error, left other results than it expects or exceeded its latency budget, or if an event type made other</para>
+/// <para>API calls than expected, so that the host can run as a regression check of results, latency and API calls.</para>
+/// </summary>
+int main(int argc, char* argv[]) {
+	using namespace implicatex::fusion;
+
+	Options options;
+	if (!parseOptions(argc, argv, options)) {
+		printUsage();
+		return 2;
+	}
+
+	InputReplay replay;
+	if (!options.replayPath.empty()) {
+		std::string error;
+		if (!replay.load(options.replayPath, error)) {
+			std::cerr << error << '\n';
+			return 1;
+		}
+		for (const auto& [eventType, budgetMs] : options.budgets) {
+			replay.setBudget(eventType, budgetMs);
+		}
+		replay.setErrorCounter([]() { return Logger::get().getErrorCount(); });
+	}
+
+	Runtime& runtime = Runtime::get();
+	runtime.setCallHook([](std::string_view) { ApiCallCounter::add(); });
+	ApiCallCounter::get().enable();
+	if (!options.isVerbose) {
+		runtime.setLogOutput(nullptr);
+	}
+
+	Ptr<ToolsApp> app = new ToolsApp();
+	runtime.setApplication(app);
+
+	Ptr<Document> document;
+	if (!options.designPath.empty()) {
+		std::string error;
+		if (!DesignRecording::load(options.designPath, document, error)) {
+			std::cerr << error << '\n';
+			return 1;
+		}
+	}
+	else {
+		document = DesignRecording::generate("Generated", options.sketchCount, options.textsPerSketch, options.seed);
+	}
+
+	if (!options.savePath.empty()) {
+		ScopedUntracked untracked;
+		return DesignRecording::save(document->getProduct(), options.savePath) ? 0 : 1;
+	}
+
+	if (!options.localeId.empty()) {
+		ScopedUntracked untracked;
+		app->getFusion360LocaleId(); // Fills the map of the languages Fusion offers
+		for (const auto& [language, localeId] : ToolsApp::localeIdMap) {
+			if (localeId == options.localeId) {
+				app->preferences()->generalPreferences()->userLanguage(language);
+			}
+		}
+	}
+
+	app->openDocument(document);
+	if (!run("")) {
+		std::cerr << "The add-in failed to start\n";
+		return 1;
+	}
+	runtime.processEvents();
+
+	runtime.resetCallCount();
+	Profiler::get().reset();
+	ApiCallCounter::get().reset();
+
+	bool isOpened = toolsApp->createSketchTextPanel();
+	runtime.processEvents();
+
+	size_t failureCount = 0;
+	if (isOpened && !replay.getEvents().empty()) {
+		std::vector<implicatex::headless::ReplayResult> results = replay.run(runtime.getActiveCommand(), options.repeatCount);
+		failureCount = (size_t)std::count_if(results.begin(), results.end(), [](const auto& result) { return result.isFailed(); });
+		if (results.size() < replay.getEvents().size() * options.repeatCount) {
+			std::cerr << "The command terminated during the replay\n";
+			failureCount++;
+		}
+		std::cout << InputReplay::getReport(results) << '\n';
+		failureCount += checkApiCalls(options.expectedCalls, results);
+	}
+
+	std::cout << "API calls: " << runtime.getCallCount() << "\n\n";
+	std::cout << Profiler::get().getReport() << '\n';
+	std::cout << ApiCallCounter::get().getReport();
+
+	stop("");
+	runtime.shutdown();
+	if (!isOpened) {
+		return 1;
+	}
+	return failureCount > 0 ? 3 : 0;
+}
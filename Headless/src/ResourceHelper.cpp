@@ -0,0 +1,187 @@
+#include "pch.h"
+#include "ImplicateXFusionToolsAddIn.h"
+#include "ResourceHelper.h"
+#include <unicode/unistr.h>
+
+#ifndef HEADLESS_RESOURCE_DIR
+#define HEADLESS_RESOURCE_DIR "."
+#endif
+
+namespace implicatex {
+	namespace fusion {
+		namespace {
+			/// <summary>The string tables of one LANGUAGE section of the resource script, by resource id.</summary>
+			struct ResourceSection {
+				std::string language;
+				std::string subLanguage;
+				std::unordered_map<UINT, std::string> strings;
+			};
+
+			std::string trim(const std::string& value) {
+				size_t first = value.find_first_not_of(" \t\r\n");
+				if (first == std::string::npos) {
+					return "";
+				}
+				size_t last = value.find_last_not_of(" \t\r\n");
+				return value.substr(first, last - first + 1);
+			}
+
+			/// <summary>Reads the ids of resource.h, which the resource script refers to by name.</summary>
+			std::unordered_map<std::string, UINT> readResourceIds(const std::string& path) {
+				std::unordered_map<std::string, UINT> ids;
+				std::ifstream file(path);
+				std::string line;
+				while (std::getline(file, line)) {
+					std::istringstream stream(line);
+					std::string directive, name;
+					UINT id = 0;
+					if (stream >> directive >> name >> id && directive == "#define") {
+						ids.emplace(name, id);
+					}
+				}
+				return ids;
+			}
+
+			/// <summary>Reads the resource script, which Visual Studio saves as UTF-16LE, as UTF-8.</summary>
+			std::string readResourceScript(const std::string& path) {
+				std::ifstream file(path, std::ios::binary);
+				std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+				size_t offset = bytes.size() >= 2 && (unsigned char)bytes[0] == 0xFF && (unsigned char)bytes[1] == 0xFE ? 2 : 0;
+				std::u16string units((bytes.size() - offset) / 2, u'\0');
+				for (size_t i = 0; i < units.size(); i++) {
+					units[i] = (char16_t)((unsigned char)bytes[offset + 2 * i] | ((unsigned char)bytes[offset + 2 * i + 1] << 8));
+				}
+				std::string text;
+				icu::UnicodeString(units.data(), (int32_t)units.size()).toUTF8String(text);
+				return text;
+			}
+
+			/// <summary>Unquotes a string literal of the resource script, where a quote is written as two quotes.</summary>
+			std::string unquote(const std::string& literal) {
+				std::string value;
+				for (size_t i = 1; i + 1 < literal.size(); i++) {
+					if (literal[i] == '"' && literal[i + 1] == '"') {
+						i++;
+					}
+					else if (literal[i] == '\\' && i + 2 < literal.size()) {
+						char escaped = literal[++i];
+						value += escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped;
+						continue;
+					}
+					value += literal[i];
+				}
+				return value;
+			}
+
+			/// <summary>Parses the STRINGTABLE blocks of ToolsAddIn.rc, grouped by LANGUAGE section.</summary>
+			std::vector<ResourceSection> parseResourceScript() {
+				std::string directory = HEADLESS_RESOURCE_DIR;
+				std::unordered_map<std::string, UINT> ids = readResourceIds(directory + "/resource.h");
+				std::istringstream script(readResourceScript(directory + "/ToolsAddIn.rc"));
+
+				std::vector<ResourceSection> sections;
+				bool isInStringTable = false;
+				bool isInBlock = false;
+				std::string line;
+				while (std::getline(script, line)) {
+					line = trim(line);
+					if (line.rfind("LANGUAGE ", 0) == 0) {
+						ResourceSection section;
+						size_t comma = line.find(',');
+						section.language = trim(line.substr(9, comma - 9));
+						section.subLanguage = comma != std::string::npos ? trim(line.substr(comma + 1)) : "";
+						sections.push_back(std::move(section));
+					}
+					else if (line == "STRINGTABLE") {
+						isInStringTable = true;
+					}
+					else if (isInStringTable && line == "BEGIN") {
+						isInBlock = true;
+					}
+					else if (isInBlock && line == "END") {
+						isInStringTable = isInBlock = false;
+					}
+					else if (isInBlock && !sections.empty()) {
+						size_t quote = line.find('"');
+						auto id = ids.find(trim(line.substr(0, quote)));
+						if (quote != std::string::npos && id != ids.end()) {
+							sections.back().strings.emplace(id->second, unquote(line.substr(quote)));
+						}
+					}
+				}
+				return sections;
+			}
+
+			/// <summary>
+			/// <para>Finds the section for the locale: LANG_ of the English language name, the traditional or simplified</para>
+			/// <para>sub language for Chinese, and the English section if the resource script has no such language.</para>
+			/// </summary>
+			const ResourceSection* findSection(const std::vector<ResourceSection>& sections, const std::string& localeId) {
+				UErrorCode status = U_ZERO_ERROR;
+				icu::Locale locale = icu::Locale::forLanguageTag(localeId, status);
+				icu::UnicodeString displayLanguage;
+				icu::Locale(locale.getLanguage()).getDisplayLanguage(icu::Locale::getEnglish(), displayLanguage);
+				std::string language;
+				displayLanguage.toUpper(icu::Locale::getEnglish()).toUTF8String(language);
+				language = "LANG_" + language;
+
+				std::string country = locale.getCountry();
+				bool isTraditional = std::strcmp(locale.getScript(), "Hant") == 0 || country == "TW" || country == "HK" || country == "MO";
+				std::string subLanguage = isTraditional ? "SUBLANG_CHINESE_TRADITIONAL" : "SUBLANG_CHINESE_SIMPLIFIED";
+
+				const ResourceSection* english = nullptr;
+				const ResourceSection* match = nullptr;
+				for (const ResourceSection& section : sections) {
+					if (!english && section.language == "LANG_ENGLISH") {
+						english = &section;
+					}
+					if (!match && section.language == language && (language != "LANG_CHINESE" || section.subLanguage == subLanguage)) {
+						match = &section;
+					}
+				}
+				return match ? match : english;
+			}
+		}
+
+		/// <summary>
+		/// <para>The headless build reads the string tables from the resource script instead of the module, as the</para>
+		/// <para>script is not compiled into a shared object; the tables are parsed on first use.</para>
+		/// </summary>
+		std::string LoadStringFromResource(UINT resourceId) {
+			static const std::vector<ResourceSection> sections = parseResourceScript();
+			const ResourceSection* section = findSection(sections, toolsLocaleId);
+			if (!section) {
+				return "";
+			}
+			auto it = section->strings.find(resourceId);
+			return it != section->strings.end() ? it->second : "";
+		}
+
+		std::string GetLocaleInfoAsString(const wchar_t* localeName, LCTYPE lcType) {
+			return "";
+		}
+
+		std::string WideCharToUtf8(const wchar_t* wideString) {
+			if (!wideString) {
+				return "";
+			}
+			std::string utf8String;
+			icu::UnicodeString::fromUTF32(reinterpret_cast<const UChar32*>(wideString), -1).toUTF8String(utf8String);
+			return utf8String;
+		}
+
+		/// <summary>Gets the name of the target locale's language in the language of the source locale.</summary>
+		std::string GetLocalizedLanguageName(const wchar_t* sourceLocale, const wchar_t* targetLocale) {
+			UErrorCode status = U_ZERO_ERROR;
+			icu::Locale source = icu::Locale::forLanguageTag(WideCharToUtf8(sourceLocale), status);
+			icu::Locale target = icu::Locale::forLanguageTag(WideCharToUtf8(targetLocale), status);
+			if (U_FAILURE(status)) {
+				return "";
+			}
+			icu::UnicodeString name;
+			std::string utf8String;
+			target.getDisplayLanguage(source, name).toUTF8String(utf8String);
+			return utf8String;
+		}
+	}
+}
@@ -0,0 +1,212 @@
+#include "StandIn.h"
+#include <iostream>
+#include <thread>
+
+namespace implicatex {
+	namespace headless {
+		Runtime::Runtime() : logOutput_(&std::cout) {}
+
+		Runtime& Runtime::get() {
+			static Runtime runtime;
+			return runtime;
+		}
+
+		#pragma region API calls
+		void Runtime::call(std::string_view method) {
+			if (untrackedDepth_ > 0) {
+				return;
+			}
+			callCount_.fetch_add(1, std::memory_order_relaxed);
+			if (hook_) {
+				hook_(method);
+			}
+			std::chrono::nanoseconds latency = getLatency(method);
+			if (latency.count() <= 0) {
+				return;
+			}
+			// Spin rather than sleep: sleeping overshoots latencies of a few microseconds by far
+			auto until = std::chrono::steady_clock::now() + latency;
+			while (std::chrono::steady_clock::now() < until) {
+				std::this_thread::yield();
+			}
+		}
+
+		/// <summary>Gets the latency of the method, by full name ("Class::method"), else by class, else the default.</summary>
+		std::chrono::nanoseconds Runtime::getLatency(std::string_view method) const {
+			if (latencies_.empty()) {
+				return latency_;
+			}
+			auto it = latencies_.find(method);
+			if (it != latencies_.end()) {
+				return it->second;
+			}
+			size_t separator = method.find("::");
+			if (separator != std::string_view::npos) {
+				it = latencies_.find(method.substr(0, separator));
+				if (it != latencies_.end()) {
+					return it->second;
+				}
+			}
+			return latency_;
+		}
+
+		void Runtime::setLatency(std::chrono::nanoseconds latency) {
+			latency_ = latency;
+		}
+
+		void Runtime::setLatency(std::string_view method, std::chrono::nanoseconds latency) {
+			latencies_.insert_or_assign(std::string(method), latency);
+		}
+
+		void Runtime::clearLatencies() {
+			latency_ = std::chrono::nanoseconds(0);
+			latencies_.clear();
+		}
+
+		void Runtime::setCallHook(std::function<void(std::string_view)> hook) {
+			hook_ = std::move(hook);
+		}
+		#pragma endregion
+
+		#pragma region Application
+		void Runtime::setApplication(const adsk::core::Ptr<adsk::core::Application>& application) {
+			application_ = application;
+		}
+
+		/// <summary>Gets the application, creating a plain one for hosts that do not register their own.</summary>
+		adsk::core::Ptr<adsk::core::Application> Runtime::getApplication() {
+			if (!application_) {
+				application_ = new adsk::core::Application();
+			}
+			return application_;
+		}
+
+		/// <summary>Terminates the active command and drops the queued events and the application.</summary>
+		void Runtime::shutdown() {
+			if (activeCommand_) {
+				terminateCommand(activeCommand_, adsk::core::CancelledTerminationReason);
+			}
+			{
+				std::lock_guard<std::mutex> lock(eventMutex_);
+				events_.clear();
+			}
+			application_ = nullptr;
+		}
+		#pragma endregion
+
+		#pragma region Events
+		void Runtime::post(std::function<void()> task) {
+			std::lock_guard<std::mutex> lock(eventMutex_);
+			events_.push_back(std::move(task));
+		}
+
+		/// <summary>Delivers the queued events on the calling thread, including events queued while delivering.</summary>
+		size_t Runtime::processEvents() {
+			size_t processed = 0;
+			for (;;) {
+				std::function<void()> task;
+				{
+					std::lock_guard<std::mutex> lock(eventMutex_);
+					if (events_.empty()) {
+						return processed;
+					}
+					task = std::move(events_.front());
+					events_.pop_front();
+				}
+				task();
+				processed++;
+			}
+		}
+		#pragma endregion
+
+		#pragma region Commands
+		/// <summary>Notifies the command of the input that the user changed, then delivers the events this queued.</summary>
+		bool Runtime::changeInput(const adsk::core::Ptr<adsk::core::CommandInput>& input) {
+			if (!input || !input->getCommand()) {
+				return false;
+			}
+			adsk::core::Ptr<adsk::core::Command> command = input->getCommand();
+			adsk::core::Ptr<adsk::core::InputChangedEvent> inputChanged;
+			adsk::core::Ptr<adsk::core::CommandInputs> inputs;
+			{
+				ScopedUntracked untracked;
+				inputChanged = command->inputChanged();
+				inputs = command->commandInputs();
+			}
+			inputChanged->notify(adsk::core::Ptr<adsk::core::InputChangedEventArgs>(new adsk::core::InputChangedEventArgs(input, inputs)));
+			processEvents();
+			return true;
+		}
+
+		bool Runtime::terminateCommand(const adsk::core::Ptr<adsk::core::Command>& command, adsk::core::CommandTerminationReason reason) {
+			if (!command || command->isTerminated()) {
+				return false;
+			}
+			command->terminate(reason);
+			processEvents();
+			return true;
+		}
+
+		/// <summary>Notifies the commandTerminated handlers of the user interface, as Fusion does after every command.</summary>
+		void Runtime::notifyCommandTerminated(const std::string& commandId, adsk::core::CommandTerminationReason reason) {
+			adsk::core::Ptr<adsk::core::ApplicationCommandEvent> commandTerminated;
+			{
+				ScopedUntracked untracked;
+				adsk::core::Ptr<adsk::core::UserInterface> ui = application_ ? application_->userInterface() : nullptr;
+				commandTerminated = ui ? ui->commandTerminated() : nullptr;
+			}
+			if (commandTerminated) {
+				commandTerminated->notify(adsk::core::Ptr<adsk::core::ApplicationCommandEventArgs>(
+					new adsk::core::ApplicationCommandEventArgs(commandId, reason)));
+			}
+		}
+
+		/// <summary>
+		/// <para>Runs a Fusion command other than the add-in's: its change to the design is no API call of the add-in</para>
+		/// <para>and is not counted. Then the command ends, completed if it changed something, and the events it queued are delivered.</para>
+		/// </summary>
+		bool Runtime::runDesignCommand(const std::string& commandId, const std::function<bool()>& change) {
+			bool isChanged = false;
+			{
+				ScopedUntracked untracked;
+				isChanged = change();
+			}
+			notifyCommandTerminated(commandId, isChanged ? adsk::core::CompletedTerminationReason : adsk::core::CancelledTerminationReason);
+			processEvents();
+			return isChanged;
+		}
+		#pragma endregion
+
+		#pragma region Dialogs and log
+		void Runtime::setDialogResult(adsk::core::DialogResults result, const std::string& filename) {
+			dialogResult_ = result;
+			dialogFilename_ = filename;
+		}
+
+		adsk::core::DialogResults Runtime::getDialogResult(std::string& filename) const {
+			filename = dialogFilename_;
+			return dialogResult_;
+		}
+
+		void Runtime::writeLog(const std::string& message, adsk::core::LogLevels level) {
+			std::lock_guard<std::mutex> lock(logMutex_);
+			if (!logOutput_) {
+				return;
+			}
+			std::ostream& output = *logOutput_;
+			switch (level) {
+				case adsk::core::ErrorLogLevel:
+					output << "[error] ";
+					break;
+				case adsk::core::WarningLogLevel:
+					output << "[warning] ";
+					break;
+				default:
+					output << "[info] ";
+					break;
+			}
+			output << message << '\n';
+		}
+		#pragma endregion
+	}
+}
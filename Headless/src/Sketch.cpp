@@ -0,0 +1,271 @@
+#include "StandIn.h"
+#include <algorithm>
+
+namespace adsk {
+	namespace fusion {
+		#pragma region Sketch points and lines
+		SketchPoint::SketchPoint(const Ptr<Sketch>& sketch, double x, double y) : sketch_(sketch), x_(x), y_(y) {}
+		SketchPoint::~SketchPoint() = default;
+
+		Ptr<Point3D> SketchPoint::geometry() const {
+			apiCall("SketchPoint::geometry");
+			ScopedUntracked untracked;
+			return Point3D::create(x_, y_, 0.0);
+		}
+
+		Ptr<Point3D> SketchPoint::worldGeometry() const {
+			apiCall("SketchPoint::worldGeometry");
+			ScopedUntracked untracked;
+			double x = x_, y = y_, z = 0.0;
+			if (sketch_) {
+				sketch_->toWorld(x_, y_, x, y, z);
+			}
+			return Point3D::create(x, y, z);
+		}
+
+		SketchLine::SketchLine(const Ptr<SketchPoint>& startPoint, const Ptr<SketchPoint>& endPoint)
+			: startPoint_(startPoint), endPoint_(endPoint) {}
+
+		Ptr<SketchPoint> SketchLine::startSketchPoint() const { apiCall("SketchLine::startSketchPoint"); return startPoint_; }
+		Ptr<SketchPoint> SketchLine::endSketchPoint() const { apiCall("SketchLine::endSketchPoint"); return endPoint_; }
+		#pragma endregion
+
+		#pragma region MultiLineTextDefinition
+		MultiLineTextDefinition::MultiLineTextDefinition(const Ptr<SketchText>& text) : text_(text) {}
+		MultiLineTextDefinition::~MultiLineTextDefinition() = default;
+
+		/// <summary>Gets the four lines of the text rectangle, counterclockwise from the minimum corner.</summary>
+		std::vector<Ptr<SketchLine>> MultiLineTextDefinition::rectangleLines() const {
+			apiCall("MultiLineTextDefinition::rectangleLines");
+			std::vector<Ptr<SketchLine>> lines;
+			if (!text_) {
+				return lines;
+			}
+			double minX, minY, maxX, maxY;
+			text_->getBounds(minX, minY, maxX, maxY);
+			Ptr<Sketch> sketch = text_->parentSketch();
+			Ptr<SketchPoint> corners[] = {
+				new SketchPoint(sketch, minX, minY),
+				new SketchPoint(sketch, maxX, minY),
+				new SketchPoint(sketch, maxX, maxY),
+				new SketchPoint(sketch, minX, maxY)
+			};
+			lines.reserve(4);
+			for (size_t i = 0; i < 4; i++) {
+				lines.push_back(new SketchLine(corners[i], corners[(i + 1) % 4]));
+			}
+			return lines;
+		}
+
+		/// <summary>Texts of the stand-in keep the default alignment, anchored at the lower left corner.</summary>
+		adsk::core::HorizontalAlignments MultiLineTextDefinition::horizontalAlignment() const {
+			apiCall("MultiLineTextDefinition::horizontalAlignment");
+			return adsk::core::LeftHorizontalAlignment;
+		}
+
+		adsk::core::VerticalAlignments MultiLineTextDefinition::verticalAlignment() const {
+			apiCall("MultiLineTextDefinition::verticalAlignment");
+			return adsk::core::BottomVerticalAlignment;
+		}
+		#pragma endregion
+
+		#pragma region Sketch
+		Sketch::Sketch(const std::string& name, const std::string& entityToken)
+			: name_(name), entityToken_(entityToken), sketchTexts_(new SketchTexts(this)) {}
+
+		Sketch::~Sketch() = default;
+
+		std::string Sketch::name() const { apiCall("Sketch::name"); return name_; }
+		bool Sketch::name(const std::string& value) { apiCall("Sketch::name"); name_ = value; touch(); return true; }
+		std::string Sketch::entityToken() const { apiCall("Sketch::entityToken"); return entityToken_; }
+		std::string Sketch::revisionId() const { apiCall("Sketch::revisionId"); return std::to_string(revision_); }
+		Ptr<SketchTexts> Sketch::sketchTexts() const { apiCall("Sketch::sketchTexts"); return sketchTexts_; }
+		bool Sketch::isComputeDeferred() const { apiCall("Sketch::isComputeDeferred"); return isComputeDeferred_; }
+		bool Sketch::isComputeDeferred(bool value) { apiCall("Sketch::isComputeDeferred"); isComputeDeferred_ = value; return true; }
+		Ptr<Component> Sketch::parentComponent() const { apiCall("Sketch::parentComponent"); return component_; }
+
+		Ptr<Point3D> Sketch::origin() const {
+			apiCall("Sketch::origin");
+			ScopedUntracked untracked;
+			return Point3D::create(plane_[0], plane_[1], plane_[2]);
+		}
+
+		Ptr<Vector3D> Sketch::xDirection() const {
+			apiCall("Sketch::xDirection");
+			ScopedUntracked untracked;
+			return Vector3D::create(plane_[3], plane_[4], plane_[5]);
+		}
+
+		Ptr<Vector3D> Sketch::yDirection() const {
+			apiCall("Sketch::yDirection");
+			ScopedUntracked untracked;
+			return Vector3D::create(plane_[6], plane_[7], plane_[8]);
+		}
+
+		/// <summary>Gets the bounding box of the sketch texts, or nullptr for an empty sketch.</summary>
+		Ptr<BoundingBox3D> Sketch::boundingBox() const {
+			apiCall("Sketch::boundingBox");
+			ScopedUntracked untracked;
+			bool isEmpty = true;
+			double min[3] = {}, max[3] = {};
+			for (size_t i = 0; i < sketchTexts_->count(); i++) {
+				Ptr<BoundingBox3D> box = sketchTexts_->item(i)->boundingBox();
+				double textMin[3] = { box->minPoint()->x(), box->minPoint()->y(), box->minPoint()->z() };
+				double textMax[3] = { box->maxPoint()->x(), box->maxPoint()->y(), box->maxPoint()->z() };
+				for (int axis = 0; axis < 3; axis++) {
+					min[axis] = isEmpty ? textMin[axis] : std::min(min[axis], textMin[axis]);
+					max[axis] = isEmpty ? textMax[axis] : std::max(max[axis], textMax[axis]);
+				}
+				isEmpty = false;
+			}
+			if (isEmpty) {
+				return nullptr;
+			}
+			return BoundingBox3D::create(Point3D::create(min[0], min[1], min[2]), Point3D::create(max[0], max[1], max[2]));
+		}
+
+		void Sketch::setPlane(double originX, double originY, double originZ,
+			double xDirectionX, double xDirectionY, double xDirectionZ,
+			double yDirectionX, double yDirectionY, double yDirectionZ) {
+			double plane[9] = { originX, originY, originZ, xDirectionX, xDirectionY, xDirectionZ, yDirectionX, yDirectionY, yDirectionZ };
+			std::copy(std::begin(plane), std::end(plane), plane_);
+			touch();
+		}
+
+		void Sketch::toWorld(double x, double y, double& worldX, double& worldY, double& worldZ) const {
+			worldX = plane_[0] + x * plane_[3] + y * plane_[6];
+			worldY = plane_[1] + x * plane_[4] + y * plane_[7];
+			worldZ = plane_[2] + x * plane_[5] + y * plane_[8];
+		}
+
+		size_t Sketches::count() const { apiCall("Sketches::count"); return items_.size(); }
+
+		Ptr<Sketch> Sketches::item(size_t index) const {
+			apiCall("Sketches::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		Ptr<Sketch> Sketches::itemByName(const std::string& name) const {
+			apiCall("Sketches::itemByName");
+			ScopedUntracked untracked;
+			auto it = std::find_if(items_.begin(), items_.end(), [&name](const Ptr<Sketch>& sketch) { return sketch->name() == name; });
+			return it != items_.end() ? *it : nullptr;
+		}
+
+		void Sketches::add(const Ptr<Sketch>& sketch) {
+			items_.push_back(sketch);
+		}
+		#pragma endregion
+
+		#pragma region SketchText
+		SketchText::SketchText(Sketch* sketch, const std::string& text, double height,
+			const Ptr<Point3D>& minPoint, const Ptr<Point3D>& maxPoint, const std::string& entityToken)
+			: sketch_(sketch), text_(text), height_(height), entityToken_(entityToken) {
+			ScopedUntracked untracked;
+			min_[0] = minPoint->x(); min_[1] = minPoint->y(); min_[2] = minPoint->z();
+			max_[0] = maxPoint->x(); max_[1] = maxPoint->y(); max_[2] = maxPoint->z();
+		}
+
+		std::string SketchText::text() const { apiCall("SketchText::text"); return text_; }
+		double SketchText::height() const { apiCall("SketchText::height"); return height_; }
+		std::string SketchText::entityToken() const { apiCall("SketchText::entityToken"); return entityToken_; }
+		Ptr<Sketch> SketchText::parentSketch() const { apiCall("SketchText::parentSketch"); return sketch_; }
+
+		bool SketchText::text(const std::string& value) {
+			apiCall("SketchText::text");
+			text_ = value;
+			if (sketch_) {
+				sketch_->touch();
+			}
+			return true;
+		}
+
+		/// <summary>Sets the height and scales the bounding box about its minimum point.</summary>
+		bool SketchText::height(double value) {
+			apiCall("SketchText::height");
+			if (value <= 0.0) {
+				return false;
+			}
+			if (height_ > 0.0) {
+				double scale = value / height_;
+				for (int axis = 0; axis < 3; axis++) {
+					max_[axis] = min_[axis] + (max_[axis] - min_[axis]) * scale;
+				}
+			}
+			height_ = value;
+			if (sketch_) {
+				sketch_->touch();
+			}
+			return true;
+		}
+
+		Ptr<BoundingBox3D> SketchText::boundingBox() const {
+			apiCall("SketchText::boundingBox");
+			ScopedUntracked untracked;
+			return BoundingBox3D::create(Point3D::create(min_[0], min_[1], min_[2]), Point3D::create(max_[0], max_[1], max_[2]));
+		}
+
+		Ptr<SketchTextDefinition> SketchText::definition() const {
+			apiCall("SketchText::definition");
+			return new MultiLineTextDefinition(const_cast<SketchText*>(this));
+		}
+
+		bool SketchText::deleteMe() {
+			apiCall("SketchText::deleteMe");
+			if (!sketch_) {
+				return false;
+			}
+			Ptr<SketchText> self = this;
+			Sketch* sketch = sketch_;
+			{
+				ScopedUntracked untracked;
+				sketch->sketchTexts()->remove(this);
+			}
+			sketch->touch();
+			invalidate();
+			return true;
+		}
+
+		/// <summary>Gets the bounds in sketch space, which the stand-in takes from the model space box of an XY sketch.</summary>
+		void SketchText::getBounds(double& minX, double& minY, double& maxX, double& maxY) const {
+			minX = min_[0];
+			minY = min_[1];
+			maxX = max_[0];
+			maxY = max_[1];
+		}
+
+		SketchTexts::SketchTexts(Sketch* sketch) : sketch_(sketch) {}
+
+		SketchTexts::~SketchTexts() {
+			for (const Ptr<SketchText>& text : items_) {
+				text->detach();
+			}
+		}
+
+		size_t SketchTexts::count() const { apiCall("SketchTexts::count"); return items_.size(); }
+
+		Ptr<SketchText> SketchTexts::item(size_t index) const {
+			apiCall("SketchTexts::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		Ptr<SketchText> SketchTexts::add(const std::string& text, double height,
+			const Ptr<Point3D>& minPoint, const Ptr<Point3D>& maxPoint, const std::string& entityToken) {
+			if (!minPoint || !maxPoint) {
+				return nullptr;
+			}
+			Ptr<SketchText> sketchText = new SketchText(sketch_, text, height, minPoint, maxPoint, entityToken);
+			items_.push_back(sketchText);
+			return sketchText;
+		}
+
+		void SketchTexts::remove(const SketchText* text) {
+			auto it = std::find_if(items_.begin(), items_.end(), [text](const Ptr<SketchText>& item) { return item.get() == text; });
+			if (it != items_.end()) {
+				(*it)->detach();
+				items_.erase(it);
+			}
+		}
+		#pragma endregion
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+#include "HeadlessRuntime.h"
+
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace implicatex {
+	namespace headless {
+		/// <summary>Reports a call of the named API method to the runtime.</summary>
+		inline void apiCall(std::string_view method) {
+			Runtime::get().call(method);
+		}
+	}
+}
+
+using implicatex::headless::apiCall;
+using implicatex::headless::ScopedUntracked;
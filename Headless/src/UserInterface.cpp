@@ -0,0 +1,441 @@
+#include "StandIn.h"
+#include <algorithm>
+
+using implicatex::headless::Runtime;
+
+namespace adsk {
+	void doEvents() {
+		apiCall("adsk::doEvents");
+		Runtime::get().processEvents();
+	}
+
+	namespace core {
+		namespace {
+			/// <summary>Removes the item with the given address from a collection of the stand-in.</summary>
+			template<class T, class U> void removeItem(std::vector<Ptr<T>>& items, const U* item) {
+				std::erase_if(items, [item](const Ptr<T>& other) { return other.get() == item; });
+			}
+		}
+
+		#pragma region Command
+		Command::Command(CommandDefinition* parent)
+			: parent_(parent),
+			commandInputs_(new CommandInputs(this, nullptr)),
+			inputChanged_(new InputChangedEvent()),
+			destroy_(new CommandEvent()),
+			execute_(new CommandEvent()),
+			executePreview_(new CommandEvent()) {}
+
+		Command::~Command() = default;
+
+		Ptr<CommandInputs> Command::commandInputs() const { apiCall("Command::commandInputs"); return commandInputs_; }
+		Ptr<InputChangedEvent> Command::inputChanged() const { apiCall("Command::inputChanged"); return inputChanged_; }
+		Ptr<CommandEvent> Command::destroy() const { apiCall("Command::destroy"); return destroy_; }
+		Ptr<CommandEvent> Command::execute() const { apiCall("Command::execute"); return execute_; }
+		Ptr<CommandEvent> Command::executePreview() const { apiCall("Command::executePreview"); return executePreview_; }
+		bool Command::isOKButtonVisible() const { apiCall("Command::isOKButtonVisible"); return isOKButtonVisible_; }
+		bool Command::isOKButtonVisible(bool value) { apiCall("Command::isOKButtonVisible"); isOKButtonVisible_ = value; return true; }
+		std::string Command::okButtonText() const { apiCall("Command::okButtonText"); return okButtonText_; }
+		bool Command::okButtonText(const std::string& value) { apiCall("Command::okButtonText"); okButtonText_ = value; return true; }
+		Ptr<CommandDefinition> Command::parentCommandDefinition() const { apiCall("Command::parentCommandDefinition"); return parent_; }
+
+		bool Command::doExecute(bool terminate) {
+			apiCall("Command::doExecute");
+			if (isTerminated_) {
+				return false;
+			}
+			execute_->notify(Ptr<CommandEventArgs>(new CommandEventArgs(this, CompletedTerminationReason)));
+			if (terminate) {
+				this->terminate(CompletedTerminationReason);
+			}
+			return true;
+		}
+
+		bool Command::registerInput(CommandInput* input) {
+			return inputsById_.emplace(input->getId(), input).second;
+		}
+
+		void Command::unregisterInput(const CommandInput* input) {
+			auto it = inputsById_.find(input->getId());
+			if (it != inputsById_.end() && it->second == input) {
+				inputsById_.erase(it);
+			}
+		}
+
+		CommandInput* Command::findInput(std::string_view id) const {
+			auto it = inputsById_.find(id);
+			return it != inputsById_.end() ? it->second : nullptr;
+		}
+
+		/// <summary>Ends the command: notifies the destroy handlers, deletes all inputs of the dialog and notifies commandTerminated.</summary>
+		void Command::terminate(CommandTerminationReason reason) {
+			if (isTerminated_) {
+				return;
+			}
+			Ptr<Command> self = this;
+			isTerminated_ = true;
+			destroy_->notify(Ptr<CommandEventArgs>(new CommandEventArgs(this, reason)));
+			commandInputs_->deleteAll();
+			if (Runtime::get().getActiveCommand() == self) {
+				Runtime::get().setActiveCommand(nullptr);
+			}
+			if (parent_) {
+				std::string commandId;
+				{
+					ScopedUntracked untracked;
+					commandId = parent_->id();
+				}
+				Runtime::get().notifyCommandTerminated(commandId, reason);
+			}
+		}
+		#pragma endregion
+
+		#pragma region Command definitions
+		std::string ControlDefinition::name() const { apiCall("ControlDefinition::name"); return name_; }
+		bool ControlDefinition::name(const std::string& value) { apiCall("ControlDefinition::name"); name_ = value; return true; }
+		bool ControlDefinition::isEnabled() const { apiCall("ControlDefinition::isEnabled"); return isEnabled_; }
+		bool ControlDefinition::isEnabled(bool value) { apiCall("ControlDefinition::isEnabled"); isEnabled_ = value; return true; }
+		bool ControlDefinition::isVisible() const { apiCall("ControlDefinition::isVisible"); return isVisible_; }
+		bool ControlDefinition::isVisible(bool value) { apiCall("ControlDefinition::isVisible"); isVisible_ = value; return true; }
+
+		CommandDefinition::CommandDefinition(const std::string& id, const std::string& name, const std::string& tooltip, const std::string& resourceFolder)
+			: id_(id), tooltip_(tooltip), resourceFolder_(resourceFolder),
+			controlDefinition_(new ControlDefinition()),
+			commandCreated_(new CommandCreatedEvent()) {
+			ScopedUntracked untracked;
+			controlDefinition_->name(name);
+		}
+
+		CommandDefinition::~CommandDefinition() = default;
+
+		std::string CommandDefinition::id() const { apiCall("CommandDefinition::id"); return id_; }
+
+		std::string CommandDefinition::name() const {
+			apiCall("CommandDefinition::name");
+			ScopedUntracked untracked;
+			return controlDefinition_->name();
+		}
+
+		std::string CommandDefinition::tooltip() const { apiCall("CommandDefinition::tooltip"); return tooltip_; }
+		std::string CommandDefinition::resourceFolder() const { apiCall("CommandDefinition::resourceFolder"); return resourceFolder_; }
+		Ptr<ControlDefinition> CommandDefinition::controlDefinition() const { apiCall("CommandDefinition::controlDefinition"); return controlDefinition_; }
+		Ptr<CommandCreatedEvent> CommandDefinition::commandCreated() const { apiCall("CommandDefinition::commandCreated"); return commandCreated_; }
+
+		/// <summary>Queues the creation of the command, which Fusion does once the add-in returns to the event loop.</summary>
+		bool CommandDefinition::execute() {
+			apiCall("CommandDefinition::execute");
+			if (!parent_) {
+				return false;
+			}
+			Ptr<CommandDefinition> self = this;
+			Runtime::get().post([self]() {
+				self->createCommand();
+			});
+			return true;
+		}
+
+		bool CommandDefinition::deleteMe() {
+			apiCall("CommandDefinition::deleteMe");
+			if (!parent_) {
+				return false;
+			}
+			Ptr<CommandDefinition> self = this;
+			if (activeCommand_) {
+				activeCommand_->terminate(CancelledTerminationReason);
+				activeCommand_.reset();
+			}
+			parent_->remove(this);
+			parent_ = nullptr;
+			invalidate();
+			return true;
+		}
+
+		/// <summary>Starts a command of this definition, pre-empting the active command, and notifies the created handlers.</summary>
+		Ptr<Command> CommandDefinition::createCommand() {
+			if (!parent_) {
+				return nullptr;
+			}
+			Runtime& runtime = Runtime::get();
+			if (Ptr<Command> active = runtime.getActiveCommand()) {
+				active->terminate(PreEmptedTerminationReason);
+			}
+			activeCommand_ = new Command(this);
+			runtime.setActiveCommand(activeCommand_);
+			commandCreated_->notify(Ptr<CommandCreatedEventArgs>(new CommandCreatedEventArgs(activeCommand_)));
+			return activeCommand_;
+		}
+
+		Ptr<CommandDefinition> CommandDefinitions::addButtonDefinition(const std::string& id, const std::string& name, const std::string& tooltip, const std::string& resourceFolder) {
+			apiCall("CommandDefinitions::addButtonDefinition");
+			for (const auto& item : items_) {
+				if (item->id_ == id) {
+					return nullptr;
+				}
+			}
+			Ptr<CommandDefinition> definition = new CommandDefinition(id, name, tooltip, resourceFolder);
+			definition->parent_ = this;
+			items_.push_back(definition);
+			return definition;
+		}
+
+		Ptr<CommandDefinition> CommandDefinitions::itemById(const std::string& id) const {
+			apiCall("CommandDefinitions::itemById");
+			for (const auto& item : items_) {
+				if (item->id_ == id) {
+					return item;
+				}
+			}
+			return nullptr;
+		}
+
+		size_t CommandDefinitions::count() const { apiCall("CommandDefinitions::count"); return items_.size(); }
+
+		Ptr<CommandDefinition> CommandDefinitions::item(size_t index) const {
+			apiCall("CommandDefinitions::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		void CommandDefinitions::remove(const CommandDefinition* definition) {
+			removeItem(items_, definition);
+		}
+		#pragma endregion
+
+		#pragma region Palettes
+		Palette::Palette(const std::string& id) : id_(id) {}
+
+		std::string Palette::id() const { apiCall("Palette::id"); return id_; }
+		bool Palette::isVisible() const { apiCall("Palette::isVisible"); return isVisible_; }
+		bool Palette::isVisible(bool value) { apiCall("Palette::isVisible"); isVisible_ = value; return true; }
+
+		bool TextCommandPalette::writeText(const std::string& text) {
+			apiCall("TextCommandPalette::writeText");
+			Runtime::get().writeLog(text, InfoLogLevel);
+			return true;
+		}
+
+		Palettes::Palettes() {
+			items_.push_back(new TextCommandPalette("TextCommands"));
+		}
+
+		Ptr<Palette> Palettes::itemById(const std::string& id) const {
+			apiCall("Palettes::itemById");
+			for (const auto& item : items_) {
+				ScopedUntracked untracked;
+				if (item->id() == id) {
+					return item;
+				}
+			}
+			return nullptr;
+		}
+		#pragma endregion
+
+		#pragma region Toolbars
+		std::string ToolbarControl::id() const { apiCall("ToolbarControl::id"); return id_; }
+		bool ToolbarControl::isVisible() const { apiCall("ToolbarControl::isVisible"); return isVisible_; }
+		bool ToolbarControl::isVisible(bool value) { apiCall("ToolbarControl::isVisible"); isVisible_ = value; return true; }
+
+		bool ToolbarControl::deleteMe() {
+			apiCall("ToolbarControl::deleteMe");
+			if (!parent_) {
+				return false;
+			}
+			Ptr<ToolbarControl> self = this;
+			parent_->remove(this);
+			parent_ = nullptr;
+			invalidate();
+			return true;
+		}
+
+		void ToolbarControl::attach(ToolbarControls* parent, const std::string& id) {
+			parent_ = parent;
+			id_ = id;
+		}
+
+		Ptr<CommandDefinition> CommandControl::commandDefinition() const { apiCall("CommandControl::commandDefinition"); return commandDefinition_; }
+
+		void CommandControl::initialize(const Ptr<CommandDefinition>& commandDefinition) {
+			commandDefinition_ = commandDefinition;
+		}
+
+		Ptr<ToolbarControls> DropDownControl::controls() const { apiCall("DropDownControl::controls"); return controls_; }
+
+		void DropDownControl::initialize(const std::string& text, const std::string& resourceFolder) {
+			text_ = text;
+			resourceFolder_ = resourceFolder;
+			controls_ = new ToolbarControls();
+		}
+
+		Ptr<CommandControl> ToolbarControls::addCommand(const Ptr<CommandDefinition>& commandDefinition, const std::string& positionId, bool isBefore) {
+			apiCall("ToolbarControls::addCommand");
+			if (!commandDefinition) {
+				return nullptr;
+			}
+			ScopedUntracked untracked;
+			Ptr<CommandControl> control = new CommandControl();
+			control->attach(this, commandDefinition->id());
+			control->initialize(commandDefinition);
+			items_.push_back(control);
+			return control;
+		}
+
+		Ptr<DropDownControl> ToolbarControls::addDropDown(const std::string& text, const std::string& resourceFolder, const std::string& id, const std::string& positionId, bool isBefore) {
+			apiCall("ToolbarControls::addDropDown");
+			Ptr<DropDownControl> control = new DropDownControl();
+			control->attach(this, id);
+			control->initialize(text, resourceFolder);
+			items_.push_back(control);
+			return control;
+		}
+
+		Ptr<ToolbarControl> ToolbarControls::itemById(const std::string& id) const {
+			apiCall("ToolbarControls::itemById");
+			ScopedUntracked untracked;
+			for (const auto& item : items_) {
+				if (item->id() == id) {
+					return item;
+				}
+			}
+			return nullptr;
+		}
+
+		size_t ToolbarControls::count() const { apiCall("ToolbarControls::count"); return items_.size(); }
+
+		Ptr<ToolbarControl> ToolbarControls::item(size_t index) const {
+			apiCall("ToolbarControls::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		void ToolbarControls::remove(const ToolbarControl* control) {
+			removeItem(items_, control);
+		}
+
+		std::string ToolbarPanel::id() const { apiCall("ToolbarPanel::id"); return id_; }
+		std::string ToolbarPanel::name() const { apiCall("ToolbarPanel::name"); return name_; }
+		Ptr<ToolbarControls> ToolbarPanel::controls() const { apiCall("ToolbarPanel::controls"); return controls_; }
+
+		bool ToolbarPanel::deleteMe() {
+			apiCall("ToolbarPanel::deleteMe");
+			if (!parent_) {
+				return false;
+			}
+			Ptr<ToolbarPanel> self = this;
+			parent_->remove(this);
+			parent_ = nullptr;
+			invalidate();
+			return true;
+		}
+
+		void ToolbarPanel::initialize(ToolbarPanels* parent, const std::string& id, const std::string& name) {
+			parent_ = parent;
+			id_ = id;
+			name_ = name;
+			controls_ = new ToolbarControls();
+		}
+
+		Ptr<ToolbarPanel> ToolbarPanels::add(const std::string& id, const std::string& name, const std::string& positionId, bool isBefore) {
+			apiCall("ToolbarPanels::add");
+			Ptr<ToolbarPanel> panel = new ToolbarPanel();
+			panel->initialize(this, id, name);
+			items_.push_back(panel);
+			return panel;
+		}
+
+		Ptr<ToolbarPanel> ToolbarPanels::itemById(const std::string& id) const {
+			apiCall("ToolbarPanels::itemById");
+			ScopedUntracked untracked;
+			for (const auto& item : items_) {
+				if (item->id() == id) {
+					return item;
+				}
+			}
+			return nullptr;
+		}
+
+		size_t ToolbarPanels::count() const { apiCall("ToolbarPanels::count"); return items_.size(); }
+
+		Ptr<ToolbarPanel> ToolbarPanels::item(size_t index) const {
+			apiCall("ToolbarPanels::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+
+		void ToolbarPanels::remove(const ToolbarPanel* panel) {
+			removeItem(items_, panel);
+		}
+
+		Workspace::Workspace(const std::string& id) : id_(id), toolbarPanels_(new ToolbarPanels()) {}
+
+		std::string Workspace::id() const { apiCall("Workspace::id"); return id_; }
+		Ptr<ToolbarPanels> Workspace::toolbarPanels() const { apiCall("Workspace::toolbarPanels"); return toolbarPanels_; }
+
+		Workspaces::Workspaces() {
+			items_.push_back(new Workspace("FusionSolidEnvironment"));
+		}
+
+		Ptr<Workspace> Workspaces::itemById(const std::string& id) const {
+			apiCall("Workspaces::itemById");
+			ScopedUntracked untracked;
+			for (const auto& item : items_) {
+				if (item->id() == id) {
+					return item;
+				}
+			}
+			return nullptr;
+		}
+
+		size_t Workspaces::count() const { apiCall("Workspaces::count"); return items_.size(); }
+
+		Ptr<Workspace> Workspaces::item(size_t index) const {
+			apiCall("Workspaces::item");
+			return index < items_.size() ? items_[index] : nullptr;
+		}
+		#pragma endregion
+
+		#pragma region FileDialog
+		std::string FileDialog::title() const { apiCall("FileDialog::title"); return title_; }
+		bool FileDialog::title(const std::string& value) { apiCall("FileDialog::title"); title_ = value; return true; }
+		std::string FileDialog::filter() const { apiCall("FileDialog::filter"); return filter_; }
+		bool FileDialog::filter(const std::string& value) { apiCall("FileDialog::filter"); filter_ = value; return true; }
+		int FileDialog::filterIndex() const { apiCall("FileDialog::filterIndex"); return filterIndex_; }
+		bool FileDialog::filterIndex(int value) { apiCall("FileDialog::filterIndex"); filterIndex_ = value; return true; }
+		std::string FileDialog::initialFilename() const { apiCall("FileDialog::initialFilename"); return initialFilename_; }
+		bool FileDialog::initialFilename(const std::string& value) { apiCall("FileDialog::initialFilename"); initialFilename_ = value; return true; }
+		std::string FileDialog::filename() const { apiCall("FileDialog::filename"); return filename_; }
+		DialogResults FileDialog::showSave() { apiCall("FileDialog::showSave"); return show(); }
+		DialogResults FileDialog::showOpen() { apiCall("FileDialog::showOpen"); return show(); }
+
+		DialogResults FileDialog::show() {
+			std::string filename;
+			DialogResults result = Runtime::get().getDialogResult(filename);
+			if (result == DialogOK) {
+				filename_ = filename.empty() ? initialFilename_ : filename;
+			}
+			return result;
+		}
+		#pragma endregion
+
+		#pragma region UserInterface
+		UserInterface::UserInterface()
+			: palettes_(new Palettes()),
+			commandDefinitions_(new CommandDefinitions()),
+			workspaces_(new Workspaces()),
+			commandTerminated_(new ApplicationCommandEvent()) {}
+
+		UserInterface::~UserInterface() = default;
+
+		Ptr<Palettes> UserInterface::palettes() const { apiCall("UserInterface::palettes"); return palettes_; }
+		Ptr<CommandDefinitions> UserInterface::commandDefinitions() const { apiCall("UserInterface::commandDefinitions"); return commandDefinitions_; }
+		Ptr<Workspaces> UserInterface::workspaces() const { apiCall("UserInterface::workspaces"); return workspaces_; }
+		Ptr<Command> UserInterface::activeCommand() const { apiCall("UserInterface::activeCommand"); return Runtime::get().getActiveCommand(); }
+		Ptr<ApplicationCommandEvent> UserInterface::commandTerminated() const { apiCall("UserInterface::commandTerminated"); return commandTerminated_; }
+		Ptr<FileDialog> UserInterface::createFileDialog() { apiCall("UserInterface::createFileDialog"); return new FileDialog(); }
+
+		/// <summary>Writes the message to the log output and answers as if the user confirmed it.</summary>
+		DialogResults UserInterface::messageBox(const std::string& text, const std::string& title, MessageBoxButtonTypes buttons, MessageBoxIconTypes icon) {
+			apiCall("UserInterface::messageBox");
+			Runtime::get().writeLog(title.empty() ? text : title + ": " + text,
+				icon == CriticalIconType ? ErrorLogLevel : icon == WarningIconType ? WarningLogLevel : InfoLogLevel);
+			return buttons == YesNoButtonType || buttons == YesNoCancelButtonType ? DialogYes : DialogOK;
+		}
+		#pragma endregion
+	}
+}
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "resource.h"
 #include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::App
 #include "Logging.h"
 #include "ImplicateXFusionToolsAddIn.h"
 #include "ToolsBar.h"
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "resource.h"
 #include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::App
 #include "Logging.h"
 #include "ImplicateXFusionToolsAddIn.h"
 #include "ToolsBar.h"
@@ -59,26 +60,26 @@ namespace implicatex {
 					std::string commandDescription = language;
 					auto commandDef = toolsUI->commandDefinitions()->itemById(commandId);
 					if (commandDef) {
-						LOG_INFO_EX("CommandDefinition already exists for " + commandId);
+						LOG_INFO_EX("CommandDefinition already exists for {}", commandId);
 						if (!commandDef->deleteMe()) {
-							LOG_ERROR("Failed to delete CommandDefinition for " + commandId);
+							LOG_ERROR("Failed to delete CommandDefinition for {}", commandId);
 							continue;
 						}
 					}
 					commandDef = toolsUI->commandDefinitions()->addButtonDefinition(commandId.c_str(), commandName.c_str(), commandDescription.c_str(), IDS_SUBDIR_FLAGS + locale);
 					if (!commandDef) {
-						LOG_ERROR("Failed to add CommandDefinition for " + commandId);
+						LOG_ERROR("Failed to add CommandDefinition for {}", commandId);
 						continue;
 					}
                     auto handler = new LanguageCommandCreatedEventHandler(locale_);
 					eventHandlers[commandId] = handler;
 					if (!commandDef->commandCreated()->add(handler)) {
-						LOG_ERROR("Failed to add event handler for " + commandId);
+						LOG_ERROR("Failed to add event handler for {}", commandId);
 						return false;
 					}
 					auto commandControl = this->controls()->addCommand(commandDef, "", false);
 					if (!commandControl) {
-						LOG_ERROR("Failed to add CommandControl for " + commandId);
+						LOG_ERROR("Failed to add CommandControl for {}", commandId);
 						return false;
 					}
 				}
@@ -106,7 +107,7 @@ namespace implicatex {
 						auto event = commandDef->commandCreated();
 						if (event) {
 							if (!event->remove(eventHandlers[commandId])) {
-								LOG_ERROR("Failed to remove event handler for " + commandId);
+								LOG_ERROR("Failed to remove event handler for {}", commandId);
 							}
 						}
 						adsk::doEvents();
@@ -115,7 +116,7 @@ namespace implicatex {
 					auto commandControl = this->controls()->itemById(commandId);
 					if (commandControl) {
 						if (!commandControl->deleteMe()) {
-							LOG_ERROR("Failed to delete CommandControl for " + commandId);
+							LOG_ERROR("Failed to delete CommandControl for {}", commandId);
 						}
 					}
 				}
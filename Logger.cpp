@@ -0,0 +1,294 @@
+#include "pch.h"
+#include "Logger.h"
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace implicatex {
+	namespace fusion {
+		namespace {
+			int64_t steadyNow() {
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+
+			int64_t systemNow() {
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+			}
+
+			/// <summary>Small sequential thread numbers read better in the log than native thread ids.</summary>
+			uint32_t currentThreadId() {
+				static std::atomic<uint32_t> nextThreadId = 1;
+				thread_local uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+				return threadId;
+			}
+		}
+
+		/// <summary>Gets the process wide logger.</summary>
+		///
+		/// <returns>The logger.</returns>
+		Logger& Logger::get() {
+			static Logger logger;
+			return logger;
+		}
+
+		Logger::Logger() : slots_(new Slot[CAPACITY]) {
+			for (size_t i = 0; i < CAPACITY; ++i) {
+				slots_[i].sequence.store(i, std::memory_order_relaxed);
+			}
+			steadyStart_ = steadyNow();
+			systemStart_ = systemNow();
+		}
+
+		Logger::~Logger() {
+			stop();
+		}
+
+		/// <summary>
+		/// <para>start opens the sink and starts the background writer. Records written before start</para>
+		/// <para>stay in the ring, up to its capacity, and are written once the writer runs.</para>
+		/// </summary>
+		///
+		/// <param name="sink">		   The sink.</param>
+		/// <param name="filePath">	   The log file, used by the file sink only.</param>
+		/// <param name="requestDrain">Called by the writer when console lines wait for drain; must be thread safe.</param>
+		///
+		/// <returns>True if it succeeds, false if the log file could not be opened.</returns>
+		bool Logger::start(LogSink sink, const std::string& filePath, std::function<void()> requestDrain) {
+			stop();
+
+			sink_ = sink;
+			requestDrain_ = std::move(requestDrain);
+			isDrainRequested_ = false;
+
+			if (sink_ == LogSink::File) {
+				std::error_code error;
+				fs::path path(reinterpret_cast<const char8_t*>(filePath.c_str()));
+				fs::create_directories(path.parent_path(), error);
+				file_.open(path, std::ios::out | std::ios::app | std::ios::binary);
+				if (!file_) {
+					return false;
+				}
+			}
+
+			isRunning_ = true;
+			writer_ = std::thread(&Logger::run, this);
+			return true;
+		}
+
+		/// <summary>Stops the writer after it has written all records, and closes the sink.</summary>
+		void Logger::stop() {
+			if (!isRunning_.exchange(false)) {
+				return;
+			}
+			if (writer_.joinable()) {
+				writer_.join();
+			}
+			if (file_.is_open()) {
+				file_.close();
+			}
+		}
+
+		/// <summary>Gets the name of a category as shown in the log file.</summary>
+		///
+		/// <param name="category">The category.</param>
+		///
+		/// <returns>The name.</returns>
+		const char* Logger::getCategoryName(LogCategory category) {
+			switch (category) {
+			case LogCategory::App: return "App";
+			case LogCategory::SketchText: return "SketchText";
+			case LogCategory::Settings: return "Settings";
+			default: return "General";
+			}
+		}
+
+		/// <summary>
+		/// <para>write claims a slot of the ring and copies the record into it. It takes no lock,</para>
+		/// <para>allocates nothing and drops the record if the ring is full.</para>
+		/// </summary>
+		///
+		/// <param name="category">   The category.</param>
+		/// <param name="level">	  The level.</param>
+		/// <param name="file">		  The source file, a string literal.</param>
+		/// <param name="line">		  The source line.</param>
+		/// <param name="function">	  The function name, a string literal.</param>
+		/// <param name="hasLocation">True to append function, file and line to the message.</param>
+		/// <param name="detail">	  Text appended after " | ", e.g. the last Fusion error; nullptr for none.</param>
+		/// <param name="message">	  The message.</param>
+		void Logger::write(LogCategory category, LogLevel level, const char* file, uint32_t line, const char* function,
+			bool hasLocation, const char* detail, std::string_view message) noexcept {
+			if (level == LogLevel::Error) {
+				errorCount_.fetch_add(1, std::memory_order_relaxed);
+			}
+			uint64_t position = enqueuePosition_.load(std::memory_order_relaxed);
+			Slot* slot = nullptr;
+			while (true) {
+				slot = &slots_[position & (CAPACITY - 1)];
+				uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+				int64_t difference = (int64_t)sequence - (int64_t)position;
+				if (difference == 0) {
+					if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						break;
+					}
+				}
+				else if (difference < 0) {
+					droppedCount_.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				else {
+					position = enqueuePosition_.load(std::memory_order_relaxed);
+				}
+			}
+
+			LogRecord& record = slot->record;
+			record.timestamp = steadyNow();
+			record.file = file;
+			record.function = function;
+			record.line = line;
+			record.threadId = currentThreadId();
+			record.category = category;
+			record.level = level;
+			record.hasLocation = hasLocation;
+			size_t length = (std::min)(message.size(), LogRecord::MESSAGE_SIZE);
+			std::memcpy(record.message, message.data(), length);
+			if (detail != nullptr) {
+				std::string_view separator(" | ");
+				std::string_view detailText(detail);
+				size_t separatorLength = (std::min)(separator.size(), LogRecord::MESSAGE_SIZE - length);
+				std::memcpy(record.message + length, separator.data(), separatorLength);
+				length += separatorLength;
+				size_t detailLength = (std::min)(detailText.size(), LogRecord::MESSAGE_SIZE - length);
+				std::memcpy(record.message + length, detailText.data(), detailLength);
+				length += detailLength;
+			}
+			record.messageLength = (uint16_t)length;
+
+			slot->sequence.store(position + 1, std::memory_order_release);
+		}
+
+		/// <summary>
+		/// <para>drain passes the formatted console lines to the output. It is called on the main thread</para>
+		/// <para>in response to requestDrain, since the Fusion console may only be written from there.</para>
+		/// </summary>
+		///
+		/// <param name="output">The output, e.g. Application::log.</param>
+		void Logger::drain(const std::function<void(LogLevel, const std::string&)>& output) {
+			std::vector<std::pair<LogLevel, std::string>> lines;
+			{
+				std::lock_guard<std::mutex> lock(pendingMutex_);
+				lines.swap(pendingLines_);
+				isDrainRequested_ = false;
+			}
+			for (const auto& [level, line] : lines) {
+				output(level, line);
+			}
+		}
+
+		/// <summary>The background writer: consumes records and sleeps briefly while the ring is empty.</summary>
+		void Logger::run() {
+			while (isRunning_.load()) {
+				if (consume() == 0) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(5));
+				}
+			}
+			// Write what arrived until stop
+			consume();
+		}
+
+		/// <summary>Formats and writes all records that are complete, in order.</summary>
+		///
+		/// <returns>The number of records written.</returns>
+		size_t Logger::consume() {
+			size_t count = 0;
+			std::string line;
+			std::string fileBatch;
+			std::vector<std::pair<LogLevel, std::string>> consoleBatch;
+
+			while (true) {
+				Slot& slot = slots_[dequeuePosition_ & (CAPACITY - 1)];
+				if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition_ + 1) {
+					break;
+				}
+
+				format(slot.record, line);
+				LogLevel level = slot.record.level;
+				slot.sequence.store(dequeuePosition_ + CAPACITY, std::memory_order_release);
+				++dequeuePosition_;
+				++count;
+
+				if (sink_ == LogSink::File) {
+					fileBatch.append(line);
+					fileBatch.push_back('\n');
+				}
+				else {
+					consoleBatch.emplace_back(level, line);
+				}
+			}
+
+			if (count == 0) {
+				return 0;
+			}
+			writtenCount_.fetch_add(count, std::memory_order_relaxed);
+
+			if (sink_ == LogSink::File) {
+				file_.write(fileBatch.data(), (std::streamsize)fileBatch.size());
+				file_.flush();
+				return count;
+			}
+
+			bool isRequestNeeded = false;
+			{
+				std::lock_guard<std::mutex> lock(pendingMutex_);
+				for (auto& entry : consoleBatch) {
+					pendingLines_.push_back(std::move(entry));
+				}
+				isRequestNeeded = !isDrainRequested_.exchange(true);
+			}
+			if (isRequestNeeded && requestDrain_) {
+				requestDrain_();
+			}
+			return count;
+		}
+
+		/// <summary>
+		/// <para>format builds the text of a record. Console lines keep the layout of the former log macros,</para>
+		/// <para>file lines are prefixed with wall clock time and thread number.</para>
+		/// </summary>
+		void Logger::format(const LogRecord& record, std::string& line) const {
+			line.clear();
+
+			if (sink_ == LogSink::File) {
+				int64_t systemTime = systemStart_ + (record.timestamp - steadyStart_);
+				std::time_t seconds = (std::time_t)(systemTime / 1000000000);
+				int milliseconds = (int)((systemTime / 1000000) % 1000);
+				std::tm time{};
+#ifdef _WIN32
+				localtime_s(&time, &seconds);
+#else
+				localtime_r(&seconds, &time);
+#endif
+				char prefix[64];
+				std::snprintf(prefix, sizeof(prefix), "%04d-%02d-%02d %02d:%02d:%02d.%03d [%u] [%s] ",
+					time.tm_year + 1900, time.tm_mon + 1, time.tm_mday, time.tm_hour, time.tm_min, time.tm_sec,
+					milliseconds, record.threadId, getCategoryName(record.category));
+				line.append(prefix);
+			}
+
+			switch (record.level) {
+			case LogLevel::Debug: line.append("[DEBUG] "); break;
+			case LogLevel::Warning: line.append("[WARNING] "); break;
+			case LogLevel::Error: line.append("[ERROR] "); break;
+			default: break;
+			}
+			line.append(record.message, record.messageLength);
+
+			if (record.hasLocation) {
+				std::string_view path(record.file);
+				std::string_view fileName = path.substr(path.find_last_of("/\\") + 1);
+				line.append(" | Function: ").append(record.function);
+				line.append(" | File: ").append(fileName);
+				line.append(" | Line: ").append(std::to_string(record.line));
+			}
+		}
+	}
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>The severity of a log record; Off only serves as level threshold.</summary>
+		enum class LogLevel : uint8_t {
+			Debug = 0,
+			Info = 1,
+			Warning = 2,
+			Error = 3,
+			Off = 4
+		};
+
+		/// <summary>The area of the add-in a log record comes from, each with its own level threshold.</summary>
+		enum class LogCategory : uint8_t {
+			General = 0,
+			App = 1,
+			SketchText = 2,
+			Settings = 3,
+			Count = 4
+		};
+
+		/// <summary>Where the background thread writes formatted records to.</summary>
+		enum class LogSink {
+			Console = 0, // Fusion text commands palette, written on the main thread
+			File = 1
+		};
+
+		/// <summary>
+		/// <para>LogRecord is the fixed size binary record passed from the logging threads to the writer.</para>
+		/// <para>File and function point to string literals, messages longer than the payload are truncated.</para>
+		/// </summary>
+		struct LogRecord {
+			static constexpr size_t MESSAGE_SIZE = 208;
+
+			int64_t timestamp;		// steady clock, nanoseconds
+			const char* file;
+			const char* function;
+			uint32_t line;
+			uint32_t threadId;
+			LogCategory category;
+			LogLevel level;
+			bool hasLocation;
+			uint16_t messageLength;
+			char message[MESSAGE_SIZE];
+		};
+
+		/// <summary>
+		/// <para>Logger is an asynchronous logging backend. Any thread appends records to a bounded lock free</para>
+		/// <para>multi producer, single consumer ring buffer; a background thread formats them and writes them</para>
+		/// <para>to a file or hands them to the main thread for the Fusion console. Logging never blocks:</para>
+		/// <para>when the ring is full the record is dropped and counted.</para>
+		/// </summary>
+		class Logger
+		{
+		public:
+			static Logger& get();
+			~Logger();
+
+			Logger(const Logger&) = delete;
+			Logger& operator=(const Logger&) = delete;
+
+			bool start(LogSink sink, const std::string& filePath, std::function<void()> requestDrain);
+			void stop();
+
+			void write(LogCategory category, LogLevel level, const char* file, uint32_t line, const char* function,
+				bool hasLocation, const char* detail, std::string_view message) noexcept;
+
+			/// <summary>
+			/// <para>write formats the message with std::format into a buffer of the record size,</para>
+			/// <para>so that even formatted records need no allocation, and appends the record.</para>
+			/// </summary>
+			template <typename... Args>
+			void write(LogCategory category, LogLevel level, const char* file, uint32_t line, const char* function,
+				bool hasLocation, const char* detail, std::format_string<Args...> format, Args&&... args) {
+				char buffer[LogRecord::MESSAGE_SIZE];
+				auto result = std::format_to_n(buffer, sizeof(buffer), format, std::forward<Args>(args)...);
+				size_t length = (std::min)((size_t)result.size, sizeof(buffer));
+				write(category, level, file, line, function, hasLocation, detail, std::string_view(buffer, length));
+			}
+
+			bool isEnabled(LogCategory category, LogLevel level) const {
+				return (uint8_t)level >= levels_[(size_t)category].load(std::memory_order_relaxed);
+			}
+			void setLevel(LogCategory category, LogLevel level) { levels_[(size_t)category].store((uint8_t)level, std::memory_order_relaxed); }
+			LogLevel getLevel(LogCategory category) const { return (LogLevel)levels_[(size_t)category].load(std::memory_order_relaxed); }
+
+			static const char* getCategoryName(LogCategory category);
+			void drain(const std::function<void(LogLevel, const std::string&)>& output);
+
+			#pragma region Getters
+			uint64_t getWrittenCount() const { return writtenCount_.load(std::memory_order_relaxed); }
+			uint64_t getDroppedCount() const { return droppedCount_.load(std::memory_order_relaxed); }
+			uint64_t getErrorCount() const { return errorCount_.load(std::memory_order_relaxed); }
+			#pragma endregion
+
+			/// <summary>Number of records the ring holds, must be a power of two.</summary>
+			static constexpr size_t CAPACITY = 4096;
+
+		private:
+			Logger();
+
+			struct Slot {
+				std::atomic<uint64_t> sequence;
+				LogRecord record;
+			};
+
+			void run();
+			size_t consume();
+			void format(const LogRecord& record, std::string& line) const;
+
+			std::unique_ptr<Slot[]> slots_;
+			alignas(64) std::atomic<uint64_t> enqueuePosition_ = 0;
+			alignas(64) uint64_t dequeuePosition_ = 0;
+			alignas(64) std::atomic<uint64_t> writtenCount_ = 0;
+			std::atomic<uint64_t> droppedCount_ = 0;
+			std::atomic<uint64_t> errorCount_ = 0; // Error records written, dropped or not
+
+			/// <summary>Runtime level thresholds per category, on top of the compile time ones in Logging.h.</summary>
+			std::atomic<uint8_t> levels_[(size_t)LogCategory::Count] = {};
+
+			LogSink sink_ = LogSink::Console;
+			std::ofstream file_;
+			std::function<void()> requestDrain_;
+			std::atomic<bool> isDrainRequested_ = false;
+			std::atomic<bool> isRunning_ = false;
+			std::thread writer_;
+
+			/// <summary>Formatted console lines waiting for the main thread.</summary>
+			std::mutex pendingMutex_;
+			std::vector<std::pair<LogLevel, std::string>> pendingLines_;
+
+			int64_t steadyStart_ = 0;
+			int64_t systemStart_ = 0;
+		};
+	}
+}
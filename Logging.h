@@ -1,30 +1,80 @@
 #pragma once
-#ifdef _LOG_FILE_
-#define LOG_TYPE LogTypes::FileLogType
-#else
-#define LOG_TYPE LogTypes::ConsoleLogType
+#include "Logger.h"
+
+/// <summary>
+/// <para>LOG_CATEGORY is the category of the log statements of a translation unit.</para>
+/// <para>Define it before including Logging.h to log under another category than General.</para>
+/// </summary>
+#ifndef LOG_CATEGORY
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::General
 #endif
 
+/// <summary>
+/// <para>LOG_LEVEL is the lowest level compiled in, LOG_LEVEL_APP .. LOG_LEVEL_SETTINGS override it per category,</para>
+/// <para>e.g. /DLOG_LEVEL_SKETCHTEXT=::implicatex::fusion::LogLevel::Debug. Statements below these levels</para>
+/// <para>compile to nothing; Logger::setLevel raises the thresholds further at runtime.</para>
+/// </summary>
+#ifndef LOG_LEVEL
 #ifdef _LOG_INFO_
-#define LOG_INFO(msg) toolsApp->log(msg, InfoLogLevel, LOG_TYPE)
-#define LOG_INFO_EX(msg) \
-    toolsApp->log(msg + " | Function: " + __func__ + " | File: " + __FILE__ + " | Line: " + std::to_string(__LINE__), InfoLogLevel, LOG_TYPE)
+#define LOG_LEVEL ::implicatex::fusion::LogLevel::Info
 #else
-#define LOG_INFO(msg) ((void)0)
-#define LOG_INFO_EX(msg) ((void)0)
+#define LOG_LEVEL ::implicatex::fusion::LogLevel::Error
+#endif
+#endif
+#ifndef LOG_LEVEL_GENERAL
+#define LOG_LEVEL_GENERAL LOG_LEVEL
 #endif
+#ifndef LOG_LEVEL_APP
+#define LOG_LEVEL_APP LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SKETCHTEXT
+#define LOG_LEVEL_SKETCHTEXT LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SETTINGS
+#define LOG_LEVEL_SETTINGS LOG_LEVEL
+#endif
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>Gets the lowest level compiled in for a category.</summary>
+		constexpr LogLevel getCompiledLogLevel(LogCategory category) {
+			switch (category) {
+			case LogCategory::App: return LOG_LEVEL_APP;
+			case LogCategory::SketchText: return LOG_LEVEL_SKETCHTEXT;
+			case LogCategory::Settings: return LOG_LEVEL_SETTINGS;
+			default: return LOG_LEVEL_GENERAL;
+			}
+		}
+	}
+}
+
+/// <summary>
+/// <para>LOG_AT logs a plain message or a std::format string with its arguments. The arguments are</para>
+/// <para>only evaluated and formatted if level and category are enabled, at compile time and at runtime.</para>
+/// </summary>
+#define LOG_AT(level, hasLocation, detail, ...) \
+    do { \
+        if constexpr (level >= ::implicatex::fusion::getCompiledLogLevel(LOG_CATEGORY)) { \
+            if (::implicatex::fusion::Logger::get().isEnabled(LOG_CATEGORY, level)) { \
+                ::implicatex::fusion::Logger::get().write(LOG_CATEGORY, level, __FILE__, __LINE__, __func__, hasLocation, detail, __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(::implicatex::fusion::LogLevel::Debug, false, nullptr, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(::implicatex::fusion::LogLevel::Info, false, nullptr, __VA_ARGS__)
+#define LOG_INFO_EX(...) LOG_AT(::implicatex::fusion::LogLevel::Info, true, nullptr, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_AT(::implicatex::fusion::LogLevel::Warning, true, nullptr, __VA_ARGS__)
 
 #ifndef LOG_ERROR
 /// <summary>
 /// <para>LOG_ERROR is a macro that logs an error message along with the last error details, </para>
 /// <para>the current function name, file name, and line number to a logging system.</para>
+/// <para>The last Fusion error is read on the calling thread, everything else is formatted later.</para>
 /// </summary>
 ///
-/// <param name="msg">The message.</param>
-#define LOG_ERROR(msg) \
-    std::string path = __FILE__; \
-    std::string fileName = path.substr(path.find_last_of("/\\") + 1); \
-    std::string errMsg; \
-    toolsApp->getLastError(&errMsg); \
-    toolsApp->log(std::string("[ERROR] ") + msg + " | " + errMsg + " | Function: " + __func__ + " | File: " + fileName + " | Line: " + std::to_string(__LINE__), ErrorLogLevel, LOG_TYPE)
+/// <param name="...">The message, or a std::format string followed by its arguments.</param>
+#define LOG_ERROR(...) \
+    LOG_AT(::implicatex::fusion::LogLevel::Error, true, \
+        [&]() { static thread_local std::string errMsg; toolsApp->getLastError(&errMsg); return errMsg.c_str(); }(), __VA_ARGS__)
 #endif
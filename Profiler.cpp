@@ -0,0 +1,156 @@
+#include "pch.h"
+#include "Profiler.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>getBucketIndex maps a value to its bucket. Values below SUB_BUCKET_COUNT * 2 get a bucket each,</para>
+		/// <para>larger values keep their SUB_BUCKET_BITS most significant bits.</para>
+		/// </summary>
+		///
+		/// <param name="value">The value.</param>
+		///
+		/// <returns>The bucket index.</returns>
+		size_t LatencyHistogram::getBucketIndex(uint64_t value) {
+			unsigned int width = (unsigned int)std::bit_width(value);
+			if (width <= SUB_BUCKET_BITS) {
+				return (size_t)value;
+			}
+			unsigned int shift = width - SUB_BUCKET_BITS;
+			return shift * SUB_BUCKET_COUNT + (size_t)(value >> shift);
+		}
+
+		/// <summary>Gets the smallest value that falls into a bucket.</summary>
+		///
+		/// <param name="index">The bucket index.</param>
+		///
+		/// <returns>The lower bound.</returns>
+		uint64_t LatencyHistogram::getBucketLowerBound(size_t index) {
+			if (index < 2 * SUB_BUCKET_COUNT) {
+				return (uint64_t)index;
+			}
+			size_t shift = index / SUB_BUCKET_COUNT - 1;
+			uint64_t mantissa = (uint64_t)(index - shift * SUB_BUCKET_COUNT);
+			return mantissa << shift;
+		}
+
+		/// <summary>Records one duration.</summary>
+		///
+		/// <param name="nanoseconds">The duration in nanoseconds.</param>
+		void LatencyHistogram::record(uint64_t nanoseconds) {
+			buckets_[getBucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+			count_.fetch_add(1, std::memory_order_relaxed);
+			total_.fetch_add(nanoseconds, std::memory_order_relaxed);
+			last_.store(nanoseconds, std::memory_order_relaxed);
+
+			uint64_t max = max_.load(std::memory_order_relaxed);
+			while (nanoseconds > max && !max_.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {
+			}
+		}
+
+		/// <summary>Clears all counts.</summary>
+		void LatencyHistogram::reset() {
+			for (auto& bucket : buckets_) {
+				bucket.store(0, std::memory_order_relaxed);
+			}
+			count_.store(0, std::memory_order_relaxed);
+			total_.store(0, std::memory_order_relaxed);
+			max_.store(0, std::memory_order_relaxed);
+			last_.store(0, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// <para>getPercentile returns the middle of the bucket holding the requested rank, capped at the maximum.</para>
+		/// <para>Records arriving meanwhile may shift the result by a bucket, which is fine for a report.</para>
+		/// </summary>
+		///
+		/// <param name="percentile">The percentile, 0 to 100.</param>
+		///
+		/// <returns>The duration in nanoseconds, 0 if nothing was recorded.</returns>
+		uint64_t LatencyHistogram::getPercentile(double percentile) const {
+			uint64_t count = getCount();
+			if (count == 0) {
+				return 0;
+			}
+
+			uint64_t rank = (uint64_t)std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * (double)count);
+			rank = (std::max)(rank, uint64_t(1));
+
+			uint64_t seen = 0;
+			for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+				seen += buckets_[i].load(std::memory_order_relaxed);
+				if (seen >= rank) {
+					uint64_t lower = getBucketLowerBound(i);
+					uint64_t upper = i + 1 < BUCKET_COUNT ? getBucketLowerBound(i + 1) : lower;
+					return (std::min)(lower + (upper - lower) / 2, getMax());
+				}
+			}
+			return getMax();
+		}
+
+		/// <summary>Gets the process wide profiler.</summary>
+		///
+		/// <returns>The profiler.</returns>
+		Profiler& Profiler::get() {
+			static Profiler profiler;
+			return profiler;
+		}
+
+		/// <summary>Clears the histograms of all spans.</summary>
+		void Profiler::reset() {
+			for (auto& histogram : histograms_) {
+				histogram.reset();
+			}
+		}
+
+		/// <summary>Gets the name of a span as shown in the report, the name of the timed function.</summary>
+		///
+		/// <param name="span">The span.</param>
+		///
+		/// <returns>The name.</returns>
+		const char* Profiler::getSpanName(ProfileSpan span) {
+			switch (span) {
+			case ProfileSpan::TextHeightMatchItems: return "getTextHeightMatchItems";
+			case ProfileSpan::TextHeightMatchTable: return "addTextHeightMatchTable";
+			case ProfileSpan::LocalizeText: return "localizeText";
+			case ProfileSpan::FocusCameraOnText: return "focusCameraOnText";
+			case ProfileSpan::HighlightGraphics: return "addHighlightGraphics";
+			case ProfileSpan::AlignModelToSketch: return "alignModelToSketchXYPlane";
+			case ProfileSpan::FillTextHeightMatchTable: return "fillTextHeightMatchTable";
+			case ProfileSpan::SuggestTextHeights: return "suggestTextHeights";
+			case ProfileSpan::PreviewTextHeight: return "previewTextHeight";
+			case ProfileSpan::PlanTextQuery: return "planTextQuery";
+			case ProfileSpan::ExecuteTextQuery: return "executeTextQuery";
+			default: return "unknown";
+			}
+		}
+
+		/// <summary>
+		/// <para>getReport prints one line per span with call count, p50, p99, maximum and total time</para>
+		/// <para>in milliseconds; spans that were never entered are listed with a count of zero.</para>
+		/// </summary>
+		///
+		/// <returns>The report.</returns>
+		std::string Profiler::getReport() const {
+			auto milliseconds = [](uint64_t nanoseconds) { return (double)nanoseconds / 1.0e6; };
+
+			std::string report;
+			char line[160];
+			std::snprintf(line, sizeof(line), "%-26s %8s %10s %10s %10s %12s\n", "Span", "Calls", "p50 ms", "p99 ms", "max ms", "total ms");
+			report.append(line);
+
+			for (size_t i = 0; i < (size_t)ProfileSpan::Count; ++i) {
+				const LatencyHistogram& histogram = histograms_[i];
+				std::snprintf(line, sizeof(line), "%-26s %8llu %10.3f %10.3f %10.3f %12.3f\n",
+					getSpanName((ProfileSpan)i),
+					(unsigned long long)histogram.getCount(),
+					milliseconds(histogram.getPercentile(50.0)),
+					milliseconds(histogram.getPercentile(99.0)),
+					milliseconds(histogram.getMax()),
+					milliseconds(histogram.getTotal()));
+				report.append(line);
+			}
+			return report;
+		}
+	}
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "TraceRecorder.h"
+#include "ApiCallCounter.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>The hot paths of the Sketch Text panel that are timed.</summary>
+		enum class ProfileSpan : uint8_t {
+			TextHeightMatchItems = 0,
+			TextHeightMatchTable = 1,
+			LocalizeText = 2,
+			FocusCameraOnText = 3,
+			HighlightGraphics = 4,
+			AlignModelToSketch = 5,
+			FillTextHeightMatchTable = 6,
+			SuggestTextHeights = 7,
+			PreviewTextHeight = 8,
+			PlanTextQuery = 9,
+			ExecuteTextQuery = 10,
+			Count = 11
+		};
+
+		/// <summary>Hits and misses of one add-in cache; only touched on the main thread.</summary>
+		struct CacheStats {
+			uint64_t hits = 0;
+			uint64_t misses = 0;
+
+			double getHitRate() const { return hits + misses > 0 ? (double)hits / (double)(hits + misses) : 0.0; }
+		};
+
+		/// <summary>
+		/// <para>LatencyHistogram counts durations in log linear buckets like an HDR histogram: each power of two</para>
+		/// <para>is split into SUB_BUCKET_COUNT buckets, which keeps the relative error of percentiles below 2%</para>
+		/// <para>from nanoseconds to hours. Recording is wait free and may happen on any thread.</para>
+		/// </summary>
+		class LatencyHistogram
+		{
+		public:
+			static constexpr unsigned int SUB_BUCKET_BITS = 6;
+			static constexpr size_t SUB_BUCKET_COUNT = size_t(1) << (SUB_BUCKET_BITS - 1);
+			static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT;
+
+			void record(uint64_t nanoseconds);
+			void reset();
+
+			uint64_t getPercentile(double percentile) const;
+
+			#pragma region Getters
+			uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+			uint64_t getTotal() const { return total_.load(std::memory_order_relaxed); }
+			uint64_t getMax() const { return max_.load(std::memory_order_relaxed); }
+			uint64_t getLast() const { return last_.load(std::memory_order_relaxed); }
+			#pragma endregion
+
+			static size_t getBucketIndex(uint64_t value);
+			static uint64_t getBucketLowerBound(size_t index);
+
+		private:
+			std::atomic<uint64_t> buckets_[BUCKET_COUNT] = {};
+			std::atomic<uint64_t> count_ = 0;
+			std::atomic<uint64_t> total_ = 0;
+			std::atomic<uint64_t> max_ = 0;
+			std::atomic<uint64_t> last_ = 0;
+		};
+
+		/// <summary>
+		/// <para>Profiler holds one latency histogram per span. Timing is on by default; two clock reads and</para>
+		/// <para>a few relaxed atomic adds per call are negligible against the Fusion API calls being timed.</para>
+		/// </summary>
+		class Profiler
+		{
+		public:
+			static Profiler& get();
+
+			Profiler(const Profiler&) = delete;
+			Profiler& operator=(const Profiler&) = delete;
+
+			void record(ProfileSpan span, uint64_t nanoseconds) { histograms_[(size_t)span].record(nanoseconds); }
+			void reset();
+			std::string getReport() const;
+
+			static const char* getSpanName(ProfileSpan span);
+
+			#pragma region Getters
+			bool isEnabled() const { return isEnabled_.load(std::memory_order_relaxed); }
+			const LatencyHistogram& getHistogram(ProfileSpan span) const { return histograms_[(size_t)span]; }
+			#pragma endregion
+
+			#pragma region Setters
+			void setEnabled(bool isEnabled) { isEnabled_.store(isEnabled, std::memory_order_relaxed); }
+			#pragma endregion
+
+		private:
+			Profiler() = default;
+
+			LatencyHistogram histograms_[(size_t)ProfileSpan::Count];
+			std::atomic<bool> isEnabled_ = true;
+		};
+
+		/// <summary>
+		/// <para>ScopedSpan records the time from its construction to its destruction under a span,</para>
+		/// <para>the span as "api" scope in the trace while the trace recorder runs, and its API calls.</para>
+		/// </summary>
+		class ScopedSpan
+		{
+		public:
+			explicit ScopedSpan(ProfileSpan span)
+				: span_(span), trace_(Profiler::getSpanName(span), "api"), operation_(Profiler::getSpanName(span)),
+				start_(Profiler::get().isEnabled() ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point()) {}
+
+			~ScopedSpan() {
+				if (start_ != std::chrono::steady_clock::time_point()) {
+					auto elapsed = std::chrono::steady_clock::now() - start_;
+					Profiler::get().record(span_, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+				}
+			}
+
+			ScopedSpan(const ScopedSpan&) = delete;
+			ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+		private:
+			ProfileSpan span_;
+			TraceScope trace_;
+			ApiOperation operation_;
+			std::chrono::steady_clock::time_point start_;
+		};
+	}
+}
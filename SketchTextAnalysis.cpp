@@ -0,0 +1,280 @@
+#include "pch.h"
+#include "resource.h"
+#include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::SketchText
+#include "Logging.h"
+#include "TraceRecorder.h"
+#include "ApiCallCounter.h"
+#include "Profiler.h"
+#include "ToolsApp.h"
+#include "ImplicateXFusionToolsAddIn.h"
+#include "SketchTextSettingsTab.h"
+#include "SketchTextDiagnosticsTab.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSnapshot.h"
+#include "SketchTextCache.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextSorter.h"
+#include "SketchTextReplacer.h"
+#include "SketchTextDuplicateFinder.h"
+#include "SketchTextHeightClusterer.h"
+#include "SketchTextFilter.h"
+#include "SketchTextQuery.h"
+#include "RefreshArena.h"
+#include "TableRowMaterializer.h"
+#include "SketchTextAnalysis.h"
+#include "SketchTextHeightTab.h"
+#include "SketchTextPanel.h"
+
+namespace implicatex {
+	namespace fusion {
+		#pragma region SketchTextAnalysis
+		/// <summary>Releases everything read and derived from the document, so that the next refresh starts over.</summary>
+		void SketchTextAnalysis::clear() {
+			sketchCache.clear();
+			snapshot = SketchTextSnapshot();
+			textIndex = SketchTextTrigramIndex();
+			rangeIndex = SketchTextRangeIndex();
+			textSorter = SketchTextSorter();
+			snapshotScope.clear();
+			duplicateFinder = SketchTextDuplicateFinder();
+			duplicatesScope.clear();
+			heightClusterer = SketchTextHeightClusterer();
+			heightClustersScope.clear();
+			heightSizes = std::vector<HeightCluster>();
+			filteredIds = std::vector<uint32_t>();
+			rowTexts = std::vector<Ptr<SketchText>>();
+			selectedText = nullptr;
+			selectedId = NO_RECORD;
+			checkedIds = std::vector<uint8_t>();
+			memoryUsage = 0;
+		}
+
+		/// <summary>Estimates the heap memory held by the analysis, counting capacities rather than sizes.</summary>
+		///
+		/// <returns>The memory in bytes.</returns>
+		size_t SketchTextAnalysis::getMemoryUsage() const {
+			return sizeof(*this)
+				+ sketchCache.getMemoryUsage()
+				+ snapshot.getMemoryUsage()
+				+ textIndex.getMemoryUsage()
+				+ rangeIndex.getMemoryUsage()
+				+ textSorter.getMemoryUsage()
+				+ duplicateFinder.getMemoryUsage()
+				+ heightClusterer.getMemoryUsage()
+				+ heightSizes.capacity() * sizeof(HeightCluster)
+				+ filteredIds.capacity() * sizeof(uint32_t)
+				+ rowTexts.capacity() * sizeof(Ptr<SketchText>)
+				+ checkedIds.capacity();
+		}
+		#pragma endregion
+
+		#pragma region SketchTextAnalysisStore
+		SketchTextAnalysisStore::~SketchTextAnalysisStore() {
+			unsubscribe();
+		}
+
+		/// <summary>Adds the handlers of the command terminated and document events.</summary>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextAnalysisStore::subscribe() {
+			unsubscribe();
+			Ptr<UserInterface> ui = toolsApp->userInterface();
+			if (!ui) {
+				return false;
+			}
+			commandTerminatedHandler_ = std::make_unique<SketchTextCommandTerminatedEventHandler>();
+			documentActivatedHandler_ = std::make_unique<SketchTextDocumentActivatedEventHandler>();
+			documentClosedHandler_ = std::make_unique<SketchTextDocumentClosedEventHandler>();
+			if (!ui->commandTerminated()->add(commandTerminatedHandler_.get()) ||
+				!toolsApp->documentActivated()->add(documentActivatedHandler_.get()) ||
+				!toolsApp->documentClosed()->add(documentClosedHandler_.get())) {
+				LOG_ERROR("Failed to add the sketch text analysis event handlers");
+				unsubscribe();
+				return false;
+			}
+			return true;
+		}
+
+		/// <summary>Removes the event handlers, e.g. before the add-in stops.</summary>
+		void SketchTextAnalysisStore::unsubscribe() {
+			if (!toolsApp) {
+				return;
+			}
+			if (commandTerminatedHandler_) {
+				Ptr<UserInterface> ui = toolsApp->userInterface();
+				if (ui) {
+					ui->commandTerminated()->remove(commandTerminatedHandler_.get());
+				}
+				commandTerminatedHandler_.reset();
+			}
+			if (documentActivatedHandler_) {
+				toolsApp->documentActivated()->remove(documentActivatedHandler_.get());
+				documentActivatedHandler_.reset();
+			}
+			if (documentClosedHandler_) {
+				toolsApp->documentClosed()->remove(documentClosedHandler_.get());
+				documentClosedHandler_.reset();
+			}
+		}
+
+		/// <summary>
+		/// <para>activate makes the analysis of a document the current one: a kept analysis moves to the front,</para>
+		/// <para>otherwise an empty one is created. The analysis it replaces is measured for the memory budget.</para>
+		/// </summary>
+		///
+		/// <param name="documentId">  The creation id of the document.</param>
+		/// <param name="documentName">The name of the document, for the log.</param>
+		///
+		/// <returns>The analysis of the document.</returns>
+		std::shared_ptr<SketchTextAnalysis> SketchTextAnalysisStore::activate(const std::string& documentId, const std::string& documentName) {
+			if (!documents_.empty() && documents_.front()->documentId == documentId) {
+				return documents_.front();
+			}
+			if (!documents_.empty()) {
+				documents_.front()->memoryUsage = documents_.front()->getMemoryUsage();
+			}
+
+			auto it = index_.find(documentId);
+			if (it != index_.end()) {
+				++stats_.hits;
+				documents_.splice(documents_.begin(), documents_, it->second);
+				LOG_INFO("Restored the sketch text analysis of {}", documentName);
+			}
+			else {
+				++stats_.misses;
+				auto analysis = std::make_shared<SketchTextAnalysis>();
+				analysis->documentId = documentId;
+				documents_.push_front(analysis);
+				index_[documentId] = documents_.begin();
+			}
+			documents_.front()->documentName = documentName;
+			trim();
+			return documents_.front();
+		}
+
+		/// <summary>
+		/// <para>getCurrent returns the analysis of the active document. The document events keep it up to date;</para>
+		/// <para>only before the first of them, e.g. when the add-in starts with a document open, the document is asked.</para>
+		/// </summary>
+		///
+		/// <returns>The analysis of the active document.</returns>
+		std::shared_ptr<SketchTextAnalysis> SketchTextAnalysisStore::getCurrent() {
+			if (!documents_.empty()) {
+				return documents_.front();
+			}
+			Ptr<Document> document = toolsApp->activeDocument();
+			return activate(document ? document->creationId() : "", document ? document->name() : "");
+		}
+
+		/// <summary>Drops the analysis of a closed document.</summary>
+		///
+		/// <param name="documentId">The creation id of the document.</param>
+		void SketchTextAnalysisStore::remove(const std::string& documentId) {
+			auto it = index_.find(documentId);
+			if (it == index_.end()) {
+				return;
+			}
+			documents_.erase(it->second);
+			index_.erase(it);
+		}
+
+		/// <summary>Drops the analyses of all documents but the current one, and clears that.</summary>
+		void SketchTextAnalysisStore::clear() {
+			while (documents_.size() > 1) {
+				index_.erase(documents_.back()->documentId);
+				documents_.pop_back();
+			}
+			if (!documents_.empty()) {
+				documents_.front()->clear();
+			}
+		}
+
+		/// <summary>Resets the counters of the store and of the sketch caches and sort keys of its analyses.</summary>
+		void SketchTextAnalysisStore::resetStatistics() {
+			stats_ = CacheStats();
+			evictionCount_ = 0;
+			for (const auto& analysis : documents_) {
+				analysis->sketchCache.resetStatistics();
+				analysis->textSorter.resetKeyCounts();
+			}
+		}
+
+		/// <summary>
+		/// <para>Estimates the heap memory held by all analyses: the current one is measured, the others as they</para>
+		/// <para>were measured when their document was left, since they do not change while it is inactive.</para>
+		/// </summary>
+		///
+		/// <returns>The memory in bytes.</returns>
+		size_t SketchTextAnalysisStore::getMemoryUsage() const {
+			size_t bytes = index_.bucket_count() * sizeof(void*);
+			for (auto it = documents_.begin(); it != documents_.end(); ++it) {
+				bytes += it == documents_.begin() ? (*it)->getMemoryUsage() : (*it)->memoryUsage;
+				bytes += (*it)->documentId.capacity() + (*it)->documentName.capacity();
+			}
+			return bytes;
+		}
+
+		/// <summary>
+		/// <para>trim evicts the least recently used analyses until at most MAX_DOCUMENTS are kept and they fit into</para>
+		/// <para>MAX_MEMORY. The current analysis stays, even if it alone exceeds the budget.</para>
+		/// </summary>
+		void SketchTextAnalysisStore::trim() {
+			if (documents_.size() <= 1) {
+				return;
+			}
+			size_t bytes = getMemoryUsage();
+			while (documents_.size() > 1 && (documents_.size() > MAX_DOCUMENTS || bytes > MAX_MEMORY)) {
+				const std::shared_ptr<SketchTextAnalysis>& analysis = documents_.back();
+				LOG_INFO("Evicting the sketch text analysis of {} ({} bytes)", analysis->documentName, analysis->memoryUsage);
+				bytes -= (std::min)(bytes, analysis->memoryUsage);
+				++evictionCount_;
+				index_.erase(analysis->documentId);
+				documents_.pop_back();
+			}
+		}
+		#pragma endregion
+
+		#pragma region DocumentEvent
+		/// <summary>
+		/// <para>Marks the cached sketches of the active document as unchecked when a command other than the panel ends;</para>
+		/// <para>the panel invalidates the sketches it changes itself.</para>
+		/// </summary>
+		///
+		/// <param name="eventArgs">The application command event arguments.</param>
+		void SketchTextCommandTerminatedEventHandler::notify(const Ptr<ApplicationCommandEventArgs>& eventArgs) {
+			if (!toolsApp->sketchTextAnalyses || !eventArgs || eventArgs->commandId() == IDS_CMD_SKETCH_TEXT_DEFINITIONS) {
+				return;
+			}
+			toolsApp->sketchTextAnalyses->getCurrent()->sketchCache.markChanged();
+		}
+
+		/// <summary>
+		/// <para>Makes the analysis of the activated document the current one. Its sketches could only change while</para>
+		/// <para>it was active, so a kept analysis is used as it was left.</para>
+		/// </summary>
+		///
+		/// <param name="eventArgs">The document event arguments.</param>
+		void SketchTextDocumentActivatedEventHandler::notify(const Ptr<DocumentEventArgs>& eventArgs) {
+			Ptr<Document> document = eventArgs ? eventArgs->document() : nullptr;
+			if (!toolsApp->sketchTextAnalyses || !document) {
+				return;
+			}
+			toolsApp->sketchTextAnalyses->activate(document->creationId(), document->name());
+		}
+
+		/// <summary>Drops the analysis of the closed document, whose entity tokens are of no use anymore.</summary>
+		///
+		/// <param name="eventArgs">The document event arguments.</param>
+		void SketchTextDocumentClosedEventHandler::notify(const Ptr<DocumentEventArgs>& eventArgs) {
+			Ptr<Document> document = eventArgs ? eventArgs->document() : nullptr;
+			if (!toolsApp->sketchTextAnalyses || !document) {
+				return;
+			}
+			LOG_INFO("Document {} closed, dropping its sketch text analysis", document->name());
+			toolsApp->sketchTextAnalyses->remove(document->creationId());
+		}
+		#pragma endregion
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+using namespace adsk::core;
+using namespace adsk::fusion;
+using namespace adsk::cam;
+
+namespace implicatex {
+	namespace fusion {
+		#pragma region DocumentEvent
+		/// <summary>
+		/// <para>SketchTextCommandTerminatedEventHandler tells the analysis of the active document that a command ended,</para>
+		/// <para>which may have changed any of its sketches.</para>
+		/// </summary>
+		class SketchTextCommandTerminatedEventHandler : public ApplicationCommandEventHandler {
+		public:
+			void notify(const Ptr<ApplicationCommandEventArgs>& eventArgs) override;
+		};
+
+		/// <summary>SketchTextDocumentActivatedEventHandler makes the analysis of the activated document the current one.</summary>
+		class SketchTextDocumentActivatedEventHandler : public DocumentEventHandler {
+		public:
+			void notify(const Ptr<DocumentEventArgs>& eventArgs) override;
+		};
+
+		/// <summary>SketchTextDocumentClosedEventHandler releases the analysis of a closed document.</summary>
+		class SketchTextDocumentClosedEventHandler : public DocumentEventHandler {
+		public:
+			void notify(const Ptr<DocumentEventArgs>& eventArgs) override;
+		};
+		#pragma endregion
+
+		/// <summary>
+		/// <para>SketchTextAnalysis is everything the panel knows about the texts of one document: the cached sketches,</para>
+		/// <para>the snapshot of the current scope with its indexes, sort keys, duplicate groups and size clusters,</para>
+		/// <para>and the filter result shown in the table.</para>
+		/// </summary>
+		struct SketchTextAnalysis {
+			static constexpr uint32_t NO_RECORD = 0xFFFFFFFF;
+
+			std::string documentId;
+			std::string documentName;
+			SketchTextCache sketchCache;
+			SketchTextSnapshot snapshot;
+			SketchTextTrigramIndex textIndex;
+			SketchTextRangeIndex rangeIndex;
+			SketchTextSorter textSorter;
+			std::string snapshotScope;
+			uint64_t snapshotGeneration = 0;
+			SketchTextDuplicateFinder duplicateFinder;
+			std::string duplicatesScope;
+			SketchTextHeightClusterer heightClusterer;
+			std::string heightClustersScope;
+			std::vector<HeightCluster> heightSizes;
+			std::vector<uint32_t> filteredIds;
+			std::vector<Ptr<SketchText>> rowTexts; // The text of each table row, row 1 first
+			Ptr<SketchText> selectedText;
+			uint32_t selectedId = NO_RECORD; // The record of the selected text
+			std::vector<uint8_t> checkedIds; // One flag per record, set by the toggle column of the table
+			size_t memoryUsage = 0; // Measured when the document was last left
+
+			void clear();
+			size_t getMemoryUsage() const;
+		};
+
+		/// <summary>
+		/// <para>SketchTextAnalysisStore keeps the analyses of the most recently used documents, so that switching back to</para>
+		/// <para>a document finds its indexes and results as they were. Least recently used documents are evicted once more</para>
+		/// <para>than MAX_DOCUMENTS are kept or their memory exceeds MAX_MEMORY; the current document is never evicted.</para>
+		/// </summary>
+		class SketchTextAnalysisStore
+		{
+		public:
+			static constexpr size_t MAX_DOCUMENTS = 8;
+			static constexpr size_t MAX_MEMORY = 256 * 1024 * 1024;
+
+			~SketchTextAnalysisStore();
+
+			bool subscribe();
+			void unsubscribe();
+			std::shared_ptr<SketchTextAnalysis> activate(const std::string& documentId, const std::string& documentName);
+			std::shared_ptr<SketchTextAnalysis> getCurrent();
+			void remove(const std::string& documentId);
+			void clear();
+			void resetStatistics();
+			void trim();
+			size_t getMemoryUsage() const;
+
+			#pragma region Getters
+			size_t getDocumentCount() const { return documents_.size(); }
+			const CacheStats& getStats() const { return stats_; }
+			uint64_t getEvictionCount() const { return evictionCount_; }
+			#pragma endregion
+
+		private:
+			// Most recently used first; the front is the analysis of the active document
+			std::list<std::shared_ptr<SketchTextAnalysis>> documents_;
+			std::unordered_map<std::string, std::list<std::shared_ptr<SketchTextAnalysis>>::iterator> index_;
+			CacheStats stats_;
+			uint64_t evictionCount_ = 0;
+			std::unique_ptr<SketchTextCommandTerminatedEventHandler> commandTerminatedHandler_;
+			std::unique_ptr<SketchTextDocumentActivatedEventHandler> documentActivatedHandler_;
+			std::unique_ptr<SketchTextDocumentClosedEventHandler> documentClosedHandler_;
+		};
+	}
+}
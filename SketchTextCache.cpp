@@ -0,0 +1,212 @@
+#include "pch.h"
+#include "resource.h"
+#include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::SketchText
+#include "Logging.h"
+#include "TraceRecorder.h"
+#include "ApiCallCounter.h"
+#include "Profiler.h"
+#include "ToolsApp.h"
+#include "ImplicateXFusionToolsAddIn.h"
+#include "SketchTextRecord.h"
+#include "SketchTextCache.h"
+
+namespace implicatex {
+	namespace fusion {
+		namespace {
+			/// <summary>
+			/// <para>Gets the corner or edge middle of the bounding box that the alignment of a text keeps in place,</para>
+			/// <para>as Fusion lays out the text rectangle from that point.</para>
+			/// </summary>
+			Point3 getAlignmentAnchor(const Box3& bounds, HorizontalAlignments horizontal, VerticalAlignments vertical) {
+				double x = horizontal == LeftHorizontalAlignment ? 0.0 : horizontal == CenterHorizontalAlignment ? 0.5 : 1.0;
+				double y = vertical == BottomVerticalAlignment ? 0.0 : vertical == MiddleVerticalAlignment ? 0.5 : 1.0;
+				return Point3{
+					bounds.minPoint.x + (bounds.maxPoint.x - bounds.minPoint.x) * x,
+					bounds.minPoint.y + (bounds.maxPoint.y - bounds.minPoint.y) * y,
+					bounds.minPoint.z
+				};
+			}
+		}
+
+		/// <summary>
+		/// <para>update gets the cached texts of the given sketches. Entries checked since the last command are</para>
+		/// <para>used as they are; older ones are compared by revision id and only changed or new sketches are read.</para>
+		/// </summary>
+		///
+		/// <param name="sketches">   The sketches.</param>
+		/// <param name="entries">	  [out] The cached texts, one per valid sketch in the order of sketches.</param>
+		/// <param name="rescanCount">[out] The number of sketches read from the model.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextCache::update(const std::vector<Ptr<Sketch>>& sketches, std::vector<const CachedSketchTexts*>& entries, size_t& rescanCount) {
+			ApiOperation operation("captureSnapshot");
+			entries.clear();
+			entries.reserve(sketches.size());
+			rescanCount = 0;
+
+			for (const auto& sketch : sketches) {
+				if (!sketch) continue;
+
+				auto [it, isNew] = sketches_.try_emplace(sketch->entityToken());
+				CachedSketchTexts& entry = it->second;
+				if (!isNew && entry.generation == generation_) {
+					++stats_.hits;
+					entries.push_back(&entry);
+					continue;
+				}
+
+				std::string revisionId = sketch->revisionId();
+				if (!isNew && revisionId == entry.revisionId) {
+					++stats_.hits;
+					entry.generation = generation_;
+					entries.push_back(&entry);
+					continue;
+				}
+
+				++stats_.misses;
+				++rescanCount;
+				entry.revisionId = revisionId;
+				memoryUsage_ -= entry.memoryUsage;
+				entry.memoryUsage = 0;
+				if (!captureSketch(sketch, entry)) {
+					LOG_ERROR("Failed to capture the texts of sketch {}", entry.name);
+					sketches_.erase(it);
+					return false;
+				}
+				entry.memoryUsage = measure(it->first, entry);
+				memoryUsage_ += entry.memoryUsage;
+				entry.generation = generation_;
+				entries.push_back(&entry);
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// <para>prune drops the entries of sketches that were deleted. It must follow an update with all sketches</para>
+		/// <para>of the design: entries that update did not touch were last seen before the latest command, so</para>
+		/// <para>their sketch is no longer in the design.</para>
+		/// </summary>
+		///
+		/// <returns>The number of dropped entries.</returns>
+		size_t SketchTextCache::prune() {
+			size_t count = 0;
+			for (auto it = sketches_.begin(); it != sketches_.end();) {
+				if (it->second.generation == generation_) {
+					++it;
+					continue;
+				}
+				memoryUsage_ -= it->second.memoryUsage;
+				it = sketches_.erase(it);
+				++count;
+			}
+			return count;
+		}
+
+		/// <summary>Drops the entry of a sketch the add-in changed, so that the next update reads it again.</summary>
+		///
+		/// <param name="sketch">The sketch.</param>
+		void SketchTextCache::invalidate(const Ptr<Sketch>& sketch) {
+			if (!sketch) {
+				return;
+			}
+			auto it = sketches_.find(sketch->entityToken());
+			if (it != sketches_.end()) {
+				memoryUsage_ -= it->second.memoryUsage;
+				sketches_.erase(it);
+			}
+			++generation_;
+		}
+
+		/// <summary>Drops all entries.</summary>
+		void SketchTextCache::clear() {
+			sketches_.clear();
+			memoryUsage_ = 0;
+			++generation_;
+		}
+
+		/// <summary>Estimates the heap memory held by the cached texts from the sizes measured when they were captured.</summary>
+		///
+		/// <returns>The memory in bytes.</returns>
+		size_t SketchTextCache::getMemoryUsage() const {
+			return sketches_.bucket_count() * sizeof(void*) + memoryUsage_;
+		}
+
+		/// <summary>Measures the heap memory held by one entry, counting capacities rather than sizes.</summary>
+		///
+		/// <param name="entityToken">The key of the entry.</param>
+		/// <param name="entry">	  The entry.</param>
+		///
+		/// <returns>The memory in bytes.</returns>
+		size_t SketchTextCache::measure(const std::string& entityToken, const CachedSketchTexts& entry) {
+			size_t bytes = sizeof(entry) + entityToken.capacity() + entry.name.capacity() + entry.revisionId.capacity()
+				+ entry.records.capacity() * sizeof(SketchTextRecord)
+				+ entry.entities.capacity() * sizeof(Ptr<SketchText>);
+			for (const auto& record : entry.records) {
+				bytes += record.text.capacity();
+			}
+			return bytes;
+		}
+
+		/// <summary>
+		/// <para>captureSketch reads text, height, bounding box and anchor of every text of a sketch into the entry.</para>
+		/// <para>A text without a bounding box is kept with empty bounds, which position filters never match.</para>
+		/// </summary>
+		///
+		/// <param name="sketch">The sketch.</param>
+		/// <param name="entry"> [in,out] The entry to fill.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextCache::captureSketch(const Ptr<Sketch>& sketch, CachedSketchTexts& entry) {
+			TraceScope trace("captureSketch", "api");
+			entry.sketch = sketch;
+			entry.name = sketch->name();
+			entry.records.clear();
+			entry.entities.clear();
+
+			Ptr<SketchTexts> sketchTexts = sketch->sketchTexts();
+			if (!sketchTexts) {
+				LOG_ERROR("No SketchTexts found in the sketch.");
+				return false;
+			}
+
+			size_t count = sketchTexts->count();
+			entry.records.reserve(count);
+			entry.entities.reserve(count);
+
+			size_t unboundedCount = 0;
+			for (size_t i = 0; i < count; ++i) {
+				Ptr<SketchText> text = sketchTexts->item(i);
+				if (!text) continue;
+
+				SketchTextRecord record;
+				record.text = text->text();
+				record.height = text->height();
+
+				Ptr<BoundingBox3D> boundingBox = text->boundingBox();
+				Ptr<Point3D> minPoint = boundingBox ? boundingBox->minPoint() : nullptr;
+				Ptr<Point3D> maxPoint = boundingBox ? boundingBox->maxPoint() : nullptr;
+				if (minPoint && maxPoint) {
+					record.bounds = Box3::of(
+						Point3{ minPoint->x(), minPoint->y(), minPoint->z() },
+						Point3{ maxPoint->x(), maxPoint->y(), maxPoint->z() });
+				}
+				else {
+					++unboundedCount;
+				}
+
+				Ptr<MultiLineTextDefinition> definition = text->definition();
+				if (definition && record.bounds.isValid()) {
+					record.anchor = getAlignmentAnchor(record.bounds, definition->horizontalAlignment(), definition->verticalAlignment());
+				}
+
+				entry.records.push_back(std::move(record));
+				entry.entities.push_back(text);
+			}
+			if (unboundedCount > 0) {
+				LOG_WARNING("{} texts of sketch {} have no bounding box", unboundedCount, entry.name);
+			}
+			return true;
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+using namespace adsk::core;
+using namespace adsk::fusion;
+using namespace adsk::cam;
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>The texts of one sketch as last read from the model, with the revision they were read at.</summary>
+		struct CachedSketchTexts {
+			Ptr<Sketch> sketch;
+			std::string name;
+			std::string revisionId;
+			uint64_t generation = 0;
+			std::vector<SketchTextRecord> records;
+			std::vector<Ptr<SketchText>> entities;
+			size_t memoryUsage = 0; // Measured when captured
+		};
+
+		/// <summary>
+		/// <para>SketchTextCache keeps the captured texts of every sketch the panel has read, keyed by entity token,</para>
+		/// <para>across panel sessions. Entries are trusted until a command terminates; then each sketch is checked</para>
+		/// <para>once against its revision id and only sketches whose revision changed are read again.</para>
+		/// <para>Entries of deleted sketches are dropped by prune after an update of all sketches of the design.</para>
+		/// </summary>
+		class SketchTextCache
+		{
+		public:
+			bool update(const std::vector<Ptr<Sketch>>& sketches, std::vector<const CachedSketchTexts*>& entries, size_t& rescanCount);
+			size_t prune();
+			void invalidate(const Ptr<Sketch>& sketch);
+			void markChanged() { ++generation_; }
+			void clear();
+			void resetStatistics() { stats_ = CacheStats(); }
+			size_t getMemoryUsage() const;
+
+			#pragma region Getters
+			uint64_t getGeneration() const { return generation_; }
+			size_t getSketchCount() const { return sketches_.size(); }
+			const CacheStats& getStats() const { return stats_; }
+			#pragma endregion
+
+		private:
+			static bool captureSketch(const Ptr<Sketch>& sketch, CachedSketchTexts& entry);
+			static size_t measure(const std::string& entityToken, const CachedSketchTexts& entry);
+
+			std::unordered_map<std::string, CachedSketchTexts> sketches_;
+			size_t memoryUsage_ = 0; // Of all entries, kept up to date as they are captured and dropped
+			uint64_t generation_ = 1;
+			CacheStats stats_;
+		};
+	}
+}
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "resource.h"
 #include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::SketchText
 #include "Logging.h"
 #include "ToolsBar.h"
 #include "ToolsApp.h"
@@ -0,0 +1,249 @@
+#include "pch.h"
+#include "resource.h"
+#include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::SketchText
+#include "Logging.h"
+#include "Profiler.h"
+#include "ToolsBar.h"
+#include "ToolsApp.h"
+#include "ImplicateXFusionToolsAddIn.h"
+#include "SketchTextCommandControl.h"
+#include "SketchTextSettingsTab.h"
+#include "SketchTextDiagnosticsTab.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSnapshot.h"
+#include "SketchTextCache.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextSorter.h"
+#include "SketchTextReplacer.h"
+#include "SketchTextDuplicateFinder.h"
+#include "SketchTextHeightClusterer.h"
+#include "SketchTextExporter.h"
+#include "SketchTextFilter.h"
+#include "SketchTextQuery.h"
+#include "RefreshArena.h"
+#include "TableRowMaterializer.h"
+#include "SketchTextAnalysis.h"
+#include "SketchTextHeightTab.h"
+#include "SketchTextPanel.h"
+
+namespace implicatex {
+	namespace fusion {
+		namespace {
+			std::string formatMilliseconds(uint64_t nanoseconds) {
+				char text[32];
+				std::snprintf(text, sizeof(text), "%.3f ms", (double)nanoseconds / 1.0e6);
+				return text;
+			}
+
+			std::string formatHitRate(const char* name, uint64_t hits, uint64_t misses) {
+				char text[64];
+				if (hits + misses == 0) {
+					std::snprintf(text, sizeof(text), "%s -", name);
+				}
+				else {
+					std::snprintf(text, sizeof(text), "%s %.0f%%", name, 100.0 * (double)hits / (double)(hits + misses));
+				}
+				return text;
+			}
+		}
+
+		/// <summary>Adds the read-only figures and the buttons of the diagnostics tab.</summary>
+		///
+		/// <param name="command"> The command.</param>
+		/// <param name="tabInput">The tab input.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextDiagnosticsTab::initialize(Ptr<Command> command, const Ptr<TabCommandInput>& tabInput) {
+			if (!tabInput) {
+				LOG_ERROR("Invalid tab input");
+				return false;
+			}
+			Ptr<CommandInputs> tabInputs = tabInput->children();
+			if (!tabInputs) {
+				LOG_ERROR("Invalid tab inputs");
+				return false;
+			}
+
+			if (!addTextBox(tabInputs, IDS_ITEM_DIAG_FILTER_TIME, IDS_LABEL_DIAG_FILTER_TIME, 1) ||
+				!addTextBox(tabInputs, IDS_ITEM_DIAG_TABLE_TIME, IDS_LABEL_DIAG_TABLE_TIME, 1) ||
+				!addTextBox(tabInputs, IDS_ITEM_DIAG_ROWS, IDS_LABEL_DIAG_ROWS, 1) ||
+				!addTextBox(tabInputs, IDS_ITEM_DIAG_CACHE_HITS, IDS_LABEL_DIAG_CACHE_HITS, 1) ||
+				!addTextBox(tabInputs, IDS_ITEM_DIAG_MEMORY, IDS_LABEL_DIAG_MEMORY, 1)) {
+				return false;
+			}
+			// Only the headless host reports API calls, in Fusion the box would show zeros
+			if (ApiCallCounter::get().isEnabled() &&
+				!addTextBox(tabInputs, IDS_ITEM_DIAG_API_CALLS, IDS_LABEL_DIAG_API_CALLS, (int)API_OPERATION_ROWS)) {
+				return false;
+			}
+
+			if (!addButton(tabInputs, IDS_ITEM_DIAG_CLEAR_CACHES, IDS_LABEL_DIAG_CLEAR_CACHES) ||
+				!addButton(tabInputs, IDS_ITEM_DIAG_RESET_COUNTERS, IDS_LABEL_DIAG_RESET_COUNTERS) ||
+				!addButton(tabInputs, IDS_ITEM_DIAG_REFRESH, IDS_LABEL_DIAG_REFRESH)) {
+				return false;
+			}
+
+			command->inputChanged()->add(new SketchTextDiagnosticsTabInputChangedEventHandler());
+
+			return update(tabInputs);
+		}
+
+		bool SketchTextDiagnosticsTab::addTextBox(const Ptr<CommandInputs>& tabInputs, const char* id, UINT labelId, int rows) {
+			Ptr<TextBoxCommandInput> textBox =
+				tabInputs->addTextBoxCommandInput(id, LoadStringFromResource(labelId), "", rows, true);
+			if (!textBox) {
+				LOG_ERROR("Failed to add diagnostics text box {}", id);
+				return false;
+			}
+			return true;
+		}
+
+		bool SketchTextDiagnosticsTab::addButton(const Ptr<CommandInputs>& tabInputs, const char* id, UINT labelId) {
+			std::string buttonLabel = LoadStringFromResource(labelId);
+			Ptr<BoolValueCommandInput> button = tabInputs->addBoolValueInput(id, buttonLabel, false);
+			if (!button) {
+				LOG_ERROR("Failed to add diagnostics button {}", id);
+				return false;
+			}
+			button->tooltip(buttonLabel);
+			button->text(" " + buttonLabel);
+			button->resourceFolder(IDS_PATH_ICON_SKETCH_TEXT_SETTINGS);
+			return true;
+		}
+
+		/// <summary>
+		/// <para>update writes the current figures into the text boxes. The API calls box, shown only when API calls</para>
+		/// <para>are counted, lists the operations with the most calls on average, each with its last and average count.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The command inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextDiagnosticsTab::update(const Ptr<CommandInputs>& inputs) {
+			Ptr<TextBoxCommandInput> filterTime = inputs->itemById(IDS_ITEM_DIAG_FILTER_TIME);
+			Ptr<TextBoxCommandInput> tableTime = inputs->itemById(IDS_ITEM_DIAG_TABLE_TIME);
+			Ptr<TextBoxCommandInput> rows = inputs->itemById(IDS_ITEM_DIAG_ROWS);
+			Ptr<TextBoxCommandInput> cacheHits = inputs->itemById(IDS_ITEM_DIAG_CACHE_HITS);
+			Ptr<TextBoxCommandInput> memory = inputs->itemById(IDS_ITEM_DIAG_MEMORY);
+			Ptr<TextBoxCommandInput> apiCalls = inputs->itemById(IDS_ITEM_DIAG_API_CALLS);
+			if (!filterTime || !tableTime || !rows || !cacheHits || !memory) {
+				LOG_ERROR("Diagnostics inputs not found");
+				return false;
+			}
+
+			const Profiler& profiler = Profiler::get();
+			filterTime->text(formatMilliseconds(profiler.getHistogram(ProfileSpan::TextHeightMatchItems).getLast()));
+			tableTime->text(formatMilliseconds(profiler.getHistogram(ProfileSpan::FillTextHeightMatchTable).getLast()));
+
+			std::shared_ptr<SketchTextHeightTab> heightTab = toolsApp->sketchTextPanel->getTextHeightTab();
+			if (heightTab) {
+				rows->text(std::format("{} ({})", heightTab->getLastRowCount(), heightTab->getTotalRowCount()));
+
+				const CacheStats& snapshotStats = heightTab->getSnapshotCacheStats();
+				const CacheStats& duplicatesStats = heightTab->getDuplicatesCacheStats();
+				const SketchTextSorter& sorter = heightTab->getTextSorter();
+				const SketchTextQueryCache& queryCache = heightTab->getQueryCache();
+				const CacheStats& sketchStats = heightTab->getAnalysis().sketchCache.getStats();
+				const SketchTextAnalysisStore* analyses = toolsApp->sketchTextAnalyses.get();
+				const CacheStats documentStats = analyses ? analyses->getStats() : CacheStats();
+				cacheHits->text(
+					formatHitRate("Documents", documentStats.hits, documentStats.misses) + ", " +
+					formatHitRate("Snapshot", snapshotStats.hits, snapshotStats.misses) + ", " +
+					formatHitRate("Sketches", sketchStats.hits, sketchStats.misses) + ", " +
+					formatHitRate("Duplicates", duplicatesStats.hits, duplicatesStats.misses) + ", " +
+					formatHitRate("Sort keys", sorter.getKeyHitCount(), sorter.getKeyMissCount()) + ", " +
+					formatHitRate("Queries", queryCache.getParseHitCount(), queryCache.getParseCount()) + ", " +
+					formatHitRate("Plans", queryCache.getPlanHitCount(), queryCache.getPlanCount()));
+
+				char text[64];
+				std::snprintf(text, sizeof(text), "%.1f KB, %zu documents", (double)heightTab->getCacheMemoryUsage() / 1024.0,
+					analyses ? analyses->getDocumentCount() : (size_t)1);
+				memory->text(text);
+			}
+
+			if (!apiCalls) {
+				return true;
+			}
+			auto operations = ApiCallCounter::get().getAllStats();
+			std::sort(operations.begin(), operations.end(), [](const auto& a, const auto& b) {
+				return a.second.totalCalls * b.second.invocations > b.second.totalCalls * a.second.invocations;
+			});
+			std::string apiText;
+			for (size_t i = 0; i < operations.size() && i < API_OPERATION_ROWS; ++i) {
+				const auto& [operation, stats] = operations[i];
+				char line[96];
+				std::snprintf(line, sizeof(line), "%s: %llu / %.1f\n", operation.c_str(),
+					(unsigned long long)stats.lastCalls,
+					stats.invocations > 0 ? (double)stats.totalCalls / (double)stats.invocations : 0.0);
+				apiText.append(line);
+			}
+			apiCalls->text(apiText);
+
+			return true;
+		}
+
+		/// <summary>Clears the caches of the height tab and refills its table from the model.</summary>
+		///
+		/// <param name="inputs">The command inputs.</param>
+		void SketchTextDiagnosticsTab::clearCaches(const Ptr<CommandInputs>& inputs) {
+			std::shared_ptr<SketchTextHeightTab> heightTab = toolsApp->sketchTextPanel->getTextHeightTab();
+			if (!heightTab) {
+				return;
+			}
+			heightTab->clearCaches();
+			if (!heightTab->refreshTextHeightMatches(inputs)) {
+				LOG_ERROR("Failed to refresh text height matches");
+			}
+		}
+
+		/// <summary>Resets timings, API call counts and the cache counters of the height tab.</summary>
+		void SketchTextDiagnosticsTab::resetCounters() {
+			Profiler::get().reset();
+			ApiCallCounter::get().reset();
+			std::shared_ptr<SketchTextHeightTab> heightTab = toolsApp->sketchTextPanel->getTextHeightTab();
+			if (heightTab) {
+				heightTab->resetStatistics();
+			}
+		}
+
+		/// <summary>
+		/// <para>The notify method updates the figures only when the diagnostics tab is activated or one of its buttons</para>
+		/// <para>is clicked. Input changes of the other tabs return before any API call, so that the figures cost</para>
+		/// <para>nothing while they are not shown; the Refresh button brings them up to date on demand.</para>
+		/// </summary>
+		///
+		/// <param name="eventArgs">The input changed event arguments.</param>
+		void SketchTextDiagnosticsTabInputChangedEventHandler::notify(const Ptr<InputChangedEventArgs>& eventArgs) {
+			Ptr<CommandInput> input = eventArgs->input();
+			if (!input) {
+				return;
+			}
+			std::string inputId = input->id();
+			if (inputId != IDS_ITEM_TAB_DIAGNOSTICS && inputId != IDS_ITEM_DIAG_CLEAR_CACHES &&
+				inputId != IDS_ITEM_DIAG_RESET_COUNTERS && inputId != IDS_ITEM_DIAG_REFRESH) {
+				return;
+			}
+
+			Ptr<Command> command = input->parentCommand();
+			Ptr<CommandInputs> inputs = command ? command->commandInputs() : nullptr;
+			if (!inputs) {
+				LOG_ERROR("Failed to get command inputs");
+				return;
+			}
+
+			if (inputId == IDS_ITEM_DIAG_CLEAR_CACHES) {
+				SketchTextDiagnosticsTab::clearCaches(inputs);
+			}
+			else if (inputId == IDS_ITEM_DIAG_RESET_COUNTERS) {
+				SketchTextDiagnosticsTab::resetCounters();
+			}
+
+			std::shared_ptr<SketchTextDiagnosticsTab> diagnosticsTab = toolsApp->sketchTextPanel->getDiagnosticsTab();
+			if (diagnosticsTab) {
+				diagnosticsTab->update(inputs);
+			}
+		}
+	}
+}
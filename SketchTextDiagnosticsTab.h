@@ -0,0 +1,40 @@
+#pragma once
+using namespace adsk::core;
+using namespace adsk::fusion;
+using namespace adsk::cam;
+
+namespace implicatex {
+	namespace fusion {
+		#pragma region ActionEvent
+		/// <summary>
+		/// <para>SketchTextDiagnosticsTabInputChangedEventHandler handles the buttons of the diagnostics tab and refreshes</para>
+		/// <para>its figures when the tab is activated or a button is clicked, never on the inputs of the other tabs.</para>
+		/// </summary>
+		class SketchTextDiagnosticsTabInputChangedEventHandler : public InputChangedEventHandler {
+		public:
+			void notify(const Ptr<InputChangedEventArgs>& eventArgs) override;
+		};
+		#pragma endregion
+
+		/// <summary>
+		/// <para>SketchTextDiagnosticsTab shows live performance figures of the panel: filter and table times,</para>
+		/// <para>materialized rows, cache hit rates, cache memory and API calls per operation.</para>
+		/// </summary>
+		class SketchTextDiagnosticsTab
+		{
+		public:
+			/// <summary>Number of operations listed in the API calls box.</summary>
+			static constexpr size_t API_OPERATION_ROWS = 8;
+
+			bool initialize(Ptr<Command> command, const Ptr<TabCommandInput>& tabInput);
+			bool update(const Ptr<CommandInputs>& inputs);
+
+			static void clearCaches(const Ptr<CommandInputs>& inputs);
+			static void resetCounters();
+
+		private:
+			bool addTextBox(const Ptr<CommandInputs>& tabInputs, const char* id, UINT labelId, int rows);
+			bool addButton(const Ptr<CommandInputs>& tabInputs, const char* id, UINT labelId);
+		};
+	}
+}
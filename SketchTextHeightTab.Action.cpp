@@ -1,12 +1,30 @@
 #include "pch.h"
 #include "resource.h"  
 #include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::SketchText
 #include "Logging.h"
+#include "Profiler.h"
 #include "ToolsBar.h"
 #include "ToolsApp.h"
 #include "ImplicateXFusionToolsAddIn.h"
 #include "SketchTextCommandControl.h"
 #include "SketchTextSettingsTab.h"
+#include "SketchTextDiagnosticsTab.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSnapshot.h"
+#include "SketchTextCache.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextSorter.h"
+#include "SketchTextReplacer.h"
+#include "SketchTextDuplicateFinder.h"
+#include "SketchTextHeightClusterer.h"
+#include "SketchTextExporter.h"
+#include "SketchTextFilter.h"
+#include "SketchTextQuery.h"
+#include "RefreshArena.h"
+#include "TableRowMaterializer.h"
+#include "SketchTextAnalysis.h"
 #include "SketchTextHeightTab.h"
 #include "SketchTextPanel.h"
 
@@ -30,13 +48,33 @@ namespace implicatex {
 				return;
 			}
 			toolsApp->sketchTextPanel->alignModelToSketchXYPlane(sketch);
+
+			Ptr<Command> command = dropdown->parentCommand();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			if (!SketchTextHeightTab::get()->refreshTextHeightMatches(command->commandInputs())) {
+				LOG_ERROR("Failed to refresh text height matches");
+				return;
+			}
 		}
 
-		/// <summary>Handles the text size replace described by eventArgs.</summary>
+		/// <summary>Handles the text size replace described by eventArgs by executing the height edit.</summary>
 		///
 		/// <param name="eventArgs">The event arguments.</param>
 		void SketchTextHeightTab::textHeightReplaced(const Ptr<InputChangedEventArgs>& eventArgs) {
 			LOG_INFO("textHeightReplaced");
+
+			Ptr<Command> command = eventArgs->input()->parentCommand();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			if (!SketchTextHeightTab::get()->requestEdit(command, PendingEdit::TextHeight)) {
+				LOG_ERROR("Failed to execute the text height edit");
+				return;
+			}
 		}
 
 		/// <summary>Handles the text size change described by eventArgs.</summary>
@@ -62,10 +100,191 @@ namespace implicatex {
 				return;
 			}
 
-			std::vector<Ptr<SketchText>> filteredTexts;
-			bool isSucceeded = heightTab->getTextHeightMatchItems(inputs, filteredTexts);
-			if (!isSucceeded) {
-				LOG_ERROR("Failed to get text height match items");
+			if (!heightTab->refreshTextHeightMatches(inputs)) {
+				LOG_ERROR("Failed to refresh text height matches");
+				return;
+			}
+		}
+
+		/// <summary>Handles the suggest sizes button and changes of the size tolerance.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textHeightSuggested(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textHeightSuggested");
+
+			Ptr<Command> command = eventArgs->input()->parentCommand();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			if (!SketchTextHeightTab::get()->suggestTextHeights(command->commandInputs())) {
+				LOG_ERROR("Failed to suggest text heights");
+				return;
+			}
+			if (getMatchMode(command->commandInputs()) == SketchTextMatchMode::OffNewHeight) {
+				// The tolerance is a criterion of this match mode
+				SketchTextHeightTab::textHeightChanged(eventArgs);
+			}
+		}
+
+		/// <summary>Handles picking one of the suggested standard sizes.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textHeightSizeSelected(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textHeightSizeSelected");
+
+			Ptr<Command> command = eventArgs->input()->parentCommand();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			if (!SketchTextHeightTab::get()->selectTextHeightSize(command->commandInputs())) {
+				LOG_ERROR("Failed to select text height size");
+				return;
+			}
+		}
+
+		/// <summary>Handles the preview option and changes of the new height, which redraw the preview.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textHeightPreviewed(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textHeightPreviewed");
+
+			Ptr<Command> command = eventArgs->input()->parentCommand();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			if (eventArgs->input()->id() == IDS_ITEM_TEXT_HEIGHT_NEW && getMatchMode(command->commandInputs()) == SketchTextMatchMode::OffNewHeight) {
+				// The new height is a criterion of this match mode; refreshing the matches redraws the preview
+				SketchTextHeightTab::textHeightChanged(eventArgs);
+				return;
+			}
+			if (!SketchTextHeightTab::get()->previewTextHeight(command->commandInputs())) {
+				LOG_ERROR("Failed to preview text heights");
+				return;
+			}
+		}
+
+		/// <summary>Handles a change of the text content filter, its prefix option or the query.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textContentChanged(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textContentChanged");
+			SketchTextHeightTab::textHeightChanged(eventArgs);
+		}
+
+		/// <summary>Handles switching between the selected sketch and all sketches as search scope.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::sketchScopeChanged(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::sketchScopeChanged");
+			SketchTextHeightTab::textHeightChanged(eventArgs);
+		}
+
+		/// <summary>Handles switching the match table between all matches and duplicate groups only.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textDuplicatesChanged(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textDuplicatesChanged");
+			SketchTextHeightTab::textHeightChanged(eventArgs);
+		}
+
+		/// <summary>Handles picking another combination of criteria for the match table.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textMatchModeChanged(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textMatchModeChanged");
+			SketchTextHeightTab::textHeightChanged(eventArgs);
+		}
+
+		/// <summary>Handles picking a saved query from the preset drop down.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textQueryPresetSelected(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textQueryPresetSelected");
+
+			Ptr<Command> command = eventArgs->input()->parentCommand();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			if (!SketchTextHeightTab::get()->applyQueryPreset(command->commandInputs())) {
+				LOG_ERROR("Failed to apply query preset");
+				return;
+			}
+		}
+
+		/// <summary>Handles the save preset button by storing the current query under the preset name.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textQueryPresetSaved(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textQueryPresetSaved");
+
+			Ptr<Command> command = eventArgs->input()->parentCommand();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			if (!SketchTextHeightTab::get()->saveQueryPreset(command->commandInputs())) {
+				LOG_ERROR("Failed to save query preset");
+				return;
+			}
+		}
+
+		/// <summary>Handles a change of the sort column or direction of the match table.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textSortChanged(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textSortChanged");
+			SketchTextHeightTab::textHeightChanged(eventArgs);
+		}
+
+		/// <summary>Handles a change of the find text, the replacement or the regular expression option.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textReplaceChanged(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textReplaceChanged");
+
+			Ptr<Command> command = eventArgs->input()->parentCommand();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			SketchTextHeightTab::get()->startTextReplacePlan(command->commandInputs());
+		}
+
+		/// <summary>Handles the replace texts button by executing the edit of the current replace plan.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textContentReplaced(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textContentReplaced");
+
+			Ptr<Command> command = eventArgs->input()->parentCommand();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			if (!SketchTextHeightTab::get()->requestEdit(command, PendingEdit::TextContent)) {
+				LOG_ERROR("Failed to execute the text replace");
+				return;
+			}
+		}
+
+		/// <summary>Handles the export button by writing the texts to a file chosen by the user.</summary>
+		///
+		/// <param name="eventArgs">The event arguments.</param>
+		void SketchTextHeightTab::textExported(const Ptr<InputChangedEventArgs>& eventArgs) {
+			LOG_INFO("SketchTextHeightTab::textExported");
+
+			Ptr<Command> command = eventArgs->input()->parentCommand();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			if (!SketchTextHeightTab::get()->exportTexts(command->commandInputs())) {
+				LOG_ERROR("Failed to export texts");
+				toolsUI->messageBox(LoadStringFromResource(IDS_MSG_EXPORT_FAILED));
 				return;
 			}
 		}
@@ -89,42 +308,97 @@ namespace implicatex {
 
 		void SketchTextHeightTab::textToggleCellSelected(const Ptr<InputChangedEventArgs>& eventArgs) {
 			LOG_INFO("textToggleCellSelected");
-			SketchTextHeightTab::get()->localizeText(eventArgs);
+			SketchTextHeightTab* heightTab = SketchTextHeightTab::get();
+			Ptr<BoolValueCommandInput> toggleInput = eventArgs->input();
+			if (toggleInput) {
+				std::string inputId = toggleInput->id();
+				heightTab->setTextChecked(heightTab->getSelectedRowNumber(inputId), toggleInput->value());
+			}
+			heightTab->localizeText(eventArgs);
 
 		}
 
 		void SketchTextHeightTab::localizeText(const Ptr<InputChangedEventArgs>& eventArgs) {
+			ScopedSpan span(ProfileSpan::LocalizeText);
 			std::string inputId = eventArgs->input()->id();
-			LOG_INFO("localizeText InputChanged: " + inputId);
+			LOG_INFO("localizeText InputChanged: {}", inputId);
 
 			unsigned int selectedRow = getSelectedRowNumber(inputId);
 
 			if (selectedRow == 0) {
-				LOG_ERROR("Invalid selected row: " + std::to_string(selectedRow));
+				LOG_ERROR("Invalid selected row: {}", selectedRow);
 				return;
 			}
 
-			LOG_INFO("Selected Row = " + std::to_string(selectedRow));
-
-			auto& idTextMap = idTextMap_;
+			LOG_INFO("Selected Row = {}", selectedRow);
 
-			auto it = idTextMap.find(selectedRow);
-			if (it != idTextMap.end()) {
-				Ptr<SketchText> sketchText = it->second;
+			if (selectedRow <= analysis_->rowTexts.size()) {
+				Ptr<SketchText> sketchText = getTextById(selectedRow);
 				if (sketchText) {
-					LOG_INFO("Text = " + idTextMap[selectedRow]->text() + " - SketchText = " + sketchText->text());
+					LOG_INFO("Text = {}", sketchText->text());
 
 					setSelectedText(sketchText);
-
-					toolsApp->sketchTextPanel->addHighlightGraphics(sketchText);
+					analysis_->selectedId = selectedRow <= analysis_->filteredIds.size()
+						? analysis_->filteredIds[selectedRow - 1] : SketchTextAnalysis::NO_RECORD;
+
+					std::vector<Ptr<SketchText>> groupTexts;
+					if (getDuplicateGroupTexts(selectedRow, groupTexts)) {
+						toolsApp->sketchTextPanel->addHighlightGraphics(groupTexts);
+					}
+					else {
+						toolsApp->sketchTextPanel->addHighlightGraphics(sketchText);
+					}
 					toolsApp->sketchTextPanel->focusCameraOnText(sketchText);
 				}
 				else {
-					LOG_ERROR("SketchText not found for input ID: " + inputId);
+					LOG_ERROR("SketchText not found for input ID: {}", inputId);
 				}
 			}
 		}
 
+		/// <summary>
+		/// <para>The notify method receives the generation of a finished replace worker</para>
+		/// <para>on the main thread and passes it to the height tab.</para>
+		/// </summary>
+		/// <param name="eventArgs">The custom event arguments, additionalInfo holds the worker generation.</param>
+		void SketchTextReplacePlannedEventHandler::notify(const Ptr<CustomEventArgs>& eventArgs) {
+			TraceScope trace("textReplacePlanned", "input");
+			ApiOperation operation("textReplacePlanned");
+			if (!toolsApp->sketchTextPanel) {
+				return;
+			}
+			SketchTextHeightTab* heightTab = toolsApp->sketchTextPanel->getTextHeightTab().get();
+			if (heightTab == nullptr) {
+				return;
+			}
+			heightTab->textReplacePlanned(std::stoull(eventArgs->additionalInfo()));
+		}
+
+		/// <summary>
+		/// <para>The notify method writes the edit requested by the height tab. It runs for the OK button too,</para>
+		/// <para>where no edit is pending and nothing is written.</para>
+		/// </summary>
+		/// <param name="eventArgs">The command event arguments.</param>
+		void SketchTextHeightTabExecuteEventHandler::notify(const Ptr<CommandEventArgs>& eventArgs) {
+			TraceScope trace("execute", "input");
+			if (!toolsApp->sketchTextPanel) {
+				return;
+			}
+			SketchTextHeightTab* heightTab = toolsApp->sketchTextPanel->getTextHeightTab().get();
+			if (heightTab == nullptr) {
+				return;
+			}
+			Ptr<Command> command = eventArgs->command();
+			if (!command) {
+				LOG_ERROR("Invalid command");
+				return;
+			}
+			if (!heightTab->applyPendingEdit(command->commandInputs())) {
+				LOG_ERROR("Failed to apply the pending edit");
+				return;
+			}
+		}
+
 		/// <summary>
 		/// <para>The notify method is an overridden virtual function that handles input change events.</para>
 		/// </summary>
@@ -134,7 +408,8 @@ namespace implicatex {
 		/// </param>
 		void SketchTextHeightTabInputChangedEventHandler::notify(const Ptr<InputChangedEventArgs>& eventArgs) {
 			std::string inputId = eventArgs->input()->id();
-			LOG_INFO("Notify InputChanged: " + inputId);
+			TraceScope trace(inputId, "input");
+			LOG_INFO("Notify InputChanged: {}", inputId);
 
 			Ptr<Command> command = eventArgs->input()->parentCommand();
 			if (!command) {
@@ -215,18 +490,20 @@ namespace implicatex {
 			//	return;
 			//}
 
-			inputId = 
-				std::regex_replace(inputId,
-					std::regex(std::format("^({}|{}|{}|{})_(\\d+)$", 
-						IDS_CELL_TEXT_ID, IDS_CELL_TEXT_VALUE, IDS_CELL_TEXT_HEIGHT, IDS_CELL_TEXT_TOGGLE)), "$1");
-            
+			std::string_view cellId;
+			unsigned int row = 0;
+			if (SketchTextHeightTab::parseTextCellId(inputId, cellId, row)) {
+				inputId = std::string(cellId);
+			}
 			SketchTextHeightTab* heightTab = toolsApp->sketchTextPanel->getTextHeightTab().get();
 
-			if (heightTab->getActions().find(inputId) !=
-				heightTab->getActions().end()) {
-				heightTab->getActions()[inputId](eventArgs);
+			auto action = heightTab->getActions().find(inputId);
+			if (action != heightTab->getActions().end()) {
+				// Inputs of the other tabs are counted by their own handlers
+				ApiOperation operation(inputId);
+				action->second(eventArgs);
 			} else {
-				LOG_INFO("Unknown inputId: " + inputId);
+				LOG_INFO("Unknown inputId: {}", inputId);
 			}
 
 			return;
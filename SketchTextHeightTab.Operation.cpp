@@ -1,20 +1,62 @@
 #include "pch.h"
 #include "resource.h"  
 #include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::SketchText
 #include "Logging.h"
+#include "Profiler.h"
 #include "ToolsBar.h"
 #include "ToolsApp.h"
 #include "ImplicateXFusionToolsAddIn.h"
+#include "SettingsStore.h"
 #include "SketchTextCommandControl.h"
 #include "SketchTextSettingsTab.h"
+#include "SketchTextDiagnosticsTab.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSnapshot.h"
+#include "SketchTextCache.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextSorter.h"
+#include "SketchTextReplacer.h"
+#include "SketchTextDuplicateFinder.h"
+#include "SketchTextHeightClusterer.h"
+#include "SketchTextExporter.h"
+#include "SketchTextFilter.h"
+#include "SketchTextQuery.h"
+#include "CellId.h"
+#include "RefreshArena.h"
+#include "TableRowMaterializer.h"
+#include "SketchTextAnalysis.h"
 #include "SketchTextHeightTab.h"
 #include "SketchTextPanel.h"
 
 namespace implicatex {
 	namespace fusion {
+		namespace {
+			/// <summary>Defers compute on sketches and turns it back on when it leaves scope, also on an early return.</summary>
+			class ComputeDeferral {
+			public:
+				~ComputeDeferral() {
+					for (const auto& sketch : sketches_) {
+						sketch->isComputeDeferred(false);
+					}
+				}
+
+				void defer(const Ptr<Sketch>& sketch) {
+					if (sketch && !sketch->isComputeDeferred()) {
+						sketch->isComputeDeferred(true);
+						sketches_.push_back(sketch);
+					}
+				}
+
+			private:
+				std::vector<Ptr<Sketch>> sketches_;
+			};
+		}
+
 		/// <summary>
-		/// <para>getTextSizeMatch retrieves and filters sketch texts based on specified minimum and maximum height,</para>
-		/// <para>updating a command input with the count of matching texts.</para>
+		/// <para>getTextSizeMatch retrieves and filters sketch texts based on specified minimum and maximum height</para>
+		/// <para>and the optional text content filter, updating a command input with the count of matching texts.</para>
 		/// </summary>
 		///
 		/// <param name="inputs">
@@ -23,83 +65,1057 @@ namespace implicatex {
 		/// </param>
 		///
 		/// <returns>True if it succeeds, false if it fails.</returns>
-		bool SketchTextHeightTab::getTextHeightMatchItems(const Ptr<CommandInputs>& inputs, std::vector<Ptr<SketchText>>& filteredTexts) {
+		bool SketchTextHeightTab::getTextHeightMatchItems(const Ptr<CommandInputs>& inputs, std::pmr::vector<Ptr<SketchText>>& filteredTexts) {
+			ScopedSpan span(ProfileSpan::TextHeightMatchItems);
 			Ptr<ValueCommandInput> minTextHeight = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_MIN);
 			Ptr<ValueCommandInput> maxTextHeight = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_MAX);
+			Ptr<StringValueCommandInput> contentFilter = inputs->itemById(IDS_ITEM_TEXT_CONTENT_FILTER);
+			Ptr<BoolValueCommandInput> contentPrefix = inputs->itemById(IDS_ITEM_TEXT_CONTENT_PREFIX);
+			Ptr<StringValueCommandInput> queryInput = inputs->itemById(IDS_ITEM_TEXT_QUERY);
+			Ptr<BoolValueCommandInput> duplicatesOnly = inputs->itemById(IDS_ITEM_TEXT_DUPLICATES_ONLY);
+			Ptr<DropDownCommandInput> sortOrderInput = inputs->itemById(IDS_ITEM_TEXT_SORT_ORDER);
+			Ptr<BoolValueCommandInput> sortDescendingInput = inputs->itemById(IDS_ITEM_TEXT_SORT_DESCENDING);
+			Ptr<ValueCommandInput> newTextHeight = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_NEW);
+			Ptr<ValueCommandInput> toleranceInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_TOLERANCE);
 			Ptr<TextBoxCommandInput> matchesTextHeightInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_MATCH);
-			Ptr<DropDownCommandInput> dropdown = inputs->itemById(IDS_ITEM_DROPDOWN_SELECT_SKETCH);
 
-			Ptr<Sketch> sketch = nullptr;
-			if (!toolsApp->sketchTextPanel->getSelectedSketch(dropdown, sketch)) {
-				LOG_ERROR("Failed to get selected sketch");
+			if (!updateSnapshot(inputs)) {
+				LOG_ERROR("Failed to capture sketch texts");
+				return false;
+			}
+
+			SketchTextFilterCriteria criteria;
+			criteria.matchMode = getMatchMode(inputs);
+			criteria.minHeight = minTextHeight->value();
+			criteria.maxHeight = maxTextHeight->value();
+			criteria.newHeight = newTextHeight ? newTextHeight->value() : 0.0;
+			criteria.tolerance = toleranceInput ? toleranceInput->value() : 0.0;
+			criteria.checkedIds = analysis_->checkedIds;
+			// Without a selected text no sketch index matches
+			criteria.selectedSketch = analysis_->selectedId < analysis_->snapshot.size()
+				? analysis_->snapshot.record(analysis_->selectedId).sketchIndex : (std::numeric_limits<unsigned int>::max)();
+			criteria.content = contentFilter ? contentFilter->value() : "";
+			criteria.isPrefixOnly = contentPrefix ? contentPrefix->value() : false;
+			criteria.isDuplicatesOnly = duplicatesOnly ? duplicatesOnly->value() : false;
+			criteria.sortOrder = SketchTextSortOrder::Collection;
+			if (sortOrderInput && sortOrderInput->selectedItem()) {
+				criteria.sortOrder = static_cast<SketchTextSortOrder>(sortOrderInput->selectedItem()->index());
+			}
+			criteria.isSortDescending = sortDescendingInput ? sortDescendingInput->value() : false;
+			criteria.localeId = toolsLocaleId;
+			isDuplicatesOnly_ = criteria.isDuplicatesOnly;
+
+			if (isDuplicatesOnly_) {
+				updateDuplicates();
+			}
+
+			std::string queryText = queryInput ? queryInput->value() : "";
+			std::vector<uint32_t> queryIds;
+			if (!queryText.empty()) {
+				std::string error;
+				if (!runTextQuery(queryText, queryIds, error)) {
+					LOG_INFO("Invalid query {}: {}", queryText, error);
+					filteredTexts.clear();
+					analysis_->filteredIds.clear();
+					if (matchesTextHeightInput) {
+						matchesTextHeightInput->text(std::format("{}: {}", LoadStringFromResource(IDS_MSG_INVALID_QUERY), error));
+					}
+					return true;
+				}
+				criteria.queryIds = &queryIds;
+			}
+
+			std::vector<uint32_t> ids;
+			size_t duplicateGroupCount = SketchTextFilter::apply(analysis_->snapshot.records(), analysis_->textIndex, analysis_->duplicateFinder, analysis_->textSorter, criteria, ids,
+				refreshArena_.resource());
+
+			filteredTexts.clear();
+			filteredTexts.reserve(ids.size());
+			for (uint32_t id : ids) {
+				filteredTexts.push_back(analysis_->snapshot.entity(id));
+			}
+			analysis_->filteredIds.swap(ids);
+
+			size_t textHeightMatchCount = filteredTexts.size();
+
+			if (matchesTextHeightInput) {
+				if (isDuplicatesOnly_) {
+					matchesTextHeightInput->text(std::format("{} ({} {})",
+						textHeightMatchCount, duplicateGroupCount, LoadStringFromResource(IDS_LABEL_DUPLICATE_GROUPS)));
+				}
+				else {
+					matchesTextHeightInput->text(std::to_string(textHeightMatchCount));
+				}
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// <para>runTextQuery compiles a query, plans it against the indexes of the snapshot and executes the plan.</para>
+		/// <para>A query run before, e.g. a preset, is taken from the query cache without parsing, and its plan is</para>
+		/// <para>kept until the indexes are rebuilt. Planning and execution are timed as separate spans.</para>
+		/// </summary>
+		///
+		/// <param name="text"> The query, see SketchTextQuery.</param>
+		/// <param name="ids">	[out] The ascending ids of the matching records.</param>
+		/// <param name="error">[out] Why the query is invalid.</param>
+		///
+		/// <returns>True if it succeeds, false if the query is invalid.</returns>
+		bool SketchTextHeightTab::runTextQuery(const std::string& text, std::vector<uint32_t>& ids, std::string& error) {
+			SketchTextCompiledQuery* compiled = nullptr;
+			{
+				ScopedSpan span(ProfileSpan::PlanTextQuery);
+				compiled = &queryCache_.compile(text);
+				if (!compiled->isValid()) {
+					error = compiled->error;
+					return false;
+				}
+				queryCache_.plan(*compiled, analysis_->textIndex, analysis_->rangeIndex);
+			}
+			LOG_INFO("Query plan: {}", compiled->plan.describe(compiled->query));
+
+			ScopedSpan span(ProfileSpan::ExecuteTextQuery);
+			SketchTextQueryPlanner::execute(compiled->query, compiled->plan, analysis_->snapshot.records(), analysis_->snapshot.sketchNames(),
+				analysis_->textIndex, analysis_->rangeIndex, ids, refreshArena_.resource());
+			return true;
+		}
+
+		/// <summary>Compiles the presets of the settings into the query cache and keeps them there.</summary>
+		void SketchTextHeightTab::compileQueryPresets() {
+			std::shared_ptr<const ToolsSettings> settings = ToolsApp::getSettings();
+			queryCache_.unpinAll();
+			for (const QueryPreset& preset : settings->queryPresets) {
+				const SketchTextCompiledQuery& compiled = queryCache_.compile(preset.query, true);
+				if (!compiled.isValid()) {
+					LOG_INFO("Invalid query preset {}: {}", preset.name, compiled.error);
+				}
+			}
+		}
+
+		/// <summary>
+		/// <para>applyQueryPreset puts the query of the selected preset into the query input and refreshes the matches.</para>
+		/// <para>The preset was compiled when the tab was created, so the refresh goes straight to the plan.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::applyQueryPreset(const Ptr<CommandInputs>& inputs) {
+			Ptr<DropDownCommandInput> presetInput = inputs->itemById(IDS_ITEM_TEXT_QUERY_PRESET);
+			Ptr<StringValueCommandInput> queryInput = inputs->itemById(IDS_ITEM_TEXT_QUERY);
+			Ptr<StringValueCommandInput> presetName = inputs->itemById(IDS_ITEM_TEXT_QUERY_PRESET_NAME);
+			if (!presetInput || !queryInput) {
+				LOG_ERROR("Query preset inputs not found");
+				return false;
+			}
+			Ptr<ListItem> item = presetInput->selectedItem();
+			std::shared_ptr<const ToolsSettings> settings = ToolsApp::getSettings();
+			size_t index = item ? item->index() : 0;
+			if (index == 0 || index > settings->queryPresets.size()) {
+				// None keeps the query as it is
+				return true;
+			}
+			const QueryPreset& preset = settings->queryPresets[index - 1];
+			queryInput->value(preset.query);
+			if (presetName) {
+				presetName->value(preset.name);
+			}
+			return refreshTextHeightMatches(inputs);
+		}
+
+		/// <summary>
+		/// <para>saveQueryPreset stores the current query under the preset name, replacing a preset of the same name;</para>
+		/// <para>an empty query removes it. The name defaults to the query. Invalid queries are not saved.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::saveQueryPreset(const Ptr<CommandInputs>& inputs) {
+			Ptr<DropDownCommandInput> presetInput = inputs->itemById(IDS_ITEM_TEXT_QUERY_PRESET);
+			Ptr<StringValueCommandInput> queryInput = inputs->itemById(IDS_ITEM_TEXT_QUERY);
+			Ptr<StringValueCommandInput> presetName = inputs->itemById(IDS_ITEM_TEXT_QUERY_PRESET_NAME);
+			Ptr<TextBoxCommandInput> matchesTextHeightInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_MATCH);
+			if (!presetInput || !queryInput || !presetName) {
+				LOG_ERROR("Query preset inputs not found");
+				return false;
+			}
+			std::string query = queryInput->value();
+			std::string name = presetName->value().empty() ? query : presetName->value();
+			if (name.empty()) {
+				return true;
+			}
+			if (!query.empty()) {
+				const SketchTextCompiledQuery& compiled = queryCache_.compile(query);
+				if (!compiled.isValid()) {
+					LOG_INFO("Not saving the invalid query preset {}: {}", name, compiled.error);
+					if (matchesTextHeightInput) {
+						matchesTextHeightInput->text(std::format("{}: {}", LoadStringFromResource(IDS_MSG_INVALID_QUERY), compiled.error));
+					}
+					return true;
+				}
+			}
+
+			if (toolsApp->settingsStore) {
+				toolsApp->settingsStore->update([&name, &query](ToolsSettings& settings) {
+					std::vector<QueryPreset>& presets = settings.queryPresets;
+					auto it = std::find_if(presets.begin(), presets.end(), [&name](const QueryPreset& preset) { return preset.name == name; });
+					if (query.empty()) {
+						if (it != presets.end()) {
+							presets.erase(it);
+						}
+					}
+					else if (it != presets.end()) {
+						it->query = query;
+					}
+					else {
+						presets.push_back({ name, query });
+					}
+				});
+			}
+			if (query.empty()) {
+				LOG_INFO("Removed query preset {}", name);
+			}
+			else {
+				LOG_INFO("Saved query preset {}", name);
+			}
+			compileQueryPresets();
+			fillQueryPresets(presetInput, query.empty() ? "" : name);
+			presetName->value(query.empty() ? "" : name);
+			return true;
+		}
+
+		/// <summary>
+		/// <para>refreshTextHeightMatches filters the captured texts with the current criteria</para>
+		/// <para>and rebuilds the match table from the result.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::refreshTextHeightMatches(const Ptr<CommandInputs>& inputs) {
+			// Everything filter and table allocate for this refresh is released at once when it returns
+			ScopedArena arena(refreshArena_);
+			std::pmr::vector<Ptr<SketchText>> filteredTexts(refreshArena_.resource());
+			if (!getTextHeightMatchItems(inputs, filteredTexts)) {
+				LOG_ERROR("Failed to get text height match items");
+				return false;
+			}
+
+			if (!updateTextHeightMatchTable(inputs, filteredTexts)) {
+				LOG_ERROR("Failed to update text height match table");
+				return false;
+			}
+
+			saveTextHeightSettings(inputs);
+
+			Ptr<BoolValueCommandInput> previewInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_PREVIEW);
+			if (previewInput && previewInput->value() && !previewTextHeight(inputs)) {
+				LOG_ERROR("Failed to update text height preview");
+			}
+
+			startTextReplacePlan(inputs);
+			return true;
+		}
+
+		/// <summary>
+		/// <para>startTextReplacePlan copies the contents of the filtered texts and matches the find pattern</para>
+		/// <para>against them on a worker thread. The worker fires IDS_EVENT_TEXT_REPLACE_PLANNED when done.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		void SketchTextHeightTab::startTextReplacePlan(const Ptr<CommandInputs>& inputs) {
+			Ptr<StringValueCommandInput> findInput = inputs->itemById(IDS_ITEM_TEXT_FIND);
+			Ptr<StringValueCommandInput> replaceInput = inputs->itemById(IDS_ITEM_TEXT_REPLACE_WITH);
+			Ptr<BoolValueCommandInput> regexInput = inputs->itemById(IDS_ITEM_TEXT_FIND_REGEX);
+
+			cancelTextReplacePlan();
+			uint64_t generation = replaceGeneration_.load();
+			replacePlan_ = SketchTextReplacePlan();
+			replacePlanBytes_ = 0;
+			replacePlan_.generation = generation;
+
+			std::string find = findInput ? findInput->value() : "";
+			if (find.empty()) {
+				if (replacePreviewInput_) {
+					replacePreviewInput_->text("");
+				}
+				return;
+			}
+			std::string replace = replaceInput ? replaceInput->value() : "";
+			bool useRegex = regexInput ? regexInput->value() : false;
+
+			std::vector<SketchTextReplacement> texts;
+			texts.reserve(analysis_->filteredIds.size());
+			for (uint32_t id : analysis_->filteredIds) {
+				texts.push_back({ id, analysis_->snapshot.record(id).text });
+			}
+
+			if (replacePreviewInput_) {
+				replacePreviewInput_->text("...");
+			}
+
+			replaceJob_ = std::async(std::launch::async,
+				[texts = std::move(texts), find, replace, useRegex, generation, &currentGeneration = replaceGeneration_]() {
+					TraceRecorder::get().setThreadName("Replace planner");
+					TraceScope trace("planTextReplace", "background");
+					SketchTextReplacePlan plan =
+						SketchTextReplacer::plan(texts, find, replace, useRegex, generation, currentGeneration);
+					if (!plan.isCancelled) {
+						toolsApp->fireCustomEvent(IDS_EVENT_TEXT_REPLACE_PLANNED, std::to_string(generation));
+					}
+					return plan;
+				});
+		}
+
+		/// <summary>
+		/// <para>cancelTextReplacePlan moves on to a new generation, which makes a running worker give up,</para>
+		/// <para>and waits for it to return.</para>
+		/// </summary>
+		void SketchTextHeightTab::cancelTextReplacePlan() {
+			++replaceGeneration_;
+			if (replaceJob_.valid()) {
+				replaceJob_.wait();
+				replaceJob_ = std::future<SketchTextReplacePlan>();
+			}
+		}
+
+		/// <summary>
+		/// <para>textReplacePlanned takes over the plan of the worker of the given generation</para>
+		/// <para>and shows the number of texts that will change, ignoring results of superseded workers.</para>
+		/// </summary>
+		///
+		/// <param name="generation">The generation reported by the worker.</param>
+		void SketchTextHeightTab::textReplacePlanned(uint64_t generation) {
+			if (generation != replaceGeneration_.load() || !replaceJob_.valid()) {
+				return;
+			}
+
+			replacePlan_ = replaceJob_.get();
+			replacePlanBytes_ = 0;
+			for (const auto& replacement : replacePlan_.replacements) {
+				replacePlanBytes_ += sizeof(replacement) + replacement.text.capacity();
+			}
+
+			if (!replacePreviewInput_) {
+				return;
+			}
+			if (!replacePlan_.isValid) {
+				replacePreviewInput_->text(LoadStringFromResource(IDS_MSG_INVALID_EXPRESSION));
+				return;
+			}
+			replacePreviewInput_->text(std::to_string(replacePlan_.replacements.size()));
+		}
+
+		/// <summary>
+		/// <para>withComputeDeferred defers compute on the sketches of the texts, calls edit for each text and turns</para>
+		/// <para>compute back on, however edit returns. Sketches whose compute was already deferred are left so.</para>
+		/// </summary>
+		///
+		/// <param name="ids">       The snapshot ids of the texts to edit.</param>
+		/// <param name="edit">      Called with the position in ids and the text, returns true if the text changed.</param>
+		/// <param name="isAffected">[out] Per snapshot sketch, true if one of its texts was passed to edit.</param>
+		///
+		/// <returns>The number of texts edit changed.</returns>
+		size_t SketchTextHeightTab::withComputeDeferred(const std::vector<uint32_t>& ids,
+			const std::function<bool(size_t index, const Ptr<SketchText>& text)>& edit, std::vector<bool>& isAffected) {
+			isAffected.assign(analysis_->snapshot.sketchCount(), false);
+			ComputeDeferral deferral;
+			for (uint32_t id : ids) {
+				unsigned int sketchIndex = analysis_->snapshot.record(id).sketchIndex;
+				if (isAffected[sketchIndex]) continue;
+
+				isAffected[sketchIndex] = true;
+				deferral.defer(analysis_->snapshot.sketch(sketchIndex));
+			}
+
+			size_t changedCount = 0;
+			for (size_t i = 0; i < ids.size(); i++) {
+				Ptr<SketchText> sketchText = analysis_->snapshot.entity(ids[i]);
+				if (sketchText && edit(i, sketchText)) {
+					++changedCount;
+				}
+			}
+			return changedCount;
+		}
+
+		/// <summary>
+		/// <para>applyTextReplacePlan writes the planned contents to the sketch texts. Compute is deferred</para>
+		/// <para>on the affected sketches while the texts are set, all within the same execute event.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::applyTextReplacePlan(const Ptr<CommandInputs>& inputs) {
+			TraceScope trace("applyTextReplacePlan", "api");
+			if (replacePlan_.generation != replaceGeneration_.load() || replaceJob_.valid()) {
+				// The worker has not reported yet, wait for its result
+				textReplacePlanned(replaceGeneration_.load());
+			}
+
+			if (!replacePlan_.isValid) {
+				LOG_ERROR("Invalid find expression: {}", replacePlan_.error);
+				return false;
+			}
+			if (replacePlan_.replacements.empty()) {
+				LOG_INFO("No texts to replace");
+				return true;
+			}
+
+			const auto& replacements = replacePlan_.replacements;
+			std::vector<uint32_t> ids;
+			ids.reserve(replacements.size());
+			for (const auto& replacement : replacements) {
+				ids.push_back(replacement.id);
+			}
+
+			std::vector<bool> isAffected;
+			size_t replacedCount = withComputeDeferred(ids, [&replacements](size_t index, const Ptr<SketchText>& text) {
+				return text->text(replacements[index].text);
+			}, isAffected);
+
+			LOG_INFO("Replaced {} of {} texts", replacedCount, replacements.size());
+
+			invalidateSketches(isAffected);
+			return refreshTextHeightMatches(inputs);
+		}
+
+		/// <summary>
+		/// <para>applyTextHeight sets the new height on all texts of the match table. Compute is deferred on the</para>
+		/// <para>affected sketches while the heights are set, as for the content replace.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::applyTextHeight(const Ptr<CommandInputs>& inputs) {
+			TraceScope trace("applyTextHeight", "api");
+			Ptr<ValueCommandInput> newHeightInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_NEW);
+			if (!newHeightInput) {
+				LOG_ERROR("Invalid new text height input");
 				return false;
 			}
+			double newHeight = newHeightInput->value();
+			if (newHeight <= 0.0) {
+				LOG_ERROR("Invalid text height: {}", newHeight);
+				return false;
+			}
+			if (analysis_->filteredIds.empty()) {
+				LOG_INFO("No texts to change");
+				return true;
+			}
 
-			double minHeightValue = minTextHeight->value();
-			double maxHeightValue = maxTextHeight->value();
+			std::vector<bool> isAffected;
+			size_t changedCount = withComputeDeferred(analysis_->filteredIds, [newHeight](size_t, const Ptr<SketchText>& text) {
+				return text->height(newHeight);
+			}, isAffected);
+
+			LOG_INFO("Changed the height of {} of {} texts to {} cm", changedCount, analysis_->filteredIds.size(), newHeight);
+
+			invalidateSketches(isAffected);
+			if (!analysis_->heightSizes.empty() && !suggestTextHeights(inputs)) {
+				LOG_ERROR("Failed to update the suggested sizes");
+			}
+			return refreshTextHeightMatches(inputs);
+		}
 
-			Ptr<SketchTexts> sketchTexts = sketch->sketchTexts();
-			if (!sketchTexts) {
-				LOG_ERROR("No SketchTexts found in the sketch.");
+		/// <summary>
+		/// <para>requestEdit stores the edit of a replace button and executes the command without terminating it.</para>
+		/// <para>The texts are written by the execute event, which Fusion records as one undoable transaction,</para>
+		/// <para>instead of the input changed event, whose changes are not grouped.</para>
+		/// </summary>
+		///
+		/// <param name="command">The panel command.</param>
+		/// <param name="edit">   The edit to write.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::requestEdit(const Ptr<Command>& command, PendingEdit edit) {
+			pendingEdit_ = edit;
+			if (!command->doExecute(false)) {
+				pendingEdit_ = PendingEdit::None;
 				return false;
 			}
+			return true;
+		}
 
-			for (size_t i = 0; i < sketchTexts->count(); ++i) {
-				Ptr<SketchText> text = sketchTexts->item(i);
-				Ptr<Point3D> minPoint = text->boundingBox()->minPoint();
-				Ptr<Point3D> maxPoint = text->boundingBox()->maxPoint();
-				if (!minPoint || !maxPoint) {
-					LOG_ERROR("Failed to get bounding box points");
+		/// <summary>applyPendingEdit writes the edit stored by requestEdit, if any, and clears it.</summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::applyPendingEdit(const Ptr<CommandInputs>& inputs) {
+			PendingEdit edit = pendingEdit_;
+			pendingEdit_ = PendingEdit::None;
+			switch (edit) {
+			case PendingEdit::TextHeight:
+				return applyTextHeight(inputs);
+			case PendingEdit::TextContent:
+				return applyTextReplacePlan(inputs);
+			default:
+				return true;
+			}
+		}
+
+		/// <summary>
+		/// <para>suggestTextHeights clusters the heights of the captured texts into the fewest standard sizes that keep</para>
+		/// <para>every text within the tolerance and lists them, with the number of texts of each, in the sizes drop down.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::suggestTextHeights(const Ptr<CommandInputs>& inputs) {
+			ScopedSpan span(ProfileSpan::SuggestTextHeights);
+			Ptr<ValueCommandInput> toleranceInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_TOLERANCE);
+			Ptr<DropDownCommandInput> sizesInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_SIZES);
+			if (!toleranceInput || !sizesInput) {
+				LOG_ERROR("Invalid size suggestion inputs");
+				return false;
+			}
+
+			if (!updateSnapshot(inputs)) {
+				LOG_ERROR("Failed to capture sketch texts");
+				return false;
+			}
+			if (analysis_->heightClustersScope.empty() || analysis_->heightClustersScope != analysis_->snapshotScope) {
+				analysis_->heightClusterer.build(analysis_->snapshot.records());
+				analysis_->heightClustersScope = analysis_->snapshotScope;
+			}
+
+			double tolerance = (std::max)(0.0, toleranceInput->value());
+			if (!analysis_->heightClusterer.suggest(tolerance, SketchTextHeightClusterer::MAX_CLUSTERS, analysis_->heightSizes)) {
+				LOG_INFO("{} sizes do not keep the tolerance of {} cm", analysis_->heightSizes.size(), tolerance);
+			}
+
+			// Sizes are shown in mm, rounded to the 0.001 mm the heights are clustered at
+			auto toMillimeters = [](double height) { return std::round(height * 10000.0) / 1000.0; };
+			std::string textsLabel = LoadStringFromResource(IDS_LABEL_TEXT_HEIGHT_SIZE_TEXTS);
+			Ptr<ListItems> sizeItems = sizesInput->listItems();
+			sizeItems->clear();
+			for (const HeightCluster& size : analysis_->heightSizes) {
+				std::string label = size.heightCount > 1
+					? std::format("{} {}: {} {} ({} - {} {})", toMillimeters(size.standardHeight), IDS_UNIT_MM, size.textCount, textsLabel,
+						toMillimeters(size.minHeight), toMillimeters(size.maxHeight), IDS_UNIT_MM)
+					: std::format("{} {}: {} {}", toMillimeters(size.standardHeight), IDS_UNIT_MM, size.textCount, textsLabel);
+				sizeItems->add(label, false);
+			}
+
+			LOG_INFO("Suggested {} sizes for {} heights of {} texts", analysis_->heightSizes.size(), analysis_->heightClusterer.getHeightCount(), analysis_->heightClusterer.getTextCount());
+			return true;
+		}
+
+		/// <summary>
+		/// <para>selectTextHeightSize feeds the picked standard size into the height replace: the height range selects</para>
+		/// <para>the texts of its cluster and the new height becomes the standard size.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::selectTextHeightSize(const Ptr<CommandInputs>& inputs) {
+			Ptr<DropDownCommandInput> sizesInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_SIZES);
+			Ptr<ValueCommandInput> minTextHeight = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_MIN);
+			Ptr<ValueCommandInput> maxTextHeight = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_MAX);
+			Ptr<ValueCommandInput> newTextHeight = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_NEW);
+			if (!sizesInput || !minTextHeight || !maxTextHeight || !newTextHeight) {
+				LOG_ERROR("Invalid text height inputs");
+				return false;
+			}
+
+			Ptr<ListItem> selectedItem = sizesInput->selectedItem();
+			if (!selectedItem) {
+				return true;
+			}
+			size_t index = (size_t)selectedItem->index();
+			if (index >= analysis_->heightSizes.size()) {
+				LOG_ERROR("Invalid size index: {}", index);
+				return false;
+			}
+
+			// Widen the range by half the clustering step, so that heights rounded onto its ends still match
+			const HeightCluster& size = analysis_->heightSizes[index];
+			minTextHeight->value(size.minHeight - SketchTextHeightClusterer::HEIGHT_STEP / 2.0);
+			maxTextHeight->value(size.maxHeight + SketchTextHeightClusterer::HEIGHT_STEP / 2.0);
+			newTextHeight->value(size.standardHeight);
+
+			return refreshTextHeightMatches(inputs);
+		}
+
+		/// <summary>
+		/// <para>previewTextHeight draws the texts of the match table as they would be with the new height: each</para>
+		/// <para>captured box is scaled about the text's anchor by the ratio of new to old height and all of them</para>
+		/// <para>go into one line set. It reads only the snapshot, so the model is neither read nor changed.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::previewTextHeight(const Ptr<CommandInputs>& inputs) {
+			ScopedSpan span(ProfileSpan::PreviewTextHeight);
+			Ptr<BoolValueCommandInput> previewInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_PREVIEW);
+			Ptr<ValueCommandInput> newHeightInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_NEW);
+			if (!previewInput || !newHeightInput) {
+				LOG_ERROR("Invalid text height preview inputs");
+				return false;
+			}
+
+			previewPoints_.clear();
+			previewIndices_.clear();
+			double newHeight = newHeightInput->value();
+			if (!previewInput->value() || newHeight <= 0.0) {
+				// Only remove graphics drawn by the preview, not the highlight of a selected text
+				if (isPreviewShown_) {
+					toolsApp->sketchTextPanel->addLineGraphics(previewPoints_, previewIndices_, PREVIEW_OPACITY);
+					isPreviewShown_ = false;
+				}
+				return true;
+			}
+
+			previewPoints_.reserve(analysis_->filteredIds.size() * 12);
+			previewIndices_.reserve(analysis_->filteredIds.size() * 8);
+			for (uint32_t id : analysis_->filteredIds) {
+				const SketchTextRecord& record = analysis_->snapshot.record(id);
+				if (record.height <= 0.0 || !record.bounds.isValid()) continue;
+
+				// A text keeps its anchor when its height changes, the lower left corner if its alignment is not known
+				Box3 previewBox = scaleBox(record.bounds, record.anchor.value_or(record.bounds.minPoint), newHeight / record.height);
+				appendRectangle(previewBox, previewBox.minPoint.z, previewPoints_, previewIndices_);
+			}
+
+			toolsApp->sketchTextPanel->addLineGraphics(previewPoints_, previewIndices_, PREVIEW_OPACITY);
+			isPreviewShown_ = true;
+			return true;
+		}
+
+		/// <summary>
+		/// <para>invalidateSketches drops the cached texts of the sketches the add-in changed, so that the next</para>
+		/// <para>refresh reads only those sketches again.</para>
+		/// </summary>
+		///
+		/// <param name="isChanged">One flag per sketch of the snapshot.</param>
+		void SketchTextHeightTab::invalidateSketches(const std::vector<bool>& isChanged) {
+			for (size_t i = 0; i < isChanged.size(); ++i) {
+				if (isChanged[i]) {
+					analysis_->sketchCache.invalidate(analysis_->snapshot.sketch((unsigned int)i));
+				}
+			}
+			invalidateSnapshot();
+		}
+
+		/// <summary>
+		/// <para>useCurrentAnalysis switches to the analysis of the active document. An analysis kept from an earlier visit</para>
+		/// <para>brings back its snapshot, indexes and results; the preview and replace plan of the previous document are dropped.</para>
+		/// </summary>
+		void SketchTextHeightTab::useCurrentAnalysis() {
+			std::shared_ptr<SketchTextAnalysis> analysis = toolsApp->sketchTextAnalyses ? toolsApp->sketchTextAnalyses->getCurrent() : nullptr;
+			if (!analysis) {
+				analysis = analysis_ ? analysis_ : std::make_shared<SketchTextAnalysis>();
+			}
+			if (analysis == analysis_) {
+				return;
+			}
+			if (analysis_) {
+				LOG_INFO("Switching the sketch text analysis from {} to {}", analysis_->documentName, analysis->documentName);
+				cancelTextReplacePlan();
+				replacePlan_ = SketchTextReplacePlan();
+				replacePlanBytes_ = 0;
+				previewPoints_.clear();
+				previewIndices_.clear();
+				isPreviewShown_ = false;
+			}
+			analysis_ = analysis;
+		}
+
+		/// <summary>
+		/// <para>updateSnapshot captures the texts of the selected sketch, or of all sketches of the root component,</para>
+		/// <para>and rebuilds the text index when that scope differs from the one captured last.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::updateSnapshot(const Ptr<CommandInputs>& inputs) {
+			Ptr<DropDownCommandInput> dropdown = inputs->itemById(IDS_ITEM_DROPDOWN_SELECT_SKETCH);
+			Ptr<BoolValueCommandInput> allSketchesInput = inputs->itemById(IDS_ITEM_ALL_SKETCHES);
+			bool allSketches = allSketchesInput ? allSketchesInput->value() : false;
+
+			useCurrentAnalysis();
+			SketchTextCache* cache = &analysis_->sketchCache;
+
+			std::vector<Ptr<Sketch>> sketches;
+			std::string scope;
+
+			if (allSketches) {
+				scope = "*";
+				if (scope == analysis_->snapshotScope && analysis_->snapshotGeneration == cache->getGeneration()) {
+					++snapshotCacheStats_.hits;
+					return true;
+				}
+				if (!getDesignSketches(sketches)) {
+					LOG_ERROR("Failed to get design sketches");
+					return false;
+				}
+			}
+			else {
+				Ptr<Sketch> sketch = nullptr;
+				if (!toolsApp->sketchTextPanel->getSelectedSketch(dropdown, sketch)) {
+					LOG_ERROR("Failed to get selected sketch");
 					return false;
 				}
+				// Sketch names need not be unique and can change, the entity token identifies the sketch.
+				// A leading '/' keeps it apart from the all sketches scope
+				scope = "/" + sketch->entityToken();
+				if (scope == analysis_->snapshotScope && analysis_->snapshotGeneration == cache->getGeneration()) {
+					++snapshotCacheStats_.hits;
+					return true;
+				}
+				sketches.push_back(sketch);
+			}
 
-				Ptr<Point3D> center = Point3D::create(
-					(minPoint->x() + maxPoint->x()) / 2.0,
-					(minPoint->y() + maxPoint->y()) / 2.0,
-					(minPoint->z() + maxPoint->z()) / 2.0
-				);
+			// Only sketches that are new or whose revision changed since they were cached are read from the model
+			std::vector<const CachedSketchTexts*> entries;
+			size_t rescanCount = 0;
+			if (!cache->update(sketches, entries, rescanCount)) {
+				LOG_ERROR("Failed to capture sketch texts");
+				return false;
+			}
+			if (allSketches) {
+				size_t prunedCount = cache->prune();
+				if (prunedCount > 0) {
+					LOG_INFO("Dropped the cached texts of {} deleted sketches", prunedCount);
+				}
+			}
+			analysis_->snapshotGeneration = cache->getGeneration();
+
+			bool isSameSketches = rescanCount == 0 && entries.size() == analysis_->snapshot.sketchCount();
+			for (size_t i = 0; isSameSketches && i < entries.size(); ++i) {
+				isSameSketches = entries[i]->sketch.get() == analysis_->snapshot.sketch((unsigned int)i).get();
+			}
+			if (scope == analysis_->snapshotScope && isSameSketches) {
+				++snapshotCacheStats_.hits;
+				return true;
+			}
 
-				//NOLOG: LOG_INFO("Min: " + std::to_string(minPoint->x()) + ", " + std::to_string(minPoint->y()) + ", " + std::to_string(minPoint->z()));
-				//NOLOG: LOG_INFO("Max: " + std::to_string(maxPoint->x()) + ", " + std::to_string(maxPoint->y()) + ", " + std::to_string(maxPoint->z()));
-				//NOLOG: LOG_INFO("Center: " + std::to_string(center->x()) + ", " + std::to_string(center->y()) + ", " + std::to_string(center->z()));
+			++snapshotCacheStats_.misses;
+			analysis_->snapshotScope.clear();
+			analysis_->snapshot.assemble(entries);
+			analysis_->textIndex.build(analysis_->snapshot.records());
+			analysis_->rangeIndex.build(analysis_->snapshot.records());
+			analysis_->textSorter.reset(analysis_->snapshot.size());
+			analysis_->duplicatesScope.clear();
+			analysis_->heightClustersScope.clear();
+			// Record ids change with the snapshot, so the checked rows and the selection start over
+			analysis_->checkedIds.assign(analysis_->snapshot.size(), 0);
+			analysis_->selectedId = SketchTextAnalysis::NO_RECORD;
+			analysis_->snapshotScope = scope;
 
-				if (text) {
-					double textHeight = text->height();
-					if (textHeight >= minHeightValue && textHeight <= maxHeightValue) {
-						filteredTexts.push_back(text);
+			LOG_INFO("Indexed {} sketch texts, {} of {} sketches read from the model", analysis_->snapshot.size(), rescanCount, entries.size());
+			if (toolsApp->sketchTextAnalyses) {
+				// The analysis grew, which may take the documents over their memory budget
+				toolsApp->sketchTextAnalyses->trim();
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// <para>saveTextHeightSettings stores sketch, search scope, height range and sort order in the settings,</para>
+		/// <para>so that the next panel starts where this one left off. Unchanged values cause no write.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		void SketchTextHeightTab::saveTextHeightSettings(const Ptr<CommandInputs>& inputs) const {
+			if (!toolsApp->settingsStore) {
+				return;
+			}
+			Ptr<DropDownCommandInput> dropdown = inputs->itemById(IDS_ITEM_DROPDOWN_SELECT_SKETCH);
+			Ptr<BoolValueCommandInput> allSketchesInput = inputs->itemById(IDS_ITEM_ALL_SKETCHES);
+			Ptr<ValueCommandInput> minTextHeight = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_MIN);
+			Ptr<ValueCommandInput> maxTextHeight = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_MAX);
+			Ptr<DropDownCommandInput> sortOrderInput = inputs->itemById(IDS_ITEM_TEXT_SORT_ORDER);
+			Ptr<BoolValueCommandInput> sortDescendingInput = inputs->itemById(IDS_ITEM_TEXT_SORT_DESCENDING);
+
+			std::shared_ptr<const ToolsSettings> current = toolsApp->settingsStore->get();
+			ToolsSettings settings = *current;
+			if (dropdown && dropdown->selectedItem()) {
+				settings.lastSketchName = dropdown->selectedItem()->name();
+			}
+			if (allSketchesInput) settings.isAllSketches = allSketchesInput->value();
+			if (minTextHeight) settings.textHeightMin = minTextHeight->value();
+			if (maxTextHeight) settings.textHeightMax = maxTextHeight->value();
+			if (sortOrderInput && sortOrderInput->selectedItem()) {
+				settings.sortOrder = (int)sortOrderInput->selectedItem()->index();
+			}
+			if (sortDescendingInput) settings.isSortDescending = sortDescendingInput->value();
+
+			if (settings.lastSketchName == current->lastSketchName && settings.isAllSketches == current->isAllSketches &&
+				settings.textHeightMin == current->textHeightMin && settings.textHeightMax == current->textHeightMax &&
+				settings.sortOrder == current->sortOrder && settings.isSortDescending == current->isSortDescending) {
+				return;
+			}
+			toolsApp->settingsStore->update([&settings](ToolsSettings& target) {
+				target.lastSketchName = settings.lastSketchName;
+				target.isAllSketches = settings.isAllSketches;
+				target.textHeightMin = settings.textHeightMin;
+				target.textHeightMax = settings.textHeightMax;
+				target.sortOrder = settings.sortOrder;
+				target.isSortDescending = settings.isSortDescending;
+			});
+		}
+
+		/// <summary>Gets all sketches of the root component of the active design.</summary>
+		///
+		/// <param name="sketches">[out] The sketches.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::getDesignSketches(std::vector<Ptr<Sketch>>& sketches) const {
+			Ptr<Design> design = toolsApp->activeProduct();
+			if (!design) {
+				LOG_ERROR("No active design");
+				return false;
+			}
+			Ptr<Sketches> rootSketches = design->rootComponent()->sketches();
+			if (!rootSketches) {
+				LOG_ERROR("No sketches found");
+				return false;
+			}
+			sketches.reserve(sketches.size() + rootSketches->count());
+			for (size_t i = 0; i < rootSketches->count(); ++i) {
+				sketches.push_back(rootSketches->item(i));
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// <para>exportTexts asks for a file and streams the texts of the match table, or of all sketches</para>
+		/// <para>of the design, to it. The format follows the chosen file type: CSV or JSON Lines.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds or the user cancels, false if it fails.</returns>
+		bool SketchTextHeightTab::exportTexts(const Ptr<CommandInputs>& inputs) {
+			TraceScope trace("exportTexts", "api");
+			Ptr<BoolValueCommandInput> exportAllInput = inputs->itemById(IDS_ITEM_TEXT_EXPORT_ALL);
+			bool exportAll = exportAllInput ? exportAllInput->value() : false;
+
+			Ptr<FileDialog> fileDialog = toolsUI->createFileDialog();
+			if (!fileDialog) {
+				LOG_ERROR("Failed to create file dialog");
+				return false;
+			}
+			fileDialog->title(LoadStringFromResource(IDS_LABEL_TEXT_EXPORT));
+			fileDialog->filter("CSV (*.csv);;JSON Lines (*.jsonl)");
+			fileDialog->filterIndex(0);
+			fileDialog->initialFilename("SketchTexts.csv");
+			if (fileDialog->showSave() != DialogOK) {
+				return true;
+			}
+			std::string path = fileDialog->filename();
+
+			// Export the whole design from its own snapshot unless the current one already covers it
+			SketchTextSnapshot designSnapshot;
+			const SketchTextSnapshot* snapshot = &analysis_->snapshot;
+			std::vector<uint32_t> ids;
+			if (exportAll) {
+				SketchTextCache* cache = &analysis_->sketchCache;
+				if (analysis_->snapshotScope != "*" || analysis_->snapshotGeneration != cache->getGeneration()) {
+					std::vector<Ptr<Sketch>> sketches;
+					std::vector<const CachedSketchTexts*> entries;
+					size_t rescanCount = 0;
+					if (!getDesignSketches(sketches) || !cache->update(sketches, entries, rescanCount)) {
+						LOG_ERROR("Failed to capture design sketch texts");
+						return false;
 					}
+					cache->prune();
+					designSnapshot.assemble(entries);
+					snapshot = &designSnapshot;
 				}
+				ids.resize(snapshot->size());
+				std::iota(ids.begin(), ids.end(), 0);
+			}
+			else {
+				ids = analysis_->filteredIds;
 			}
 
-			size_t textHeightMatchCount = filteredTexts.size();
+			auto startTime = std::chrono::steady_clock::now();
 
-			matchesTextHeightInput->text(std::to_string(textHeightMatchCount));
+			SketchTextExporter exporter;
+			if (!exporter.open(path, SketchTextExporter::formatFromPath(path))) {
+				LOG_ERROR("Failed to open export file: {}", path);
+				return false;
+			}
+			for (uint32_t id : ids) {
+				const SketchTextRecord& record = snapshot->record(id);
+				Ptr<SketchText> sketchText = snapshot->entity(id);
+				if (!exporter.write(record, snapshot->sketchName(record.sketchIndex), sketchText ? sketchText->entityToken() : "")) {
+					LOG_ERROR("Failed to write export file: {}", path);
+					return false;
+				}
+			}
+			if (!exporter.close()) {
+				LOG_ERROR("Failed to close export file: {}", path);
+				return false;
+			}
 
-			//for (const auto& text : filteredTexts) {
-			//	TRACE("Filtered Text: " + text->text());
-			//}
+			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+			LOG_INFO("Exported {} texts in {} ms to {}", exporter.getRowCount(), elapsed.count(), path);
+			return true;
+		}
+
+		/// <summary>
+		/// <para>updateDuplicates groups the captured texts by normalized content, height and position,</para>
+		/// <para>once per snapshot and only when the duplicates filter is used.</para>
+		/// </summary>
+		void SketchTextHeightTab::updateDuplicates() {
+			if (!analysis_->duplicatesScope.empty() && analysis_->duplicatesScope == analysis_->snapshotScope) {
+				++duplicatesCacheStats_.hits;
+				return;
+			}
+			++duplicatesCacheStats_.misses;
+			analysis_->duplicateFinder.build(analysis_->snapshot.records(), DUPLICATE_HEIGHT_STEP, DUPLICATE_POSITION_STEP,
+				refreshArena_.resource());
+			analysis_->duplicatesScope = analysis_->snapshotScope;
+
+			LOG_INFO("Found {} duplicate groups", analysis_->duplicateFinder.groupCount());
+		}
+
+		/// <summary>
+		/// <para>clearCaches releases the analyses of all documents with their cached sketch texts, snapshots, indexes,</para>
+		/// <para>sort keys and duplicate groups, and the replace plan, so that the next refresh reads everything from the model again.</para>
+		/// </summary>
+		void SketchTextHeightTab::clearCaches() {
+			cancelTextReplacePlan();
+			replacePlan_ = SketchTextReplacePlan();
+			replacePlanBytes_ = 0;
+			previewPoints_ = std::vector<double>();
+			previewIndices_ = std::vector<int>();
+			analysis_->clear();
+			if (toolsApp->sketchTextAnalyses) {
+				toolsApp->sketchTextAnalyses->clear();
+			}
+			queryCache_.clear();
+			compileQueryPresets();
+		}
+
+		/// <summary>Resets the cache and table counters shown in the diagnostics tab.</summary>
+		void SketchTextHeightTab::resetStatistics() {
+			snapshotCacheStats_ = CacheStats();
+			duplicatesCacheStats_ = CacheStats();
+			queryCache_.resetStatistics();
+			if (toolsApp->sketchTextAnalyses) {
+				toolsApp->sketchTextAnalyses->resetStatistics();
+			}
+			else {
+				analysis_->textSorter.resetKeyCounts();
+				analysis_->sketchCache.resetStatistics();
+			}
+			lastRowCount_ = 0;
+			totalRowCount_ = 0;
+		}
+
+		/// <summary>Estimates the heap memory held by the caches of the tab and the analyses of all documents.</summary>
+		///
+		/// <returns>The memory in bytes.</returns>
+		size_t SketchTextHeightTab::getCacheMemoryUsage() const {
+			return previewPoints_.capacity() * sizeof(double)
+				+ previewIndices_.capacity() * sizeof(int)
+				+ refreshArena_.getCapacity()
+				+ (rowMaterializer_ ? rowMaterializer_->getMemoryUsage() : 0)
+				+ queryCache_.getMemoryUsage()
+				+ replacePlanBytes_
+				+ (toolsApp->sketchTextAnalyses ? toolsApp->sketchTextAnalyses->getMemoryUsage() : analysis_->getMemoryUsage());
+		}
+
+		/// <summary>Gets all texts of the duplicate group shown in the given table row.</summary>
+		///
+		/// <param name="row">		 The table row number, starting at 1.</param>
+		/// <param name="groupTexts">[out] The texts of the group, empty if the row has no group.</param>
+		///
+		/// <returns>True if the row belongs to a duplicate group, false otherwise.</returns>
+		bool SketchTextHeightTab::getDuplicateGroupTexts(unsigned int row, std::vector<Ptr<SketchText>>& groupTexts) const {
+			groupTexts.clear();
+			if (!isDuplicatesOnly_ || row == 0 || row > analysis_->filteredIds.size()) {
+				return false;
+			}
+			uint32_t groupIndex = analysis_->duplicateFinder.groupOf(analysis_->filteredIds[row - 1]);
+			if (groupIndex == SketchTextDuplicateFinder::NO_GROUP) {
+				return false;
+			}
+
+			std::vector<uint32_t> ids;
+			analysis_->duplicateFinder.group(groupIndex, ids);
+			groupTexts.reserve(ids.size());
+			for (uint32_t id : ids) {
+				groupTexts.push_back(analysis_->snapshot.entity(id));
+			}
 			return true;
 		}
 
 		unsigned int SketchTextHeightTab::getSelectedRowNumber(std::string& inputId) {
+			std::string_view cellId;
 			unsigned int selectedRow = 0;
-			std::smatch match;
-			std::string expression = 
-				std::format("^({}|{}|{}|{})_(\\d+)$", IDS_CELL_TEXT_ID, IDS_CELL_TEXT_VALUE, IDS_CELL_TEXT_HEIGHT, IDS_CELL_TEXT_TOGGLE);
-
-			if (std::regex_match(inputId, match, std::regex(expression))) {
-				selectedRow = std::stoi(match[2]);
+			if (!parseTextCellId(inputId, cellId, selectedRow)) {
+				return 0;
 			}
 
 			return selectedRow;
 		}
 
+		/// <summary>
+		/// <para>parseTextCellId splits the input id of a cell of the match table into its column id and row,</para>
+		/// <para>returning false for the ids of other inputs.</para>
+		/// </summary>
+		///
+		/// <param name="inputId">The input id.</param>
+		/// <param name="cellId"> [out] The column id of the cell.</param>
+		/// <param name="row">	  [out] The row of the cell.</param>
+		///
+		/// <returns>True if the input is a cell of the match table.</returns>
+		bool SketchTextHeightTab::parseTextCellId(std::string_view inputId, std::string_view& cellId, unsigned int& row) {
+			if (!parseCellId(inputId, cellId, row)) {
+				return false;
+			}
+			return cellId == IDS_CELL_TEXT_ID || cellId == IDS_CELL_TEXT_VALUE || cellId == IDS_CELL_TEXT_HEIGHT || cellId == IDS_CELL_TEXT_TOGGLE;
+		}
+
+		/// <summary>Reads the match mode drop down; its items follow SketchTextMatchMode.</summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>The match mode, InHeightRange if none is selected.</returns>
+		SketchTextMatchMode SketchTextHeightTab::getMatchMode(const Ptr<CommandInputs>& inputs) {
+			Ptr<DropDownCommandInput> matchModeInput = inputs->itemById(IDS_ITEM_TEXT_MATCH_MODE);
+			if (!matchModeInput || !matchModeInput->selectedItem()) {
+				return SketchTextMatchMode::InHeightRange;
+			}
+			return static_cast<SketchTextMatchMode>(matchModeInput->selectedItem()->index());
+		}
+
+		/// <summary>
+		/// <para>setTextChecked keeps the state of the toggle cell of a row with the record it shows, so that</para>
+		/// <para>the Checked match mode can select it and a later fill shows it checked again.</para>
+		/// </summary>
+		///
+		/// <param name="row">		The row, starting at 1.</param>
+		/// <param name="isChecked">The state of the toggle cell.</param>
+		void SketchTextHeightTab::setTextChecked(unsigned int row, bool isChecked) {
+			if (row == 0 || row > analysis_->filteredIds.size()) {
+				return;
+			}
+			uint32_t id = analysis_->filteredIds[row - 1];
+			if (id < analysis_->checkedIds.size()) {
+				analysis_->checkedIds[id] = isChecked ? 1 : 0;
+			}
+		}
+
 		Ptr<SketchText> SketchTextHeightTab::getTextById(const unsigned int id) const
 		{
-			auto it = idTextMap_.find(id);
-			if (it != idTextMap_.end())
-				return it->second;
-			return nullptr;
+			const auto& rowTexts = analysis_->rowTexts;
+			if (id == 0 || id > rowTexts.size())
+				return nullptr;
+			return rowTexts[id - 1];
 		}
 
 		SketchTextHeightTab* SketchTextHeightTab::get() { 
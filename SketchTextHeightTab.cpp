@@ -1,28 +1,80 @@
 #include "pch.h"
 #include "resource.h"  
 #include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::SketchText
 #include "Logging.h"
+#include "Profiler.h"
 #include "ToolsBar.h"
 #include "ToolsApp.h"
 #include "ImplicateXFusionToolsAddIn.h"
+#include "SettingsStore.h"
 #include "SketchTextCommandControl.h"
 #include "SketchTextSettingsTab.h"
+#include "SketchTextDiagnosticsTab.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSnapshot.h"
+#include "SketchTextCache.h"
+#include "CellId.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextSorter.h"
+#include "SketchTextReplacer.h"
+#include "SketchTextDuplicateFinder.h"
+#include "SketchTextHeightClusterer.h"
+#include "SketchTextExporter.h"
+#include "SketchTextFilter.h"
+#include "SketchTextQuery.h"
+#include "RefreshArena.h"
+#include "TableRowMaterializer.h"
+#include "SketchTextAnalysis.h"
 #include "SketchTextHeightTab.h"
 #include "SketchTextPanel.h"
 
 namespace implicatex {
 	namespace fusion {
+		/// <summary>
+		/// <para>The destructor cancels a running replace worker, waits for it to leave</para>
+		/// <para>and unregisters the custom event it reports to.</para>
+		/// </summary>
+		SketchTextHeightTab::~SketchTextHeightTab() {
+			cancelTextReplacePlan();
+			if (toolsApp) {
+				toolsApp->unregisterCustomEvent(IDS_EVENT_TEXT_REPLACE_PLANNED);
+			}
+		}
+
 		bool SketchTextHeightTab::initialize(Ptr<Command> command, const Ptr<TabCommandInput>& tabInput) {
 			actions_.insert({ std::string(IDS_ITEM_DROPDOWN_SELECT_SKETCH), &SketchTextHeightTab::dropDownSelected});
 			actions_.insert({ std::string(IDS_ITEM_TEXT_HEIGHT_REPLACE), &SketchTextHeightTab::textHeightReplaced});
 			actions_.insert({ std::string(IDS_ITEM_TEXT_HEIGHT_MIN), &SketchTextHeightTab::textHeightChanged });
 			actions_.insert({ std::string(IDS_ITEM_TEXT_HEIGHT_MAX), &SketchTextHeightTab::textHeightChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_HEIGHT_TOLERANCE), &SketchTextHeightTab::textHeightSuggested });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_HEIGHT_SUGGEST), &SketchTextHeightTab::textHeightSuggested });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_HEIGHT_SIZES), &SketchTextHeightTab::textHeightSizeSelected });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_HEIGHT_NEW), &SketchTextHeightTab::textHeightPreviewed });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_HEIGHT_PREVIEW), &SketchTextHeightTab::textHeightPreviewed });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_CONTENT_FILTER), &SketchTextHeightTab::textContentChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_CONTENT_PREFIX), &SketchTextHeightTab::textContentChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_QUERY), &SketchTextHeightTab::textContentChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_QUERY_PRESET), &SketchTextHeightTab::textQueryPresetSelected });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_QUERY_PRESET_SAVE), &SketchTextHeightTab::textQueryPresetSaved });
+			actions_.insert({ std::string(IDS_ITEM_ALL_SKETCHES), &SketchTextHeightTab::sketchScopeChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_DUPLICATES_ONLY), &SketchTextHeightTab::textDuplicatesChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_MATCH_MODE), &SketchTextHeightTab::textMatchModeChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_SORT_ORDER), &SketchTextHeightTab::textSortChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_SORT_DESCENDING), &SketchTextHeightTab::textSortChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_FIND), &SketchTextHeightTab::textReplaceChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_REPLACE_WITH), &SketchTextHeightTab::textReplaceChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_FIND_REGEX), &SketchTextHeightTab::textReplaceChanged });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_CONTENT_REPLACE), &SketchTextHeightTab::textContentReplaced });
+			actions_.insert({ std::string(IDS_ITEM_TEXT_EXPORT), &SketchTextHeightTab::textExported });
 			actions_.insert({ std::string(IDS_CELL_TEXT_ID), &SketchTextHeightTab::textIdCellSelected });
 			actions_.insert({ std::string(IDS_CELL_TEXT_VALUE), &SketchTextHeightTab::textValueCellSelected });
 			actions_.insert({ std::string(IDS_CELL_TEXT_HEIGHT), &SketchTextHeightTab::textHeightCellSelected });
 			actions_.insert({ std::string(IDS_CELL_TEXT_TOGGLE), &SketchTextHeightTab::textToggleCellSelected });
 
 			textValueCellInput_ = nullptr;
+			useCurrentAnalysis();
 
 			Ptr<CommandInputs> tabInputs = tabInput->children();
 			if (!tabInputs) {
@@ -46,6 +98,11 @@ namespace implicatex {
 
 			tabInputs->addSeparatorCommandInput(IDS_ITEM_TEXT_HEIGHT_MATCH_SEPARATOR);
 
+			if (!addTextSortOrder(tabInputs)) {
+				LOG_ERROR("Failed to add text sort order");
+				return false;
+			}
+
 			if (!addTextHeightMatchTable(tabInputs)) {
 				LOG_ERROR("Failed to add text size match");
 				return false;
@@ -53,11 +110,23 @@ namespace implicatex {
 
 			tabInputs->addSeparatorCommandInput(IDS_ITEM_TEXT_HEIGHT_MATCH_SEPARATOR);
 
+			if (!addTextHeightSuggestion(tabInputs)) {
+				LOG_ERROR("Failed to add text height suggestion");
+				return false;
+			}
+
 			Ptr<ValueInput> newTextHeightInput = ValueInput::createByReal(1.0);
 			Ptr<ValueCommandInput> newTextHeightCmdInput = 
 				tabInputs->addValueInput(IDS_ITEM_TEXT_HEIGHT_NEW, 
 					LoadStringFromResource(IDS_LABEL_TEXT_HEIGHT_NEW), IDS_UNIT_MM, newTextHeightInput);
 
+			Ptr<BoolValueCommandInput> previewInput =
+				tabInputs->addBoolValueInput(IDS_ITEM_TEXT_HEIGHT_PREVIEW, LoadStringFromResource(IDS_LABEL_TEXT_HEIGHT_PREVIEW), true, "", false);
+			if (!previewInput) {
+				LOG_ERROR("Failed to add text height preview command input");
+				return false;
+			}
+
 			std::string buttonLabel = LoadStringFromResource(IDS_LABEL_TEXT_HEIGHT_REPLACE);
 
 			Ptr<BoolValueCommandInput> replaceButton = 
@@ -72,7 +141,30 @@ namespace implicatex {
 			replaceButton->text(" " + buttonLabel);
 			replaceButton->resourceFolder(IDS_PATH_ICON_SKETCH_TEXT_HEIGHT);
 
+			tabInputs->addSeparatorCommandInput(IDS_ITEM_TEXT_REPLACE_SEPARATOR);
+
+			if (!addTextContentReplace(tabInputs)) {
+				LOG_ERROR("Failed to add text content replace");
+				return false;
+			}
+
+			tabInputs->addSeparatorCommandInput(IDS_ITEM_TEXT_EXPORT_SEPARATOR);
+
+			if (!addTextExport(tabInputs)) {
+				LOG_ERROR("Failed to add text export");
+				return false;
+			}
+
+			toolsApp->unregisterCustomEvent(IDS_EVENT_TEXT_REPLACE_PLANNED);
+			Ptr<CustomEvent> replacePlannedEvent = toolsApp->registerCustomEvent(IDS_EVENT_TEXT_REPLACE_PLANNED);
+			if (!replacePlannedEvent) {
+				LOG_ERROR("Failed to register text replace event");
+				return false;
+			}
+			replacePlannedEvent->add(new SketchTextReplacePlannedEventHandler());
+
 			command->inputChanged()->add(new SketchTextHeightTabInputChangedEventHandler());
+			command->execute()->add(new SketchTextHeightTabExecuteEventHandler());
 
 			return true;
 		}
@@ -88,14 +180,29 @@ namespace implicatex {
 				LOG_ERROR("Invalid inputs");
 				return false;
 			}
+			std::shared_ptr<const ToolsSettings> settings = ToolsApp::getSettings();
 			std::string selectSketchLabel = LoadStringFromResource(IDS_LABEL_SELECT_SKETCH);
 			dropdown = 
 				inputs->addDropDownCommandInput(IDS_ITEM_DROPDOWN_SELECT_SKETCH, selectSketchLabel, DropDownStyles::LabeledIconDropDownStyle);
 			Ptr<Design> design = toolsApp->activeProduct();
 			Ptr<Sketches> sketches = design->rootComponent()->sketches();
+			// Preselect the sketch used last, if it still exists
+			size_t selectedIndex = 0;
+			for (size_t i = 0; i < sketches->count(); ++i) {
+				if (sketches->item(i)->name() == settings->lastSketchName) {
+					selectedIndex = i;
+					break;
+				}
+			}
 			for (size_t i = 0; i < sketches->count(); ++i) {
 				Ptr<Sketch> sketch = sketches->item(i);
-				dropdown->listItems()->add(sketch->name(), (i == 0) ? true : false, IDS_PATH_ICON_SKETCH_TEXT);
+				dropdown->listItems()->add(sketch->name(), (i == selectedIndex) ? true : false, IDS_PATH_ICON_SKETCH_TEXT);
+			}
+			Ptr<BoolValueCommandInput> allSketches =
+				inputs->addBoolValueInput(IDS_ITEM_ALL_SKETCHES, LoadStringFromResource(IDS_LABEL_ALL_SKETCHES), true, "", settings->isAllSketches);
+			if (!allSketches) {
+				LOG_ERROR("Failed to add all sketches command input");
+				return false;
 			}
 			return true;
 		}
@@ -113,8 +220,9 @@ namespace implicatex {
 				LOG_ERROR("Failed to add text box command input");
 				return false;
 			}
-			Ptr<ValueInput> minTextHeightInput = ValueInput::createByReal(0.0);
-			Ptr<ValueInput> maxTextHeightInput = ValueInput::createByReal(1.0);
+			std::shared_ptr<const ToolsSettings> settings = ToolsApp::getSettings();
+			Ptr<ValueInput> minTextHeightInput = ValueInput::createByReal(settings->textHeightMin);
+			Ptr<ValueInput> maxTextHeightInput = ValueInput::createByReal(settings->textHeightMax);
 
 			Ptr<ValueCommandInput> minTextHeight = 
 				inputs->addValueInput(IDS_ITEM_TEXT_HEIGHT_MIN, 
@@ -130,6 +238,255 @@ namespace implicatex {
 				LOG_ERROR("Failed to add max text height command input");
 				return false;
 			}
+			Ptr<StringValueCommandInput> contentFilter =
+				inputs->addStringValueInput(IDS_ITEM_TEXT_CONTENT_FILTER,
+					LoadStringFromResource(IDS_LABEL_TEXT_CONTENT_FILTER), "");
+			if (!contentFilter) {
+				LOG_ERROR("Failed to add text content filter command input");
+				return false;
+			}
+			Ptr<BoolValueCommandInput> contentPrefix =
+				inputs->addBoolValueInput(IDS_ITEM_TEXT_CONTENT_PREFIX,
+					LoadStringFromResource(IDS_LABEL_TEXT_CONTENT_PREFIX), true, "", false);
+			if (!contentPrefix) {
+				LOG_ERROR("Failed to add text content prefix command input");
+				return false;
+			}
+			Ptr<StringValueCommandInput> query =
+				inputs->addStringValueInput(IDS_ITEM_TEXT_QUERY, LoadStringFromResource(IDS_LABEL_TEXT_QUERY), "");
+			if (!query) {
+				LOG_ERROR("Failed to add text query command input");
+				return false;
+			}
+			query->tooltip(LoadStringFromResource(IDS_LABEL_TEXT_QUERY_TOOLTIP));
+			if (!addTextQueryPresets(inputs)) {
+				LOG_ERROR("Failed to add query presets");
+				return false;
+			}
+			Ptr<BoolValueCommandInput> duplicatesOnly =
+				inputs->addBoolValueInput(IDS_ITEM_TEXT_DUPLICATES_ONLY,
+					LoadStringFromResource(IDS_LABEL_TEXT_DUPLICATES_ONLY), true, "", false);
+			if (!duplicatesOnly) {
+				LOG_ERROR("Failed to add duplicates only command input");
+				return false;
+			}
+			Ptr<DropDownCommandInput> matchMode =
+				inputs->addDropDownCommandInput(IDS_ITEM_TEXT_MATCH_MODE,
+					LoadStringFromResource(IDS_LABEL_TEXT_MATCH_MODE), DropDownStyles::TextListDropDownStyle);
+			if (!matchMode) {
+				LOG_ERROR("Failed to add match mode command input");
+				return false;
+			}
+			// Item order must follow SketchTextMatchMode
+			matchMode->listItems()->add(LoadStringFromResource(IDS_LABEL_MATCH_IN_RANGE), true);
+			matchMode->listItems()->add(LoadStringFromResource(IDS_LABEL_MATCH_OUTSIDE_RANGE), false);
+			matchMode->listItems()->add(LoadStringFromResource(IDS_LABEL_MATCH_OFF_NEW_HEIGHT), false);
+			matchMode->listItems()->add(LoadStringFromResource(IDS_LABEL_MATCH_CHECKED), false);
+			matchMode->listItems()->add(LoadStringFromResource(IDS_LABEL_MATCH_SELECTED_SKETCH), false);
+			return true;
+		}
+
+		/// <summary>
+		/// <para>addTextQueryPresets adds the drop down of the saved queries, the name to save the current query under</para>
+		/// <para>and the save button, and compiles the presets so that picking one runs its plan right away.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::addTextQueryPresets(const Ptr<CommandInputs>& inputs) {
+			Ptr<DropDownCommandInput> presets =
+				inputs->addDropDownCommandInput(IDS_ITEM_TEXT_QUERY_PRESET,
+					LoadStringFromResource(IDS_LABEL_TEXT_QUERY_PRESET), DropDownStyles::TextListDropDownStyle);
+			if (!presets) {
+				LOG_ERROR("Failed to add query preset command input");
+				return false;
+			}
+			fillQueryPresets(presets, "");
+
+			Ptr<StringValueCommandInput> presetName =
+				inputs->addStringValueInput(IDS_ITEM_TEXT_QUERY_PRESET_NAME, LoadStringFromResource(IDS_LABEL_TEXT_QUERY_PRESET_NAME), "");
+			if (!presetName) {
+				LOG_ERROR("Failed to add query preset name command input");
+				return false;
+			}
+
+			std::string buttonLabel = LoadStringFromResource(IDS_LABEL_TEXT_QUERY_PRESET_SAVE);
+			Ptr<BoolValueCommandInput> saveButton =
+				inputs->addBoolValueInput(IDS_ITEM_TEXT_QUERY_PRESET_SAVE, buttonLabel, false);
+			if (!saveButton) {
+				LOG_ERROR("Failed to add save preset button");
+				return false;
+			}
+			saveButton->tooltip(buttonLabel);
+			saveButton->text(" " + buttonLabel);
+
+			compileQueryPresets();
+			return true;
+		}
+
+		/// <summary>Lists None and the presets of the settings, selecting the one with the name or None.</summary>
+		///
+		/// <param name="presetInput"> The preset drop down.</param>
+		/// <param name="selectedName">The name of the preset to select, empty for None.</param>
+		void SketchTextHeightTab::fillQueryPresets(const Ptr<DropDownCommandInput>& presetInput, const std::string& selectedName) const {
+			std::shared_ptr<const ToolsSettings> settings = ToolsApp::getSettings();
+			Ptr<ListItems> items = presetInput->listItems();
+			items->clear();
+			// Item 0 is None, item i the preset i - 1 of the settings
+			items->add(LoadStringFromResource(IDS_LABEL_QUERY_PRESET_NONE), selectedName.empty());
+			for (const QueryPreset& preset : settings->queryPresets) {
+				items->add(preset.name, preset.name == selectedName);
+			}
+		}
+
+		/// <summary>Adds the sort column drop down and the descending option for the match table.</summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::addTextSortOrder(const Ptr<CommandInputs>& inputs) {
+			Ptr<DropDownCommandInput> sortOrder =
+				inputs->addDropDownCommandInput(IDS_ITEM_TEXT_SORT_ORDER,
+					LoadStringFromResource(IDS_LABEL_TEXT_SORT_ORDER), DropDownStyles::TextListDropDownStyle);
+			if (!sortOrder) {
+				LOG_ERROR("Failed to add sort order command input");
+				return false;
+			}
+			std::shared_ptr<const ToolsSettings> settings = ToolsApp::getSettings();
+			int selectedOrder = settings->sortOrder;
+			// Item order must follow SketchTextSortOrder
+			sortOrder->listItems()->add(LoadStringFromResource(IDS_LABEL_SORT_COLLECTION), selectedOrder == (int)SketchTextSortOrder::Collection);
+			sortOrder->listItems()->add(LoadStringFromResource(IDS_LABEL_SORT_TEXT), selectedOrder == (int)SketchTextSortOrder::Text);
+			sortOrder->listItems()->add(LoadStringFromResource(IDS_LABEL_SORT_HEIGHT), selectedOrder == (int)SketchTextSortOrder::Height);
+			sortOrder->listItems()->add(LoadStringFromResource(IDS_LABEL_SORT_POSITION), selectedOrder == (int)SketchTextSortOrder::Position);
+
+			Ptr<BoolValueCommandInput> descending =
+				inputs->addBoolValueInput(IDS_ITEM_TEXT_SORT_DESCENDING,
+					LoadStringFromResource(IDS_LABEL_TEXT_SORT_DESCENDING), true, "", settings->isSortDescending);
+			if (!descending) {
+				LOG_ERROR("Failed to add sort descending command input");
+				return false;
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// <para>addTextContentReplace adds the find and replace inputs for text contents,</para>
+		/// <para>a read only preview of the number of texts that will change and the replace button.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::addTextContentReplace(const Ptr<CommandInputs>& inputs) {
+			Ptr<StringValueCommandInput> findInput =
+				inputs->addStringValueInput(IDS_ITEM_TEXT_FIND, LoadStringFromResource(IDS_LABEL_TEXT_FIND), "");
+			if (!findInput) {
+				LOG_ERROR("Failed to add find text command input");
+				return false;
+			}
+			Ptr<StringValueCommandInput> replaceInput =
+				inputs->addStringValueInput(IDS_ITEM_TEXT_REPLACE_WITH, LoadStringFromResource(IDS_LABEL_TEXT_REPLACE_WITH), "");
+			if (!replaceInput) {
+				LOG_ERROR("Failed to add replace text command input");
+				return false;
+			}
+			Ptr<BoolValueCommandInput> regexInput =
+				inputs->addBoolValueInput(IDS_ITEM_TEXT_FIND_REGEX, LoadStringFromResource(IDS_LABEL_TEXT_FIND_REGEX), true, "", false);
+			if (!regexInput) {
+				LOG_ERROR("Failed to add regular expression command input");
+				return false;
+			}
+			replacePreviewInput_ =
+				inputs->addTextBoxCommandInput(IDS_ITEM_TEXT_REPLACE_PREVIEW,
+					LoadStringFromResource(IDS_LABEL_TEXT_REPLACE_PREVIEW), "", 1, true);
+			if (!replacePreviewInput_) {
+				LOG_ERROR("Failed to add replace preview command input");
+				return false;
+			}
+
+			std::string buttonLabel = LoadStringFromResource(IDS_LABEL_TEXT_CONTENT_REPLACE);
+
+			Ptr<BoolValueCommandInput> replaceButton =
+				inputs->addBoolValueInput(IDS_ITEM_TEXT_CONTENT_REPLACE, buttonLabel, false);
+			if (!replaceButton) {
+				LOG_ERROR("Failed to add replace texts button");
+				return false;
+			}
+
+			replaceButton->tooltip(buttonLabel);
+			replaceButton->text(" " + buttonLabel);
+			replaceButton->resourceFolder(IDS_PATH_ICON_SKETCH_TEXT);
+			return true;
+		}
+
+		/// <summary>
+		/// <para>addTextHeightSuggestion adds the tolerance, the button that suggests standard sizes for the heights</para>
+		/// <para>of the captured texts and the drop down that lists them; picking one prepares the height replace.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::addTextHeightSuggestion(const Ptr<CommandInputs>& inputs) {
+			Ptr<ValueCommandInput> tolerance =
+				inputs->addValueInput(IDS_ITEM_TEXT_HEIGHT_TOLERANCE,
+					LoadStringFromResource(IDS_LABEL_TEXT_HEIGHT_TOLERANCE), IDS_UNIT_MM, ValueInput::createByReal(SIZE_TOLERANCE));
+			if (!tolerance) {
+				LOG_ERROR("Failed to add size tolerance command input");
+				return false;
+			}
+
+			std::string buttonLabel = LoadStringFromResource(IDS_LABEL_TEXT_HEIGHT_SUGGEST);
+
+			Ptr<BoolValueCommandInput> suggestButton =
+				inputs->addBoolValueInput(IDS_ITEM_TEXT_HEIGHT_SUGGEST, buttonLabel, false);
+			if (!suggestButton) {
+				LOG_ERROR("Failed to add suggest sizes button");
+				return false;
+			}
+
+			suggestButton->tooltip(buttonLabel);
+			suggestButton->text(" " + buttonLabel);
+			suggestButton->resourceFolder(IDS_PATH_ICON_SKETCH_TEXT_HEIGHT);
+
+			Ptr<DropDownCommandInput> sizes =
+				inputs->addDropDownCommandInput(IDS_ITEM_TEXT_HEIGHT_SIZES,
+					LoadStringFromResource(IDS_LABEL_TEXT_HEIGHT_SIZES), DropDownStyles::TextListDropDownStyle);
+			if (!sizes) {
+				LOG_ERROR("Failed to add standard sizes command input");
+				return false;
+			}
+			analysis_->heightSizes.clear();
+			return true;
+		}
+
+		/// <summary>Adds the whole design option and the export button.</summary>
+		///
+		/// <param name="inputs">The inputs.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::addTextExport(const Ptr<CommandInputs>& inputs) {
+			Ptr<BoolValueCommandInput> exportAll =
+				inputs->addBoolValueInput(IDS_ITEM_TEXT_EXPORT_ALL, LoadStringFromResource(IDS_LABEL_TEXT_EXPORT_ALL), true, "", false);
+			if (!exportAll) {
+				LOG_ERROR("Failed to add export all command input");
+				return false;
+			}
+
+			std::string buttonLabel = LoadStringFromResource(IDS_LABEL_TEXT_EXPORT);
+
+			Ptr<BoolValueCommandInput> exportButton =
+				inputs->addBoolValueInput(IDS_ITEM_TEXT_EXPORT, buttonLabel, false);
+			if (!exportButton) {
+				LOG_ERROR("Failed to add export button");
+				return false;
+			}
+
+			exportButton->tooltip(buttonLabel);
+			exportButton->text(" " + buttonLabel);
+			exportButton->resourceFolder(IDS_PATH_ICON_SKETCH_TEXT);
 			return true;
 		}
 
@@ -139,6 +496,7 @@ namespace implicatex {
 		///
 		/// <returns>True if it succeeds, false if it fails.</returns>
 		bool SketchTextHeightTab::addTextHeightMatchTable(const Ptr<CommandInputs>& inputs) {
+			ScopedSpan span(ProfileSpan::TextHeightMatchTable);
 			Ptr<TextBoxCommandInput> textHeightMatch = 
 				inputs->addTextBoxCommandInput(IDS_ITEM_TEXT_HEIGHT_MATCH, 
 					LoadStringFromResource(IDS_LABEL_TEXT_HEIGHT_MATCH), "", 1, true);
@@ -146,7 +504,8 @@ namespace implicatex {
 				LOG_ERROR("Failed to add text size match command input");
 				return false;
 			}
-			std::vector<Ptr<SketchText>> filteredTexts;
+			ScopedArena arena(refreshArena_);
+			std::pmr::vector<Ptr<SketchText>> filteredTexts(refreshArena_.resource());
 			if (!getTextHeightMatchItems(inputs, filteredTexts)) {
 				LOG_ERROR("Failed to get text size match");
 				return false;
@@ -168,48 +527,105 @@ namespace implicatex {
 			tableInput->columnSpacing(1);
 			tableInput->rowSpacing(1);
 
-			SketchTextHeightTab* heightTab = toolsApp->sketchTextPanel->getTextHeightTab().get();
+			return fillTextHeightMatchTable(tableInput, filteredTexts);
+		}
+
+		/// <summary>
+		/// <para>fillTextHeightMatchTable adds one row of id, text, height and toggle cells per filtered text</para>
+		/// <para>and maps each row number to its sketch text for the cell selection actions. The cell ids, row</para>
+		/// <para>numbers and height texts come from the row materializer, so that a fill allocates nothing per row</para>
+		/// <para>on this side of the API once the table has been that large before.</para>
+		/// </summary>
+		///
+		/// <param name="tableInput">   The match table.</param>
+		/// <param name="filteredTexts">The texts to show, in row order.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::fillTextHeightMatchTable(const Ptr<TableCommandInput>& tableInput, const std::pmr::vector<Ptr<SketchText>>& filteredTexts) {
+			ScopedSpan span(ProfileSpan::FillTextHeightMatchTable);
+			Ptr<CommandInputs> inputs = tableInput->commandInputs();
+			if (!inputs) {
+				LOG_ERROR("Failed to get table command inputs");
+				return false;
+			}
+
+			auto& rowTexts = analysis_->rowTexts;
 
-			auto& idTextMap = heightTab->idTextMap_;
+			rowTexts.clear();
 
-			idTextMap.clear();
+			unsigned int rowCount = (unsigned int)filteredTexts.size();
+			unsigned int pageSize = ToolsApp::getSettings()->tablePageSize;
+			if (pageSize > 0) {
+				rowCount = (std::min)(rowCount, pageSize);
+			}
+			lastRowCount_ = rowCount;
+			totalRowCount_ += rowCount;
+
+			if (!rowMaterializer_) {
+				rowMaterializer_ = std::make_unique<TableRowMaterializer>(
+					std::vector<std::string_view>{ IDS_CELL_TEXT_ID, IDS_CELL_TEXT_VALUE, IDS_CELL_TEXT_HEIGHT, IDS_CELL_TEXT_TOGGLE }, IDS_UNIT_MM);
+			}
+			TableRowMaterializer& cells = *rowMaterializer_;
+			const std::vector<uint32_t>& filteredIds = analysis_->filteredIds;
+			const std::vector<uint8_t>& checkedIds = analysis_->checkedIds;
+			cells.reserve(rowCount);
+			rowTexts.reserve(rowCount);
 
-			for (unsigned int row = 0; row < (unsigned int)filteredTexts.size(); ++row) {
+			for (unsigned int row = 0; row < rowCount; ++row) {
 				unsigned int key = row + 1;
 
-				Ptr<SketchText> sketchText = filteredTexts[row];
+				const Ptr<SketchText>& sketchText = filteredTexts[row];
 
 				// Column 1: ID
 				Ptr<StringValueCommandInput> idInput = inputs->addStringValueInput(
-					std::format("{}_{}", IDS_CELL_TEXT_ID, key), "", std::to_string(key));
+					cells.cellId(0, key), "", cells.rowNumber(key));
 				idInput->isReadOnly(true);
 				tableInput->addCommandInput(idInput, row, 0);
 
 				// Column 2: Text
 				Ptr<StringValueCommandInput> textInput = inputs->addStringValueInput(
-					std::format("{}_{}", IDS_CELL_TEXT_VALUE, key),	"",  sketchText->text());
+					cells.cellId(1, key), "", sketchText->text());
 				textInput->isReadOnly(true);
 				tableInput->addCommandInput(textInput, row, 1);
 
 				// Column 3: Height
 				double heightCm = sketchText->height();
 				double heightMm = heightCm * 10.0;
-				std::ostringstream heightString;
-				heightString << std::fixed << std::setprecision(2) << heightMm << " " << IDS_UNIT_MM;
 				Ptr<StringValueCommandInput> heightInput = inputs->addStringValueInput(
-					std::format("{}_{}", IDS_CELL_TEXT_HEIGHT, key), "", heightString.str()	);
+					cells.cellId(2, key), "", cells.formatLength(heightMm, 2));
 				heightInput->isReadOnly(true);
 				tableInput->addCommandInput(heightInput, row, 2);
 
 				// Column 4: Toggle (checkbox)
 				Ptr<BoolValueCommandInput> toggleInput = inputs->addBoolValueInput(
-					std::format("{}_{}", IDS_CELL_TEXT_TOGGLE, key), "", true, "", false);
+					cells.cellId(3, key), "", true, "", row < filteredIds.size() && filteredIds[row] < checkedIds.size() && checkedIds[filteredIds[row]] != 0);
 				tableInput->addCommandInput(toggleInput, row, 3);
 
-				idTextMap[key] = sketchText;
+				rowTexts.push_back(sketchText);
 			}
 
 			return true;
 		}
+
+		/// <summary>
+		/// <para>updateTextHeightMatchTable replaces the rows of the match table with the given texts,</para>
+		/// <para>used whenever the filter criteria or the searched sketches change.</para>
+		/// </summary>
+		///
+		/// <param name="inputs">		The inputs.</param>
+		/// <param name="filteredTexts">The texts to show, in row order.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextHeightTab::updateTextHeightMatchTable(const Ptr<CommandInputs>& inputs, const std::pmr::vector<Ptr<SketchText>>& filteredTexts) {
+			Ptr<TableCommandInput> tableInput = inputs->itemById(IDS_ITEM_TEXT_HEIGHT_TABLE);
+			if (!tableInput) {
+				LOG_ERROR("TableCommandInput not found");
+				return false;
+			}
+
+			tableInput->clear();
+
+			return fillTextHeightMatchTable(tableInput, filteredTexts);
+		}
 	}
 }
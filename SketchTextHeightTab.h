@@ -14,24 +14,107 @@ namespace implicatex {
 		public:
 			void notify(const Ptr<InputChangedEventArgs>& eventArgs) override;
 		};
+
+		/// <summary>
+		/// <para>SketchTextReplacePlannedEventHandler receives the custom event fired by the replace worker</para>
+		/// <para>and hands the finished plan to the height tab on the main thread.</para>
+		/// </summary>
+		class SketchTextReplacePlannedEventHandler : public CustomEventHandler {
+		public:
+			void notify(const Ptr<CustomEventArgs>& eventArgs) override;
+		};
+
+		/// <summary>
+		/// <para>SketchTextHeightTabExecuteEventHandler writes the edit requested by a replace button. Fusion records</para>
+		/// <para>the changes of an execute event as one transaction, so the edit is undone in a single step.</para>
+		/// </summary>
+		class SketchTextHeightTabExecuteEventHandler : public CommandEventHandler {
+		public:
+			void notify(const Ptr<CommandEventArgs>& eventArgs) override;
+		};
 		#pragma endregion
 
 		class SketchTextHeightTab
 		{
 		public:
+			/// <summary>Edit requested by a replace button and written by the next execute event.</summary>
+			enum class PendingEdit { None, TextHeight, TextContent };
+
+			/// <summary>Largest differences of duplicates in cm: 0.01 mm for heights, 0.1 mm for positions.</summary>
+			static constexpr double DUPLICATE_HEIGHT_STEP = 0.001;
+			static constexpr double DUPLICATE_POSITION_STEP = 0.01;
+			/// <summary>Default tolerance of the standard size suggestion in cm (0.05 mm).</summary>
+			static constexpr double SIZE_TOLERANCE = 0.005;
+			/// <summary>Opacity of the ghost rectangles of the height preview.</summary>
+			static constexpr double PREVIEW_OPACITY = 0.5;
+
+			~SketchTextHeightTab();
+
 			bool initialize(Ptr<Command> command, const Ptr<TabCommandInput>& tabInput);
 
 			#pragma region Design
 			bool addSketchDropDown(const Ptr<CommandInputs>& inputs, Ptr<DropDownCommandInput>& dropdown);
 			bool addTextHeightFilter(const Ptr<CommandInputs>& inputs);
+			bool addTextQueryPresets(const Ptr<CommandInputs>& inputs);
+			void fillQueryPresets(const Ptr<DropDownCommandInput>& presetInput, const std::string& selectedName) const;
+			bool addTextSortOrder(const Ptr<CommandInputs>& inputs);
+			bool addTextContentReplace(const Ptr<CommandInputs>& inputs);
+			bool addTextExport(const Ptr<CommandInputs>& inputs);
 			bool addTextHeightMatchTable(const Ptr<CommandInputs>& inputs);
-			bool getTextHeightMatchItems(const Ptr<CommandInputs>& inputs, std::vector<Ptr<SketchText>>& filteredTexts);
+			bool addTextHeightSuggestion(const Ptr<CommandInputs>& inputs);
+			bool fillTextHeightMatchTable(const Ptr<TableCommandInput>& tableInput, const std::pmr::vector<Ptr<SketchText>>& filteredTexts);
+			bool updateTextHeightMatchTable(const Ptr<CommandInputs>& inputs, const std::pmr::vector<Ptr<SketchText>>& filteredTexts);
+			bool getTextHeightMatchItems(const Ptr<CommandInputs>& inputs, std::pmr::vector<Ptr<SketchText>>& filteredTexts);
+			bool refreshTextHeightMatches(const Ptr<CommandInputs>& inputs);
+			#pragma endregion
+
+			#pragma region Operation
+			bool updateSnapshot(const Ptr<CommandInputs>& inputs);
+			void updateDuplicates();
+			void saveTextHeightSettings(const Ptr<CommandInputs>& inputs) const;
+			bool getDuplicateGroupTexts(unsigned int row, std::vector<Ptr<SketchText>>& groupTexts) const;
+			void invalidateSnapshot() { analysis_->snapshotScope.clear(); }
+			void invalidateSketches(const std::vector<bool>& isChanged);
+			void useCurrentAnalysis();
+			void compileQueryPresets();
+			bool applyQueryPreset(const Ptr<CommandInputs>& inputs);
+			bool saveQueryPreset(const Ptr<CommandInputs>& inputs);
+			void startTextReplacePlan(const Ptr<CommandInputs>& inputs);
+			void cancelTextReplacePlan();
+			void textReplacePlanned(uint64_t generation);
+			size_t withComputeDeferred(const std::vector<uint32_t>& ids,
+				const std::function<bool(size_t index, const Ptr<SketchText>& text)>& edit, std::vector<bool>& isAffected);
+			bool applyTextReplacePlan(const Ptr<CommandInputs>& inputs);
+			bool applyTextHeight(const Ptr<CommandInputs>& inputs);
+			bool requestEdit(const Ptr<Command>& command, PendingEdit edit);
+			bool applyPendingEdit(const Ptr<CommandInputs>& inputs);
+			bool suggestTextHeights(const Ptr<CommandInputs>& inputs);
+			bool selectTextHeightSize(const Ptr<CommandInputs>& inputs);
+			bool previewTextHeight(const Ptr<CommandInputs>& inputs);
+			bool getDesignSketches(std::vector<Ptr<Sketch>>& sketches) const;
+			bool exportTexts(const Ptr<CommandInputs>& inputs);
+			void clearCaches();
+			void resetStatistics();
+			size_t getCacheMemoryUsage() const;
 			#pragma endregion
 
 			#pragma region Action
 			static void dropDownSelected(const Ptr<InputChangedEventArgs>& eventArgs);
 			static void textHeightReplaced(const Ptr<InputChangedEventArgs>& eventArgs);
 			static void textHeightChanged(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textHeightSuggested(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textHeightSizeSelected(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textHeightPreviewed(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textContentChanged(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void sketchScopeChanged(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textDuplicatesChanged(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textMatchModeChanged(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textQueryPresetSelected(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textQueryPresetSaved(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textSortChanged(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textReplaceChanged(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textContentReplaced(const Ptr<InputChangedEventArgs>& eventArgs);
+			static void textExported(const Ptr<InputChangedEventArgs>& eventArgs);
 			static void textIdCellSelected(const Ptr<InputChangedEventArgs>& eventArgs);
 			static void textValueCellSelected(const Ptr<InputChangedEventArgs>& eventArgs);
 			static void textHeightCellSelected(const Ptr<InputChangedEventArgs>& eventArgs);
@@ -42,27 +125,56 @@ namespace implicatex {
 			#pragma region Getters
 			static SketchTextHeightTab* get();
 			unsigned int getSelectedRowNumber(std::string& inputId);
+			static bool parseTextCellId(std::string_view inputId, std::string_view& cellId, unsigned int& row);
 			Ptr<SketchText> getTextById(const unsigned int id) const;
-			Ptr<SketchText> getSelectedText() const { return selectedText_; }
+			static SketchTextMatchMode getMatchMode(const Ptr<CommandInputs>& inputs);
+			bool runTextQuery(const std::string& text, std::vector<uint32_t>& ids, std::string& error);
+			Ptr<SketchText> getSelectedText() const { return analysis_->selectedText; }
 			const std::string& getPendingTextValue() const { return pendingTextValue_; }
 			Ptr<StringValueCommandInput> getTextValueCellInput() const { return textValueCellInput_; }
+			const SketchTextAnalysis& getAnalysis() const { return *analysis_; }
+			const SketchTextSnapshot& getSnapshot() const { return analysis_->snapshot; }
+			const SketchTextTrigramIndex& getTextIndex() const { return analysis_->textIndex; }
+			const SketchTextSorter& getTextSorter() const { return analysis_->textSorter; }
+			const SketchTextQueryCache& getQueryCache() const { return queryCache_; }
+			const std::vector<HeightCluster>& getTextHeightSizes() const { return analysis_->heightSizes; }
+			const CacheStats& getSnapshotCacheStats() const { return snapshotCacheStats_; }
+			const CacheStats& getDuplicatesCacheStats() const { return duplicatesCacheStats_; }
+			size_t getLastRowCount() const { return lastRowCount_; }
+			uint64_t getTotalRowCount() const { return totalRowCount_; }
 			std::unordered_map<std::string, void(*)(const Ptr<InputChangedEventArgs>& eventArgs)>& getActions() { return actions_; }
 			#pragma endregion
 
 			#pragma region Setters
-			void setSelectedText(const Ptr<SketchText>& text) { selectedText_ = text; }
+			void setSelectedText(const Ptr<SketchText>& text) { analysis_->selectedText = text; }
+			void setTextChecked(unsigned int row, bool isChecked);
 		    void setPendingTextValue(const std::string& value) { pendingTextValue_ = value; }
 			void setTextValueCellInput(const Ptr<StringValueCommandInput>& input) { textValueCellInput_ = input; }
 			void setActions(const std::unordered_map<std::string, void(*)(const Ptr<InputChangedEventArgs>& eventArgs)>& actions) { actions_ = actions; }
 			#pragma endregion
 
-			std::unordered_map<unsigned int, Ptr<SketchText>> idTextMap_;
-
 		private:
+			std::shared_ptr<SketchTextAnalysis> analysis_;
+			RefreshArena refreshArena_;
+			std::unique_ptr<TableRowMaterializer> rowMaterializer_; // Created on the first fill, when the cell ids are known
+			SketchTextQueryCache queryCache_; // Kept across documents; the plans follow the index generation
 			std::string pendingTextValue_;
-			Ptr<SketchText> selectedText_;
 			Ptr<StringValueCommandInput> textValueCellInput_;
 			std::unordered_map<std::string, void(*)(const Ptr<InputChangedEventArgs>& eventArgs)> actions_;
+			PendingEdit pendingEdit_ = PendingEdit::None;
+			std::vector<double> previewPoints_;
+			std::vector<int> previewIndices_;
+			bool isPreviewShown_ = false;
+			bool isDuplicatesOnly_ = false;
+			std::future<SketchTextReplacePlan> replaceJob_;
+			std::atomic<uint64_t> replaceGeneration_ = 0;
+			SketchTextReplacePlan replacePlan_;
+			size_t replacePlanBytes_ = 0; // Measured when the plan is taken
+			Ptr<TextBoxCommandInput> replacePreviewInput_;
+			CacheStats snapshotCacheStats_;
+			CacheStats duplicatesCacheStats_;
+			size_t lastRowCount_ = 0;
+			uint64_t totalRowCount_ = 0;
 		};
 	}
 }
@@ -1,12 +1,31 @@
 #include "pch.h"
 #include "resource.h"  
 #include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::SketchText
 #include "Logging.h"
+#include "Profiler.h"
+#include "ApiCallCounter.h"
 #include "ToolsBar.h"
 #include "ToolsApp.h"
 #include "ImplicateXFusionToolsAddIn.h"
 #include "SketchTextCommandControl.h"
 #include "SketchTextSettingsTab.h"
+#include "SketchTextDiagnosticsTab.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSnapshot.h"
+#include "SketchTextCache.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextSorter.h"
+#include "SketchTextReplacer.h"
+#include "SketchTextDuplicateFinder.h"
+#include "SketchTextHeightClusterer.h"
+#include "SketchTextExporter.h"
+#include "SketchTextFilter.h"
+#include "SketchTextQuery.h"
+#include "RefreshArena.h"
+#include "TableRowMaterializer.h"
+#include "SketchTextAnalysis.h"
 #include "SketchTextHeightTab.h"
 #include "SketchTextPanel.h"
 
@@ -70,6 +89,37 @@ namespace implicatex {
 			return true;
 		}
 
+		/// <summary>Adds the diagnostics tab with the live performance figures of the panel.</summary>
+		///
+		/// <param name="command">The command.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextPanel::addDiagnosticsTab(const Ptr<Command>& command) {
+			Ptr<CommandInputs> inputs = command->commandInputs();
+			if (!inputs) {
+				LOG_ERROR("Failed to get command inputs");
+				return false;
+			}
+
+			Ptr<TabCommandInput> diagnosticsTab =
+				inputs->addTabCommandInput(IDS_ITEM_TAB_DIAGNOSTICS,
+					LoadStringFromResource(IDS_LABEL_TAB_DIAGNOSTICS), IDS_PATH_ICON_SKETCH_TEXT_SETTINGS);
+
+			if (!diagnosticsTab) {
+				LOG_ERROR("Failed to add diagnostics tab command input");
+				return false;
+			}
+
+			diagnosticsTab_ = std::make_shared<SketchTextDiagnosticsTab>();
+
+			if (!diagnosticsTab_ || !diagnosticsTab_->initialize(command, diagnosticsTab)) {
+				LOG_ERROR("Failed to initialize diagnostics tab command input");
+				return false;
+			}
+
+			return true;
+		}
+
 		/// <summary>
 		/// <para>The notify method is an overridden virtual function that handles the creation </para>
 		/// <para>of a command by setting up its user interface elements,including tabs, dropdowns, </para>
@@ -80,6 +130,7 @@ namespace implicatex {
 		/// <para>which likely contains information related to the creation of a command event.</para>
 		/// </param>
 		void SketchTextPanelCommandCreatedEventHandler::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+			ApiOperation operation("sketchTextPanelCreated");
 			Ptr<Command> command = eventArgs->command();
 			Ptr<CommandInputs> inputs = command->commandInputs();
 
@@ -97,6 +148,11 @@ namespace implicatex {
 				LOG_ERROR("Failed to add text height tab command input");
 				return;
 			}
+
+			if (!toolsApp->sketchTextPanel->addDiagnosticsTab(command)) {
+				LOG_ERROR("Failed to add diagnostics tab command input");
+				return;
+			}
 		}
 	}
 }
@@ -1,17 +1,47 @@
 #include "pch.h"
 #include "resource.h"  
 #include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::SketchText
 #include "Logging.h"
+#include "Profiler.h"
 #include "ToolsBar.h"
 #include "ToolsApp.h"
 #include "ImplicateXFusionToolsAddIn.h"
+#include "SettingsStore.h"
 #include "SketchTextCommandControl.h"
 #include "SketchTextSettingsTab.h"
+#include "SketchTextDiagnosticsTab.h"
+#include "Geometry.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSnapshot.h"
+#include "SketchTextCache.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextSorter.h"
+#include "SketchTextReplacer.h"
+#include "SketchTextDuplicateFinder.h"
+#include "SketchTextHeightClusterer.h"
+#include "SketchTextExporter.h"
+#include "SketchTextFilter.h"
+#include "SketchTextQuery.h"
+#include "RefreshArena.h"
+#include "TableRowMaterializer.h"
+#include "SketchTextAnalysis.h"
 #include "SketchTextHeightTab.h"
 #include "SketchTextPanel.h"
 
 namespace implicatex {
 	namespace fusion {
+		namespace {
+			Point3 toPoint3(const Ptr<Point3D>& point) {
+				return Point3{ point->x(), point->y(), point->z() };
+			}
+
+			Ptr<Point3D> toPoint3D(const Point3& point) {
+				return Point3D::create(point.x, point.y, point.z);
+			}
+		}
+
 		/// <summary>
 		/// <para>getSelectedSketch retrieves a sketch from a dropdown command input in the SketchTextPanel, </para>
 		/// <para>returning a boolean indicating success or failure while logging errors for various failure conditions.</para>
@@ -66,90 +96,27 @@ namespace implicatex {
 		///
 		/// <returns>The text position.</returns>
 		Ptr<Point3D> SketchTextPanel::getTextPosition(const Ptr<SketchText>& sketchText) {
-			if (!sketchText) {
-				LOG_ERROR("Invalid SketchText");
+			Box3 textBox;
+			if (!getTextBox(sketchText, textBox)) {
 				return nullptr;
 			}
 
-			Ptr<SketchTextDefinition> textDef = sketchText->definition();
-			Ptr<MultiLineTextDefinition> multiLineTextDef = textDef;
-			if (!multiLineTextDef) {
-				LOG_ERROR("No MultiLineTextDefinition found for the sketch text.");
-				return nullptr;
-			}
+			Point3 center = textBox.center();
+			LOG_INFO("Center Point: ({}, {})", center.x, center.y);
 
-			std::vector<Ptr<SketchLine>> lines =
-				multiLineTextDef->rectangleLines();
-			if (lines.size() != 4) {
-				LOG_ERROR("rectangleLines does not have the expected number of lines.");
-				return nullptr;
-			}
-			for (size_t i = 0; i < lines.size(); ++i) {
-				Ptr<SketchLine> line = lines[i];
-
-				if (line) {
-					LOG_INFO("Line World = "
-						+ std::to_string(i) + ": "
-						+ std::to_string(line->startSketchPoint()->worldGeometry()->x()) + ", "
-						+ std::to_string(line->startSketchPoint()->worldGeometry()->y()) + ", "
-						+ std::to_string(line->startSketchPoint()->worldGeometry()->z()));
-					LOG_INFO("Line Sketch = "
-						+ std::to_string(i) + ": "
-						+ std::to_string(line->startSketchPoint()->geometry()->x()) + ", "
-						+ std::to_string(line->startSketchPoint()->geometry()->y()));
-				}
-			}
-
-			double minX = (std::numeric_limits<double>::max)();
-			double minY = (std::numeric_limits<double>::max)();
-			double maxX = std::numeric_limits<double>::lowest();
-			double maxY = std::numeric_limits<double>::lowest();
-
-			for (const auto& line : lines) {
-				if (!line) continue;
-
-				Ptr<Point3D> startPoint =
-					line->startSketchPoint()->worldGeometry();
-				Ptr<Point3D> endPoint =
-					line->endSketchPoint()->worldGeometry();
-
-				if (startPoint) {
-					minX = (std::min)(minX, startPoint->x());
-					minY = (std::min)(minY, startPoint->y());
-					maxX = (std::max)(maxX, startPoint->x());
-					maxY = (std::max)(maxY, startPoint->y());
-				}
-
-				if (endPoint) {
-					minX = (std::min)(minX, endPoint->x());
-					minY = (std::min)(minY, endPoint->y());
-					maxX = (std::max)(maxX, endPoint->x());
-					maxY = (std::max)(maxY, endPoint->y());
-				}
-			}
-
-			double centerX = (minX + maxX) / 2.0;
-			double centerY = (minY + maxY) / 2.0;
-
-			LOG_INFO("Center Point: (" + std::to_string(centerX) + ", " + std::to_string(centerY) + ")");
-
-			Ptr<Point3D> centerPoint = Point3D::create(centerX, centerY, 0.0);
-
-			return centerPoint;
+			return toPoint3D(center);
 		}
 
 		/// <summary>
-		/// <para>The getTextPoints function retrieves the bounding box coordinates and center point </para>
-		/// <para>of a given sketch text, returning false if the input is invalid or no valid points are found.</para>
+		/// <para>The getTextBox function collects the world coordinates of the rectangle lines of a sketch text</para>
+		/// <para>into a bounding box, returning false if the input is invalid or no valid points are found.</para>
 		/// </summary>
 		///
-		/// <param name="sketchText"> The sketch text.</param>
-		/// <param name="centerPoint">[in,out] The center point.</param>
-		/// <param name="minPoint">   [in,out] The minimum point.</param>
-		/// <param name="maxPoint">   [in,out] The maximum point.</param>
+		/// <param name="sketchText">The sketch text.</param>
+		/// <param name="textBox">   [in,out] The bounding box of the text.</param>
 		///
 		/// <returns>True if it succeeds, false if it fails.</returns>
-		bool SketchTextPanel::getTextPoints(const Ptr<SketchText>& sketchText, Ptr<Point3D>& centerPoint, Ptr<Point3D>& minPoint, Ptr<Point3D>& maxPoint) {
+		bool SketchTextPanel::getTextBox(const Ptr<SketchText>& sketchText, Box3& textBox) {
 			if (!sketchText) {
 				LOG_ERROR("Invalid SketchText");
 				return false;
@@ -168,14 +135,7 @@ namespace implicatex {
 				return false;
 			}
 
-			double minX = (std::numeric_limits<double>::max)();
-			double minY = (std::numeric_limits<double>::max)();
-			double maxX = (std::numeric_limits<double>::lowest)();
-			double maxY = (std::numeric_limits<double>::lowest)();
-
-			Ptr<Point3D> startPoint = nullptr;
-			Ptr<Point3D> endPoint = nullptr;
-
+			textBox = Box3();
 			for (const auto& line : lines) {
 				if (!line) continue;
 
@@ -183,35 +143,17 @@ namespace implicatex {
 				Ptr<Point3D> endPoint = line->endSketchPoint()->worldGeometry();
 
 				if (startPoint) {
-					minX = (std::min)(minX, startPoint->x());
-					minY = (std::min)(minY, startPoint->y());
-					maxX = (std::max)(maxX, startPoint->x());
-					maxY = (std::max)(maxY, startPoint->y());
+					textBox.extend(toPoint3(startPoint));
 				}
 
 				if (endPoint) {
-					minX = (std::min)(minX, endPoint->x());
-					minY = (std::min)(minY, endPoint->y());
-					maxX = (std::max)(maxX, endPoint->x());
-					maxY = (std::max)(maxY, endPoint->y());
+					textBox.extend(toPoint3(endPoint));
 				}
 			}
-			if (minX == (std::numeric_limits<double>::max)() || minY == (std::numeric_limits<double>::max)() ||
-				maxX == (std::numeric_limits<double>::lowest)() || maxY == (std::numeric_limits<double>::lowest)()) {
+			if (!textBox.isValid()) {
 				LOG_INFO("No valid points found for the bounding box.");
 				return false;
 			}
-			double centerX = (minX + maxX) / 2.0;
-			double centerY = (minY + maxY) / 2.0;
-			double centerZ = 0.0;
-			
-			if (startPoint) {
-				centerZ = startPoint->z();
-			}
-
-			minPoint = Point3D::create(minX, minY, centerZ);
-			maxPoint = Point3D::create(maxX, maxY, centerZ);
-			centerPoint = Point3D::create(centerX, centerY, centerZ);
 
 			return true;
 		}
@@ -228,6 +170,7 @@ namespace implicatex {
 		///
 		/// <returns>True if it succeeds, false if it fails.</returns>
 		bool SketchTextPanel::alignModelToSketchXYPlane(const Ptr<Sketch>& sketch) {
+			ScopedSpan span(ProfileSpan::AlignModelToSketch);
 			if (!sketch) {
 				LOG_ERROR("Invalid sketch provided.");
 				return false;
@@ -265,17 +208,7 @@ namespace implicatex {
 				return false;
 			}
 
-			Ptr<Point3D> center = Point3D::create(
-				(minPoint->x() + maxPoint->x()) / 2.0,
-				(minPoint->y() + maxPoint->y()) / 2.0,
-				(minPoint->z() + maxPoint->z()) / 2.0
-			);
-
-			double diagonal = sqrt(
-				pow(maxPoint->x() - minPoint->x(), 2) +
-				pow(maxPoint->y() - minPoint->y(), 2) +
-				pow(maxPoint->z() - minPoint->z(), 2)
-			);
+			CameraFit fit = getSketchCamera(Box3::of(toPoint3(minPoint), toPoint3(maxPoint)));
 
 			ViewOrientations orientation;
 			if (sketchZDirection->z() > 0) {
@@ -284,7 +217,7 @@ namespace implicatex {
 			else {
 				orientation = ViewOrientations::BottomViewOrientation;
 			}
-			LOG_INFO("Orientation: " + std::to_string(static_cast<int>(orientation)));
+			LOG_INFO("Orientation: {}", static_cast<int>(orientation));
 
 			Ptr<Camera> camera = Camera::create();
 			if (!camera) {
@@ -292,8 +225,8 @@ namespace implicatex {
 				return false;
 			}
 
-			camera->eye(Point3D::create(center->x(), center->y(), center->z() + diagonal * 1.5));
-			camera->target(center);
+			camera->eye(toPoint3D(fit.eye));
+			camera->target(toPoint3D(fit.target));
 			camera->upVector(Vector3D::create(0.0, 1.0, 0.0));
 			camera->isSmoothTransition(true);
 			camera->viewOrientation(orientation);
@@ -318,30 +251,17 @@ namespace implicatex {
 		/// <para>allowing for safe and efficient access to sketch text objects.</para>
 		/// </param>
 		void SketchTextPanel::focusCameraOnText(const Ptr<SketchText>& sketchText) {
+			ScopedSpan span(ProfileSpan::FocusCameraOnText);
 			if (!sketchText) {
 				LOG_ERROR("Invalid SketchText");
 				return;
 			}
 
-			Ptr<Point3D> position = nullptr;
-			Ptr<Point3D> minPoint = nullptr;
-			Ptr<Point3D> maxPoint = nullptr;
-
-			if (!toolsApp->sketchTextPanel->getTextPoints(sketchText, position, minPoint, maxPoint)) {
+			Box3 textBox;
+			if (!getTextBox(sketchText, textBox)) {
 				LOG_ERROR("Failed to get text points");
 				return;
 			}
-			if (!position || !minPoint || !maxPoint) {
-				LOG_ERROR("Invalid points");
-				return;
-			}
-
-			// Calculate the diagonal of the bounding box
-			double diagonal = sqrt(
-				pow(maxPoint->x() - minPoint->x(), 2) +
-				pow(maxPoint->y() - minPoint->y(), 2) +
-				pow(maxPoint->z() - minPoint->z(), 2)
-			);
 
 			double zoomFactor = settingsTab_->getZoomFactor(); // Zoom closer to the text
 
@@ -360,12 +280,14 @@ namespace implicatex {
 				return;
 			}
 
+			CameraFit fit = getTextCamera(textBox, viewportCameraType == CameraTypes::OrthographicCameraType, zoomFactor);
+
 			switch (viewportCameraType)
 			{
 			case CameraTypes::OrthographicCameraType:
 				sketchTextCamera->cameraType(CameraTypes::OrthographicCameraType);
-				sketchTextCamera->eye(Point3D::create(position->x(), position->y(), position->z() + 1.0));
-				sketchTextCamera->setExtents(diagonal * zoomFactor, diagonal * zoomFactor);
+				sketchTextCamera->eye(toPoint3D(fit.eye));
+				sketchTextCamera->setExtents(fit.extent, fit.extent);
 				break;
 
 			case CameraTypes::PerspectiveCameraType:
@@ -374,13 +296,13 @@ namespace implicatex {
 
 			case CameraTypes::PerspectiveWithOrthoFacesCameraType:
 				sketchTextCamera->cameraType(CameraTypes::PerspectiveWithOrthoFacesCameraType);
-				sketchTextCamera->eye(Point3D::create(position->x(), position->y(), position->z() + diagonal * 1.0));
+				sketchTextCamera->eye(toPoint3D(fit.eye));
 				sketchTextCamera->perspectiveAngle(zoomFactor);
 				break;
 			}
 
-			// Set the camera position (eye) and the target (centerPoint)
-			sketchTextCamera->target(position);
+			// Set the camera position (eye) and the target (center of the text)
+			sketchTextCamera->target(toPoint3D(fit.target));
 			sketchTextCamera->upVector(Vector3D::create(0.0, 1.0, 0.0));
 			sketchTextCamera->isSmoothTransition(true);
 			sketchTextCamera->viewOrientation(ViewOrientations::TopViewOrientation);
@@ -402,96 +324,88 @@ namespace implicatex {
 				LOG_ERROR("Invalid SketchText");
 				return;
 			}
+			addHighlightGraphics(std::vector<Ptr<SketchText>>{ sketchText });
+		}
 
-			Ptr<SketchTextDefinition> textDef = sketchText->definition();
-			Ptr<MultiLineTextDefinition> multiLineTextDef = textDef;
-			if (!multiLineTextDef) {
-				LOG_ERROR("No MultiLineTextDefinition found for the sketch text.");
-				return;
+		/// <summary>
+		/// <para>addHighlightGraphics replaces any existing highlight with one rectangle around each given text,</para>
+		/// <para>all drawn as a single line set, e.g. to show a whole group of duplicates at once.</para>
+		/// </summary>
+		///
+		/// <param name="sketchTexts">The sketch texts.</param>
+		void SketchTextPanel::addHighlightGraphics(const std::vector<Ptr<SketchText>>& sketchTexts) {
+			ScopedSpan span(ProfileSpan::HighlightGraphics);
+			std::vector<double> points;
+			std::vector<int> indices;
+			points.reserve(sketchTexts.size() * 12);
+			indices.reserve(sketchTexts.size() * 8);
+
+			for (const auto& sketchText : sketchTexts) {
+				if (!sketchText) continue;
+
+				Box3 textBox;
+				if (!getTextBox(sketchText, textBox)) {
+					continue;
+				}
+
+				appendRectangle(textBox, textBox.minPoint.z, points, indices);
 			}
 
-			std::vector<Ptr<SketchLine>> lines = multiLineTextDef->rectangleLines();
-			if (lines.size() != 4) {
-				LOG_ERROR("RectangleLines does not have the expected number of lines.");
+			if (points.empty()) {
+				LOG_ERROR("No texts to highlight");
 				return;
 			}
 
-			double minX = (std::numeric_limits<double>::max)();
-			double minY = (std::numeric_limits<double>::max)();
-			double maxX = std::numeric_limits<double>::lowest();
-			double maxY = std::numeric_limits<double>::lowest();
-
-			Ptr<Point3D> startPoint;
-			Ptr<Point3D> endPoint;
-
-			for (const auto& line : lines) {
-				if (!line) continue;
+			addLineGraphics(points, indices, 1.0);
+		}
 
-				startPoint = line->startSketchPoint()->worldGeometry();
-				endPoint = line->endSketchPoint()->worldGeometry();
+		/// <summary>clearGraphics deletes the custom graphics groups of the root component, i.e. highlights and previews.</summary>
+		///
+		/// <returns>True if there were graphics to delete.</returns>
+		bool SketchTextPanel::clearGraphics() {
+			Ptr<Design> design = toolsApp->activeProduct();
+			if (!design) {
+				return false;
+			}
+			Ptr<Component> root = design->rootComponent();
+			if (!root || root->customGraphicsGroups()->count() == 0) {
+				return false;
+			}
 
-				if (startPoint) {
-					minX = (std::min)(minX, startPoint->x());
-					minY = (std::min)(minY, startPoint->y());
-					maxX = (std::max)(maxX, startPoint->x());
-					maxY = (std::max)(maxY, startPoint->y());
+			for (size_t i = 0; i < root->customGraphicsGroups()->count(); ++i) {
+				Ptr<CustomGraphicsGroup> group = root->customGraphicsGroups()->item(i);
+				if (group) {
+					group->deleteMe();
 				}
+			}
+			LOG_INFO("Deleted existing graphics.");
+			return true;
+		}
 
-				if (endPoint) {
-					minX = (std::min)(minX, endPoint->x());
-					minY = (std::min)(minY, endPoint->y());
-					maxX = (std::max)(maxX, endPoint->x());
-					maxY = (std::max)(maxY, endPoint->y());
-				}
+		/// <summary>
+		/// <para>addLineGraphics replaces any existing graphics with one line set in the highlight color and weight</para>
+		/// <para>of the settings, so that any number of rectangles costs a single custom graphics batch.</para>
+		/// </summary>
+		///
+		/// <param name="points"> The coordinates, three per point.</param>
+		/// <param name="indices">The point indices, two per line.</param>
+		/// <param name="opacity">The opacity, below 1.0 for ghost graphics.</param>
+		void SketchTextPanel::addLineGraphics(const std::vector<double>& points, const std::vector<int>& indices, double opacity) {
+			if (clearGraphics() && points.empty()) {
+				toolsApp->activeViewport()->refresh();
 			}
-			if (minX == (std::numeric_limits<double>::max)() || minY == (std::numeric_limits<double>::max)() ||
-				maxX == std::numeric_limits<double>::lowest() || maxY == std::numeric_limits<double>::lowest()) {
-				LOG_ERROR("No valid points found for the bounding box.");
+			if (points.empty()) {
 				return;
 			}
-			double centerX = (minX + maxX) / 2.0;
-			double centerY = (minY + maxY) / 2.0;
-			double centerZ = 0.0;
-			
-			if (startPoint) {
-				centerZ = startPoint->z();
-			}
-
-			//NOLOG: LOG_INFO("BoundingBox Min: (" + std::to_string(minX) + ", " + std::to_string(minY) + ")");
-			//NOLOG: LOG_INFO("BoundingBox Max: (" + std::to_string(maxX) + ", " + std::to_string(maxY) + ")");
-			//NOLOG: LOG_INFO("BoundingBox Center: (" + std::to_string(centerX) + ", " + std::to_string(centerY) + ")");
 
 			Ptr<Design> design = toolsApp->activeProduct();
 			Ptr<Component> root = design->rootComponent();
-
-			if (root->customGraphicsGroups()->count() > 0) {
-				for (size_t i = 0; i < root->customGraphicsGroups()->count(); ++i) {
-					Ptr<CustomGraphicsGroup> group = root->customGraphicsGroups()->item(i);
-					if (group) {
-						group->deleteMe();
-					}
-				}
-				LOG_INFO("Deleted existing graphics.");
-				toolsApp->activeViewport()->refresh();
-			}
-
 			Ptr<CustomGraphicsGroup> highlightGraphics = root->customGraphicsGroups()->add();
 			if (!highlightGraphics) {
 				LOG_ERROR("Failed to create CustomGraphicsGroup");
 				return;
 			}
 
-			std::vector<double> points = {
-				minX, minY, centerZ,
-				maxX, minY, centerZ,
-				maxX, maxY, centerZ,
-				minX, maxY, centerZ
-			};
-
-			std::vector<int> indices = {
-				0, 1, 1, 2, 2, 3, 3, 0
-			};
-
 			Ptr<CustomGraphicsCoordinates> coordinates = CustomGraphicsCoordinates::create(points);
 			if (!coordinates) {
 				LOG_ERROR("Failed to create CustomGraphicsCoordinates");
@@ -504,12 +418,15 @@ namespace implicatex {
 				return;
 			}
 
-			auto colorEffect = CustomGraphicsSolidColorEffect::create(Color::create(0x00, 0xFF, 0xFF, 0xFF));
+			std::shared_ptr<const ToolsSettings> settings = ToolsApp::getSettings();
+			uint32_t color = settings->highlightColor;
+			auto colorEffect = CustomGraphicsSolidColorEffect::create(
+				Color::create((color >> 24) & 0xFF, (color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF));
 			linesGraphics->color(colorEffect);
-			linesGraphics->weight(1.5);
+			linesGraphics->weight((float)settings->highlightWeight);
 			linesGraphics->isVisible(true);
 			linesGraphics->isSelectable(true);
-			linesGraphics->setOpacity(1.0, true);
+			linesGraphics->setOpacity(opacity, true);
 
 			toolsApp->activeViewport()->refresh();
 		}
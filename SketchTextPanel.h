@@ -10,6 +10,7 @@ namespace implicatex {
 		constexpr auto IDS_ITEM_DROPDOWN_SELECT_SKETCH = "dropdownSelectSketch"; // dropdownSelectSketch
 		constexpr auto IDS_ITEM_TAB_SETTINGS = "settingsTab"; // settingsTab
 		constexpr auto IDS_ITEM_TAB_TEXT_HEIGHT = "textHeightTab"; // textHeightTab
+		constexpr auto IDS_ITEM_TAB_DIAGNOSTICS = "diagnosticsTab"; // diagnosticsTab
 		constexpr auto IDS_ITEM_TEXT_HEIGHT_MIN = "textHeightMin"; // textHeightMin
 		constexpr auto IDS_ITEM_TEXT_HEIGHT_MAX = "textHeightMax"; // textHeightMax
 		constexpr auto IDS_ITEM_TEXT_HEIGHT_NEW = "textHeightNew"; // textHeightNew
@@ -17,9 +18,45 @@ namespace implicatex {
 		constexpr auto IDS_ITEM_TEXT_HEIGHT_MATCH = "textHeightMatch"; // textHeightMatch
 		constexpr auto IDS_ITEM_TEXT_HEIGHT_TABLE = "textHeightTable"; // textHeightTable
 		constexpr auto IDS_ITEM_TEXT_HEIGHT_REPLACE = "textHeightReplace"; // textHeightReplace
+		constexpr auto IDS_ITEM_TEXT_HEIGHT_TOLERANCE = "textHeightTolerance"; // textHeightTolerance
+		constexpr auto IDS_ITEM_TEXT_HEIGHT_SUGGEST = "textHeightSuggest"; // textHeightSuggest
+		constexpr auto IDS_ITEM_TEXT_HEIGHT_SIZES = "textHeightSizes"; // textHeightSizes
+		constexpr auto IDS_ITEM_TEXT_HEIGHT_PREVIEW = "textHeightPreview"; // textHeightPreview
 		constexpr auto IDS_ITEM_TEXT_HEIGHT_SEPARATOR = "textHeightSeparator"; // textHeightSeparator
 		constexpr auto IDS_ITEM_TEXT_HEIGHT_MATCH_SEPARATOR = "textHeightMatchSeparator"; // textHeightMatchSeparator
 		constexpr auto IDS_ITEM_TEXT_ZOOM_FACTOR = "textZoomFactor"; // textZoomFactor
+		constexpr auto IDS_ITEM_TEXT_CONTENT_FILTER = "textContentFilter"; // textContentFilter
+		constexpr auto IDS_ITEM_TEXT_CONTENT_PREFIX = "textContentPrefix"; // textContentPrefix
+		constexpr auto IDS_ITEM_TEXT_QUERY = "textQuery"; // textQuery
+		constexpr auto IDS_ITEM_TEXT_QUERY_PRESET = "textQueryPreset"; // textQueryPreset
+		constexpr auto IDS_ITEM_TEXT_QUERY_PRESET_NAME = "textQueryPresetName"; // textQueryPresetName
+		constexpr auto IDS_ITEM_TEXT_QUERY_PRESET_SAVE = "textQueryPresetSave"; // textQueryPresetSave
+		constexpr auto IDS_ITEM_TEXT_DUPLICATES_ONLY = "textDuplicatesOnly"; // textDuplicatesOnly
+		constexpr auto IDS_ITEM_TEXT_MATCH_MODE = "textMatchMode"; // textMatchMode
+		constexpr auto IDS_ITEM_ALL_SKETCHES = "allSketches"; // allSketches
+		constexpr auto IDS_ITEM_TEXT_SORT_ORDER = "textSortOrder"; // textSortOrder
+		constexpr auto IDS_ITEM_TEXT_SORT_DESCENDING = "textSortDescending"; // textSortDescending
+		constexpr auto IDS_ITEM_TEXT_REPLACE_SEPARATOR = "textReplaceSeparator"; // textReplaceSeparator
+		constexpr auto IDS_ITEM_TEXT_FIND = "textFind"; // textFind
+		constexpr auto IDS_ITEM_TEXT_REPLACE_WITH = "textReplaceWith"; // textReplaceWith
+		constexpr auto IDS_ITEM_TEXT_FIND_REGEX = "textFindRegex"; // textFindRegex
+		constexpr auto IDS_ITEM_TEXT_REPLACE_PREVIEW = "textReplacePreview"; // textReplacePreview
+		constexpr auto IDS_ITEM_TEXT_CONTENT_REPLACE = "textContentReplace"; // textContentReplace
+		constexpr auto IDS_ITEM_TEXT_EXPORT_SEPARATOR = "textExportSeparator"; // textExportSeparator
+		constexpr auto IDS_ITEM_TEXT_EXPORT_ALL = "textExportAll"; // textExportAll
+		constexpr auto IDS_ITEM_TEXT_EXPORT = "textExport"; // textExport
+		constexpr auto IDS_ITEM_PROFILE_REPORT = "profileReport"; // profileReport
+		constexpr auto IDS_ITEM_TRACE_RECORD = "traceRecord"; // traceRecord
+		constexpr auto IDS_ITEM_DIAG_FILTER_TIME = "diagFilterTime"; // diagFilterTime
+		constexpr auto IDS_ITEM_DIAG_TABLE_TIME = "diagTableTime"; // diagTableTime
+		constexpr auto IDS_ITEM_DIAG_ROWS = "diagRows"; // diagRows
+		constexpr auto IDS_ITEM_DIAG_CACHE_HITS = "diagCacheHits"; // diagCacheHits
+		constexpr auto IDS_ITEM_DIAG_MEMORY = "diagMemory"; // diagMemory
+		constexpr auto IDS_ITEM_DIAG_API_CALLS = "diagApiCalls"; // diagApiCalls
+		constexpr auto IDS_ITEM_DIAG_CLEAR_CACHES = "diagClearCaches"; // diagClearCaches
+		constexpr auto IDS_ITEM_DIAG_RESET_COUNTERS = "diagResetCounters"; // diagResetCounters
+		constexpr auto IDS_ITEM_DIAG_REFRESH = "diagRefresh"; // diagRefresh
+		constexpr auto IDS_EVENT_TEXT_REPLACE_PLANNED = "ImplicateXTextReplacePlanned"; // ImplicateXTextReplacePlanned
 		constexpr auto IDS_PATH_ICON_SKETCH_TEXT = "Resources/Sketch/Text"; // Resources/Sketch/Text
 		constexpr auto IDS_PATH_ICON_SKETCH_TEXT_SETTINGS = "Resources/Sketch/Text/Settings"; // Resources/Sketch/Text/Settings
 		constexpr auto IDS_PATH_ICON_SKETCH_TEXT_HEIGHT = "Resources/Sketch/Text/Height"; // Resources/Sketch/Text/Height
@@ -41,6 +78,8 @@ namespace implicatex {
 		};
 		#pragma endregion
 
+		struct Box3;
+
 		class SketchTextPanel
 		{
 		public:
@@ -54,26 +93,32 @@ namespace implicatex {
 			#pragma region Design
 			bool addTextHeightTab(const Ptr<Command>& command);
 			bool addSettingsTab(const Ptr<Command>& command);
+			bool addDiagnosticsTab(const Ptr<Command>& command);
 			#pragma endregion
 
 			#pragma region Operation
 			Ptr<Point3D> getTextPosition(const Ptr<SketchText>& sketchText);
-			bool getTextPoints(const Ptr<SketchText>& sketchText, Ptr<Point3D>& centerPoint, Ptr<Point3D>& minPoint, Ptr<Point3D>& maxPoint);
+			bool getTextBox(const Ptr<SketchText>& sketchText, Box3& textBox);
 			bool getSelectedSketch(const Ptr<DropDownCommandInput>& dropdown, Ptr<Sketch>& sketch);
 			bool alignModelToSketchXYPlane(const Ptr<Sketch>& sketch);
 			void addHighlightGraphics(const Ptr<SketchText>& text);
+			void addHighlightGraphics(const std::vector<Ptr<SketchText>>& texts);
+			bool clearGraphics();
+			void addLineGraphics(const std::vector<double>& points, const std::vector<int>& indices, double opacity);
 			void focusCameraOnText(const Ptr<SketchText>& sketchText);
 			#pragma endregion
 
 			#pragma region Getters
             //Ptr<SketchTextSettingsTab> getSettingsTab() const { return Ptr<SketchTextSettingsTab>(settingsTab_.get()); }
 			std::shared_ptr<SketchTextHeightTab> getTextHeightTab() const { return textHeightTab_; }
+			std::shared_ptr<SketchTextDiagnosticsTab> getDiagnosticsTab() const { return diagnosticsTab_; }
 			#pragma endregion
 		public:
 			#pragma region Properties
 			std::shared_ptr<SketchTextSettingsTab> settingsTab_;
 		private:
 			std::shared_ptr<SketchTextHeightTab> textHeightTab_;
+			std::shared_ptr<SketchTextDiagnosticsTab> diagnosticsTab_;
 			#pragma endregion
 		};
 	}
@@ -1,19 +1,35 @@
 #include "pch.h"
-#include <nlohmann/json.hpp>
 #include "resource.h"
 #include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::Settings
 #include "Logging.h"
+#include "Profiler.h"
 #include "FileHelper.h"
+#include "SettingsStore.h"
 #include "ToolsBar.h"
 #include "ToolsApp.h"
 #include "ImplicateXFusionToolsAddIn.h"
 #include "SketchTextCommandControl.h"
 #include "SketchTextSettingsTab.h"
+#include "SketchTextDiagnosticsTab.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSnapshot.h"
+#include "SketchTextCache.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextSorter.h"
+#include "SketchTextReplacer.h"
+#include "SketchTextDuplicateFinder.h"
+#include "SketchTextHeightClusterer.h"
+#include "SketchTextExporter.h"
+#include "SketchTextFilter.h"
+#include "SketchTextQuery.h"
+#include "RefreshArena.h"
+#include "TableRowMaterializer.h"
+#include "SketchTextAnalysis.h"
 #include "SketchTextHeightTab.h"
 #include "SketchTextPanel.h"
 
-using json = nlohmann::json;
-
 namespace implicatex {
 	namespace fusion {
 		bool SketchTextSettingsTab::initialize(Ptr<Command> command, const Ptr<TabCommandInput>& tabInput) {
@@ -35,38 +51,71 @@ namespace implicatex {
 				return false;
 			}
 
-			ensureUserSettingsDirectoryExists();
-
 			zoomSlider->valueOne(load());
 
+			std::string reportLabel = LoadStringFromResource(IDS_LABEL_PROFILE_REPORT);
+			Ptr<BoolValueCommandInput> reportButton =
+				tabInputs->addBoolValueInput(IDS_ITEM_PROFILE_REPORT, reportLabel, false);
+			if (!reportButton) {
+				LOG_ERROR("Failed to add profile report button");
+				return false;
+			}
+			reportButton->tooltip(reportLabel);
+			reportButton->text(" " + reportLabel);
+			reportButton->resourceFolder(IDS_PATH_ICON_SKETCH_TEXT_SETTINGS);
+
+			Ptr<BoolValueCommandInput> traceInput =
+				tabInputs->addBoolValueInput(IDS_ITEM_TRACE_RECORD, LoadStringFromResource(IDS_LABEL_TRACE_RECORD), true, "", TraceRecorder::get().isEnabled());
+			if (!traceInput) {
+				LOG_ERROR("Failed to add trace record input");
+				return false;
+			}
+
 			command->inputChanged()->add(new SketchTextSettingsTabInputChangedEventHandler());
 
 			return true;
 		}
 
+		/// <summary>
+		/// <para>save hands the zoom factor to the settings store, which writes it to the settings file</para>
+		/// <para>in the background once the slider has come to rest.</para>
+		/// </summary>
 		void SketchTextSettingsTab::save() {
-			json j;
-			j["SketchText"]["zoomFactor"] = zoomFactor_;
-			std::string path = getUserSettingsPath();
-			//NOLOG: LOG_INFO("Saving settings to: " + path);
-			std::ofstream file(path);
-			file << j.dump(4);
+			if (!toolsApp->settingsStore) {
+				LOG_ERROR("Settings store not available");
+				return;
+			}
+			double zoomFactor = zoomFactor_;
+			toolsApp->settingsStore->update([zoomFactor](ToolsSettings& settings) { settings.zoomFactor = zoomFactor; });
 		}
 
+		/// <summary>Reads the zoom factor from the settings store.</summary>
+		///
+		/// <returns>The zoom factor.</returns>
 		double SketchTextSettingsTab::load() {
-			std::string path = getUserSettingsPath();
-			LOG_INFO("Loading settings from: " + path);
-			std::ifstream file(path);
-			//NOLOG: LOG_INFO("File opened: " + std::to_string(file.is_open()));
-			if (!file) return 1.0;
-			json j;
-			file >> j;
-			//NOLOG: LOG_INFO("File read: " + std::to_string(file.good()));
-			//NOLOG: LOG_INFO(j.dump(4));
-			zoomFactor_ = j.value("SketchText", json{}).value("zoomFactor", 1.0);
+			zoomFactor_ = ToolsApp::getSettings()->zoomFactor;
 			return zoomFactor_;
 		}
 
+		/// <summary>
+		/// <para>writeTrace stops the trace recorder and writes what it recorded as Chrome trace JSON</para>
+		/// <para>next to the log file, reporting the path in the text commands palette.</para>
+		/// </summary>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextSettingsTab::writeTrace() {
+			TraceRecorder::get().stop();
+
+			std::string path = getUserTracePath();
+			if (!TraceRecorder::get().writeJson(path)) {
+				LOG_ERROR("Failed to write trace file: {}", path);
+				return false;
+			}
+
+			toolsApp->log(LoadStringFromResource(IDS_MSG_TRACE_WRITTEN) + path, InfoLogLevel, ConsoleLogType);
+			return true;
+		}
+
 		/// <summary>
 		/// <para>The notify method is an overridden virtual function that handles input change events.</para>
 		/// </summary>
@@ -76,7 +125,13 @@ namespace implicatex {
 		/// </param>
 		void SketchTextSettingsTabInputChangedEventHandler::notify(const Ptr<InputChangedEventArgs>& eventArgs) {
 			std::string inputId = eventArgs->input()->id();
-			LOG_INFO("SettingsTab InputChanged: " + inputId);
+			if (inputId != IDS_ITEM_TEXT_ZOOM_FACTOR && inputId != IDS_ITEM_PROFILE_REPORT && inputId != IDS_ITEM_TRACE_RECORD) {
+				// The inputs of the other tabs are traced and counted by their own handlers
+				return;
+			}
+			TraceScope trace(inputId, "input");
+			ApiOperation operation(inputId);
+			LOG_INFO("SettingsTab InputChanged: {}", inputId);
 
 			std::weak_ptr<SketchTextSettingsTab> settingsTabTemp = toolsApp->sketchTextPanel->settingsTab_;
 			auto settingsTab = settingsTabTemp.lock();
@@ -105,12 +160,25 @@ namespace implicatex {
 
 				if (eventArgs->input()->id() == IDS_ITEM_TEXT_ZOOM_FACTOR) {
 					settingsTab->setZoomFactor(zoomSlider->valueOne());
-					LOG_INFO("Zoomfaktor: " + std::to_string(settingsTab->getZoomFactor()));
+					LOG_INFO("Zoomfaktor: {}", settingsTab->getZoomFactor());
 					settingsTab->save();
 
 					SketchTextHeightTab* heightTab = toolsApp->sketchTextPanel->getTextHeightTab().get();
 					toolsApp->sketchTextPanel->focusCameraOnText(heightTab->getSelectedText());
 				}
+				else if (eventArgs->input()->id() == IDS_ITEM_PROFILE_REPORT) {
+					toolsApp->log(Profiler::get().getReport(), InfoLogLevel, ConsoleLogType);
+					toolsApp->log(ApiCallCounter::get().getReport(), InfoLogLevel, ConsoleLogType);
+				}
+				else if (eventArgs->input()->id() == IDS_ITEM_TRACE_RECORD) {
+					Ptr<BoolValueCommandInput> traceInput = eventArgs->input();
+					if (traceInput && traceInput->value()) {
+						TraceRecorder::get().start();
+					}
+					else {
+						settingsTab->writeTrace();
+					}
+				}
 
 				break;
 			}
@@ -23,6 +23,7 @@ namespace implicatex {
 
 			void save();
 			double load();
+			bool writeTrace();
 
 			double getZoomFactor() const { return zoomFactor_; }
 			void setZoomFactor(double zoomFactor) { zoomFactor_ = zoomFactor; }
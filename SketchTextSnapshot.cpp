@@ -0,0 +1,69 @@
+#include "pch.h"
+#include "resource.h"
+#include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::SketchText
+#include "Logging.h"
+#include "TraceRecorder.h"
+#include "ApiCallCounter.h"
+#include "Profiler.h"
+#include "ToolsApp.h"
+#include "ImplicateXFusionToolsAddIn.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSnapshot.h"
+#include "SketchTextCache.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>assemble joins the texts of the given sketches, in their order, replacing any previous content.</para>
+		/// <para>Records take the index of their sketch in this snapshot.</para>
+		/// </summary>
+		///
+		/// <param name="sketches">The cached texts of the sketches.</param>
+		void SketchTextSnapshot::assemble(const std::vector<const CachedSketchTexts*>& sketches) {
+			clear();
+
+			size_t count = 0;
+			for (const CachedSketchTexts* cached : sketches) {
+				count += cached->records.size();
+			}
+			records_.reserve(count);
+			entities_.reserve(count);
+			sketchNames_.reserve(sketches.size());
+			sketches_.reserve(sketches.size());
+
+			for (const CachedSketchTexts* cached : sketches) {
+				unsigned int sketchIndex = (unsigned int)sketches_.size();
+				sketchNames_.push_back(cached->name);
+				sketches_.push_back(cached->sketch);
+				textBytes_ += sketchNames_.back().capacity();
+				for (const SketchTextRecord& record : cached->records) {
+					records_.push_back(record);
+					records_.back().sketchIndex = sketchIndex;
+					textBytes_ += records_.back().text.capacity();
+				}
+				entities_.insert(entities_.end(), cached->entities.begin(), cached->entities.end());
+			}
+		}
+
+		/// <summary>Removes all captured records, entities and sketch names.</summary>
+		void SketchTextSnapshot::clear() {
+			records_.clear();
+			entities_.clear();
+			sketchNames_.clear();
+			sketches_.clear();
+			textBytes_ = 0;
+		}
+
+		/// <summary>Estimates the heap memory held by the snapshot, counting capacities rather than sizes.</summary>
+		///
+		/// <returns>The memory in bytes.</returns>
+		size_t SketchTextSnapshot::getMemoryUsage() const {
+			return records_.capacity() * sizeof(SketchTextRecord)
+				+ entities_.capacity() * sizeof(Ptr<SketchText>)
+				+ sketchNames_.capacity() * sizeof(std::string)
+				+ sketches_.capacity() * sizeof(Ptr<Sketch>)
+				+ textBytes_;
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+using namespace adsk::core;
+using namespace adsk::fusion;
+using namespace adsk::cam;
+
+namespace implicatex {
+	namespace fusion {
+		struct CachedSketchTexts;
+
+		/// <summary>
+		/// <para>SketchTextSnapshot joins the cached texts of one or more sketches into SketchTextRecord values,</para>
+		/// <para>keeping the SketchText entities alongside so that results can be mapped back to the model.</para>
+		/// </summary>
+		class SketchTextSnapshot
+		{
+		public:
+			void assemble(const std::vector<const CachedSketchTexts*>& sketches);
+			void clear();
+			size_t getMemoryUsage() const;
+
+			#pragma region Getters
+			size_t size() const { return records_.size(); }
+			bool empty() const { return records_.empty(); }
+			const std::vector<SketchTextRecord>& records() const { return records_; }
+			const SketchTextRecord& record(size_t index) const { return records_[index]; }
+			Ptr<SketchText> entity(size_t index) const { return entities_[index]; }
+			const std::string& sketchName(unsigned int sketchIndex) const { return sketchNames_[sketchIndex]; }
+			const std::vector<std::string>& sketchNames() const { return sketchNames_; }
+			Ptr<Sketch> sketch(unsigned int sketchIndex) const { return sketches_[sketchIndex]; }
+			size_t sketchCount() const { return sketches_.size(); }
+			#pragma endregion
+
+		private:
+			std::vector<SketchTextRecord> records_;
+			std::vector<Ptr<SketchText>> entities_;
+			std::vector<std::string> sketchNames_;
+			std::vector<Ptr<Sketch>> sketches_;
+			size_t textBytes_ = 0; // Capacity of the record texts and sketch names, summed when assembled
+		};
+	}
+}
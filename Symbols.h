@@ -9,3 +9,4 @@ constexpr auto IDS_CMD_IMPLICATEX_TOOLS = "ImplicateXToolsCommand"; // Implicate
 constexpr auto IDS_CMD_SKETCHTEXT = "SketchTextCommand"; // SketchTextCommand
 constexpr auto IDS_ID_LANG_SELECTOR = "LanguageDropDownControl"; // LanguageDropDownControl
 constexpr auto IDS_CMD_LANG_SELECTOR = "LanguageDropDownCommand"; // LanguageDropDownCommand
+constexpr auto IDS_EVENT_LOG_DRAIN = "ImplicateXLogDrain"; // ImplicateXLogDrain
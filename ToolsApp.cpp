@@ -1,11 +1,33 @@
 #include "pch.h"  
 #include "resource.h"  
 #include "ResourceHelper.h"
+#define LOG_CATEGORY ::implicatex::fusion::LogCategory::App
 #include "Logging.h"
+#include "TraceRecorder.h"
+#include "Profiler.h"
+#include "FileHelper.h"
+#include "LocaleTable.h"
+#include "SettingsStore.h"
 #include "ToolsBar.h"
 #include "ToolsApp.h"  
 #include "ImplicateXFusionToolsAddIn.h"
 #include "SketchTextSettingsTab.h"
+#include "SketchTextDiagnosticsTab.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSnapshot.h"
+#include "SketchTextCache.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextSorter.h"
+#include "SketchTextReplacer.h"
+#include "SketchTextDuplicateFinder.h"
+#include "SketchTextHeightClusterer.h"
+#include "SketchTextExporter.h"
+#include "SketchTextFilter.h"
+#include "SketchTextQuery.h"
+#include "RefreshArena.h"
+#include "TableRowMaterializer.h"
+#include "SketchTextAnalysis.h"
 #include "SketchTextHeightTab.h"
 #include "SketchTextPanel.h"
 
@@ -17,6 +39,8 @@ namespace implicatex {
 	namespace fusion {
 		std::unique_ptr<ToolsBar> ToolsApp::toolsBar = nullptr;
 		std::unique_ptr<SketchTextPanel> ToolsApp::sketchTextPanel = nullptr;
+		std::unique_ptr<SketchTextAnalysisStore> ToolsApp::sketchTextAnalyses = nullptr;
+		std::unique_ptr<SettingsStore> ToolsApp::settingsStore = nullptr;
 
 		std::map<UserLanguages, std::string> ToolsApp::localeIdMap;
 
@@ -41,6 +65,9 @@ namespace implicatex {
                return false;  
            }  
 
+           startLogging();
+           TraceRecorder::get().setThreadName("Main");
+
            Ptr<TextCommandPalette> textCommandPalette = userInterface()->palettes()->itemById("TextCommands");  
            if (textCommandPalette) {  
                textCommandPalette->isVisible(true);  
@@ -51,6 +78,17 @@ namespace implicatex {
            LOG_INFO(toolsLocaleId);  
            LOG_INFO(LoadStringFromResource(IDS_MSG_APP_INITIALIZED)); // Ensure IDS_MSG_APP_INITIALIZED is defined  
 
+           ensureUserSettingsDirectoryExists();
+           settingsStore = std::make_unique<SettingsStore>(getUserSettingsPath());
+           if (!settingsStore->load()) {
+               LOG_INFO("No settings loaded from: {}", settingsStore->getPath());
+           }
+
+           sketchTextAnalyses = std::make_unique<SketchTextAnalysisStore>();
+           if (!sketchTextAnalyses->subscribe()) {
+               LOG_ERROR("Failed to subscribe the sketch text analyses to document changes");
+           }
+
            if (!createBar()) {  
                LOG_ERROR(LoadStringFromResource(IDS_ERR_CREATE_BAR));  
                return false;  
@@ -87,7 +125,55 @@ namespace implicatex {
 				break;
 			}
 			removeBar();
+
+			if (sketchTextAnalyses) {
+				// Removes the event handlers while the application still exists
+				sketchTextAnalyses.reset();
+			}
+
+			if (settingsStore) {
+				// Stops the writer and writes pending changes
+				settingsStore.reset();
+			}
 			LOG_INFO(LoadStringFromResource(IDS_MSG_APP_TERMINATED));
+
+			stopLogging();
+		}
+
+		bool ToolsApp::startLogging() {
+			unregisterCustomEvent(IDS_EVENT_LOG_DRAIN);
+			Ptr<CustomEvent> drainEvent = registerCustomEvent(IDS_EVENT_LOG_DRAIN);
+			if (!drainEvent) {
+				return false;
+			}
+			drainEvent->add(new LogDrainEventHandler());
+
+#ifdef _LOG_FILE_
+			LogSink sink = LogSink::File;
+#else
+			LogSink sink = LogSink::Console;
+#endif
+			return Logger::get().start(sink, getUserLogPath(), []() {
+				toolsApp->fireCustomEvent(IDS_EVENT_LOG_DRAIN);
+			});
+		}
+
+		void ToolsApp::stopLogging() {
+			Logger::get().stop();
+			LogDrainEventHandler().notify(nullptr);
+			unregisterCustomEvent(IDS_EVENT_LOG_DRAIN);
+		}
+
+		/// <summary>Writes the pending log lines to the Fusion console.</summary>
+		///
+		/// <param name="eventArgs">The custom event arguments, unused.</param>
+		void LogDrainEventHandler::notify(const Ptr<CustomEventArgs>& eventArgs) {
+			Logger::get().drain([](LogLevel level, const std::string& line) {
+				LogLevels logLevel = level == LogLevel::Error ? ErrorLogLevel
+					: level == LogLevel::Warning ? WarningLogLevel
+					: InfoLogLevel;
+				toolsApp->log(line, logLevel, ConsoleLogType);
+			});
 		}
 
 		/// <summary>
@@ -115,6 +201,14 @@ namespace implicatex {
 			return true;
 		}
 
+		std::shared_ptr<const ToolsSettings> ToolsApp::getSettings() {
+			if (settingsStore) {
+				return settingsStore->get();
+			}
+			static const std::shared_ptr<const ToolsSettings> defaultSettings = std::make_shared<const ToolsSettings>();
+			return defaultSettings;
+		}
+
 		/// <summary>
 		/// <para>The ToolsApp::removeBar() function is responsible for safely removing and resetting a pointer</para>
 		/// <para> to a panel associated with sketch text definitions,</para>
@@ -181,7 +275,7 @@ namespace implicatex {
 			localeIdMap.insert({ UserLanguages::SpanishLanguage,			 "es-ES" });
 			localeIdMap.insert({ UserLanguages::TurkishLanguage,			 "tr-TR" });
 
-			std::string localeId = "en-US"; // Default to English
+			std::string localeId = LocaleTable::DEFAULT_LOCALE_ID; // Default to English
 
 			Ptr<Preferences> preferences = this->preferences();
 			if (preferences) {
@@ -205,35 +299,7 @@ namespace implicatex {
 		/// <param name="selectedLocale">		   The selected locale.</param>
 		/// <param name="localeLanguageRegionMap">[in,out] The locale language region map.</param>
 		void ToolsApp::getLanguageRegionNames(std::string selectedLocale, std::map<std::string,std::string>& localeLanguageRegionMap) {
-			UErrorCode status = U_ZERO_ERROR;
-			UnicodeString result;
-			Locale localeBuilder;
-			std::string languageCode;
-			std::string regionCode;
-			std::string selectedCode = selectedLocale.substr(0, 2);;
-			std::string languageRegionName;
-			
-			localeLanguageRegionMap.clear();
-
-			for (const auto& [index, locale] : ToolsApp::localeIdMap) {
-				languageCode = locale.substr(0, 2);
-				regionCode = locale.substr(3, 2);
-				localeBuilder =
-					LocaleBuilder()
-					.setLanguage(languageCode.c_str())
-					.setRegion(regionCode.c_str())
-					.build(status);
-				if (U_SUCCESS(status)) {
-					localeBuilder.getDisplayName(Locale::forLanguageTag(selectedCode.c_str(), status), result);
-					result.toUTF8String(languageRegionName);
-					localeLanguageRegionMap.insert({ locale, languageRegionName });
-				}
-				else {
-					LOG_ERROR("Error creating LocaleBuilder: " + std::to_string(status));
-				}
-
-				languageRegionName.clear();
-			}
+			LocaleTable::getLanguageRegionNames(selectedLocale, localeLanguageRegionMap);
 		}
 
 		/// <summary>
@@ -244,15 +310,7 @@ namespace implicatex {
 		/// <param name="selectedLocale">		    The selected locale.</param>
 		/// <param name="localeLanguageRegionMap">[in,out] The locale language region map.</param>
 		void ToolsApp::getLanguageRegionNamesSorted(std::string selectedLocale, std::vector<std::pair<std::string, std::string>>& sortedLocaleLanguageRegionList) {
-			std::map<std::string, std::string> localeLanguageRegionMap;
-
-			getLanguageRegionNames(selectedLocale, localeLanguageRegionMap);
-
-			sortedLocaleLanguageRegionList.assign(localeLanguageRegionMap.begin(), localeLanguageRegionMap.end());
-
-			std::sort(sortedLocaleLanguageRegionList.begin(), sortedLocaleLanguageRegionList.end(), [](const auto& a, const auto& b) {
-				return a.second < b.second;
-			});
+			LocaleTable::getLanguageRegionNamesSorted(selectedLocale, sortedLocaleLanguageRegionList);
 		}
 	}
 }
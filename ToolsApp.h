@@ -8,6 +8,19 @@ using namespace adsk::cam;
 namespace implicatex {
 	namespace fusion {
 		class SketchTextPanel;
+		class SketchTextAnalysisStore;
+
+		/// <summary>
+		/// <para>LogDrainEventHandler receives the custom event fired by the logger's writer thread</para>
+		/// <para>and writes the pending log lines to the Fusion console on the main thread.</para>
+		/// </summary>
+		class LogDrainEventHandler : public CustomEventHandler {
+		public:
+			void notify(const Ptr<CustomEventArgs>& eventArgs) override;
+		};
+
+		class SettingsStore;
+		struct ToolsSettings;
 		/// <summary>
 		/// <para>The ToolsApp class in the implicatex::fusion namespace is designed to manage the initialization,</para>
 		/// <para>termination, and user interface components of the Implicate-X tools application, </para>
@@ -25,6 +38,19 @@ namespace implicatex {
 
 			static std::unique_ptr<SketchTextPanel> sketchTextPanel;
 
+			/// <summary>The sketch text analyses of the recently used documents, kept across panel sessions.</summary>
+			static std::unique_ptr<SketchTextAnalysisStore> sketchTextAnalyses;
+
+			/// <summary>The user settings, loaded once and written behind by a background thread.</summary>
+			static std::unique_ptr<SettingsStore> settingsStore;
+
+			/// <summary>
+			/// <para>getSettings returns the current settings snapshot of the settings store,</para>
+			/// <para>or default settings while no store exists.</para>
+			/// </summary>
+			/// <returns>The settings snapshot, never null.</returns>
+			static std::shared_ptr<const ToolsSettings> getSettings();
+
 			/// <summary>The locale identifier map.</summary>
 			static std::map<UserLanguages, std::string> localeIdMap;
 
@@ -55,6 +81,16 @@ namespace implicatex {
 			/// </summary>
 			void removeBar();
 
+			/// <summary>
+			/// <para>startLogging starts the asynchronous logger, writing to the log file with _LOG_FILE_</para>
+			/// <para>and to the Fusion console otherwise, drained through IDS_EVENT_LOG_DRAIN.</para>
+			/// </summary>
+			/// <returns>True if it succeeds, false if it fails.</returns>
+			bool startLogging();
+
+			/// <summary>Stops the logger after writing all pending records.</summary>
+			void stopLogging();
+
 			bool createSketchTextPanel();
 
 			void removeSketchTextPanel();
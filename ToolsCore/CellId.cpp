@@ -0,0 +1,53 @@
+#include "CorePch.h"
+#include "CellId.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>makeCellId builds the input id of a table cell from the id of its column and the row,</para>
+		/// <para>e.g. "textIdCell_3".</para>
+		/// </summary>
+		///
+		/// <param name="cellId">The id of the column.</param>
+		/// <param name="row">	 The row number.</param>
+		///
+		/// <returns>The input id of the cell.</returns>
+		std::string makeCellId(std::string_view cellId, unsigned int row) {
+			char digits[16];
+			auto result = std::to_chars(digits, digits + sizeof(digits), row);
+			std::string inputId;
+			inputId.reserve(cellId.size() + 1 + (result.ptr - digits));
+			inputId.append(cellId);
+			inputId.push_back('_');
+			inputId.append(digits, result.ptr);
+			return inputId;
+		}
+
+		/// <summary>
+		/// <para>parseCellId splits the input id of a table cell into the id of its column and the row,</para>
+		/// <para>the reverse of makeCellId. Input ids without a numeric row suffix are not cells.</para>
+		/// </summary>
+		///
+		/// <param name="inputId">The input id.</param>
+		/// <param name="cellId"> [out] The id of the column, a view into inputId.</param>
+		/// <param name="row">	  [out] The row number.</param>
+		///
+		/// <returns>True if the input id is the id of a cell.</returns>
+		bool parseCellId(std::string_view inputId, std::string_view& cellId, unsigned int& row) {
+			size_t separator = inputId.find_last_of('_');
+			if (separator == std::string_view::npos || separator == 0 || separator + 1 == inputId.size()) {
+				return false;
+			}
+			const char* first = inputId.data() + separator + 1;
+			const char* last = inputId.data() + inputId.size();
+			unsigned int value = 0;
+			auto result = std::from_chars(first, last, value);
+			if (result.ec != std::errc() || result.ptr != last) {
+				return false;
+			}
+			cellId = inputId.substr(0, separator);
+			row = value;
+			return true;
+		}
+	}
+}
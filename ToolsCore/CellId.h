@@ -0,0 +1,8 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		std::string makeCellId(std::string_view cellId, unsigned int row);
+		bool parseCellId(std::string_view inputId, std::string_view& cellId, unsigned int& row);
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+// The standard and ICU headers of the core library, which uses neither the Fusion API nor Windows
+// so that it can be built and measured with any C++20 toolchain. The add-in's pch.h includes it.
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <shared_mutex>
+#include <cmath>
+#include <ctime>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <charconv>
+#include <bit>
+#include <iomanip>
+#include <iostream>
+#include <fstream>
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <tuple>
+#include <concepts>
+#include <sstream>
+#include <locale>
+#include <limits>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <memory_resource>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <regex>
+// Ensure ICU library is properly included
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4635)
+#endif
+#include <unicode/utypes.h>
+#include <unicode/locid.h>
+#include <unicode/ustream.h>
+#include <unicode/locdspnm.h>
+#include <unicode/localebuilder.h>
+#include <unicode/coll.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
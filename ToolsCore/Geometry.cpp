@@ -0,0 +1,120 @@
+#include "CorePch.h"
+#include "Geometry.h"
+
+namespace implicatex {
+	namespace fusion {
+		void Box3::extend(const Point3& point) {
+			minPoint.x = (std::min)(minPoint.x, point.x);
+			minPoint.y = (std::min)(minPoint.y, point.y);
+			minPoint.z = (std::min)(minPoint.z, point.z);
+			maxPoint.x = (std::max)(maxPoint.x, point.x);
+			maxPoint.y = (std::max)(maxPoint.y, point.y);
+			maxPoint.z = (std::max)(maxPoint.z, point.z);
+		}
+
+		void Box3::extend(const Box3& box) {
+			if (box.isValid()) {
+				extend(box.minPoint);
+				extend(box.maxPoint);
+			}
+		}
+
+		Point3 Box3::center() const {
+			return Point3{
+				(minPoint.x + maxPoint.x) / 2.0,
+				(minPoint.y + maxPoint.y) / 2.0,
+				(minPoint.z + maxPoint.z) / 2.0
+			};
+		}
+
+		double Box3::diagonal() const {
+			double dx = maxPoint.x - minPoint.x;
+			double dy = maxPoint.y - minPoint.y;
+			double dz = maxPoint.z - minPoint.z;
+			return std::sqrt(dx * dx + dy * dy + dz * dz);
+		}
+
+		/// <summary>
+		/// <para>getTextCamera looks down onto the center of a text. An orthographic camera shows the diagonal</para>
+		/// <para>times the zoom factor; a perspective camera stands one diagonal above the text and uses</para>
+		/// <para>the zoom factor as its perspective angle.</para>
+		/// </summary>
+		///
+		/// <param name="textBox">		 The bounding box of the text.</param>
+		/// <param name="isOrthographic">True for an orthographic camera.</param>
+		/// <param name="zoomFactor">	 The zoom factor of the settings.</param>
+		///
+		/// <returns>The eye, target and extent of the camera.</returns>
+		CameraFit getTextCamera(const Box3& textBox, bool isOrthographic, double zoomFactor) {
+			CameraFit fit;
+			fit.target = textBox.center();
+			fit.target.z = textBox.minPoint.z;
+			double diagonal = textBox.diagonal();
+			fit.eye = fit.target;
+			if (isOrthographic) {
+				fit.eye.z += 1.0;
+				fit.extent = diagonal * zoomFactor;
+			}
+			else {
+				fit.eye.z += diagonal;
+			}
+			return fit;
+		}
+
+		/// <summary>getSketchCamera looks down onto the center of a sketch from one and a half diagonals above.</summary>
+		///
+		/// <param name="sketchBox">The bounding box of the sketch.</param>
+		///
+		/// <returns>The eye and target of the camera.</returns>
+		CameraFit getSketchCamera(const Box3& sketchBox) {
+			CameraFit fit;
+			fit.target = sketchBox.center();
+			fit.eye = fit.target;
+			fit.eye.z += sketchBox.diagonal() * 1.5;
+			return fit;
+		}
+
+		/// <summary>
+		/// <para>scaleBox scales a box about an anchor point, e.g. the bounds of a text whose height changes</para>
+		/// <para>by ratio while its anchor stays in place.</para>
+		/// </summary>
+		///
+		/// <param name="box">   The box to scale.</param>
+		/// <param name="anchor">The point that keeps its position.</param>
+		/// <param name="ratio"> The scale factor.</param>
+		///
+		/// <returns>The scaled box.</returns>
+		Box3 scaleBox(const Box3& box, const Point3& anchor, double ratio) {
+			auto scale = [&anchor, ratio](const Point3& point) {
+				return Point3{
+					anchor.x + (point.x - anchor.x) * ratio,
+					anchor.y + (point.y - anchor.y) * ratio,
+					anchor.z + (point.z - anchor.z) * ratio
+				};
+			};
+			return Box3::of(scale(box.minPoint), scale(box.maxPoint));
+		}
+
+		/// <summary>
+		/// <para>appendRectangle adds the outline of a box in the plane at z to a line set: four corner points</para>
+		/// <para>and the index pairs of its four edges.</para>
+		/// </summary>
+		///
+		/// <param name="box">	  The box to outline.</param>
+		/// <param name="z">	  The height of the outline.</param>
+		/// <param name="points"> [in,out] The coordinates, three per point.</param>
+		/// <param name="indices">[in,out] The point indices, two per line.</param>
+		void appendRectangle(const Box3& box, double z, std::vector<double>& points, std::vector<int>& indices) {
+			int base = (int)(points.size() / 3);
+			points.insert(points.end(), {
+				box.minPoint.x, box.minPoint.y, z,
+				box.maxPoint.x, box.minPoint.y, z,
+				box.maxPoint.x, box.maxPoint.y, z,
+				box.minPoint.x, box.maxPoint.y, z
+			});
+			indices.insert(indices.end(), {
+				base + 0, base + 1, base + 1, base + 2, base + 2, base + 3, base + 3, base + 0
+			});
+		}
+	}
+}
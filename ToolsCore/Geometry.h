@@ -0,0 +1,42 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>A point or direction in model space, in Fusion internal units (cm).</summary>
+		struct Point3 {
+			double x = 0.0;
+			double y = 0.0;
+			double z = 0.0;
+		};
+
+		/// <summary>
+		/// <para>Box3 is an axis aligned bounding box. A default constructed box is empty; extending it</para>
+		/// <para>by a point makes it valid.</para>
+		/// </summary>
+		struct Box3 {
+			Point3 minPoint{ (std::numeric_limits<double>::max)(), (std::numeric_limits<double>::max)(), (std::numeric_limits<double>::max)() };
+			Point3 maxPoint{ std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() };
+
+			static Box3 of(const Point3& minPoint, const Point3& maxPoint) { return Box3{ minPoint, maxPoint }; }
+
+			void extend(const Point3& point);
+			void extend(const Box3& box);
+
+			bool isValid() const { return minPoint.x <= maxPoint.x && minPoint.y <= maxPoint.y && minPoint.z <= maxPoint.z; }
+			Point3 center() const;
+			double diagonal() const;
+		};
+
+		/// <summary>The camera to set on the viewport, see getTextCamera and getSketchCamera.</summary>
+		struct CameraFit {
+			Point3 eye;
+			Point3 target;
+			double extent = 0.0; // Orthographic cameras only
+		};
+
+		CameraFit getTextCamera(const Box3& textBox, bool isOrthographic, double zoomFactor);
+		CameraFit getSketchCamera(const Box3& sketchBox);
+		Box3 scaleBox(const Box3& box, const Point3& anchor, double ratio);
+		void appendRectangle(const Box3& box, double z, std::vector<double>& points, std::vector<int>& indices);
+	}
+}
@@ -0,0 +1,68 @@
+#include "CorePch.h"
+#include "LocaleTable.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>getLocaleIds returns the ids of the supported locales as language-REGION, e.g. "de-DE".</summary>
+		///
+		/// <returns>The locale ids.</returns>
+		const std::vector<std::string>& LocaleTable::getLocaleIds() {
+			static const std::vector<std::string> localeIds = {
+				"zh-CN", "zh-TW", "cs-CZ", "en-US", "fr-FR", "de-DE", "hu-HU", "it-IT",
+				"ja-JP", "ko-KR", "pl-PL", "pt-BR", "ru-RU", "es-ES", "tr-TR"
+			};
+			return localeIds;
+		}
+
+		/// <summary>
+		/// <para>The getLanguageRegionNames function retrieves the language and region names of the supported locales</para>
+		/// <para>in the language of the selected locale. Locales ICU cannot build are left out.</para>
+		/// </summary>
+		///
+		/// <param name="selectedLocale">		   The selected locale.</param>
+		/// <param name="localeLanguageRegionMap">[in,out] The locale language region map.</param>
+		void LocaleTable::getLanguageRegionNames(const std::string& selectedLocale, std::map<std::string, std::string>& localeLanguageRegionMap) {
+			std::string selectedCode = selectedLocale.substr(0, 2);
+			std::string languageRegionName;
+
+			localeLanguageRegionMap.clear();
+
+			for (const std::string& localeId : getLocaleIds()) {
+				UErrorCode status = U_ZERO_ERROR;
+				icu::Locale locale =
+					icu::LocaleBuilder()
+					.setLanguage(localeId.substr(0, 2))
+					.setRegion(localeId.substr(3, 2))
+					.build(status);
+				if (U_FAILURE(status)) {
+					continue;
+				}
+
+				icu::UnicodeString result;
+				locale.getDisplayName(icu::Locale::forLanguageTag(selectedCode.c_str(), status), result);
+				languageRegionName.clear();
+				result.toUTF8String(languageRegionName);
+				localeLanguageRegionMap.insert({ localeId, languageRegionName });
+			}
+		}
+
+		/// <summary>
+		/// <para>The getLanguageRegionNamesSorted function retrieves the language-region pairs of getLanguageRegionNames</para>
+		/// <para>sorted by their names.</para>
+		/// </summary>
+		///
+		/// <param name="selectedLocale">				The selected locale.</param>
+		/// <param name="sortedLocaleLanguageRegionList">[in,out] The locale ids and names, sorted by name.</param>
+		void LocaleTable::getLanguageRegionNamesSorted(const std::string& selectedLocale, std::vector<std::pair<std::string, std::string>>& sortedLocaleLanguageRegionList) {
+			std::map<std::string, std::string> localeLanguageRegionMap;
+
+			getLanguageRegionNames(selectedLocale, localeLanguageRegionMap);
+
+			sortedLocaleLanguageRegionList.assign(localeLanguageRegionMap.begin(), localeLanguageRegionMap.end());
+
+			std::sort(sortedLocaleLanguageRegionList.begin(), sortedLocaleLanguageRegionList.end(), [](const auto& a, const auto& b) {
+				return a.second < b.second;
+			});
+		}
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>LocaleTable lists the locales the add-in is translated to, which are the user languages of Fusion,</para>
+		/// <para>and names them in a display language with ICU.</para>
+		/// </summary>
+		class LocaleTable
+		{
+		public:
+			static constexpr const char* DEFAULT_LOCALE_ID = "en-US";
+
+			static const std::vector<std::string>& getLocaleIds();
+			static void getLanguageRegionNames(const std::string& selectedLocale, std::map<std::string, std::string>& localeLanguageRegionMap);
+			static void getLanguageRegionNamesSorted(const std::string& selectedLocale, std::vector<std::pair<std::string, std::string>>& sortedLocaleLanguageRegionList);
+		};
+	}
+}
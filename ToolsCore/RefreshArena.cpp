@@ -0,0 +1,40 @@
+#include "CorePch.h"
+#include "RefreshArena.h"
+
+namespace implicatex {
+	namespace fusion {
+		RefreshArena::RefreshArena(size_t capacity) : capacity_(capacity) {
+			reset();
+		}
+
+		/// <summary>
+		/// <para>release drops all allocations of the refresh. If the refresh overflowed the buffer, the buffer grows</para>
+		/// <para>by the overflow, rounded up to a power of two and at most to MAX_CAPACITY.</para>
+		/// </summary>
+		void RefreshArena::release() {
+			arena_->release();
+			lastOverflow_ = overflow_.bytes;
+			overflow_.bytes = 0;
+			++releaseCount_;
+			if (lastOverflow_ > 0 && capacity_ < MAX_CAPACITY) {
+				capacity_ = (std::min)(std::bit_ceil(capacity_ + lastOverflow_), MAX_CAPACITY);
+				reset();
+			}
+		}
+
+		void RefreshArena::reset() {
+			arena_.reset();
+			buffer_ = std::make_unique_for_overwrite<std::byte[]>(capacity_);
+			arena_ = std::make_unique<std::pmr::monotonic_buffer_resource>(buffer_.get(), capacity_, &overflow_);
+		}
+
+		void* RefreshArena::OverflowResource::do_allocate(size_t size, size_t alignment) {
+			bytes += size;
+			return std::pmr::new_delete_resource()->allocate(size, alignment);
+		}
+
+		void RefreshArena::OverflowResource::do_deallocate(void* memory, size_t size, size_t alignment) {
+			std::pmr::new_delete_resource()->deallocate(memory, size, alignment);
+		}
+	}
+}
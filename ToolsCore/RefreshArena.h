@@ -0,0 +1,77 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>RefreshArena hands out the memory of the temporaries of one refresh of the match table: filter scratch,</para>
+		/// <para>the filtered entities and cell texts. Allocations bump a pointer through a buffer that is kept between</para>
+		/// <para>refreshes; nothing is freed until the refresh ends and release drops everything at once. A refresh that</para>
+		/// <para>outgrows the buffer takes the rest from the heap and the buffer grows to fit the next one.</para>
+		/// </summary>
+		class RefreshArena
+		{
+		public:
+			static constexpr size_t INITIAL_CAPACITY = 64 * 1024;
+			static constexpr size_t MAX_CAPACITY = 16 * 1024 * 1024;
+
+			explicit RefreshArena(size_t capacity = INITIAL_CAPACITY);
+
+			RefreshArena(const RefreshArena&) = delete;
+			RefreshArena& operator=(const RefreshArena&) = delete;
+
+			std::pmr::memory_resource* resource() { return arena_.get(); }
+			void release();
+
+			#pragma region Getters
+			size_t getCapacity() const { return capacity_; }
+			size_t getLastOverflow() const { return lastOverflow_; }
+			uint64_t getReleaseCount() const { return releaseCount_; }
+			#pragma endregion
+
+		private:
+			friend class ScopedArena;
+
+			/// <summary>Takes the memory the buffer cannot provide from the heap and counts how much that was.</summary>
+			class OverflowResource : public std::pmr::memory_resource {
+			public:
+				size_t bytes = 0;
+
+			private:
+				void* do_allocate(size_t size, size_t alignment) override;
+				void do_deallocate(void* memory, size_t size, size_t alignment) override;
+				bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+			};
+
+			void reset();
+
+			std::unique_ptr<std::byte[]> buffer_;
+			size_t capacity_ = 0;
+			OverflowResource overflow_;
+			std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_;
+			int depth_ = 0;
+			size_t lastOverflow_ = 0;
+			uint64_t releaseCount_ = 0;
+		};
+
+		/// <summary>
+		/// <para>ScopedArena releases the arena when the outermost scope of a refresh closes, so that refreshes nested</para>
+		/// <para>in an input changed event keep the memory of the one that started them.</para>
+		/// </summary>
+		class ScopedArena
+		{
+		public:
+			explicit ScopedArena(RefreshArena& arena) : arena_(arena) { ++arena_.depth_; }
+			~ScopedArena() {
+				if (--arena_.depth_ == 0) {
+					arena_.release();
+				}
+			}
+
+			ScopedArena(const ScopedArena&) = delete;
+			ScopedArena& operator=(const ScopedArena&) = delete;
+
+		private:
+			RefreshArena& arena_;
+		};
+	}
+}
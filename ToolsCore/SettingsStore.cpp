@@ -0,0 +1,316 @@
+#include "CorePch.h"
+#include <nlohmann/json.hpp>
+#include "SettingsStore.h"
+#include "TraceRecorder.h"
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+using json = nlohmann::json;
+
+namespace implicatex {
+	namespace fusion {
+		namespace {
+			constexpr auto KEY_VERSION = "version";
+			constexpr auto KEY_SKETCH_TEXT = "SketchText";
+
+			/// <summary>The last snapshot version of all stores, so that a version names one snapshot of one store.</summary>
+			std::atomic<uint64_t> lastSnapshotVersion = 0;
+
+			/// <summary>The snapshot a thread read last, with its version.</summary>
+			struct SnapshotCache {
+				uint64_t version = 0;
+				std::shared_ptr<const ToolsSettings> settings;
+			};
+
+			thread_local SnapshotCache snapshotCache;
+
+			/// <summary>Formats a packed 0xRRGGBBAA color as "#RRGGBBAA".</summary>
+			std::string colorToString(uint32_t color) {
+				char text[10];
+				std::snprintf(text, sizeof(text), "#%08X", (unsigned int)color);
+				return text;
+			}
+
+			/// <summary>Parses "#RRGGBBAA", keeping the fallback if the text is not a valid color.</summary>
+			uint32_t colorFromString(const std::string& text, uint32_t fallback) {
+				if (text.size() != 9 || text[0] != '#') {
+					return fallback;
+				}
+				uint32_t color = 0;
+				auto [end, error] = std::from_chars(text.data() + 1, text.data() + text.size(), color, 16);
+				return (error == std::errc() && end == text.data() + text.size()) ? color : fallback;
+			}
+
+			/// <summary>
+			/// <para>migrate upgrades a settings document step by step to the current schema.</para>
+			/// <para>Version 1 files have no version key and only hold SketchText.zoomFactor.</para>
+			/// </summary>
+			///
+			/// <param name="j">[in,out] The settings document.</param>
+			///
+			/// <returns>The version the document had before migrating.</returns>
+			int migrate(json& j) {
+				int version = j.value(KEY_VERSION, 1);
+				if (version < 2) {
+					// Version 2 added the height tab state and the highlight style, all with defaults
+					if (!j.contains(KEY_SKETCH_TEXT) || !j[KEY_SKETCH_TEXT].is_object()) {
+						j[KEY_SKETCH_TEXT] = json::object();
+					}
+				}
+				// Version 3 added the query presets, none by default
+				if (version < ToolsSettings::SCHEMA_VERSION) {
+					j[KEY_VERSION] = ToolsSettings::SCHEMA_VERSION;
+				}
+				return version;
+			}
+
+			/// <summary>Reads a value if present and of the right type, keeping the default otherwise.</summary>
+			template <typename T>
+			void read(const json& section, const char* key, T& value) {
+				auto it = section.find(key);
+				if (it == section.end()) return;
+				try {
+					value = it->get<T>();
+				}
+				catch (const json::exception&) {
+				}
+			}
+
+			/// <summary>Reads the query presets, skipping entries without a name or a query.</summary>
+			void readQueryPresets(const json& section, std::vector<QueryPreset>& presets) {
+				auto it = section.find("queryPresets");
+				if (it == section.end() || !it->is_array()) return;
+				for (const json& entry : *it) {
+					if (!entry.is_object()) continue;
+					QueryPreset preset;
+					read(entry, "name", preset.name);
+					read(entry, "query", preset.query);
+					if (!preset.name.empty() && !preset.query.empty()) {
+						presets.push_back(std::move(preset));
+					}
+				}
+			}
+		}
+
+		/// <summary>Creates the store and starts its background writer.</summary>
+		///
+		/// <param name="path">		  The path of the settings file.</param>
+		/// <param name="quietPeriod">The time without changes after which pending changes are written.</param>
+		SettingsStore::SettingsStore(const std::string& path, std::chrono::milliseconds quietPeriod)
+			: path_(path), quietPeriod_(quietPeriod), snapshot_(std::make_shared<const ToolsSettings>()), snapshotVersion_(++lastSnapshotVersion) {
+			writer_ = std::thread(&SettingsStore::run, this);
+		}
+
+		/// <summary>Stops the background writer and writes any pending change.</summary>
+		SettingsStore::~SettingsStore() {
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				isStopping_ = true;
+			}
+			changed_.notify_all();
+			if (writer_.joinable()) {
+				writer_.join();
+			}
+			flush();
+		}
+
+		/// <summary>
+		/// <para>load reads the settings file once, migrating older schema versions and keeping</para>
+		/// <para>the defaults for missing or unreadable values. Files written by a newer schema</para>
+		/// <para>are read but never overwritten.</para>
+		/// </summary>
+		///
+		/// <returns>True if the file was read, false if it is missing or invalid.</returns>
+		bool SettingsStore::load() {
+			auto settings = std::make_shared<ToolsSettings>();
+			bool isLoaded = false;
+			int version = 0;
+
+			std::ifstream file(path_);
+			if (file) {
+				json j = json::parse(file, nullptr, false);
+				if (!j.is_discarded() && j.is_object()) {
+					version = migrate(j);
+					const json& section = j[KEY_SKETCH_TEXT];
+					if (section.is_object()) {
+						std::string highlightColor = colorToString(settings->highlightColor);
+						read(section, "zoomFactor", settings->zoomFactor);
+						readQueryPresets(section, settings->queryPresets);
+						read(section, "lastSketch", settings->lastSketchName);
+						read(section, "allSketches", settings->isAllSketches);
+						read(section, "textHeightMin", settings->textHeightMin);
+						read(section, "textHeightMax", settings->textHeightMax);
+						read(section, "sortOrder", settings->sortOrder);
+						read(section, "sortDescending", settings->isSortDescending);
+						read(section, "tablePageSize", settings->tablePageSize);
+						read(section, "highlightColor", highlightColor);
+						read(section, "highlightWeight", settings->highlightWeight);
+						settings->highlightColor = colorFromString(highlightColor, settings->highlightColor);
+					}
+					isLoaded = true;
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			loadedVersion_ = version;
+			isReadOnly_ = version > ToolsSettings::SCHEMA_VERSION;
+			snapshot_ = std::move(settings);
+			snapshotVersion_.store(++lastSnapshotVersion, std::memory_order_release);
+			// Write migrated files back in the current schema
+			isDirty_ = isLoaded && version < ToolsSettings::SCHEMA_VERSION;
+			if (isDirty_) {
+				lastChange_ = std::chrono::steady_clock::now();
+				changed_.notify_all();
+			}
+			return isLoaded;
+		}
+
+		/// <summary>Writes pending changes now, e.g. when the add-in stops.</summary>
+		///
+		/// <returns>True if nothing was pending or the write succeeded, false if it failed.</returns>
+		bool SettingsStore::flush() {
+			return writePending();
+		}
+
+		/// <summary>
+		/// <para>get returns the current snapshot. The snapshot cached by the calling thread is returned as long</para>
+		/// <para>as its version is current, without any lock; after a change the cache is refreshed under the mutex.</para>
+		/// </summary>
+		///
+		/// <returns>The settings, which never change while they are held.</returns>
+		std::shared_ptr<const ToolsSettings> SettingsStore::get() const {
+			if (snapshotCache.version != snapshotVersion_.load(std::memory_order_acquire)) {
+				std::lock_guard<std::mutex> lock(mutex_);
+				snapshotCache.settings = snapshot_;
+				snapshotCache.version = snapshotVersion_.load(std::memory_order_relaxed);
+			}
+			return snapshotCache.settings;
+		}
+
+		/// <summary>
+		/// <para>update applies a change to a copy of the current settings and publishes the copy</para>
+		/// <para>as new snapshot. Readers holding the old snapshot keep it unchanged. Each call restarts</para>
+		/// <para>the quiet period, so a burst of changes leads to a single write.</para>
+		/// </summary>
+		///
+		/// <param name="change">The change to apply. It runs under the store mutex and must not call get.</param>
+		void SettingsStore::update(const std::function<void(ToolsSettings&)>& change) {
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				auto settings = std::make_shared<ToolsSettings>(*snapshot_);
+				change(*settings);
+				snapshot_ = std::move(settings);
+				snapshotVersion_.store(++lastSnapshotVersion, std::memory_order_release);
+				isDirty_ = true;
+				lastChange_ = std::chrono::steady_clock::now();
+			}
+			changed_.notify_all();
+		}
+
+		/// <summary>The background writer: waits for a change, then for the quiet period, then writes.</summary>
+		void SettingsStore::run() {
+			TraceRecorder::get().setThreadName("Settings writer");
+
+			std::unique_lock<std::mutex> lock(mutex_);
+			while (true) {
+				changed_.wait(lock, [this]() { return isDirty_ || isStopping_; });
+				while (!isStopping_ && std::chrono::steady_clock::now() < lastChange_ + quietPeriod_) {
+					changed_.wait_until(lock, lastChange_ + quietPeriod_);
+				}
+				if (isStopping_) {
+					// The destructor writes what is left
+					return;
+				}
+
+				lock.unlock();
+				writePending();
+				lock.lock();
+			}
+		}
+
+		/// <summary>
+		/// <para>Takes the pending settings, if any, and writes them. If the write fails the settings are marked</para>
+		/// <para>dirty again, so that the writer retries after the quiet period and flush reports the failure.</para>
+		/// </summary>
+		bool SettingsStore::writePending() {
+			// Taking and writing under the write lock keeps an older copy from overwriting a newer one
+			std::lock_guard<std::mutex> writeLock(writeMutex_);
+
+			std::shared_ptr<const ToolsSettings> settings;
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				if (!isDirty_ || isReadOnly_) {
+					return true;
+				}
+				settings = snapshot_;
+				isDirty_ = false;
+			}
+			if (write(*settings)) {
+				return true;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				// An update during the write has already marked a newer snapshot dirty and restarted the quiet period
+				if (!isDirty_) {
+					isDirty_ = true;
+					lastChange_ = std::chrono::steady_clock::now();
+				}
+			}
+			changed_.notify_all();
+			return false;
+		}
+
+		/// <summary>
+		/// <para>write serializes the settings into a temporary file next to the settings file and renames it</para>
+		/// <para>over the settings file, so that readers never see a partially written file.</para>
+		/// </summary>
+		///
+		/// <param name="settings">The settings.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SettingsStore::write(const ToolsSettings& settings) {
+			TraceScope trace("writeSettings", "background");
+			json j;
+			j[KEY_VERSION] = ToolsSettings::SCHEMA_VERSION;
+			json& section = j[KEY_SKETCH_TEXT];
+			section["zoomFactor"] = settings.zoomFactor;
+			json& presets = section["queryPresets"] = json::array();
+			for (const QueryPreset& preset : settings.queryPresets) {
+				presets.push_back({ { "name", preset.name }, { "query", preset.query } });
+			}
+			section["lastSketch"] = settings.lastSketchName;
+			section["allSketches"] = settings.isAllSketches;
+			section["textHeightMin"] = settings.textHeightMin;
+			section["textHeightMax"] = settings.textHeightMax;
+			section["sortOrder"] = settings.sortOrder;
+			section["sortDescending"] = settings.isSortDescending;
+			section["tablePageSize"] = settings.tablePageSize;
+			section["highlightColor"] = colorToString(settings.highlightColor);
+			section["highlightWeight"] = settings.highlightWeight;
+
+			std::string tempPath = path_ + ".tmp";
+			{
+				std::ofstream file(tempPath, std::ios::out | std::ios::trunc);
+				file << j.dump(4);
+				file.close();
+				if (file.fail()) {
+					hasWriteFailed_ = true;
+					return false;
+				}
+			}
+
+			std::error_code error;
+			fs::rename(tempPath, path_, error);
+			if (error) {
+				fs::remove(tempPath, error);
+				hasWriteFailed_ = true;
+				return false;
+			}
+
+			++writeCount_;
+			return true;
+		}
+	}
+}
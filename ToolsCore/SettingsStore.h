@@ -0,0 +1,90 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>A named text query of the Text Height tab, see SketchTextQuery.</summary>
+		struct QueryPreset {
+			std::string name;
+			std::string query;
+		};
+
+		/// <summary>
+		/// <para>ToolsSettings holds the typed values persisted in the user settings file.</para>
+		/// <para>Lengths are in Fusion internal units (cm), colors are packed as 0xRRGGBBAA.</para>
+		/// </summary>
+		struct ToolsSettings {
+			/// <summary>The schema version written by this build; older files are migrated on load.</summary>
+			static constexpr int SCHEMA_VERSION = 3;
+
+			double zoomFactor = 1.0;
+			std::vector<QueryPreset> queryPresets;
+			std::string lastSketchName;
+			bool isAllSketches = false;
+			double textHeightMin = 0.0;
+			double textHeightMax = 1.0;
+			int sortOrder = 0;
+			bool isSortDescending = false;
+			unsigned int tablePageSize = 0; // 0 shows all rows
+			uint32_t highlightColor = 0x00FFFFFF;
+			double highlightWeight = 1.5;
+		};
+
+		/// <summary>
+		/// <para>SettingsStore is the process wide owner of the user settings. They are loaded once,</para>
+		/// <para>read as immutable snapshots and changed only through update, which publishes a new snapshot</para>
+		/// <para>and marks it dirty. Each thread caches the last snapshot it read with its version, so that a read</para>
+		/// <para>is one atomic load and a reference count increment; only the first read after a change takes the</para>
+		/// <para>store mutex to refresh the cache.</para>
+		/// <para>A background thread writes dirty settings once no further change arrived for the quiet period,</para>
+		/// <para>to a temporary file first which is then renamed over the old one.</para>
+		/// </summary>
+		class SettingsStore
+		{
+		public:
+			explicit SettingsStore(const std::string& path, std::chrono::milliseconds quietPeriod = std::chrono::milliseconds(500));
+			~SettingsStore();
+
+			SettingsStore(const SettingsStore&) = delete;
+			SettingsStore& operator=(const SettingsStore&) = delete;
+
+			bool load();
+			bool flush();
+
+			std::shared_ptr<const ToolsSettings> get() const;
+			void update(const std::function<void(ToolsSettings&)>& change);
+
+			#pragma region Getters
+			const std::string& getPath() const { return path_; }
+			int getLoadedVersion() const { return loadedVersion_; }
+			size_t getWriteCount() const { return writeCount_.load(); }
+			bool hasWriteFailed() const { return hasWriteFailed_.load(); }
+			#pragma endregion
+
+		private:
+			void run();
+			bool writePending();
+			bool write(const ToolsSettings& settings);
+
+			std::string path_;
+			std::chrono::milliseconds quietPeriod_;
+			int loadedVersion_ = 0;
+
+			/// <summary>Guards the snapshot and the dirty state and serializes updates.</summary>
+			mutable std::mutex mutex_;
+			std::shared_ptr<const ToolsSettings> snapshot_;
+			/// <summary>Version of the snapshot, unique in the process, written under mutex_.</summary>
+			std::atomic<uint64_t> snapshotVersion_ = 0;
+			std::condition_variable changed_;
+			bool isDirty_ = false;
+			bool isStopping_ = false;
+			bool isReadOnly_ = false;
+			std::chrono::steady_clock::time_point lastChange_;
+
+			/// <summary>Serializes file writes of the background thread and flush.</summary>
+			std::mutex writeMutex_;
+			std::atomic<size_t> writeCount_ = 0;
+			std::atomic<bool> hasWriteFailed_ = false;
+			std::thread writer_;
+		};
+	}
+}
@@ -0,0 +1,191 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextDuplicateFinder.h"
+
+namespace implicatex {
+	namespace fusion {
+		namespace {
+			/// <summary>The hash key of a grid cell: the number of the normalized text plus the quantized height and center.</summary>
+			struct CellKey {
+				uint32_t text;
+				int64_t height;
+				int64_t x;
+				int64_t y;
+				int64_t z;
+
+				bool operator==(const CellKey& other) const = default;
+			};
+
+			struct CellKeyHash {
+				size_t operator()(const CellKey& key) const {
+					size_t hash = std::hash<uint32_t>()(key.text);
+					for (int64_t value : { key.height, key.x, key.y, key.z }) {
+						hash ^= std::hash<int64_t>()(value) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+					}
+					return hash;
+				}
+			};
+
+			int64_t quantize(double value, double step) {
+				return (int64_t)std::llround(value / step);
+			}
+
+			/// <summary>Finds the root of a record, halving the path on the way.</summary>
+			uint32_t findRoot(std::pmr::vector<uint32_t>& parents, uint32_t id) {
+				while (parents[id] != id) {
+					parents[id] = parents[parents[id]];
+					id = parents[id];
+				}
+				return id;
+			}
+		}
+
+		/// <summary>
+		/// <para>build puts every record into the grid cell of its normalized text, height and center, one step wide</para>
+		/// <para>in each. A record within a step of another lies in the same or a neighbouring cell, so the 81 cells</para>
+		/// <para>around a record are probed for earlier records, and those within a step are joined to its group.</para>
+		/// <para>The groups with more than one member are kept, ordered by their first record and storing their ids</para>
+		/// <para>back to back in one array.</para>
+		/// </summary>
+		///
+		/// <param name="records">	  The records to group; record ids are their positions in this vector.</param>
+		/// <param name="heightStep">  The largest height difference of duplicates, in the unit of the records (cm).</param>
+		/// <param name="positionStep">The largest center offset of duplicates along each axis, in the unit of the records (cm).</param>
+		/// <param name="resource">	  The memory of the hash tables and the other temporaries, e.g. the arena of a refresh.</param>
+		void SketchTextDuplicateFinder::build(const std::vector<SketchTextRecord>& records, double heightStep, double positionStep,
+			std::pmr::memory_resource* resource) {
+			clear();
+			if (heightStep <= 0.0 || positionStep <= 0.0) {
+				return;
+			}
+
+			std::pmr::unordered_map<std::string, uint32_t> textNumbers(resource);
+			std::pmr::unordered_map<CellKey, uint32_t, CellKeyHash> cells(resource);
+			textNumbers.reserve(records.size());
+			cells.reserve(records.size());
+
+			// Each cell holds a list of its records, linked through nextInCell
+			std::pmr::vector<uint32_t> nextInCell(records.size(), NO_GROUP, resource);
+			std::pmr::vector<Point3> centers(records.size(), resource);
+			std::pmr::vector<uint32_t> parents(records.size(), resource);
+			std::iota(parents.begin(), parents.end(), 0);
+
+			for (uint32_t id = 0; id < (uint32_t)records.size(); ++id) {
+				const SketchTextRecord& record = records[id];
+				if (!record.bounds.isValid()) {
+					// Without a position a text is nobody's duplicate
+					continue;
+				}
+				centers[id] = record.bounds.center();
+				const Point3& center = centers[id];
+				uint32_t text = textNumbers.try_emplace(normalize(record.text), (uint32_t)textNumbers.size()).first->second;
+				CellKey key{ text, quantize(record.height, heightStep),
+					quantize(center.x, positionStep), quantize(center.y, positionStep), quantize(center.z, positionStep) };
+
+				for (int64_t dh = -1; dh <= 1; ++dh) {
+					for (int64_t dx = -1; dx <= 1; ++dx) {
+						for (int64_t dy = -1; dy <= 1; ++dy) {
+							for (int64_t dz = -1; dz <= 1; ++dz) {
+								auto it = cells.find(CellKey{ text, key.height + dh, key.x + dx, key.y + dy, key.z + dz });
+								if (it == cells.end()) continue;
+								for (uint32_t other = it->second; other != NO_GROUP; other = nextInCell[other]) {
+									const Point3& otherCenter = centers[other];
+									bool isNear = std::abs(records[other].height - record.height) <= heightStep
+										&& std::abs(otherCenter.x - center.x) <= positionStep
+										&& std::abs(otherCenter.y - center.y) <= positionStep
+										&& std::abs(otherCenter.z - center.z) <= positionStep;
+									if (!isNear) continue;
+									// The smaller id becomes the root, so that a root is the first record of its group
+									uint32_t root = findRoot(parents, id);
+									uint32_t otherRoot = findRoot(parents, other);
+									parents[(std::max)(root, otherRoot)] = (std::min)(root, otherRoot);
+								}
+							}
+						}
+					}
+				}
+
+				auto [it, isInserted] = cells.try_emplace(key, id);
+				if (!isInserted) {
+					nextInCell[id] = it->second;
+					it->second = id;
+				}
+			}
+
+			std::pmr::vector<uint32_t> groupSizes(records.size(), 0, resource);
+			for (uint32_t id = 0; id < (uint32_t)records.size(); ++id) {
+				++groupSizes[findRoot(parents, id)];
+			}
+
+			// Number the groups with duplicates in order of their first record, their root
+			groupOf_.assign(records.size(), NO_GROUP);
+			groupOffsets_.push_back(0);
+			for (uint32_t id = 0; id < (uint32_t)records.size(); ++id) {
+				uint32_t root = findRoot(parents, id);
+				if (groupSizes[root] < 2) continue;
+				if (root == id) {
+					groupOf_[id] = (uint32_t)groupOffsets_.size() - 1;
+					groupOffsets_.push_back(groupOffsets_.back() + groupSizes[root]);
+				}
+				else {
+					groupOf_[id] = groupOf_[root];
+				}
+			}
+
+			std::pmr::vector<uint32_t> fill(groupOffsets_.begin(), groupOffsets_.end() - 1, resource);
+			groupIds_.resize(groupOffsets_.back());
+			for (uint32_t id = 0; id < (uint32_t)records.size(); ++id) {
+				if (groupOf_[id] != NO_GROUP) {
+					groupIds_[fill[groupOf_[id]]++] = id;
+				}
+			}
+		}
+
+		/// <summary>Removes all groups.</summary>
+		void SketchTextDuplicateFinder::clear() {
+			groupOf_.clear();
+			groupOffsets_.clear();
+			groupIds_.clear();
+		}
+
+		/// <summary>Gets the ids of all records of a group, in ascending order.</summary>
+		///
+		/// <param name="groupIndex">The group index, as returned by groupOf.</param>
+		/// <param name="ids">		 [out] The record ids.</param>
+		void SketchTextDuplicateFinder::group(uint32_t groupIndex, std::vector<uint32_t>& ids) const {
+			ids.clear();
+			if (groupIndex >= groupCount()) {
+				return;
+			}
+			ids.assign(groupIds_.begin() + groupOffsets_[groupIndex], groupIds_.begin() + groupOffsets_[groupIndex + 1]);
+		}
+
+		/// <summary>
+		/// <para>normalize case folds the text, collapses runs of white space to one blank</para>
+		/// <para>and trims it, so that labels differing only in case or spacing compare equal.</para>
+		/// </summary>
+		///
+		/// <param name="text">The UTF-8 text.</param>
+		///
+		/// <returns>The normalized text.</returns>
+		std::string SketchTextDuplicateFinder::normalize(const std::string& text) {
+			std::string folded = SketchTextTrigramIndex::fold(text);
+			std::string result;
+			result.reserve(folded.size());
+			bool isSpace = false;
+			for (char c : folded) {
+				if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+					isSpace = !result.empty();
+					continue;
+				}
+				if (isSpace) {
+					result.push_back(' ');
+					isSpace = false;
+				}
+				result.push_back(c);
+			}
+			return result;
+		}
+	}
+}
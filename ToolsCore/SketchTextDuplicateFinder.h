@@ -0,0 +1,37 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		struct SketchTextRecord;
+
+		/// <summary>
+		/// <para>SketchTextDuplicateFinder groups records that show the same label at the same place: the same</para>
+		/// <para>normalized text, with height and bounding box center within a step of each other (near duplicates).</para>
+		/// <para>Records are hashed into a grid of step sized cells and only the neighbouring cells are compared.</para>
+		/// <para>Groups are closed over chains, so a group may span more than a step from end to end.</para>
+		/// </summary>
+		class SketchTextDuplicateFinder
+		{
+		public:
+			void build(const std::vector<SketchTextRecord>& records, double heightStep, double positionStep,
+				std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+			void clear();
+			size_t getMemoryUsage() const { return (groupOf_.capacity() + groupOffsets_.capacity() + groupIds_.capacity()) * sizeof(uint32_t); }
+
+			bool empty() const { return groupOffsets_.size() <= 1; }
+			size_t groupCount() const { return groupOffsets_.empty() ? 0 : groupOffsets_.size() - 1; }
+			uint32_t groupOf(uint32_t id) const { return id < groupOf_.size() ? groupOf_[id] : NO_GROUP; }
+			void group(uint32_t groupIndex, std::vector<uint32_t>& ids) const;
+
+			static std::string normalize(const std::string& text);
+
+			/// <summary>Group index of records without any duplicate.</summary>
+			static constexpr uint32_t NO_GROUP = 0xFFFFFFFF;
+
+		private:
+			std::vector<uint32_t> groupOf_;
+			std::vector<uint32_t> groupOffsets_;
+			std::vector<uint32_t> groupIds_;
+		};
+	}
+}
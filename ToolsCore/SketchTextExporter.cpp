@@ -0,0 +1,199 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextExporter.h"
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>The destructor writes out any buffered rows of a file that was not closed.</summary>
+		SketchTextExporter::~SketchTextExporter() {
+			close();
+		}
+
+		/// <summary>
+		/// <para>open creates the file and writes the CSV header line; JSON Lines files have no header.</para>
+		/// </summary>
+		///
+		/// <param name="path">  The path of the file, an existing file is overwritten.</param>
+		/// <param name="format">The file format.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextExporter::open(const std::string& path, SketchTextExportFormat format) {
+			close();
+
+			// Fusion passes UTF-8 paths
+			file_.open(fs::path(reinterpret_cast<const char8_t*>(path.c_str())), std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file_) {
+				return false;
+			}
+
+			format_ = format;
+			rowCount_ = 0;
+			buffer_.clear();
+			buffer_.reserve(FLUSH_SIZE + 1024);
+
+			if (format_ == SketchTextExportFormat::Csv) {
+				// UTF-8 byte order mark, so that spreadsheet applications detect the encoding
+				buffer_.append("\xEF\xBB\xBF");
+				buffer_.append("sketch,text,height_mm,min_x_mm,min_y_mm,min_z_mm,max_x_mm,max_y_mm,max_z_mm,entity_token\r\n");
+			}
+			return true;
+		}
+
+		/// <summary>Formats one record as a row and writes the buffer out once it is full.</summary>
+		///
+		/// <param name="record">	  The record.</param>
+		/// <param name="sketchName"> The name of the sketch holding the text.</param>
+		/// <param name="entityToken">The entity token of the text.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool SketchTextExporter::write(const SketchTextRecord& record, const std::string& sketchName, const std::string& entityToken) {
+			if (!file_.is_open()) {
+				return false;
+			}
+
+			// Records hold Fusion internal units (cm)
+			const double values[] = {
+				record.height * 10.0,
+				record.bounds.minPoint.x * 10.0, record.bounds.minPoint.y * 10.0, record.bounds.minPoint.z * 10.0,
+				record.bounds.maxPoint.x * 10.0, record.bounds.maxPoint.y * 10.0, record.bounds.maxPoint.z * 10.0
+			};
+
+			// Texts without a bounding box leave the bounds empty, or null in JSON
+			size_t valueCount = record.bounds.isValid() ? std::size(values) : 1;
+
+			if (format_ == SketchTextExportFormat::Csv) {
+				appendCsvField(sketchName);
+				buffer_.push_back(',');
+				appendCsvField(record.text);
+				for (size_t i = 0; i < std::size(values); ++i) {
+					buffer_.push_back(',');
+					if (i < valueCount) {
+						appendNumber(values[i]);
+					}
+				}
+				buffer_.push_back(',');
+				appendCsvField(entityToken);
+				buffer_.append("\r\n");
+			}
+			else {
+				static const char* const names[] = {
+					"\"height_mm\":", "\"min_x_mm\":", "\"min_y_mm\":", "\"min_z_mm\":",
+					"\"max_x_mm\":", "\"max_y_mm\":", "\"max_z_mm\":"
+				};
+				buffer_.append("{\"sketch\":");
+				appendJsonString(sketchName);
+				buffer_.append(",\"text\":");
+				appendJsonString(record.text);
+				for (size_t i = 0; i < std::size(values); ++i) {
+					buffer_.push_back(',');
+					buffer_.append(names[i]);
+					if (i < valueCount) {
+						appendNumber(values[i]);
+					}
+					else {
+						buffer_.append("null");
+					}
+				}
+				buffer_.append(",\"entity_token\":");
+				appendJsonString(entityToken);
+				buffer_.append("}\n");
+			}
+
+			++rowCount_;
+			if (buffer_.size() >= FLUSH_SIZE) {
+				return flush();
+			}
+			return true;
+		}
+
+		/// <summary>Writes out the remaining rows and closes the file.</summary>
+		///
+		/// <returns>True if all rows were written, false if writing failed or no file was open.</returns>
+		bool SketchTextExporter::close() {
+			if (!file_.is_open()) {
+				return false;
+			}
+			bool isFlushed = flush();
+			file_.close();
+			return isFlushed && !file_.fail();
+		}
+
+		/// <summary>Chooses JSON Lines for .jsonl and .json files and CSV for all other extensions.</summary>
+		///
+		/// <param name="path">The file path.</param>
+		///
+		/// <returns>The export format.</returns>
+		SketchTextExportFormat SketchTextExporter::formatFromPath(const std::string& path) {
+			size_t dot = path.find_last_of("./\\");
+			std::string extension = (dot != std::string::npos && path[dot] == '.') ? path.substr(dot) : "";
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+			if (extension == ".jsonl" || extension == ".json") {
+				return SketchTextExportFormat::JsonLines;
+			}
+			return SketchTextExportFormat::Csv;
+		}
+
+		bool SketchTextExporter::flush() {
+			if (!buffer_.empty()) {
+				file_.write(buffer_.data(), (std::streamsize)buffer_.size());
+				buffer_.clear();
+			}
+			return !file_.fail();
+		}
+
+		/// <summary>Appends a number with up to four decimals, without going through the stream locale.</summary>
+		void SketchTextExporter::appendNumber(double value) {
+			char digits[32];
+			auto [end, error] = std::to_chars(digits, digits + sizeof(digits), std::round(value * 1e4) / 1e4, std::chars_format::general, 10);
+			if (error != std::errc()) {
+				buffer_.push_back('0');
+				return;
+			}
+			buffer_.append(digits, end);
+		}
+
+		/// <summary>Appends a CSV field, quoted and with doubled quotes if it contains separators, quotes or line breaks.</summary>
+		void SketchTextExporter::appendCsvField(const std::string& value) {
+			if (value.find_first_of(",\"\r\n") == std::string::npos) {
+				buffer_.append(value);
+				return;
+			}
+			buffer_.push_back('"');
+			for (char c : value) {
+				if (c == '"') {
+					buffer_.push_back('"');
+				}
+				buffer_.push_back(c);
+			}
+			buffer_.push_back('"');
+		}
+
+		/// <summary>Appends a quoted JSON string, escaping quotes, backslashes and control characters.</summary>
+		void SketchTextExporter::appendJsonString(const std::string& value) {
+			static const char hex[] = "0123456789abcdef";
+			buffer_.push_back('"');
+			for (char c : value) {
+				switch (c) {
+				case '"':  buffer_.append("\\\""); break;
+				case '\\': buffer_.append("\\\\"); break;
+				case '\n': buffer_.append("\\n"); break;
+				case '\r': buffer_.append("\\r"); break;
+				case '\t': buffer_.append("\\t"); break;
+				default:
+					if ((unsigned char)c < 0x20) {
+						buffer_.append("\\u00");
+						buffer_.push_back(hex[(unsigned char)c >> 4]);
+						buffer_.push_back(hex[(unsigned char)c & 0x0F]);
+					}
+					else {
+						buffer_.push_back(c);
+					}
+				}
+			}
+			buffer_.push_back('"');
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		struct SketchTextRecord;
+
+		/// <summary>The file formats of SketchTextExporter.</summary>
+		enum class SketchTextExportFormat {
+			Csv = 0,
+			JsonLines = 1
+		};
+
+		/// <summary>
+		/// <para>SketchTextExporter streams sketch text records to a CSV or JSON Lines file.</para>
+		/// <para>Rows are formatted into a fixed size buffer that is written out whenever it fills up,</para>
+		/// <para>so memory use does not grow with the number of exported texts.</para>
+		/// </summary>
+		class SketchTextExporter
+		{
+		public:
+			~SketchTextExporter();
+
+			bool open(const std::string& path, SketchTextExportFormat format);
+			bool write(const SketchTextRecord& record, const std::string& sketchName, const std::string& entityToken);
+			bool close();
+
+			size_t getRowCount() const { return rowCount_; }
+
+			static SketchTextExportFormat formatFromPath(const std::string& path);
+
+		private:
+			bool flush();
+			void appendNumber(double value);
+			void appendCsvField(const std::string& value);
+			void appendJsonString(const std::string& value);
+
+			/// <summary>Buffer size at which the formatted rows are written to the file.</summary>
+			static constexpr size_t FLUSH_SIZE = 1 << 16;
+
+			std::ofstream file_;
+			std::string buffer_;
+			SketchTextExportFormat format_ = SketchTextExportFormat::Csv;
+			size_t rowCount_ = 0;
+		};
+	}
+}
@@ -0,0 +1,101 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextPredicate.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextDuplicateFinder.h"
+#include "SketchTextSorter.h"
+#include "SketchTextFilter.h"
+
+namespace implicatex {
+	namespace fusion {
+		namespace {
+			/// <summary>Accepts the texts that belong to a duplicate group.</summary>
+			struct InDuplicateGroup {
+				const SketchTextDuplicateFinder* duplicateFinder = nullptr;
+
+				bool operator()(uint32_t id, const SketchTextRecord&) const {
+					return duplicateFinder->groupOf(id) != SketchTextDuplicateFinder::NO_GROUP;
+				}
+			};
+
+			/// <summary>Filters the ids with the predicate of the match mode, fused with the duplicates test if requested.</summary>
+			template<SketchTextPredicate Predicate>
+			void filterMatches(const std::vector<SketchTextRecord>& records, const SketchTextDuplicateFinder& duplicateFinder,
+				const SketchTextFilterCriteria& criteria, std::vector<uint32_t>& ids, const Predicate& match) {
+				if (criteria.isDuplicatesOnly) {
+					filterIds(records, ids, allOf(match, InDuplicateGroup{ &duplicateFinder }));
+				}
+				else {
+					filterIds(records, ids, match);
+				}
+			}
+		}
+
+		/// <summary>
+		/// <para>apply filters the records by content, then by the match mode and, if requested, duplicates in one</para>
+		/// <para>pass, and sorts the result. The ids of a query take the place of content and match mode. Each</para>
+		/// <para>combination of criteria is its own instantiation of the predicates, chosen once per call.</para>
+		/// <para>The duplicate finder must have grouped the same records if only duplicates are requested.</para>
+		/// </summary>
+		///
+		/// <param name="records">		  The captured records.</param>
+		/// <param name="index">		  The trigram index of the records.</param>
+		/// <param name="duplicateFinder">The duplicate groups of the records.</param>
+		/// <param name="sorter">		  The sorter with the cached collation keys of the records.</param>
+		/// <param name="criteria">		  The filter criteria.</param>
+		/// <param name="ids">			  [out] The ids of the matching records in table order.</param>
+		/// <param name="resource">		  The memory of the temporaries, e.g. the arena of a refresh.</param>
+		///
+		/// <returns>The number of duplicate groups among the matches, 0 unless only duplicates are requested.</returns>
+		size_t SketchTextFilter::apply(const std::vector<SketchTextRecord>& records, const SketchTextTrigramIndex& index,
+			const SketchTextDuplicateFinder& duplicateFinder, SketchTextSorter& sorter,
+			const SketchTextFilterCriteria& criteria, std::vector<uint32_t>& ids, std::pmr::memory_resource* resource) {
+			if (criteria.queryIds) {
+				// The query has checked contents and heights itself
+				ids = *criteria.queryIds;
+				filterMatches(records, duplicateFinder, criteria, ids, AnyText{});
+			}
+			else {
+				index.find(criteria.content, criteria.isPrefixOnly, ids, resource);
+
+				HeightInRange inRange{ criteria.minHeight, criteria.maxHeight };
+				switch (criteria.matchMode) {
+				case SketchTextMatchMode::OutsideHeightRange:
+					filterMatches(records, duplicateFinder, criteria, ids, negate(inRange));
+					break;
+				case SketchTextMatchMode::OffNewHeight:
+					filterMatches(records, duplicateFinder, criteria, ids, allOf(inRange, negate(HeightNear{ criteria.newHeight, criteria.tolerance })));
+					break;
+				case SketchTextMatchMode::Checked:
+					filterMatches(records, duplicateFinder, criteria, ids, allOf(inRange, Flagged{ criteria.checkedIds }));
+					break;
+				case SketchTextMatchMode::SelectedSketch:
+					filterMatches(records, duplicateFinder, criteria, ids, allOf(inRange, SketchIn{ std::span<const unsigned int>(&criteria.selectedSketch, 1) }));
+					break;
+				default:
+					filterMatches(records, duplicateFinder, criteria, ids, inRange);
+					break;
+				}
+			}
+
+			sorter.sort(records, criteria.localeId, criteria.sortOrder, criteria.isSortDescending, ids);
+
+			size_t duplicateGroupCount = 0;
+			if (criteria.isDuplicatesOnly) {
+				// Keep the members of a group together, placing each group where its first member sorts
+				std::pmr::vector<uint32_t> groupRank(duplicateFinder.groupCount(), SketchTextDuplicateFinder::NO_GROUP, resource);
+				for (uint32_t id : ids) {
+					uint32_t& rank = groupRank[duplicateFinder.groupOf(id)];
+					if (rank == SketchTextDuplicateFinder::NO_GROUP) {
+						rank = (uint32_t)duplicateGroupCount++;
+					}
+				}
+				std::stable_sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+					return groupRank[duplicateFinder.groupOf(a)] < groupRank[duplicateFinder.groupOf(b)];
+				});
+			}
+
+			return duplicateGroupCount;
+		}
+	}
+}
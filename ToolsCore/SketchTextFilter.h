@@ -0,0 +1,52 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		struct SketchTextRecord;
+		class SketchTextTrigramIndex;
+		class SketchTextDuplicateFinder;
+		class SketchTextSorter;
+		enum class SketchTextSortOrder;
+
+		/// <summary>The combinations of criteria the height tab offers, in the order of its match drop down.</summary>
+		enum class SketchTextMatchMode {
+			InHeightRange,
+			OutsideHeightRange,
+			OffNewHeight,	// In the height range, but further from the new height than the tolerance
+			Checked,		// In the height range and checked in the match table
+			SelectedSketch	// In the height range and in the sketch of the selected text
+		};
+
+		/// <summary>The criteria of the match table, read from the inputs of the height tab.</summary>
+		struct SketchTextFilterCriteria {
+			SketchTextMatchMode matchMode = SketchTextMatchMode::InHeightRange;
+			double minHeight = 0.0; // Fusion internal units (cm)
+			double maxHeight = 0.0;
+			double newHeight = 0.0;
+			double tolerance = 0.0;
+			std::span<const uint8_t> checkedIds; // One flag per record id
+			unsigned int selectedSketch = 0;
+			std::string content;
+			bool isPrefixOnly = false;
+			const std::vector<uint32_t>* queryIds = nullptr; // The result of a query, which replaces content, height range and match mode
+			bool isDuplicatesOnly = false;
+			SketchTextSortOrder sortOrder{};
+			bool isSortDescending = false;
+			std::string localeId;
+		};
+
+		/// <summary>
+		/// <para>SketchTextFilter selects and orders the record ids of the match table: the texts containing the</para>
+		/// <para>content that fit the match mode, optionally only the duplicates, sorted by the sort order.</para>
+		/// <para>Duplicates are kept together, each group placed where its first member sorts.</para>
+		/// </summary>
+		class SketchTextFilter
+		{
+		public:
+			static size_t apply(const std::vector<SketchTextRecord>& records, const SketchTextTrigramIndex& index,
+				const SketchTextDuplicateFinder& duplicateFinder, SketchTextSorter& sorter,
+				const SketchTextFilterCriteria& criteria, std::vector<uint32_t>& ids,
+				std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		};
+	}
+}
@@ -0,0 +1,210 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextHeightClusterer.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>build reduces the heights of the records to their sorted distinct values with the number of texts</para>
+		/// <para>of each and prepares the prefix sums the cluster costs are computed from.</para>
+		/// </summary>
+		///
+		/// <param name="records">The records whose heights are clustered.</param>
+		void SketchTextHeightClusterer::build(const std::vector<SketchTextRecord>& records) {
+			clear();
+
+			std::vector<int64_t> keys;
+			keys.reserve(records.size());
+			for (const SketchTextRecord& record : records) {
+				keys.push_back((int64_t)std::llround(record.height / HEIGHT_STEP));
+			}
+			std::sort(keys.begin(), keys.end());
+
+			for (size_t i = 0; i < keys.size();) {
+				size_t end = i + 1;
+				while (end < keys.size() && keys[end] == keys[i]) {
+					++end;
+				}
+				heights_.push_back((double)keys[i] * HEIGHT_STEP);
+				counts_.push_back((uint32_t)(end - i));
+				i = end;
+			}
+			textCount_ = keys.size();
+
+			// Offsetting by the first height keeps the squares small, so that the costs do not cancel out
+			double offset = heights_.empty() ? 0.0 : heights_.front();
+			countSums_.assign(heights_.size() + 1, 0.0);
+			sums_.assign(heights_.size() + 1, 0.0);
+			squareSums_.assign(heights_.size() + 1, 0.0);
+			for (size_t i = 0; i < heights_.size(); ++i) {
+				double count = (double)counts_[i];
+				double value = heights_[i] - offset;
+				countSums_[i + 1] = countSums_[i] + count;
+				sums_[i + 1] = sums_[i] + count * value;
+				squareSums_[i + 1] = squareSums_[i] + count * value * value;
+			}
+		}
+
+		void SketchTextHeightClusterer::clear() {
+			heights_.clear();
+			counts_.clear();
+			textCount_ = 0;
+			countSums_.clear();
+			sums_.clear();
+			squareSums_.clear();
+			costs_.clear();
+			splits_.clear();
+		}
+
+		size_t SketchTextHeightClusterer::getMemoryUsage() const {
+			size_t bytes = (heights_.capacity() + countSums_.capacity() + sums_.capacity() + squareSums_.capacity() + costs_.capacity()) * sizeof(double)
+				+ counts_.capacity() * sizeof(uint32_t);
+			for (const auto& splits : splits_) {
+				bytes += splits.capacity() * sizeof(uint32_t);
+			}
+			return bytes;
+		}
+
+		/// <summary>
+		/// <para>suggest finds the fewest clusters, up to maxClusters, in which every height is within the tolerance</para>
+		/// <para>of the standard height of its cluster. Cluster counts already computed are reused.</para>
+		/// </summary>
+		///
+		/// <param name="tolerance">  The largest deviation from the standard height, in cm.</param>
+		/// <param name="maxClusters">The largest number of clusters to try.</param>
+		/// <param name="clusters">   [out] The clusters in ascending order of height.</param>
+		///
+		/// <returns>True if the clusters keep the tolerance, false if maxClusters clusters do not.</returns>
+		bool SketchTextHeightClusterer::suggest(double tolerance, size_t maxClusters, std::vector<HeightCluster>& clusters) {
+			clusters.clear();
+			size_t clusterLimit = (std::min)(maxClusters, heights_.size());
+			for (size_t clusterCount = 1; clusterCount <= clusterLimit; ++clusterCount) {
+				while (splits_.size() < clusterCount) {
+					addLayer();
+				}
+				getClusters(clusterCount, tolerance, clusters);
+				bool isWithinTolerance = std::all_of(clusters.begin(), clusters.end(), [&](const HeightCluster& cluster) {
+					return cluster.getDeviation() <= tolerance + HEIGHT_STEP / 2.0;
+				});
+				if (isWithinTolerance) {
+					return true;
+				}
+			}
+			return heights_.empty();
+		}
+
+		/// <summary>partition splits the heights into the given number of clusters with the least squared deviation.</summary>
+		///
+		/// <param name="clusterCount">The number of clusters, at most the number of distinct heights.</param>
+		/// <param name="clusters">	   [out] The clusters in ascending order of height.</param>
+		void SketchTextHeightClusterer::partition(size_t clusterCount, std::vector<HeightCluster>& clusters) {
+			clusterCount = (std::min)(clusterCount, heights_.size());
+			while (splits_.size() < clusterCount) {
+				addLayer();
+			}
+			getClusters(clusterCount, 0.0, clusters);
+		}
+
+		/// <summary>getCost returns the squared deviation of the heights first to last from their mean, weighted by count.</summary>
+		double SketchTextHeightClusterer::getCost(size_t first, size_t last) const {
+			double count = countSums_[last + 1] - countSums_[first];
+			double sum = sums_[last + 1] - sums_[first];
+			double squareSum = squareSums_[last + 1] - squareSums_[first];
+			return (std::max)(0.0, squareSum - sum * sum / count);
+		}
+
+		/// <summary>addLayer computes the best partitions into one more cluster from those of the last layer.</summary>
+		void SketchTextHeightClusterer::addLayer() {
+			size_t heightCount = heights_.size();
+			std::vector<uint32_t> splits(heightCount, 0);
+			if (splits_.empty()) {
+				costs_.resize(heightCount);
+				for (size_t last = 0; last < heightCount; ++last) {
+					costs_[last] = getCost(0, last);
+				}
+			}
+			else {
+				size_t layer = splits_.size();
+				std::vector<double> costs(heightCount, std::numeric_limits<double>::infinity());
+				computeLayer(costs, splits, layer, heightCount - 1, layer, heightCount - 1);
+				costs_.swap(costs);
+			}
+			splits_.push_back(std::move(splits));
+		}
+
+		/// <summary>
+		/// <para>computeLayer finds the best first height of the last cluster for the partitions ending at first to last.</para>
+		/// <para>That split never moves left as the end moves right, so the middle end bounds the search of both halves.</para>
+		/// </summary>
+		void SketchTextHeightClusterer::computeLayer(std::vector<double>& costs, std::vector<uint32_t>& splits, size_t first, size_t last, size_t splitFirst, size_t splitLast) const {
+			size_t layer = splits_.size();
+			size_t middle = first + (last - first) / 2;
+			double bestCost = std::numeric_limits<double>::infinity();
+			size_t bestSplit = (std::max)(splitFirst, layer);
+			for (size_t split = bestSplit; split <= (std::min)(middle, splitLast); ++split) {
+				double cost = costs_[split - 1] + getCost(split, middle);
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestSplit = split;
+				}
+			}
+			costs[middle] = bestCost;
+			splits[middle] = (uint32_t)bestSplit;
+
+			if (middle > first) {
+				computeLayer(costs, splits, first, middle - 1, splitFirst, bestSplit);
+			}
+			if (middle < last) {
+				computeLayer(costs, splits, middle + 1, last, bestSplit, splitLast);
+			}
+		}
+
+		/// <summary>
+		/// <para>getClusters follows the splits back from the last height. The standard height of a cluster is the roundest</para>
+		/// <para>height that keeps all of its heights within the tolerance, or within its range without a tolerance:</para>
+		/// <para>a whole millimeter if one fits, else a half, a tenth, a twentieth or a hundredth of a millimeter,</para>
+		/// <para>the one closest to the mean of the cluster.</para>
+		/// </summary>
+		void SketchTextHeightClusterer::getClusters(size_t clusterCount, double tolerance, std::vector<HeightCluster>& clusters) const {
+			static const double standardSteps[] = { 0.1, 0.05, 0.01, 0.005, 0.001 };
+
+			clusters.clear();
+			if (clusterCount == 0) {
+				return;
+			}
+			clusters.resize(clusterCount);
+			size_t last = heights_.size() - 1;
+			for (size_t layer = clusterCount; layer-- > 0;) {
+				size_t first = layer == 0 ? 0 : splits_[layer][last];
+				HeightCluster& cluster = clusters[layer];
+				cluster.minHeight = heights_[first];
+				cluster.maxHeight = heights_[last];
+				cluster.textCount = (size_t)(countSums_[last + 1] - countSums_[first]);
+				cluster.heightCount = last - first + 1;
+
+				double mean = heights_.front() + (sums_[last + 1] - sums_[first]) / (double)cluster.textCount;
+				double low = cluster.minHeight;
+				double high = cluster.maxHeight;
+				if (tolerance > 0.0 && cluster.maxHeight - tolerance <= cluster.minHeight + tolerance) {
+					low = cluster.maxHeight - tolerance;
+					high = cluster.minHeight + tolerance;
+				}
+				cluster.standardHeight = std::round(std::clamp(mean, low, high) / HEIGHT_STEP) * HEIGHT_STEP;
+				for (double step : standardSteps) {
+					double candidate = std::round(mean / step) * step;
+					double below = std::ceil((low - HEIGHT_STEP / 2.0) / step) * step;
+					double above = std::floor((high + HEIGHT_STEP / 2.0) / step) * step;
+					if (below <= above) {
+						cluster.standardHeight = std::clamp(candidate, below, above);
+						break;
+					}
+				}
+
+				if (first == 0) {
+					break;
+				}
+				last = first - 1;
+			}
+		}
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		struct SketchTextRecord;
+
+		/// <summary>One suggested standard size and the heights of the texts that map to it, in cm.</summary>
+		struct HeightCluster {
+			double standardHeight = 0.0; // The roundest height near the mean of the cluster
+			double minHeight = 0.0;
+			double maxHeight = 0.0;
+			size_t textCount = 0;
+			size_t heightCount = 0; // Distinct heights
+
+			double getDeviation() const { return (std::max)(standardHeight - minHeight, maxHeight - standardHeight); }
+		};
+
+		/// <summary>
+		/// <para>SketchTextHeightClusterer groups text heights into the fewest standard sizes that keep every text within a</para>
+		/// <para>tolerance of its size. Heights are reduced to their distinct values with counts, then clustered optimally in</para>
+		/// <para>1D (least squared deviation from the cluster means) by a dynamic program over the sorted values, which finds</para>
+		/// <para>the split points of each cluster count by divide and conquer in O(n log n) per count.</para>
+		/// </summary>
+		class SketchTextHeightClusterer
+		{
+		public:
+			/// <summary>Heights closer than this step (0.001 mm) are taken as the same height.</summary>
+			static constexpr double HEIGHT_STEP = 0.0001;
+			static constexpr size_t MAX_CLUSTERS = 16;
+
+			void build(const std::vector<SketchTextRecord>& records);
+			void clear();
+			bool suggest(double tolerance, size_t maxClusters, std::vector<HeightCluster>& clusters);
+			void partition(size_t clusterCount, std::vector<HeightCluster>& clusters);
+
+			#pragma region Getters
+			size_t getHeightCount() const { return heights_.size(); }
+			size_t getTextCount() const { return textCount_; }
+			size_t getMemoryUsage() const;
+			#pragma endregion
+
+		private:
+			double getCost(size_t first, size_t last) const;
+			void addLayer();
+			void computeLayer(std::vector<double>& costs, std::vector<uint32_t>& splits, size_t first, size_t last, size_t splitFirst, size_t splitLast) const;
+			void getClusters(size_t clusterCount, double tolerance, std::vector<HeightCluster>& clusters) const;
+
+			std::vector<double> heights_;
+			std::vector<uint32_t> counts_;
+			size_t textCount_ = 0;
+
+			/// <summary>Prefix sums of count, count * offset and count * offset^2, with the offset taken from the first height.</summary>
+			std::vector<double> countSums_;
+			std::vector<double> sums_;
+			std::vector<double> squareSums_;
+
+			/// <summary>Cost of the best partition of the first j + 1 heights into k + 1 clusters, for the last k computed.</summary>
+			std::vector<double> costs_;
+			/// <summary>First height of the last cluster of those partitions, one layer per cluster count.</summary>
+			std::vector<std::vector<uint32_t>> splits_;
+		};
+	}
+}
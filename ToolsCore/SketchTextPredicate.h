@@ -0,0 +1,142 @@
+#pragma once
+#include "SketchTextRecord.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>A sketch text predicate is any callable that decides on one record by its id and values. The predicates</para>
+		/// <para>below are plain structs that compose through allOf, anyOf and negate into a single type, so that the</para>
+		/// <para>compiler inlines the whole query into one loop: adding a criterion adds a test, not a pass or a call.</para>
+		/// </summary>
+		template<typename Predicate>
+		concept SketchTextPredicate = std::predicate<const Predicate&, uint32_t, const SketchTextRecord&>;
+
+		#pragma region Predicates
+		/// <summary>Accepts every record, e.g. as the neutral criterion of a combination.</summary>
+		struct AnyText {
+			bool operator()(uint32_t, const SketchTextRecord&) const { return true; }
+		};
+
+		/// <summary>Accepts heights within the closed range, in Fusion internal units (cm).</summary>
+		struct HeightInRange {
+			double minHeight = 0.0;
+			double maxHeight = 0.0;
+
+			bool operator()(uint32_t, const SketchTextRecord& record) const {
+				return record.height >= minHeight && record.height <= maxHeight;
+			}
+		};
+
+		/// <summary>Accepts heights that differ from the height by at most the tolerance, both in cm.</summary>
+		struct HeightNear {
+			double height = 0.0;
+			double tolerance = 0.0;
+
+			bool operator()(uint32_t, const SketchTextRecord& record) const {
+				return std::abs(record.height - height) <= tolerance;
+			}
+		};
+
+		/// <summary>Accepts texts containing the content exactly, without the case folding of the trigram index.</summary>
+		struct TextContains {
+			std::string_view content;
+
+			bool operator()(uint32_t, const SketchTextRecord& record) const {
+				return record.text.find(content) != std::string::npos;
+			}
+		};
+
+		/// <summary>Accepts texts the expression matches anywhere in. The expression must outlive the predicate.</summary>
+		struct TextMatches {
+			const std::regex* expression = nullptr;
+
+			bool operator()(uint32_t, const SketchTextRecord& record) const {
+				return std::regex_search(record.text, *expression);
+			}
+		};
+
+		/// <summary>Accepts texts of the sketches whose snapshot indexes are listed in ascending order.</summary>
+		struct SketchIn {
+			std::span<const unsigned int> sketchIndexes;
+
+			bool operator()(uint32_t, const SketchTextRecord& record) const {
+				return std::binary_search(sketchIndexes.begin(), sketchIndexes.end(), record.sketchIndex);
+			}
+		};
+
+		/// <summary>Accepts texts whose bounding box lies within the region.</summary>
+		struct BoundsWithin {
+			Box3 region;
+
+			bool operator()(uint32_t, const SketchTextRecord& record) const {
+				return record.bounds.isValid()
+					&& record.bounds.minPoint.x >= region.minPoint.x && record.bounds.maxPoint.x <= region.maxPoint.x
+					&& record.bounds.minPoint.y >= region.minPoint.y && record.bounds.maxPoint.y <= region.maxPoint.y
+					&& record.bounds.minPoint.z >= region.minPoint.z && record.bounds.maxPoint.z <= region.maxPoint.z;
+			}
+		};
+
+		/// <summary>Accepts the records whose flag is set, one flag per record id, e.g. the checked rows of a table.</summary>
+		struct Flagged {
+			std::span<const uint8_t> flags;
+
+			bool operator()(uint32_t id, const SketchTextRecord&) const {
+				return id < flags.size() && flags[id] != 0;
+			}
+		};
+		#pragma endregion
+
+		#pragma region Combinators
+		/// <summary>Accepts the records all predicates accept, testing them in order until one rejects.</summary>
+		template<SketchTextPredicate... Predicates>
+		struct AllOf {
+			std::tuple<Predicates...> predicates;
+
+			bool operator()(uint32_t id, const SketchTextRecord& record) const {
+				return std::apply([&](const auto&... predicate) { return (predicate(id, record) && ...); }, predicates);
+			}
+		};
+
+		/// <summary>Accepts the records any predicate accepts, testing them in order until one accepts.</summary>
+		template<SketchTextPredicate... Predicates>
+		struct AnyOf {
+			std::tuple<Predicates...> predicates;
+
+			bool operator()(uint32_t id, const SketchTextRecord& record) const {
+				return std::apply([&](const auto&... predicate) { return (predicate(id, record) || ...); }, predicates);
+			}
+		};
+
+		/// <summary>Accepts the records the predicate rejects.</summary>
+		template<SketchTextPredicate Predicate>
+		struct Not {
+			Predicate predicate;
+
+			bool operator()(uint32_t id, const SketchTextRecord& record) const { return !predicate(id, record); }
+		};
+
+		template<SketchTextPredicate... Predicates>
+		AllOf<Predicates...> allOf(Predicates... predicates) { return { { std::move(predicates)... } }; }
+
+		template<SketchTextPredicate... Predicates>
+		AnyOf<Predicates...> anyOf(Predicates... predicates) { return { { std::move(predicates)... } }; }
+
+		template<SketchTextPredicate Predicate>
+		Not<Predicate> negate(Predicate predicate) { return { std::move(predicate) }; }
+		#pragma endregion
+
+		/// <summary>
+		/// <para>filterIds keeps the ids whose records the predicate accepts, in their order, in one pass over the ids.</para>
+		/// </summary>
+		///
+		/// <param name="records">  The records the ids refer to.</param>
+		/// <param name="ids">		[in,out] The candidate ids, e.g. the result of an index query.</param>
+		/// <param name="predicate">The predicate, usually a combination.</param>
+		template<SketchTextPredicate Predicate>
+		void filterIds(const std::vector<SketchTextRecord>& records, std::vector<uint32_t>& ids, const Predicate& predicate) {
+			ids.erase(std::remove_if(ids.begin(), ids.end(), [&](uint32_t id) {
+				return !predicate(id, records[id]);
+			}), ids.end());
+		}
+	}
+}
@@ -0,0 +1,519 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextPredicate.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextQuery.h"
+
+namespace implicatex {
+	namespace fusion {
+		namespace {
+			bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+			/// <summary>Reads a quoted or bare value at position and moves past it.</summary>
+			bool readValue(std::string_view text, size_t& position, std::string& value, std::string& error) {
+				value.clear();
+				if (position < text.size() && text[position] == '"') {
+					for (++position; position < text.size(); ++position) {
+						char c = text[position];
+						if (c == '"') {
+							++position;
+							return true;
+						}
+						if (c == '\\' && position + 1 < text.size() && text[position + 1] == '"') {
+							c = text[++position];
+						}
+						value.push_back(c);
+					}
+					error = "Missing closing quote";
+					return false;
+				}
+				while (position < text.size() && !isSpace(text[position])) {
+					value.push_back(text[position++]);
+				}
+				return true;
+			}
+
+			/// <summary>Converts a length with an optional unit (mm, cm or in, mm by default) to cm.</summary>
+			bool parseLength(std::string_view text, double& length, std::string_view defaultUnit) {
+				const char* first = text.data();
+				const char* last = first + text.size();
+				auto result = std::from_chars(first, last, length);
+				if (result.ec != std::errc()) {
+					return false;
+				}
+				std::string_view unit(result.ptr, last - result.ptr);
+				if (unit.empty()) {
+					unit = defaultUnit;
+				}
+				if (unit == "mm") {
+					length /= 10.0;
+				}
+				else if (unit == "in") {
+					length *= 2.54;
+				}
+				else if (unit != "cm") {
+					return false;
+				}
+				return true;
+			}
+
+			/// <summary>The unit at the end of a length, if any.</summary>
+			std::string_view unitOf(std::string_view text) {
+				size_t end = text.size();
+				while (end > 0 && std::isalpha((unsigned char)text[end - 1])) {
+					--end;
+				}
+				return text.substr(end);
+			}
+
+			/// <summary>Parses 2.5, 2..3, ..3, 2.., >2, >=2, <3 or <=3, each with an optional unit, into a closed range in cm.</summary>
+			bool parseHeight(std::string_view text, double& minHeight, double& maxHeight, std::string& error) {
+				constexpr double infinity = std::numeric_limits<double>::infinity();
+				bool isValid = true;
+				if (text.starts_with(">=") || text.starts_with("<=")) {
+					double height = 0.0;
+					isValid = parseLength(text.substr(2), height, "mm");
+					minHeight = text[0] == '>' ? height : -infinity;
+					maxHeight = text[0] == '>' ? infinity : height;
+				}
+				else if (text.starts_with(">") || text.starts_with("<")) {
+					double height = 0.0;
+					isValid = parseLength(text.substr(1), height, "mm");
+					minHeight = text[0] == '>' ? std::nextafter(height, infinity) : -infinity;
+					maxHeight = text[0] == '>' ? infinity : std::nextafter(height, -infinity);
+				}
+				else if (size_t dots = text.find(".."); dots != std::string_view::npos) {
+					std::string_view lower = text.substr(0, dots);
+					std::string_view upper = text.substr(dots + 2);
+					// A unit given only at the upper end applies to both
+					std::string_view unit = unitOf(upper).empty() ? std::string_view("mm") : unitOf(upper);
+					minHeight = -infinity;
+					maxHeight = infinity;
+					isValid = !(lower.empty() && upper.empty())
+						&& (lower.empty() || parseLength(lower, minHeight, unit))
+						&& (upper.empty() || parseLength(upper, maxHeight, unit));
+				}
+				else {
+					double height = 0.0;
+					isValid = parseLength(text, height, "mm");
+					minHeight = height - SketchTextQuery::HEIGHT_EPSILON;
+					maxHeight = height + SketchTextQuery::HEIGHT_EPSILON;
+				}
+				if (!isValid) {
+					error = "Invalid height '" + std::string(text) + "'";
+				}
+				return isValid;
+			}
+
+			/// <summary>Parses x1,y1,x2,y2 with an optional unit at the end into a region in cm, unbounded in z.</summary>
+			bool parseRegion(std::string_view text, Box3& region, std::string& error) {
+				std::string_view unit = unitOf(text);
+				std::string_view numbers = text.substr(0, text.size() - unit.size());
+				if (unit.empty()) {
+					unit = "mm";
+				}
+				double values[4] = {};
+				size_t count = 0;
+				size_t start = 0;
+				bool isAtEnd = false; // The last number read was not followed by a comma
+				while (count < 4 && start <= numbers.size()) {
+					size_t comma = numbers.find(',', start);
+					std::string_view number = numbers.substr(start, comma == std::string_view::npos ? std::string_view::npos : comma - start);
+					if (!parseLength(number, values[count++], unit)) {
+						break;
+					}
+					if (comma == std::string_view::npos) {
+						isAtEnd = true;
+						break;
+					}
+					start = comma + 1;
+				}
+				if (count != 4 || !isAtEnd) {
+					error = "Invalid region '" + std::string(text) + "', expected x1,y1,x2,y2";
+					return false;
+				}
+				region = Box3::of(
+					Point3{ (std::min)(values[0], values[2]), (std::min)(values[1], values[3]), std::numeric_limits<double>::lowest() },
+					Point3{ (std::max)(values[0], values[2]), (std::max)(values[1], values[3]), (std::numeric_limits<double>::max)() });
+				return true;
+			}
+
+			/// <summary>The terms of a query the access path did not check yet, tested in one pass.</summary>
+			struct QueryResidual {
+				std::optional<HeightInRange> height;
+				std::optional<BoundsWithin> region;
+				std::optional<SketchIn> sketches;
+				const std::vector<std::regex>* expressions = nullptr;
+
+				bool operator()(uint32_t id, const SketchTextRecord& record) const {
+					if ((height && !(*height)(id, record)) || (region && !(*region)(id, record)) || (sketches && !(*sketches)(id, record))) {
+						return false;
+					}
+					for (const std::regex& expression : *expressions) {
+						if (!TextMatches{ &expression }(id, record)) {
+							return false;
+						}
+					}
+					return true;
+				}
+			};
+		}
+
+		#pragma region SketchTextQuery
+		/// <summary>Parses the text of a query, see SketchTextQuery.</summary>
+		///
+		/// <param name="text"> The query.</param>
+		/// <param name="query">[out] The parsed query.</param>
+		/// <param name="error">[out] Why the query is invalid.</param>
+		///
+		/// <returns>True if it succeeds, false if the query is invalid.</returns>
+		bool SketchTextQuery::parse(std::string_view text, SketchTextQuery& query, std::string& error) {
+			query = SketchTextQuery();
+			size_t position = 0;
+			std::string value;
+			while (true) {
+				while (position < text.size() && isSpace(text[position])) {
+					++position;
+				}
+				if (position >= text.size()) {
+					return true;
+				}
+
+				size_t nameEnd = position;
+				while (nameEnd < text.size() && std::isalpha((unsigned char)text[nameEnd])) {
+					++nameEnd;
+				}
+				bool isField = nameEnd > position && nameEnd < text.size() && (text[nameEnd] == ':' || text[nameEnd] == '~');
+				if (!isField) {
+					if (!readValue(text, position, value, error)) {
+						return false;
+					}
+					query.contents.push_back(value);
+					continue;
+				}
+
+				std::string_view name = text.substr(position, nameEnd - position);
+				char op = text[nameEnd];
+				position = nameEnd + 1;
+				if (!readValue(text, position, value, error)) {
+					return false;
+				}
+				if (value.empty()) {
+					error = "Missing value of '" + std::string(name) + op + "'";
+					return false;
+				}
+
+				if (name == "text" && op == '~') {
+					try {
+						query.expressions.emplace_back(value, std::regex::ECMAScript | std::regex::optimize);
+					}
+					catch (const std::regex_error&) {
+						error = "Invalid expression '" + value + "'";
+						return false;
+					}
+					query.patterns.push_back(value);
+				}
+				else if (op == '~') {
+					error = "'" + std::string(name) + "' does not take an expression";
+					return false;
+				}
+				else if (name == "text") {
+					query.contents.push_back(value);
+				}
+				else if (name == "height") {
+					double minHeight = 0.0;
+					double maxHeight = 0.0;
+					if (!parseHeight(value, minHeight, maxHeight, error)) {
+						return false;
+					}
+					// Several heights narrow the range
+					query.minHeight = query.hasHeight ? (std::max)(query.minHeight, minHeight) : minHeight;
+					query.maxHeight = query.hasHeight ? (std::min)(query.maxHeight, maxHeight) : maxHeight;
+					query.hasHeight = true;
+				}
+				else if (name == "sketch") {
+					query.sketchPatterns.push_back(value);
+				}
+				else if (name == "in") {
+					Box3 region;
+					if (!parseRegion(value, region, error)) {
+						return false;
+					}
+					if (query.hasRegion) {
+						region = Box3::of(
+							Point3{ (std::max)(region.minPoint.x, query.region.minPoint.x), (std::max)(region.minPoint.y, query.region.minPoint.y), region.minPoint.z },
+							Point3{ (std::min)(region.maxPoint.x, query.region.maxPoint.x), (std::min)(region.maxPoint.y, query.region.maxPoint.y), region.maxPoint.z });
+					}
+					query.region = region;
+					query.hasRegion = true;
+				}
+				else {
+					error = "Unknown field '" + std::string(name) + "'";
+					return false;
+				}
+			}
+		}
+		#pragma endregion
+
+		#pragma region SketchTextQueryPlan
+		/// <summary>Describes the plan for the log, e.g. "height index, 120 of 4000 rows".</summary>
+		///
+		/// <param name="query">The planned query.</param>
+		///
+		/// <returns>The description.</returns>
+		std::string SketchTextQueryPlan::describe(const SketchTextQuery& query) const {
+			switch (accessPath) {
+			case SketchTextAccessPath::HeightIndex:
+				return "height index, " + std::to_string(estimatedRows) + " of " + std::to_string(recordCount) + " rows";
+			case SketchTextAccessPath::TrigramIndex:
+				return "trigram index for \"" + query.contents[contentIndex] + "\", at most " + std::to_string(estimatedRows) + " of " + std::to_string(recordCount) + " rows";
+			case SketchTextAccessPath::SpatialIndex:
+				return "spatial index, " + std::to_string(estimatedRows) + " of " + std::to_string(recordCount) + " rows";
+			default:
+				return "full scan of " + std::to_string(recordCount) + " rows";
+			}
+		}
+		#pragma endregion
+
+		#pragma region SketchTextQueryPlanner
+		/// <summary>
+		/// <para>plan estimates the candidates of every access path the query allows and picks the fewest; on a tie</para>
+		/// <para>the height index wins over the trigram index, which wins over the spatial index and the full scan.</para>
+		/// <para>The estimates take a binary search or a posting list lookup each, no candidate is read.</para>
+		/// </summary>
+		///
+		/// <param name="query">	 The query.</param>
+		/// <param name="textIndex"> The trigram index of the records.</param>
+		/// <param name="rangeIndex">The height and position index of the same records.</param>
+		///
+		/// <returns>The plan.</returns>
+		SketchTextQueryPlan SketchTextQueryPlanner::plan(const SketchTextQuery& query, const SketchTextTrigramIndex& textIndex, const SketchTextRangeIndex& rangeIndex) {
+			SketchTextQueryPlan plan;
+			plan.recordCount = rangeIndex.size();
+			plan.estimatedRows = plan.recordCount;
+
+			auto consider = [&plan](SketchTextAccessPath accessPath, size_t estimatedRows) {
+				if (estimatedRows < plan.estimatedRows || (estimatedRows == plan.estimatedRows && plan.accessPath == SketchTextAccessPath::FullScan)) {
+					plan.accessPath = accessPath;
+					plan.estimatedRows = estimatedRows;
+				}
+			};
+
+			if (query.hasHeight) {
+				consider(SketchTextAccessPath::HeightIndex, rangeIndex.countHeight(query.minHeight, query.maxHeight));
+			}
+			if (!query.contents.empty()) {
+				// Only the most selective content is looked up first, the others are intersected with its result
+				size_t fewestRows = (std::numeric_limits<size_t>::max)();
+				for (size_t i = 0; i < query.contents.size(); ++i) {
+					size_t estimatedRows = textIndex.estimate(query.contents[i], false);
+					if (estimatedRows < fewestRows) {
+						fewestRows = estimatedRows;
+						plan.contentIndex = i;
+					}
+				}
+				consider(SketchTextAccessPath::TrigramIndex, fewestRows);
+			}
+			if (query.hasRegion) {
+				consider(SketchTextAccessPath::SpatialIndex, rangeIndex.countLeft(query.region.minPoint.x, query.region.maxPoint.x));
+			}
+			return plan;
+		}
+
+		/// <summary>
+		/// <para>execute reads the candidates of the access path, intersects them with the trigram lookups of the other</para>
+		/// <para>contents and keeps those that pass the remaining terms, checked together in one pass.</para>
+		/// </summary>
+		///
+		/// <param name="query">	  The query.</param>
+		/// <param name="plan">		  The plan of the query for these indexes.</param>
+		/// <param name="records">	  The records.</param>
+		/// <param name="sketchNames">The names of the sketches, by the sketch index of the records.</param>
+		/// <param name="textIndex">  The trigram index of the records.</param>
+		/// <param name="rangeIndex"> The height and position index of the records.</param>
+		/// <param name="ids">		  [out] The ascending ids of the matching records.</param>
+		/// <param name="resource">	  The memory of the temporaries, e.g. the arena of a refresh.</param>
+		void SketchTextQueryPlanner::execute(const SketchTextQuery& query, const SketchTextQueryPlan& plan, const std::vector<SketchTextRecord>& records,
+			const std::vector<std::string>& sketchNames, const SketchTextTrigramIndex& textIndex, const SketchTextRangeIndex& rangeIndex,
+			std::vector<uint32_t>& ids, std::pmr::memory_resource* resource) {
+			switch (plan.accessPath) {
+			case SketchTextAccessPath::HeightIndex:
+				rangeIndex.findHeight(query.minHeight, query.maxHeight, ids);
+				break;
+			case SketchTextAccessPath::TrigramIndex:
+				textIndex.find(query.contents[plan.contentIndex], false, ids, resource);
+				break;
+			case SketchTextAccessPath::SpatialIndex:
+				rangeIndex.findLeft(query.region.minPoint.x, query.region.maxPoint.x, ids);
+				break;
+			default:
+				ids.resize(records.size());
+				std::iota(ids.begin(), ids.end(), 0);
+				break;
+			}
+
+			std::vector<uint32_t> contentIds;
+			std::pmr::vector<uint32_t> intersection(resource);
+			for (size_t i = 0; i < query.contents.size() && !ids.empty(); ++i) {
+				if (plan.accessPath == SketchTextAccessPath::TrigramIndex && i == plan.contentIndex) {
+					continue;
+				}
+				textIndex.find(query.contents[i], false, contentIds, resource);
+				intersection.clear();
+				std::set_intersection(ids.begin(), ids.end(), contentIds.begin(), contentIds.end(), std::back_inserter(intersection));
+				ids.assign(intersection.begin(), intersection.end());
+			}
+
+			QueryResidual residual;
+			residual.expressions = &query.expressions;
+			if (query.hasHeight && plan.accessPath != SketchTextAccessPath::HeightIndex) {
+				residual.height = HeightInRange{ query.minHeight, query.maxHeight };
+			}
+			if (query.hasRegion) {
+				// The spatial index only checks the left edge
+				residual.region = BoundsWithin{ query.region };
+			}
+			std::pmr::vector<unsigned int> sketchIndexes(resource);
+			if (!query.sketchPatterns.empty()) {
+				for (unsigned int sketchIndex = 0; sketchIndex < (unsigned int)sketchNames.size(); ++sketchIndex) {
+					bool isMatch = std::all_of(query.sketchPatterns.begin(), query.sketchPatterns.end(), [&](const std::string& pattern) {
+						return matchWildcard(pattern, sketchNames[sketchIndex]);
+					});
+					if (isMatch) {
+						sketchIndexes.push_back(sketchIndex);
+					}
+				}
+				residual.sketches = SketchIn{ sketchIndexes };
+			}
+			filterIds(records, ids, residual);
+		}
+
+		/// <summary>Matches a text against a pattern in which * stands for any run of characters and ? for one, ignoring ASCII case.</summary>
+		///
+		/// <param name="pattern">The pattern.</param>
+		/// <param name="text">   The text.</param>
+		///
+		/// <returns>True if the whole text matches.</returns>
+		bool SketchTextQueryPlanner::matchWildcard(std::string_view pattern, std::string_view text) {
+			auto equal = [](char a, char b) { return std::tolower((unsigned char)a) == std::tolower((unsigned char)b); };
+			size_t p = 0;
+			size_t t = 0;
+			size_t star = std::string_view::npos;
+			size_t resume = 0;
+			while (t < text.size()) {
+				if (p < pattern.size() && (pattern[p] == '?' || (pattern[p] != '*' && equal(pattern[p], text[t])))) {
+					++p;
+					++t;
+				}
+				else if (p < pattern.size() && pattern[p] == '*') {
+					star = p++;
+					resume = t;
+				}
+				else if (star != std::string_view::npos) {
+					p = star + 1;
+					t = ++resume;
+				}
+				else {
+					return false;
+				}
+			}
+			while (p < pattern.size() && pattern[p] == '*') {
+				++p;
+			}
+			return p == pattern.size();
+		}
+		#pragma endregion
+
+		#pragma region SketchTextQueryCache
+		/// <summary>
+		/// <para>compile returns the compiled query of a text, parsing it only the first time. Invalid queries are kept</para>
+		/// <para>as well, with their error, so that a query being typed does not parse again on every refresh.</para>
+		/// </summary>
+		///
+		/// <param name="text">	   The query, see SketchTextQuery.</param>
+		/// <param name="isPinned">True to keep the query until unpinned, e.g. for a preset.</param>
+		///
+		/// <returns>The compiled query, valid until the next call to compile, unpinAll or clear.</returns>
+		SketchTextCompiledQuery& SketchTextQueryCache::compile(const std::string& text, bool isPinned) {
+			auto it = queries_.find(text);
+			if (it != queries_.end()) {
+				++parseHits_;
+				it->second.isPinned = it->second.isPinned || isPinned;
+				return it->second;
+			}
+
+			if (queries_.size() >= MAX_QUERIES) {
+				std::erase_if(queries_, [](const auto& entry) { return !entry.second.isPinned; });
+			}
+			++parseCount_;
+			SketchTextCompiledQuery& compiled = queries_[text];
+			compiled.isPinned = isPinned;
+			if (!SketchTextQuery::parse(text, compiled.query, compiled.error) && compiled.error.empty()) {
+				compiled.error = "Invalid query";
+			}
+			return compiled;
+		}
+
+		/// <summary>
+		/// <para>plan returns the plan of a valid compiled query for the indexes, planning it again only when they</para>
+		/// <para>were rebuilt since. Both indexes are built together, so the generation of the range index stands for both.</para>
+		/// </summary>
+		///
+		/// <param name="compiled">  [in,out] The compiled query.</param>
+		/// <param name="textIndex"> The trigram index of the records.</param>
+		/// <param name="rangeIndex">The height and position index of the same records.</param>
+		///
+		/// <returns>The plan.</returns>
+		const SketchTextQueryPlan& SketchTextQueryCache::plan(SketchTextCompiledQuery& compiled, const SketchTextTrigramIndex& textIndex, const SketchTextRangeIndex& rangeIndex) {
+			if (compiled.planGeneration != 0 && compiled.planGeneration == rangeIndex.getGeneration()) {
+				++planHits_;
+				return compiled.plan;
+			}
+			++planCount_;
+			compiled.plan = SketchTextQueryPlanner::plan(compiled.query, textIndex, rangeIndex);
+			compiled.planGeneration = rangeIndex.getGeneration();
+			return compiled.plan;
+		}
+
+		/// <summary>Lets the pinned queries be dropped like the others, e.g. before the presets are pinned anew.</summary>
+		void SketchTextQueryCache::unpinAll() {
+			for (auto& [text, compiled] : queries_) {
+				compiled.isPinned = false;
+			}
+		}
+
+		void SketchTextQueryCache::clear() {
+			queries_.clear();
+		}
+
+		void SketchTextQueryCache::resetStatistics() {
+			parseHits_ = 0;
+			parseCount_ = 0;
+			planHits_ = 0;
+			planCount_ = 0;
+		}
+
+		/// <summary>Estimates the heap memory held by the cache; compiled expressions are counted by their pattern.</summary>
+		///
+		/// <returns>The memory in bytes.</returns>
+		size_t SketchTextQueryCache::getMemoryUsage() const {
+			auto stringsUsage = [](const std::vector<std::string>& strings) {
+				size_t bytes = strings.capacity() * sizeof(std::string);
+				for (const std::string& string : strings) {
+					bytes += string.capacity();
+				}
+				return bytes;
+			};
+			size_t bytes = queries_.bucket_count() * sizeof(void*);
+			for (const auto& [text, compiled] : queries_) {
+				const SketchTextQuery& query = compiled.query;
+				bytes += sizeof(std::pair<const std::string, SketchTextCompiledQuery>) + text.capacity() + compiled.error.capacity()
+					+ stringsUsage(query.contents) + stringsUsage(query.patterns) + stringsUsage(query.sketchPatterns)
+					+ query.expressions.capacity() * sizeof(std::regex);
+			}
+			return bytes;
+		}
+		#pragma endregion
+	}
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+#include "Geometry.h"
+
+namespace implicatex {
+	namespace fusion {
+		struct SketchTextRecord;
+		class SketchTextTrigramIndex;
+		class SketchTextRangeIndex;
+
+		/// <summary>
+		/// <para>SketchTextQuery is a parsed text query. All terms must hold; a query like</para>
+		/// <para>  height:2..3mm text~"^M\d+" sketch:"Panel*" label</para>
+		/// <para>selects the texts from 2 to 3 mm high that match the expression, in sketches whose name starts with</para>
+		/// <para>Panel, that contain "label". The terms are:</para>
+		/// <para>  height:2.5mm  height:2..3mm  height:>=2cm  height:..0.1in   a height or range, in mm by default</para>
+		/// <para>  text:abc  text:"a b"  abc                                   contains the text, ignoring case</para>
+		/// <para>  text~"^M\d+"                                               the regular expression matches</para>
+		/// <para>  sketch:Panel*                                              the sketch name matches, * and ? as wildcards</para>
+		/// <para>  in:0,0,100,50mm                                            the bounds lie within x1,y1,x2,y2</para>
+		/// <para>Within quotes, \" stands for a quote; other backslashes are kept for the expression.</para>
+		/// </summary>
+		struct SketchTextQuery {
+			/// <summary>Half the display precision of the table (0.01 mm), the tolerance of a single height.</summary>
+			static constexpr double HEIGHT_EPSILON = 0.0005;
+
+			bool hasHeight = false;
+			double minHeight = 0.0; // Fusion internal units (cm)
+			double maxHeight = 0.0;
+			std::vector<std::string> contents;
+			std::vector<std::string> patterns;
+			std::vector<std::regex> expressions;
+			std::vector<std::string> sketchPatterns;
+			bool hasRegion = false;
+			Box3 region;
+
+			static bool parse(std::string_view text, SketchTextQuery& query, std::string& error);
+			bool empty() const { return !hasHeight && contents.empty() && patterns.empty() && sketchPatterns.empty() && !hasRegion; }
+		};
+
+		/// <summary>The ways the planner can find the first candidates of a query.</summary>
+		enum class SketchTextAccessPath {
+			FullScan,
+			HeightIndex,
+			TrigramIndex,
+			SpatialIndex
+		};
+
+		/// <summary>The access path chosen for a query and the number of candidates it is expected to return.</summary>
+		struct SketchTextQueryPlan {
+			SketchTextAccessPath accessPath = SketchTextAccessPath::FullScan;
+			size_t estimatedRows = 0;
+			size_t recordCount = 0;
+			size_t contentIndex = 0; // The content looked up by the trigram index
+
+			std::string describe(const SketchTextQuery& query) const;
+		};
+
+		/// <summary>
+		/// <para>SketchTextQueryPlanner estimates, by binary searches and posting list lengths, how many candidates each</para>
+		/// <para>index would return for a query and picks the cheapest access path. Execution reads the candidates from</para>
+		/// <para>that path, intersects them with the other contents and checks the remaining terms in one pass.</para>
+		/// </summary>
+		class SketchTextQueryPlanner
+		{
+		public:
+			static SketchTextQueryPlan plan(const SketchTextQuery& query, const SketchTextTrigramIndex& textIndex, const SketchTextRangeIndex& rangeIndex);
+			static void execute(const SketchTextQuery& query, const SketchTextQueryPlan& plan, const std::vector<SketchTextRecord>& records,
+				const std::vector<std::string>& sketchNames, const SketchTextTrigramIndex& textIndex, const SketchTextRangeIndex& rangeIndex,
+				std::vector<uint32_t>& ids, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+			static bool matchWildcard(std::string_view pattern, std::string_view text);
+		};
+
+		/// <summary>A query parsed once, with the plan made for the indexes of one generation.</summary>
+		struct SketchTextCompiledQuery {
+			SketchTextQuery query;
+			std::string error; // Why the query is invalid, empty if it is valid
+			SketchTextQueryPlan plan;
+			uint64_t planGeneration = 0; // The index generation the plan was made for, 0 if not planned yet
+			bool isPinned = false;
+
+			bool isValid() const { return error.empty(); }
+		};
+
+		/// <summary>
+		/// <para>SketchTextQueryCache keeps queries compiled by their text, so that a query run again, e.g. a saved preset,</para>
+		/// <para>is neither parsed nor planned again: its plan is kept until the indexes are rebuilt. Pinned queries stay</para>
+		/// <para>until unpinned; the others are dropped together once MAX_QUERIES are kept.</para>
+		/// </summary>
+		class SketchTextQueryCache
+		{
+		public:
+			static constexpr size_t MAX_QUERIES = 64;
+
+			SketchTextCompiledQuery& compile(const std::string& text, bool isPinned = false);
+			const SketchTextQueryPlan& plan(SketchTextCompiledQuery& compiled, const SketchTextTrigramIndex& textIndex, const SketchTextRangeIndex& rangeIndex);
+			void unpinAll();
+			void clear();
+			void resetStatistics();
+			size_t getMemoryUsage() const;
+
+			#pragma region Getters
+			size_t getQueryCount() const { return queries_.size(); }
+			uint64_t getParseHitCount() const { return parseHits_; }
+			uint64_t getParseCount() const { return parseCount_; }
+			uint64_t getPlanHitCount() const { return planHits_; }
+			uint64_t getPlanCount() const { return planCount_; }
+			#pragma endregion
+
+		private:
+			std::unordered_map<std::string, SketchTextCompiledQuery> queries_;
+			uint64_t parseHits_ = 0;
+			uint64_t parseCount_ = 0;
+			uint64_t planHits_ = 0;
+			uint64_t planCount_ = 0;
+		};
+	}
+}
@@ -0,0 +1,98 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextRangeIndex.h"
+
+namespace implicatex {
+	namespace fusion {
+		namespace {
+			std::atomic<uint64_t> lastGeneration = 0;
+
+			/// <summary>Sorts the record ids by a key and stores keys and ids in that order.</summary>
+			template<typename Key>
+			void order(const std::vector<SketchTextRecord>& records, Key key, std::vector<double>& keys, std::vector<uint32_t>& ids) {
+				ids.resize(records.size());
+				std::iota(ids.begin(), ids.end(), 0);
+				std::stable_sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+					return key(records[a]) < key(records[b]);
+				});
+				keys.resize(ids.size());
+				for (size_t i = 0; i < ids.size(); ++i) {
+					keys[i] = key(records[ids[i]]);
+				}
+			}
+		}
+
+		/// <summary>Orders the records by height and by the left edge of their bounds.</summary>
+		///
+		/// <param name="records">The records to index; record ids are their positions in this vector.</param>
+		void SketchTextRangeIndex::build(const std::vector<SketchTextRecord>& records) {
+			order(records, [](const SketchTextRecord& record) { return record.height; }, heights_, heightIds_);
+			order(records, [](const SketchTextRecord& record) { return record.bounds.minPoint.x; }, lefts_, leftIds_);
+			generation_ = ++lastGeneration;
+		}
+
+		void SketchTextRangeIndex::clear() {
+			heights_.clear();
+			heightIds_.clear();
+			lefts_.clear();
+			leftIds_.clear();
+			generation_ = 0;
+		}
+
+		/// <summary>Estimates the heap memory held by the index, counting capacities rather than sizes.</summary>
+		///
+		/// <returns>The memory in bytes.</returns>
+		size_t SketchTextRangeIndex::getMemoryUsage() const {
+			return (heights_.capacity() + lefts_.capacity()) * sizeof(double)
+				+ (heightIds_.capacity() + leftIds_.capacity()) * sizeof(uint32_t);
+		}
+
+		/// <summary>Counts the records with a height within the closed range, in cm.</summary>
+		size_t SketchTextRangeIndex::countHeight(double minHeight, double maxHeight) const {
+			auto [first, last] = range(heights_, minHeight, maxHeight);
+			return last - first;
+		}
+
+		/// <summary>Returns the ascending ids of the records with a height within the closed range, in cm.</summary>
+		///
+		/// <param name="minHeight">The smallest height.</param>
+		/// <param name="maxHeight">The largest height.</param>
+		/// <param name="ids">		[out] The ids.</param>
+		void SketchTextRangeIndex::findHeight(double minHeight, double maxHeight, std::vector<uint32_t>& ids) const {
+			collect(heightIds_, range(heights_, minHeight, maxHeight), ids);
+		}
+
+		/// <summary>Counts the records whose bounds start within the closed range of x, in cm.</summary>
+		size_t SketchTextRangeIndex::countLeft(double minX, double maxX) const {
+			auto [first, last] = range(lefts_, minX, maxX);
+			return last - first;
+		}
+
+		/// <summary>
+		/// <para>Returns the ascending ids of the records whose bounds start within the closed range of x, in cm:</para>
+		/// <para>the candidates of a region, which the caller checks against the other edges.</para>
+		/// </summary>
+		///
+		/// <param name="minX">The smallest left edge.</param>
+		/// <param name="maxX">The largest left edge.</param>
+		/// <param name="ids"> [out] The ids.</param>
+		void SketchTextRangeIndex::findLeft(double minX, double maxX, std::vector<uint32_t>& ids) const {
+			collect(leftIds_, range(lefts_, minX, maxX), ids);
+		}
+
+		std::pair<size_t, size_t> SketchTextRangeIndex::range(const std::vector<double>& keys, double minKey, double maxKey) {
+			if (!(minKey <= maxKey)) {
+				return { 0, 0 };
+			}
+			size_t first = std::lower_bound(keys.begin(), keys.end(), minKey) - keys.begin();
+			size_t last = std::upper_bound(keys.begin() + first, keys.end(), maxKey) - keys.begin();
+			return { first, last };
+		}
+
+		void SketchTextRangeIndex::collect(const std::vector<uint32_t>& order, std::pair<size_t, size_t> range, std::vector<uint32_t>& ids) {
+			ids.assign(order.begin() + range.first, order.begin() + range.second);
+			// Later stages expect the ids in collection order
+			std::sort(ids.begin(), ids.end());
+		}
+	}
+}
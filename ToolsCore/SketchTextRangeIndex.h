@@ -0,0 +1,39 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		struct SketchTextRecord;
+
+		/// <summary>
+		/// <para>SketchTextRangeIndex keeps the record ids ordered by height and by the left edge of their bounding box,</para>
+		/// <para>so that height ranges and regions are answered, and their result sizes estimated, by binary search.</para>
+		/// <para>Every build gets a generation unique in the process, so that plans made for one build are recognized.</para>
+		/// </summary>
+		class SketchTextRangeIndex
+		{
+		public:
+			void build(const std::vector<SketchTextRecord>& records);
+			void clear();
+			size_t getMemoryUsage() const;
+
+			size_t countHeight(double minHeight, double maxHeight) const;
+			void findHeight(double minHeight, double maxHeight, std::vector<uint32_t>& ids) const;
+			size_t countLeft(double minX, double maxX) const;
+			void findLeft(double minX, double maxX, std::vector<uint32_t>& ids) const;
+
+			bool empty() const { return heightIds_.empty(); }
+			size_t size() const { return heightIds_.size(); }
+			uint64_t getGeneration() const { return generation_; }
+
+		private:
+			static std::pair<size_t, size_t> range(const std::vector<double>& keys, double minKey, double maxKey);
+			static void collect(const std::vector<uint32_t>& order, std::pair<size_t, size_t> range, std::vector<uint32_t>& ids);
+
+			std::vector<double> heights_;	// Ascending
+			std::vector<uint32_t> heightIds_;
+			std::vector<double> lefts_;		// Ascending
+			std::vector<uint32_t> leftIds_;
+			uint64_t generation_ = 0; // 0 until built
+		};
+	}
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Geometry.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>SketchTextRecord holds the plain values of one sketch text, read once from the Fusion API,</para>
+		/// <para>so that filters and indexes can work on them without further API round trips.</para>
+		/// </summary>
+		struct SketchTextRecord {
+			std::string text;
+			double height = 0.0; // Fusion internal units (cm)
+			Box3 bounds;
+			unsigned int sketchIndex = 0;
+			std::optional<Point3> anchor; // The point the text keeps when its height changes, set by its alignment
+		};
+	}
+}
@@ -0,0 +1,91 @@
+#include "CorePch.h"
+#include "SketchTextReplacer.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>plan applies the pattern to every text and collects the texts whose content changes.</para>
+		/// <para>The job gives up early once currentGeneration moves past its own generation.</para>
+		/// </summary>
+		///
+		/// <param name="texts">			The ids and current contents of the texts to match.</param>
+		/// <param name="find">				The literal text or regular expression to find.</param>
+		/// <param name="replace">			The replacement; may use $1.. references for regular expressions.</param>
+		/// <param name="useRegex">			True to treat find as ECMAScript regular expression.</param>
+		/// <param name="generation">		The generation of this job.</param>
+		/// <param name="currentGeneration">The generation of the most recently requested job.</param>
+		///
+		/// <returns>The replace plan.</returns>
+		SketchTextReplacePlan SketchTextReplacer::plan(
+			const std::vector<SketchTextReplacement>& texts,
+			const std::string& find,
+			const std::string& replace,
+			bool useRegex,
+			uint64_t generation,
+			const std::atomic<uint64_t>& currentGeneration) {
+			SketchTextReplacePlan result;
+			result.generation = generation;
+
+			if (find.empty()) {
+				return result;
+			}
+
+			std::regex expression;
+			if (useRegex) {
+				try {
+					expression = std::regex(find, std::regex::ECMAScript);
+				}
+				catch (const std::regex_error& e) {
+					result.isValid = false;
+					result.error = e.what();
+					return result;
+				}
+			}
+
+			for (size_t i = 0; i < texts.size(); ++i) {
+				if ((i & 0x3FF) == 0 && currentGeneration.load(std::memory_order_relaxed) != generation) {
+					result.isCancelled = true;
+					result.replacements.clear();
+					return result;
+				}
+
+				const std::string& text = texts[i].text;
+				std::string replaced = useRegex
+					? std::regex_replace(text, expression, replace)
+					: replaceLiteral(text, find, replace);
+
+				if (replaced != text) {
+					result.replacements.push_back({ texts[i].id, std::move(replaced) });
+				}
+			}
+
+			return result;
+		}
+
+		/// <summary>Replaces every occurrence of find in text, scanning left to right without overlaps.</summary>
+		///
+		/// <param name="text">   The text.</param>
+		/// <param name="find">   The text to find, must not be empty.</param>
+		/// <param name="replace">The replacement.</param>
+		///
+		/// <returns>The text with all occurrences replaced.</returns>
+		std::string SketchTextReplacer::replaceLiteral(const std::string& text, const std::string& find, const std::string& replace) {
+			size_t position = text.find(find);
+			if (position == std::string::npos) {
+				return text;
+			}
+
+			std::string result;
+			result.reserve(text.size());
+			size_t start = 0;
+			while (position != std::string::npos) {
+				result.append(text, start, position - start);
+				result.append(replace);
+				start = position + find.size();
+				position = text.find(find, start);
+			}
+			result.append(text, start, std::string::npos);
+			return result;
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>The new content of one record, identified by its snapshot id.</summary>
+		struct SketchTextReplacement {
+			uint32_t id = 0;
+			std::string text;
+		};
+
+		/// <summary>
+		/// <para>SketchTextReplacePlan is the result of matching a find pattern against a set of texts:</para>
+		/// <para>only texts whose content actually changes are listed.</para>
+		/// </summary>
+		struct SketchTextReplacePlan {
+			uint64_t generation = 0;
+			bool isValid = true;
+			bool isCancelled = false;
+			std::string error;
+			std::vector<SketchTextReplacement> replacements;
+		};
+
+		/// <summary>
+		/// <para>SketchTextReplacer computes replace plans for literal or regular expression patterns.</para>
+		/// <para>It works on copied texts only and can therefore run on a worker thread.</para>
+		/// </summary>
+		class SketchTextReplacer
+		{
+		public:
+			static SketchTextReplacePlan plan(
+				const std::vector<SketchTextReplacement>& texts,
+				const std::string& find,
+				const std::string& replace,
+				bool useRegex,
+				uint64_t generation,
+				const std::atomic<uint64_t>& currentGeneration);
+
+			static std::string replaceLiteral(const std::string& text, const std::string& find, const std::string& replace);
+		};
+	}
+}
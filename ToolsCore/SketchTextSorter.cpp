@@ -0,0 +1,140 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextSorter.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>reset drops all cached collation keys and sizes the cache for a newly captured snapshot.</para>
+		/// </summary>
+		///
+		/// <param name="recordCount">Number of records of the snapshot.</param>
+		void SketchTextSorter::reset(size_t recordCount) {
+			keyBytes_.clear();
+			keyOffsets_.assign(recordCount, NO_KEY);
+			keyLengths_.assign(recordCount, 0);
+			cachedKeyCount_ = 0;
+		}
+
+		/// <summary>
+		/// <para>sort orders the given record ids by the requested column. Ties keep the collection order,</para>
+		/// <para>position sorts top to bottom and then left to right like reading a drawing.</para>
+		/// </summary>
+		///
+		/// <param name="records">   The records the ids refer to.</param>
+		/// <param name="localeId">  The locale used for text collation, e.g. "de-DE".</param>
+		/// <param name="order">     The sort column.</param>
+		/// <param name="descending">True to reverse the order.</param>
+		/// <param name="ids">       [in,out] The ids to sort, ascending on input.</param>
+		void SketchTextSorter::sort(const std::vector<SketchTextRecord>& records, const std::string& localeId, SketchTextSortOrder order, bool descending, std::vector<uint32_t>& ids) {
+			if (keyOffsets_.size() != records.size()) {
+				reset(records.size());
+			}
+
+			auto byOrder = [&](auto less) {
+				if (descending) {
+					std::stable_sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) { return less(b, a); });
+				}
+				else {
+					std::stable_sort(ids.begin(), ids.end(), less);
+				}
+			};
+
+			switch (order) {
+			case SketchTextSortOrder::Collection:
+				if (descending) {
+					std::reverse(ids.begin(), ids.end());
+				}
+				break;
+
+			case SketchTextSortOrder::Text:
+				if (!ensureCollator(localeId)) {
+					byOrder([&](uint32_t a, uint32_t b) { return records[a].text < records[b].text; });
+					break;
+				}
+				ensureKeys(records, ids);
+				byOrder([&](uint32_t a, uint32_t b) { return compareKeys(a, b) < 0; });
+				break;
+
+			case SketchTextSortOrder::Height:
+				byOrder([&](uint32_t a, uint32_t b) { return records[a].height < records[b].height; });
+				break;
+
+			case SketchTextSortOrder::Position:
+				byOrder([&](uint32_t a, uint32_t b) {
+					const Box3& boundsA = records[a].bounds;
+					const Box3& boundsB = records[b].bounds;
+					double ay = boundsA.minPoint.y + boundsA.maxPoint.y;
+					double by = boundsB.minPoint.y + boundsB.maxPoint.y;
+					if (ay != by) return ay > by;
+					return boundsA.minPoint.x + boundsA.maxPoint.x < boundsB.minPoint.x + boundsB.maxPoint.x;
+				});
+				break;
+			}
+		}
+
+		/// <summary>
+		/// <para>ensureCollator creates the ICU collator for the locale, dropping all cached keys</para>
+		/// <para>when the locale differs from the one the keys were computed with.</para>
+		/// </summary>
+		///
+		/// <param name="localeId">The locale identifier.</param>
+		///
+		/// <returns>True if a collator is available, false if ICU failed to create one.</returns>
+		bool SketchTextSorter::ensureCollator(const std::string& localeId) {
+			if (collator_ && collatorLocaleId_ == localeId) {
+				return true;
+			}
+
+			UErrorCode status = U_ZERO_ERROR;
+			icu::Locale locale = icu::Locale::forLanguageTag(localeId.c_str(), status);
+			if (U_FAILURE(status)) {
+				return false;
+			}
+			collator_.reset(icu::Collator::createInstance(locale, status));
+			if (U_FAILURE(status) || !collator_) {
+				collator_.reset();
+				return false;
+			}
+
+			collatorLocaleId_ = localeId;
+			reset(keyOffsets_.size());
+			return true;
+		}
+
+		/// <summary>Computes the collation keys of all given ids that are not cached yet.</summary>
+		///
+		/// <param name="records">The records the ids refer to.</param>
+		/// <param name="ids">    The ids that are about to be sorted.</param>
+		void SketchTextSorter::ensureKeys(const std::vector<SketchTextRecord>& records, const std::vector<uint32_t>& ids) {
+			std::vector<uint8_t> buffer(256);
+			for (uint32_t id : ids) {
+				if (keyOffsets_[id] != NO_KEY) {
+					++keyHitCount_;
+					continue;
+				}
+				++keyMissCount_;
+
+				icu::UnicodeString text = icu::UnicodeString::fromUTF8(records[id].text);
+				int32_t length = collator_->getSortKey(text, buffer.data(), (int32_t)buffer.size());
+				if (length > (int32_t)buffer.size()) {
+					buffer.resize(length);
+					length = collator_->getSortKey(text, buffer.data(), (int32_t)buffer.size());
+				}
+
+				keyOffsets_[id] = (uint32_t)keyBytes_.size();
+				keyLengths_[id] = (uint32_t)length;
+				keyBytes_.insert(keyBytes_.end(), buffer.begin(), buffer.begin() + length);
+				++cachedKeyCount_;
+			}
+		}
+
+		int SketchTextSorter::compareKeys(uint32_t a, uint32_t b) const {
+			uint32_t lengthA = keyLengths_[a];
+			uint32_t lengthB = keyLengths_[b];
+			int result = std::memcmp(keyBytes_.data() + keyOffsets_[a], keyBytes_.data() + keyOffsets_[b], (std::min)(lengthA, lengthB));
+			if (result != 0) return result;
+			return (lengthA < lengthB) ? -1 : (lengthA > lengthB) ? 1 : 0;
+		}
+	}
+}
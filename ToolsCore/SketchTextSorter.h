@@ -0,0 +1,49 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		struct SketchTextRecord;
+
+		/// <summary>The columns the match table can be sorted by.</summary>
+		enum class SketchTextSortOrder {
+			Collection = 0,
+			Text = 1,
+			Height = 2,
+			Position = 3
+		};
+
+		/// <summary>
+		/// <para>SketchTextSorter orders record ids by text, height or position. Text order uses ICU collation keys</para>
+		/// <para>for the tools locale, computed once per record and cached, so that each sort compares bytes only.</para>
+		/// </summary>
+		class SketchTextSorter
+		{
+		public:
+			void reset(size_t recordCount);
+			void sort(const std::vector<SketchTextRecord>& records, const std::string& localeId, SketchTextSortOrder order, bool descending, std::vector<uint32_t>& ids);
+
+			size_t getCachedKeyCount() const { return cachedKeyCount_; }
+			uint64_t getKeyHitCount() const { return keyHitCount_; }
+			uint64_t getKeyMissCount() const { return keyMissCount_; }
+			void resetKeyCounts() { keyHitCount_ = 0; keyMissCount_ = 0; }
+			size_t getMemoryUsage() const { return keyBytes_.capacity() + (keyOffsets_.capacity() + keyLengths_.capacity()) * sizeof(uint32_t); }
+
+		private:
+			bool ensureCollator(const std::string& localeId);
+			void ensureKeys(const std::vector<SketchTextRecord>& records, const std::vector<uint32_t>& ids);
+			int compareKeys(uint32_t a, uint32_t b) const;
+
+			/// <summary>Marks a record whose collation key has not been computed yet.</summary>
+			static constexpr uint32_t NO_KEY = (std::numeric_limits<uint32_t>::max)();
+
+			std::unique_ptr<icu::Collator> collator_;
+			std::string collatorLocaleId_;
+			std::vector<uint8_t> keyBytes_;
+			std::vector<uint32_t> keyOffsets_;
+			std::vector<uint32_t> keyLengths_;
+			size_t cachedKeyCount_ = 0;
+			uint64_t keyHitCount_ = 0;
+			uint64_t keyMissCount_ = 0;
+		};
+	}
+}
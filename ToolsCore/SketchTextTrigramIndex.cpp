@@ -0,0 +1,186 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextTrigramIndex.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>build folds every record text, prefixes it with the start marker and collects all byte trigrams</para>
+		/// <para>into sorted, de-duplicated posting lists stored back to back in one array.</para>
+		/// </summary>
+		///
+		/// <param name="records">The records to index; record ids are their positions in this vector.</param>
+		void SketchTextTrigramIndex::build(const std::vector<SketchTextRecord>& records) {
+			clear();
+
+			folded_.reserve(records.size());
+			std::vector<uint64_t> postings;
+			postings.reserve(records.size() * 8);
+
+			for (uint32_t id = 0; id < (uint32_t)records.size(); ++id) {
+				std::string folded = START_MARKER + fold(records[id].text);
+				for (size_t i = 0; i + 3 <= folded.size(); ++i) {
+					postings.push_back(((uint64_t)trigramKey(folded, i) << 32) | id);
+				}
+				textBytes_ += folded.capacity();
+				folded_.push_back(std::move(folded));
+			}
+
+			std::sort(postings.begin(), postings.end());
+			postings.erase(std::unique(postings.begin(), postings.end()), postings.end());
+
+			ids_.reserve(postings.size());
+			for (uint64_t posting : postings) {
+				uint32_t key = (uint32_t)(posting >> 32);
+				if (keys_.empty() || keys_.back() != key) {
+					keys_.push_back(key);
+					offsets_.push_back((uint32_t)ids_.size());
+				}
+				ids_.push_back((uint32_t)posting);
+			}
+			offsets_.push_back((uint32_t)ids_.size());
+		}
+
+		/// <summary>Removes all indexed texts and posting lists.</summary>
+		void SketchTextTrigramIndex::clear() {
+			folded_.clear();
+			keys_.clear();
+			offsets_.clear();
+			ids_.clear();
+			textBytes_ = 0;
+		}
+
+		/// <summary>Estimates the heap memory held by the index, counting capacities rather than sizes.</summary>
+		///
+		/// <returns>The memory in bytes.</returns>
+		size_t SketchTextTrigramIndex::getMemoryUsage() const {
+			return folded_.capacity() * sizeof(std::string) + textBytes_
+				+ (keys_.capacity() + offsets_.capacity() + ids_.capacity()) * sizeof(uint32_t);
+		}
+
+		/// <summary>
+		/// <para>find returns the ascending ids of all records whose text contains the query,</para>
+		/// <para>or starts with it if prefixOnly is set. Matching is case insensitive.</para>
+		/// </summary>
+		///
+		/// <param name="query">	 The text to search for. An empty query matches every record.</param>
+		/// <param name="prefixOnly">True to match only at the start of the text.</param>
+		/// <param name="ids">		 [in,out] Receives the matching record ids.</param>
+		/// <param name="resource">  The memory of the posting list intersection, e.g. the arena of a refresh.</param>
+		void SketchTextTrigramIndex::find(const std::string& query, bool prefixOnly, std::vector<uint32_t>& ids,
+			std::pmr::memory_resource* resource) const {
+			ids.clear();
+
+			std::string pattern = fold(query);
+			if (pattern.empty()) {
+				ids.resize(folded_.size());
+				std::iota(ids.begin(), ids.end(), 0);
+				return;
+			}
+			if (prefixOnly) {
+				pattern.insert(pattern.begin(), START_MARKER);
+			}
+
+			// Too short for a trigram lookup, a scan over the folded texts is cheap enough
+			if (pattern.size() < 3) {
+				scan(pattern, prefixOnly, ids);
+				return;
+			}
+
+			std::pmr::vector<std::pair<uint32_t, uint32_t>> ranges(resource);
+			for (size_t i = 0; i + 3 <= pattern.size(); ++i) {
+				uint32_t key = trigramKey(pattern, i);
+				auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+				if (it == keys_.end() || *it != key) {
+					return; // A trigram of the query occurs in no text at all
+				}
+				size_t slot = it - keys_.begin();
+				ranges.push_back({ offsets_[slot], offsets_[slot + 1] });
+			}
+
+			std::sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) {
+				return (a.second - a.first) < (b.second - b.first);
+			});
+			ranges.erase(std::unique(ranges.begin(), ranges.end()), ranges.end());
+
+			std::pmr::vector<uint32_t> candidates(ids_.begin() + ranges[0].first, ids_.begin() + ranges[0].second, resource);
+			std::pmr::vector<uint32_t> intersection(resource);
+			for (size_t r = 1; r < ranges.size() && !candidates.empty(); ++r) {
+				intersection.clear();
+				std::set_intersection(candidates.begin(), candidates.end(),
+					ids_.begin() + ranges[r].first, ids_.begin() + ranges[r].second,
+					std::back_inserter(intersection));
+				candidates.swap(intersection);
+			}
+
+			// Trigrams only narrow the candidates, the final check removes texts with scattered trigrams
+			ids.reserve(candidates.size());
+			for (uint32_t id : candidates) {
+				const std::string& folded = folded_[id];
+				if (prefixOnly ? folded.compare(0, pattern.size(), pattern) == 0 : folded.find(pattern, 1) != std::string::npos) {
+					ids.push_back(id);
+				}
+			}
+		}
+
+		/// <summary>
+		/// <para>estimate returns an upper bound of the number of records find returns for the query without</para>
+		/// <para>intersecting: the length of the shortest posting list of its trigrams, or all records if the</para>
+		/// <para>query is too short for a lookup.</para>
+		/// </summary>
+		///
+		/// <param name="query">	 The text to search for.</param>
+		/// <param name="prefixOnly">True to match only at the start of the text.</param>
+		///
+		/// <returns>The estimated number of matches.</returns>
+		size_t SketchTextTrigramIndex::estimate(const std::string& query, bool prefixOnly) const {
+			std::string pattern = fold(query);
+			if (prefixOnly && !pattern.empty()) {
+				pattern.insert(pattern.begin(), START_MARKER);
+			}
+			if (pattern.size() < 3) {
+				return folded_.size();
+			}
+			size_t count = folded_.size();
+			for (size_t i = 0; i + 3 <= pattern.size(); ++i) {
+				uint32_t key = trigramKey(pattern, i);
+				auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+				if (it == keys_.end() || *it != key) {
+					return 0;
+				}
+				size_t slot = it - keys_.begin();
+				count = (std::min)(count, (size_t)(offsets_[slot + 1] - offsets_[slot]));
+			}
+			return count;
+		}
+
+		/// <summary>
+		/// <para>fold returns the Unicode case folded form of a UTF-8 text,</para>
+		/// <para>so that index and queries compare independently of upper and lower case.</para>
+		/// </summary>
+		///
+		/// <param name="text">The UTF-8 text.</param>
+		///
+		/// <returns>The case folded UTF-8 text.</returns>
+		std::string SketchTextTrigramIndex::fold(const std::string& text) {
+			std::string folded;
+			icu::UnicodeString::fromUTF8(text).foldCase().toUTF8String(folded);
+			return folded;
+		}
+
+		uint32_t SketchTextTrigramIndex::trigramKey(const std::string& text, size_t position) {
+			return ((uint32_t)(unsigned char)text[position] << 16)
+				| ((uint32_t)(unsigned char)text[position + 1] << 8)
+				| (uint32_t)(unsigned char)text[position + 2];
+		}
+
+		void SketchTextTrigramIndex::scan(const std::string& pattern, bool prefixOnly, std::vector<uint32_t>& ids) const {
+			for (uint32_t id = 0; id < (uint32_t)folded_.size(); ++id) {
+				const std::string& folded = folded_[id];
+				if (prefixOnly ? folded.compare(0, pattern.size(), pattern) == 0 : folded.find(pattern, 1) != std::string::npos) {
+					ids.push_back(id);
+				}
+			}
+		}
+	}
+}
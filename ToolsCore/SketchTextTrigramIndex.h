@@ -0,0 +1,41 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		struct SketchTextRecord;
+
+		/// <summary>
+		/// <para>SketchTextTrigramIndex is an inverted index from byte trigrams of the case folded text</para>
+		/// <para>to the ids of the records containing them, answering substring and prefix queries</para>
+		/// <para>by intersecting posting lists instead of scanning every text.</para>
+		/// </summary>
+		class SketchTextTrigramIndex
+		{
+		public:
+			void build(const std::vector<SketchTextRecord>& records);
+			void clear();
+			size_t getMemoryUsage() const;
+			void find(const std::string& query, bool prefixOnly, std::vector<uint32_t>& ids,
+				std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+			size_t estimate(const std::string& query, bool prefixOnly) const;
+
+			bool empty() const { return folded_.empty(); }
+			size_t size() const { return folded_.size(); }
+
+			static std::string fold(const std::string& text);
+
+		private:
+			static uint32_t trigramKey(const std::string& text, size_t position);
+			void scan(const std::string& pattern, bool prefixOnly, std::vector<uint32_t>& ids) const;
+
+			/// <summary>Marks the start of each folded text so that prefix queries can use the index.</summary>
+			static constexpr char START_MARKER = '\x01';
+
+			std::vector<std::string> folded_;
+			std::vector<uint32_t> keys_;
+			std::vector<uint32_t> offsets_;
+			std::vector<uint32_t> ids_;
+			size_t textBytes_ = 0; // Capacity of the folded texts, summed when built
+		};
+	}
+}
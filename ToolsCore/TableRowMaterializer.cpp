@@ -0,0 +1,73 @@
+#include "CorePch.h"
+#include "CellId.h"
+#include "TableRowMaterializer.h"
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>Creates a materializer for the given columns.</summary>
+		///
+		/// <param name="columnIds">The ids of the columns, from which the cell ids are made.</param>
+		/// <param name="unit">		The unit appended to formatted lengths after a space, e.g. "mm", or empty.</param>
+		TableRowMaterializer::TableRowMaterializer(std::vector<std::string_view> columnIds, std::string_view unit)
+			: columnIds_(columnIds.begin(), columnIds.end()), cellIds_(columnIds.size()) {
+			if (!unit.empty()) {
+				unitSuffix_.append(" ").append(unit);
+			}
+			buffer_.reserve(32 + unitSuffix_.size());
+		}
+
+		/// <summary>
+		/// <para>reserve interns the cell ids and row numbers of rows up to rowCount. Rows interned before are kept,</para>
+		/// <para>so a table that never grows past its largest fill allocates nothing here after the first.</para>
+		/// </summary>
+		///
+		/// <param name="rowCount">The number of rows.</param>
+		void TableRowMaterializer::reserve(unsigned int rowCount) {
+			unsigned int first = getRowCount();
+			if (rowCount <= first) {
+				return;
+			}
+			for (size_t column = 0; column < columnIds_.size(); ++column) {
+				std::vector<std::string>& ids = cellIds_[column];
+				cellIdBytes_ -= ids.capacity() * sizeof(std::string);
+				ids.reserve(rowCount);
+				cellIdBytes_ += ids.capacity() * sizeof(std::string);
+				for (unsigned int row = first + 1; row <= rowCount; ++row) {
+					ids.push_back(makeCellId(columnIds_[column], row));
+					const std::string& id = ids.back();
+					cellIdBytes_ += id.capacity() >= sizeof(std::string) ? id.capacity() : 0; // Short ids live inside the string
+				}
+			}
+			rowNumbers_.reserve(rowCount);
+			char digits[16];
+			for (unsigned int row = first + 1; row <= rowCount; ++row) {
+				auto result = std::to_chars(digits, digits + sizeof(digits), row);
+				rowNumbers_.emplace_back(digits, result.ptr);
+			}
+		}
+
+		/// <summary>
+		/// <para>formatLength writes a value with a fixed number of decimals and the unit, e.g. "2.50 mm", into</para>
+		/// <para>the reused buffer. The result is valid until the next call.</para>
+		/// </summary>
+		///
+		/// <param name="value">	The value, in the unit.</param>
+		/// <param name="precision">The number of decimals.</param>
+		///
+		/// <returns>The formatted value.</returns>
+		const std::string& TableRowMaterializer::formatLength(double value, int precision) {
+			char digits[64];
+			auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+			buffer_.assign(digits, result.ec == std::errc() ? result.ptr : digits);
+			buffer_.append(unitSuffix_);
+			return buffer_;
+		}
+
+		/// <summary>Estimates the heap memory held by the interned strings.</summary>
+		///
+		/// <returns>The memory in bytes.</returns>
+		size_t TableRowMaterializer::getMemoryUsage() const {
+			return rowNumbers_.capacity() * sizeof(std::string) + buffer_.capacity() + cellIdBytes_;
+		}
+	}
+}
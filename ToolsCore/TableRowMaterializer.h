@@ -0,0 +1,37 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>TableRowMaterializer supplies the cell strings of table rows without allocating per row: the input ids</para>
+		/// <para>of the cells ("textIdCell_1".."textIdCell_N") and the row numbers are interned once up to the largest row</para>
+		/// <para>count seen and reused by every later fill; heights are formatted with std::to_chars into a reused buffer.</para>
+		/// </summary>
+		class TableRowMaterializer
+		{
+		public:
+			explicit TableRowMaterializer(std::vector<std::string_view> columnIds, std::string_view unit = "");
+
+			void reserve(unsigned int rowCount);
+
+			/// <summary>The input id of the cell at column and row; the row starts at 1 and must be reserved.</summary>
+			const std::string& cellId(size_t column, unsigned int row) const { return cellIds_[column][row - 1]; }
+			/// <summary>The decimal row number; the row starts at 1 and must be reserved.</summary>
+			const std::string& rowNumber(unsigned int row) const { return rowNumbers_[row - 1]; }
+			const std::string& formatLength(double value, int precision);
+
+			#pragma region Getters
+			unsigned int getRowCount() const { return (unsigned int)rowNumbers_.size(); }
+			size_t getMemoryUsage() const;
+			#pragma endregion
+
+		private:
+			std::vector<std::string> columnIds_;
+			std::vector<std::vector<std::string>> cellIds_;
+			std::vector<std::string> rowNumbers_;
+			std::string unitSuffix_;
+			std::string buffer_;
+			size_t cellIdBytes_ = 0; // Heap memory of the interned cell ids, summed when reserved
+		};
+	}
+}
@@ -0,0 +1,206 @@
+#include "CorePch.h"
+#include "TraceRecorder.h"
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace implicatex {
+	namespace fusion {
+		namespace {
+			int64_t steadyNow() {
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+
+			/// <summary>Appends a string as JSON string literal; names are ids and literals, so only quotes and controls matter.</summary>
+			void appendJsonString(std::string& out, std::string_view text) {
+				out.push_back('"');
+				for (char c : text) {
+					if (c == '"' || c == '\\') {
+						out.push_back('\\');
+						out.push_back(c);
+					}
+					else if ((unsigned char)c < 0x20) {
+						out.push_back(' ');
+					}
+					else {
+						out.push_back(c);
+					}
+				}
+				out.push_back('"');
+			}
+		}
+
+		/// <summary>Gets the process wide trace recorder.</summary>
+		///
+		/// <returns>The trace recorder.</returns>
+		TraceRecorder& TraceRecorder::get() {
+			static TraceRecorder recorder;
+			return recorder;
+		}
+
+		/// <summary>Discards previously recorded events and starts recording.</summary>
+		void TraceRecorder::start() {
+			clear();
+			startTimestamp_ = steadyNow();
+			isEnabled_.store(true, std::memory_order_relaxed);
+		}
+
+		/// <summary>Stops recording; scopes that are still open record their end events nevertheless.</summary>
+		void TraceRecorder::stop() {
+			isEnabled_.store(false, std::memory_order_relaxed);
+		}
+
+		/// <summary>Discards all recorded events, keeping the buffers and thread names.</summary>
+		void TraceRecorder::clear() {
+			std::lock_guard<std::mutex> lock(buffersMutex_);
+			for (auto& buffer : buffers_) {
+				std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+				buffer->events.clear();
+				buffer->droppedCount = 0;
+			}
+		}
+
+		/// <summary>
+		/// <para>getThreadBuffer returns the buffer of the calling thread, creating it on first use.</para>
+		/// <para>Buffers are owned by the recorder and outlive their threads, so a trace shows finished workers too.</para>
+		/// </summary>
+		///
+		/// <returns>The thread buffer.</returns>
+		TraceBuffer& TraceRecorder::getThreadBuffer() {
+			thread_local TraceBuffer* threadBuffer = nullptr;
+			if (threadBuffer == nullptr) {
+				std::lock_guard<std::mutex> lock(buffersMutex_);
+				auto buffer = std::make_unique<TraceBuffer>();
+				buffer->threadId = (uint32_t)buffers_.size() + 1;
+				buffer->events.reserve(1024);
+				threadBuffer = buffer.get();
+				buffers_.push_back(std::move(buffer));
+			}
+			return *threadBuffer;
+		}
+
+		/// <summary>Appends one event to the buffer of the calling thread.</summary>
+		///
+		/// <param name="phase">   'B' for begin, 'E' for end.</param>
+		/// <param name="name">	   The name, truncated to TraceEvent::NAME_SIZE characters.</param>
+		/// <param name="category">The category, a string literal.</param>
+		void TraceRecorder::record(char phase, std::string_view name, const char* category) {
+			TraceEvent event;
+			event.timestamp = steadyNow();
+			event.category = category;
+			event.phase = phase;
+			size_t length = (std::min)(name.size(), TraceEvent::NAME_SIZE);
+			std::memcpy(event.name, name.data(), length);
+			event.name[length] = '\0';
+
+			TraceBuffer& buffer = getThreadBuffer();
+			std::lock_guard<std::mutex> lock(buffer.mutex);
+			if (buffer.events.size() < THREAD_CAPACITY) {
+				buffer.events.push_back(event);
+			}
+			else {
+				++buffer.droppedCount;
+			}
+		}
+
+		/// <summary>Names the calling thread in the trace, e.g. "Main" or "Settings writer".</summary>
+		///
+		/// <param name="name">The name.</param>
+		void TraceRecorder::setThreadName(const std::string& name) {
+			TraceBuffer& buffer = getThreadBuffer();
+			std::lock_guard<std::mutex> lock(buffer.mutex);
+			buffer.threadName = name;
+		}
+
+		/// <summary>Gets the number of recorded events over all threads.</summary>
+		size_t TraceRecorder::getEventCount() {
+			size_t count = 0;
+			std::lock_guard<std::mutex> lock(buffersMutex_);
+			for (auto& buffer : buffers_) {
+				std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+				count += buffer->events.size();
+			}
+			return count;
+		}
+
+		/// <summary>Gets the number of events dropped because a thread buffer was full.</summary>
+		uint64_t TraceRecorder::getDroppedCount() {
+			uint64_t count = 0;
+			std::lock_guard<std::mutex> lock(buffersMutex_);
+			for (auto& buffer : buffers_) {
+				std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+				count += buffer->droppedCount;
+			}
+			return count;
+		}
+
+		/// <summary>
+		/// <para>writeJson writes the recorded events in the Chrome Trace Event format, with timestamps in</para>
+		/// <para>microseconds since start and one thread_name metadata event per named thread.</para>
+		/// <para>Each buffer is copied under its lock, so recording may go on while the file is written.</para>
+		/// </summary>
+		///
+		/// <param name="path">The file path.</param>
+		///
+		/// <returns>True if it succeeds, false if it fails.</returns>
+		bool TraceRecorder::writeJson(const std::string& path) {
+			std::ofstream file(fs::path(reinterpret_cast<const char8_t*>(path.c_str())), std::ios::binary | std::ios::trunc);
+			if (!file.is_open()) {
+				return false;
+			}
+
+			std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+			bool isFirst = true;
+			auto separate = [&out, &isFirst]() {
+				if (!isFirst) out.append(",\n");
+				isFirst = false;
+			};
+
+			std::vector<TraceEvent> events;
+			std::lock_guard<std::mutex> lock(buffersMutex_);
+			for (auto& buffer : buffers_) {
+				std::string threadName;
+				{
+					std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+					events = buffer->events;
+					threadName = buffer->threadName;
+				}
+
+				if (!threadName.empty()) {
+					separate();
+					out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+					out.append(std::to_string(buffer->threadId));
+					out.append(",\"args\":{\"name\":");
+					appendJsonString(out, threadName);
+					out.append("}}");
+				}
+
+				for (const TraceEvent& event : events) {
+					char timestamp[32];
+					std::snprintf(timestamp, sizeof(timestamp), "%.3f", (double)(event.timestamp - startTimestamp_) / 1000.0);
+
+					separate();
+					out.append("{\"name\":");
+					appendJsonString(out, event.name);
+					out.append(",\"cat\":");
+					appendJsonString(out, event.category != nullptr ? event.category : "");
+					out.append(",\"ph\":\"");
+					out.push_back(event.phase);
+					out.append("\",\"ts\":");
+					out.append(timestamp);
+					out.append(",\"pid\":1,\"tid\":");
+					out.append(std::to_string(buffer->threadId));
+					out.push_back('}');
+				}
+
+				file.write(out.data(), (std::streamsize)out.size());
+				out.clear();
+			}
+
+			out.append("]}\n");
+			file.write(out.data(), (std::streamsize)out.size());
+			file.close();
+			return !file.fail();
+		}
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		/// <summary>
+		/// <para>TraceEvent is one begin ('B') or end ('E') event of the Chrome Trace Event format.</para>
+		/// <para>The name is copied, so that input ids can be used; the category must be a string literal.</para>
+		/// </summary>
+		struct TraceEvent {
+			static constexpr size_t NAME_SIZE = 47;
+
+			int64_t timestamp;		// steady clock, nanoseconds
+			const char* category;
+			char phase;
+			char name[NAME_SIZE + 1];
+		};
+
+		/// <summary>The events of one thread; only that thread appends, the lock is taken by the export.</summary>
+		struct TraceBuffer {
+			uint32_t threadId = 0;
+			std::string threadName;
+			std::mutex mutex;
+			std::vector<TraceEvent> events;
+			uint64_t droppedCount = 0;
+		};
+
+		/// <summary>
+		/// <para>TraceRecorder records begin and end events into per thread buffers while it is started and writes</para>
+		/// <para>them as Chrome Trace Event JSON on demand, to be opened in Perfetto or chrome://tracing.</para>
+		/// <para>When stopped, recording costs a single relaxed load per scope.</para>
+		/// </summary>
+		class TraceRecorder
+		{
+		public:
+			static TraceRecorder& get();
+
+			TraceRecorder(const TraceRecorder&) = delete;
+			TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+			void start();
+			void stop();
+			void clear();
+
+			void record(char phase, std::string_view name, const char* category);
+			void setThreadName(const std::string& name);
+
+			bool writeJson(const std::string& path);
+
+			#pragma region Getters
+			bool isEnabled() const { return isEnabled_.load(std::memory_order_relaxed); }
+			size_t getEventCount();
+			uint64_t getDroppedCount();
+			#pragma endregion
+
+			/// <summary>Maximum number of events kept per thread; further events are dropped and counted.</summary>
+			static constexpr size_t THREAD_CAPACITY = 1 << 16;
+
+		private:
+			TraceRecorder() = default;
+
+			TraceBuffer& getThreadBuffer();
+
+			std::atomic<bool> isEnabled_ = false;
+			int64_t startTimestamp_ = 0;
+
+			std::mutex buffersMutex_;
+			std::vector<std::unique_ptr<TraceBuffer>> buffers_;
+		};
+
+		/// <summary>
+		/// <para>TraceScope records a begin event on construction and the matching end event on destruction.</para>
+		/// <para>End events carry no name, viewers pair them with the innermost open begin event of the thread.</para>
+		/// </summary>
+		class TraceScope
+		{
+		public:
+			TraceScope(std::string_view name, const char* category)
+				: isActive_(TraceRecorder::get().isEnabled()), category_(category) {
+				if (isActive_) {
+					TraceRecorder::get().record('B', name, category_);
+				}
+			}
+
+			~TraceScope() {
+				if (isActive_) {
+					TraceRecorder::get().record('E', std::string_view(), category_);
+				}
+			}
+
+			TraceScope(const TraceScope&) = delete;
+			TraceScope& operator=(const TraceScope&) = delete;
+
+		private:
+			bool isActive_;
+			const char* category_;
+		};
+	}
+}
@@ -0,0 +1,183 @@
+#include "CorePch.h"
+#include <nlohmann/json.hpp>
+#include "SettingsStore.h"
+#include "TestHarness.h"
+
+using namespace implicatex::fusion;
+using implicatex::fusion::tests::getTempPath;
+using json = nlohmann::json;
+
+namespace {
+	// Long enough that only flush writes
+	constexpr std::chrono::milliseconds QUIET_PERIOD = std::chrono::hours(1);
+
+	std::string writeSettingsFile(const std::string& name, const std::string& content) {
+		std::string path = getTempPath(name);
+		std::ofstream file(path, std::ios::out | std::ios::trunc);
+		file << content;
+		return path;
+	}
+
+	json readSettingsFile(const std::string& path) {
+		std::ifstream file(path);
+		return json::parse(file, nullptr, false);
+	}
+}
+
+TEST_CASE(SettingsMigrateVersion1) {
+	std::string path = writeSettingsFile("settings-v1.json", R"({ "SketchText": { "zoomFactor": 2.5 } })");
+	SettingsStore store(path, QUIET_PERIOD);
+	CHECK(store.load());
+	CHECK_EQUAL(store.getLoadedVersion(), 1);
+
+	std::shared_ptr<const ToolsSettings> settings = store.get();
+	CHECK_EQUAL(settings->zoomFactor, 2.5);
+	CHECK(settings->queryPresets.empty());
+	CHECK_EQUAL(settings->textHeightMax, ToolsSettings().textHeightMax);
+	CHECK_EQUAL(settings->highlightColor, ToolsSettings().highlightColor);
+
+	// Migrated files are written back in the current schema
+	CHECK(store.flush());
+	CHECK_EQUAL(store.getWriteCount(), 1u);
+	json j = readSettingsFile(path);
+	CHECK_EQUAL(j.value("version", 0), ToolsSettings::SCHEMA_VERSION);
+	CHECK_EQUAL(j["SketchText"].value("zoomFactor", 0.0), 2.5);
+	CHECK(j["SketchText"]["queryPresets"].is_array());
+}
+
+TEST_CASE(SettingsMigrateVersion1WithoutSection) {
+	std::string path = writeSettingsFile("settings-v1-empty.json", R"({ "SketchText": 5 })");
+	SettingsStore store(path, QUIET_PERIOD);
+	CHECK(store.load());
+	CHECK_EQUAL(store.getLoadedVersion(), 1);
+	CHECK_EQUAL(store.get()->zoomFactor, 1.0);
+	CHECK(store.flush());
+	CHECK(readSettingsFile(path)["SketchText"].is_object());
+}
+
+TEST_CASE(SettingsMigrateVersion2) {
+	std::string path = writeSettingsFile("settings-v2.json", R"({
+		"version": 2,
+		"SketchText": {
+			"zoomFactor": 1.5, "lastSketch": "Front", "allSketches": true, "textHeightMin": 0.1, "textHeightMax": 0.4,
+			"sortOrder": 2, "sortDescending": true, "tablePageSize": 50, "highlightColor": "#FF000080", "highlightWeight": "wide"
+		}
+	})");
+	SettingsStore store(path, QUIET_PERIOD);
+	CHECK(store.load());
+	CHECK_EQUAL(store.getLoadedVersion(), 2);
+
+	std::shared_ptr<const ToolsSettings> settings = store.get();
+	CHECK_EQUAL(settings->zoomFactor, 1.5);
+	CHECK_EQUAL(settings->lastSketchName, "Front");
+	CHECK(settings->isAllSketches);
+	CHECK_EQUAL(settings->textHeightMin, 0.1);
+	CHECK_EQUAL(settings->textHeightMax, 0.4);
+	CHECK_EQUAL(settings->sortOrder, 2);
+	CHECK(settings->isSortDescending);
+	CHECK_EQUAL(settings->tablePageSize, 50u);
+	CHECK_EQUAL(settings->highlightColor, 0xFF000080u);
+	// A value of the wrong type keeps the default
+	CHECK_EQUAL(settings->highlightWeight, ToolsSettings().highlightWeight);
+	CHECK(settings->queryPresets.empty());
+
+	CHECK(store.flush());
+	json j = readSettingsFile(path);
+	CHECK_EQUAL(j.value("version", 0), ToolsSettings::SCHEMA_VERSION);
+	CHECK_EQUAL(j["SketchText"].value("highlightColor", ""), "#FF000080");
+}
+
+TEST_CASE(SettingsKeepNewerVersion) {
+	std::string content = R"({ "version": 99, "SketchText": { "zoomFactor": 3.0 } })";
+	std::string path = writeSettingsFile("settings-v99.json", content);
+	{
+		SettingsStore store(path, QUIET_PERIOD);
+		CHECK(store.load());
+		CHECK_EQUAL(store.getLoadedVersion(), 99);
+		CHECK_EQUAL(store.get()->zoomFactor, 3.0);
+		store.update([](ToolsSettings& settings) { settings.zoomFactor = 4.0; });
+		CHECK_EQUAL(store.get()->zoomFactor, 4.0);
+		CHECK(store.flush());
+		CHECK_EQUAL(store.getWriteCount(), 0u);
+	}
+	CHECK_EQUAL(readSettingsFile(path).dump(), json::parse(content).dump());
+}
+
+TEST_CASE(SettingsRoundTrip) {
+	std::string path = getTempPath("settings-round-trip.json");
+	{
+		SettingsStore store(path, QUIET_PERIOD);
+		CHECK(!store.load());
+		std::shared_ptr<const ToolsSettings> before = store.get();
+		store.update([](ToolsSettings& settings) {
+			settings.queryPresets.push_back({ "Small", "height:<2" });
+			settings.queryPresets.push_back({ "", "dropped without a name" });
+			settings.highlightColor = 0x12345678;
+		});
+		// Readers keep the snapshot they hold
+		CHECK(before->queryPresets.empty());
+		CHECK_EQUAL(store.get()->queryPresets.size(), 2u);
+		CHECK(store.flush());
+		CHECK(store.flush());
+		CHECK_EQUAL(store.getWriteCount(), 1u);
+	}
+
+	SettingsStore store(path, QUIET_PERIOD);
+	CHECK(store.load());
+	CHECK_EQUAL(store.getLoadedVersion(), ToolsSettings::SCHEMA_VERSION);
+	std::shared_ptr<const ToolsSettings> settings = store.get();
+	CHECK_EQUAL(settings->queryPresets.size(), 1u);
+	if (!settings->queryPresets.empty()) {
+		CHECK_EQUAL(settings->queryPresets[0].name, "Small");
+		CHECK_EQUAL(settings->queryPresets[0].query, "height:<2");
+	}
+	CHECK_EQUAL(settings->highlightColor, 0x12345678u);
+	// Nothing changed, nothing to write
+	CHECK(store.flush());
+	CHECK_EQUAL(store.getWriteCount(), 0u);
+}
+
+TEST_CASE(SettingsReadersSeeUpdates) {
+	SettingsStore store(getTempPath("settings-readers.json"), QUIET_PERIOD);
+	CHECK_EQUAL(store.get()->zoomFactor, 1.0);
+	store.update([](ToolsSettings& settings) {
+		settings.zoomFactor = 2.0;
+		settings.tablePageSize = 2;
+	});
+	// The thread refreshes its cached snapshot after its own change
+	CHECK_EQUAL(store.get()->zoomFactor, 2.0);
+
+	constexpr int UPDATE_COUNT = 2000;
+	constexpr int READER_COUNT = 4;
+	std::atomic<bool> isOrdered = true;
+	std::atomic<int> startedCount = 0;
+	std::vector<std::thread> readers;
+	for (int i = 0; i < READER_COUNT; ++i) {
+		readers.emplace_back([&store, &isOrdered, &startedCount]() {
+			++startedCount;
+			double last = 0.0;
+			while (last < UPDATE_COUNT) {
+				std::shared_ptr<const ToolsSettings> settings = store.get();
+				// Snapshots are whole and never go back
+				if (settings->zoomFactor < last || settings->tablePageSize != (unsigned int)settings->zoomFactor) {
+					isOrdered = false;
+					return;
+				}
+				last = settings->zoomFactor;
+			}
+		});
+	}
+	while (startedCount < READER_COUNT) {
+		std::this_thread::yield();
+	}
+	for (int i = 3; i <= UPDATE_COUNT; ++i) {
+		store.update([i](ToolsSettings& settings) {
+			settings.zoomFactor = (double)i;
+			settings.tablePageSize = (unsigned int)i;
+		});
+	}
+	for (std::thread& reader : readers) {
+		reader.join();
+	}
+	CHECK(isOrdered.load());
+}
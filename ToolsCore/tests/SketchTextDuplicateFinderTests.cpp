@@ -0,0 +1,141 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextDuplicateFinder.h"
+#include "TestHarness.h"
+
+#include <random>
+
+using namespace implicatex::fusion;
+
+namespace {
+	constexpr double HEIGHT_STEP = 0.001;
+	constexpr double POSITION_STEP = 0.01;
+
+	SketchTextRecord makeRecord(const std::string& text, double height, double x, double y) {
+		return SketchTextRecord{ text, height, Box3::of(Point3{ x, y, 0.0 }, Point3{ x + 1.0, y + height, 0.0 }), 0 };
+	}
+
+	std::vector<uint32_t> getGroup(const SketchTextDuplicateFinder& finder, uint32_t id) {
+		std::vector<uint32_t> ids;
+		finder.group(finder.groupOf(id), ids);
+		return ids;
+	}
+
+	/// <summary>Groups the records by comparing every pair, closing the groups over chains.</summary>
+	std::vector<std::vector<uint32_t>> getBruteForceGroups(const std::vector<SketchTextRecord>& records) {
+		std::vector<uint32_t> groupOf(records.size());
+		std::iota(groupOf.begin(), groupOf.end(), 0);
+		for (uint32_t a = 0; a < (uint32_t)records.size(); ++a) {
+			for (uint32_t b = a + 1; b < (uint32_t)records.size(); ++b) {
+				Point3 centerA = records[a].bounds.center();
+				Point3 centerB = records[b].bounds.center();
+				bool isNear = records[a].bounds.isValid() && records[b].bounds.isValid()
+					&& SketchTextDuplicateFinder::normalize(records[a].text) == SketchTextDuplicateFinder::normalize(records[b].text)
+					&& std::abs(records[a].height - records[b].height) <= HEIGHT_STEP
+					&& std::abs(centerA.x - centerB.x) <= POSITION_STEP
+					&& std::abs(centerA.y - centerB.y) <= POSITION_STEP
+					&& std::abs(centerA.z - centerB.z) <= POSITION_STEP;
+				if (isNear && groupOf[a] != groupOf[b]) {
+					uint32_t from = (std::max)(groupOf[a], groupOf[b]);
+					uint32_t to = (std::min)(groupOf[a], groupOf[b]);
+					std::replace(groupOf.begin(), groupOf.end(), from, to);
+				}
+			}
+		}
+		std::map<uint32_t, std::vector<uint32_t>> members;
+		for (uint32_t id = 0; id < (uint32_t)records.size(); ++id) {
+			members[groupOf[id]].push_back(id);
+		}
+		std::vector<std::vector<uint32_t>> groups;
+		for (auto& [first, ids] : members) {
+			if (ids.size() > 1) {
+				groups.push_back(std::move(ids));
+			}
+		}
+		return groups;
+	}
+}
+
+TEST_CASE(DuplicateFinderGroupsSameLabels) {
+	std::vector<SketchTextRecord> records = {
+		makeRecord("M6", 0.25, 1.0, 1.0),			// 0
+		makeRecord("Bore", 0.25, 5.0, 1.0),			// 1
+		makeRecord(" m6 ", 0.25, 1.0, 1.0),			// 2, differs only in case and spacing
+		makeRecord("M6", 0.35, 1.0, 1.0),			// 3, other height
+		makeRecord("M6", 0.25, 3.0, 1.0),			// 4, other place
+		makeRecord("Bore", 0.25, 5.0, 1.0),			// 5
+		makeRecord("M6", 0.25, 1.0, 1.0),			// 6
+		SketchTextRecord{ "Bore", 0.25, Box3(), 0 }	// 7, without bounds
+	};
+	SketchTextDuplicateFinder finder;
+	finder.build(records, HEIGHT_STEP, POSITION_STEP);
+
+	CHECK_EQUAL(finder.groupCount(), 2u);
+	CHECK((getGroup(finder, 0) == std::vector<uint32_t>{ 0, 2, 6 }));
+	CHECK((getGroup(finder, 5) == std::vector<uint32_t>{ 1, 5 }));
+	// Groups are numbered in order of their first record
+	CHECK_EQUAL(finder.groupOf(0), 0u);
+	CHECK_EQUAL(finder.groupOf(1), 1u);
+	for (uint32_t id : { 3u, 4u, 7u, 100u }) {
+		CHECK_EQUAL(finder.groupOf(id), SketchTextDuplicateFinder::NO_GROUP);
+	}
+
+	CHECK_EQUAL(SketchTextDuplicateFinder::normalize("  Hole \t A\n"), "hole a");
+
+	finder.build(records, 0.0, POSITION_STEP);
+	CHECK(finder.empty());
+}
+
+TEST_CASE(DuplicateFinderGroupsAcrossCells) {
+	// Pairs a hair apart on either side of a cell boundary of the height, x and y steps
+	std::vector<SketchTextRecord> records = {
+		makeRecord("X", 0.25, 0.0149 - 0.5, 2.0),		// 0, center x 0.0149
+		makeRecord("X", 0.25, 0.0151 - 0.5, 2.0),		// 1, center x 0.0151
+		makeRecord("H", 0.2504, 4.0, 4.0),				// 2
+		makeRecord("H", 0.2506, 4.0, 4.0),				// 3
+		makeRecord("D", 0.25, 0.0249 - 0.5, 6.0249),	// 4, diagonal across x and y
+		makeRecord("D", 0.25, 0.0251 - 0.5, 6.0251),	// 5
+		makeRecord("F", 0.25, 8.0, 8.0),				// 6, more than a step apart
+		makeRecord("F", 0.25, 8.0 + 0.011, 8.0),		// 7
+		makeRecord("C", 0.25, 10.0, 10.0),				// 8, a chain of near duplicates
+		makeRecord("C", 0.25, 10.008, 10.0),			// 9
+		makeRecord("C", 0.25, 10.016, 10.0)				// 10
+	};
+	// The bounds center is half the width of 1 to the right
+	SketchTextDuplicateFinder finder;
+	finder.build(records, HEIGHT_STEP, POSITION_STEP);
+
+	CHECK((getGroup(finder, 0) == std::vector<uint32_t>{ 0, 1 }));
+	CHECK((getGroup(finder, 2) == std::vector<uint32_t>{ 2, 3 }));
+	CHECK((getGroup(finder, 4) == std::vector<uint32_t>{ 4, 5 }));
+	CHECK_EQUAL(finder.groupOf(6), SketchTextDuplicateFinder::NO_GROUP);
+	CHECK_EQUAL(finder.groupOf(7), SketchTextDuplicateFinder::NO_GROUP);
+	CHECK((getGroup(finder, 10) == std::vector<uint32_t>{ 8, 9, 10 }));
+	CHECK_EQUAL(finder.groupCount(), 4u);
+}
+
+TEST_CASE(DuplicateFinderMatchesBruteForce) {
+	std::mt19937 random(5);
+	std::uniform_real_distribution<double> offset(-0.02, 0.02);
+	std::uniform_real_distribution<double> heightOffset(-0.002, 0.002);
+	std::vector<SketchTextRecord> records;
+	for (size_t i = 0; i < 600; ++i) {
+		// Few labels at few places, scattered by about a step, so that many records straddle the cell boundaries
+		std::string text = std::string(1, (char)('A' + random() % 3));
+		double x = (double)(random() % 4) + offset(random);
+		double y = (double)(random() % 4) + offset(random);
+		records.push_back(makeRecord(i % 7 == 0 ? " " + text : text, 0.25 + heightOffset(random), x, y));
+	}
+	records.push_back(SketchTextRecord{ "A", 0.25, Box3(), 0 });
+
+	SketchTextDuplicateFinder finder;
+	finder.build(records, HEIGHT_STEP, POSITION_STEP);
+	std::vector<std::vector<uint32_t>> expected = getBruteForceGroups(records);
+
+	CHECK_EQUAL(finder.groupCount(), expected.size());
+	for (uint32_t groupIndex = 0; groupIndex < (uint32_t)(std::min)(finder.groupCount(), expected.size()); ++groupIndex) {
+		std::vector<uint32_t> ids;
+		finder.group(groupIndex, ids);
+		CHECK(ids == expected[groupIndex]);
+	}
+}
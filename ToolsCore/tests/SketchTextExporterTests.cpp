@@ -0,0 +1,67 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextExporter.h"
+#include "TestHarness.h"
+
+using namespace implicatex::fusion;
+using implicatex::fusion::tests::getTempPath;
+
+namespace {
+	std::string readFile(const std::string& path) {
+		std::ifstream file(path, std::ios::in | std::ios::binary);
+		std::ostringstream content;
+		content << file.rdbuf();
+		return content.str();
+	}
+
+	SketchTextRecord makeRecord(const std::string& text, bool hasBounds) {
+		SketchTextRecord record;
+		record.text = text;
+		record.height = 0.25;
+		if (hasBounds) {
+			record.bounds = Box3::of(Point3{ 1.0, 2.0, 0.0 }, Point3{ 1.5, 2.25, 0.0 });
+		}
+		return record;
+	}
+}
+
+TEST_CASE(ExporterEscapesCsv) {
+	std::string path = getTempPath("texts.csv");
+	SketchTextExporter exporter;
+	CHECK(exporter.open(path, SketchTextExporter::formatFromPath(path)));
+	CHECK(exporter.write(makeRecord("plain", true), "Sketch1", "token:1"));
+	CHECK(exporter.write(makeRecord("a,b \"c\"\r\nd", false), "Sketch, 2", "token:2"));
+	CHECK_EQUAL(exporter.getRowCount(), 2u);
+	CHECK(exporter.close());
+
+	CHECK_EQUAL(readFile(path),
+		"\xEF\xBB\xBF" "sketch,text,height_mm,min_x_mm,min_y_mm,min_z_mm,max_x_mm,max_y_mm,max_z_mm,entity_token\r\n"
+		"Sketch1,plain,2.5,10,20,0,15,22.5,0,token:1\r\n"
+		"\"Sketch, 2\",\"a,b \"\"c\"\"\r\nd\",2.5,,,,,,,token:2\r\n");
+}
+
+TEST_CASE(ExporterEscapesJson) {
+	std::string path = getTempPath("texts.jsonl");
+	SketchTextExporter exporter;
+	CHECK(exporter.open(path, SketchTextExporter::formatFromPath(path)));
+	CHECK(exporter.write(makeRecord("say \"hi\"\\\t\n\x01 \xC3\xA4", true), "Sketch1", "token:1"));
+	CHECK(exporter.write(makeRecord("", false), "Sketch2", "token:2"));
+	CHECK(exporter.close());
+
+	CHECK_EQUAL(readFile(path),
+		"{\"sketch\":\"Sketch1\",\"text\":\"say \\\"hi\\\"\\\\\\t\\n\\u0001 \xC3\xA4\",\"height_mm\":2.5,"
+		"\"min_x_mm\":10,\"min_y_mm\":20,\"min_z_mm\":0,\"max_x_mm\":15,\"max_y_mm\":22.5,\"max_z_mm\":0,\"entity_token\":\"token:1\"}\n"
+		"{\"sketch\":\"Sketch2\",\"text\":\"\",\"height_mm\":2.5,"
+		"\"min_x_mm\":null,\"min_y_mm\":null,\"min_z_mm\":null,\"max_x_mm\":null,\"max_y_mm\":null,\"max_z_mm\":null,\"entity_token\":\"token:2\"}\n");
+}
+
+TEST_CASE(ExporterFormatFromPath) {
+	CHECK(SketchTextExporter::formatFromPath("a/b.JSONL") == SketchTextExportFormat::JsonLines);
+	CHECK(SketchTextExporter::formatFromPath("b.json") == SketchTextExportFormat::JsonLines);
+	CHECK(SketchTextExporter::formatFromPath("b.csv") == SketchTextExportFormat::Csv);
+	CHECK(SketchTextExporter::formatFromPath("dir.json/b") == SketchTextExportFormat::Csv);
+
+	SketchTextExporter exporter;
+	CHECK(!exporter.write(makeRecord("closed", true), "Sketch1", "token"));
+	CHECK(!exporter.close());
+}
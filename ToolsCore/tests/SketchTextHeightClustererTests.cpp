@@ -0,0 +1,122 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextHeightClusterer.h"
+#include "TestHarness.h"
+
+#include <random>
+
+using namespace implicatex::fusion;
+
+namespace {
+	std::vector<SketchTextRecord> makeRecords(const std::vector<double>& heights) {
+		std::vector<SketchTextRecord> records;
+		for (double height : heights) {
+			SketchTextRecord record;
+			record.height = height;
+			records.push_back(record);
+		}
+		return records;
+	}
+
+	/// <summary>The squared deviation of the heights in [minHeight, maxHeight] from their mean.</summary>
+	double getCost(const std::vector<double>& heights, double minHeight, double maxHeight) {
+		double sum = 0.0;
+		size_t count = 0;
+		for (double height : heights) {
+			if (height >= minHeight - 1e-9 && height <= maxHeight + 1e-9) {
+				sum += height;
+				++count;
+			}
+		}
+		double mean = sum / (double)count;
+		double cost = 0.0;
+		for (double height : heights) {
+			if (height >= minHeight - 1e-9 && height <= maxHeight + 1e-9) {
+				cost += (height - mean) * (height - mean);
+			}
+		}
+		return cost;
+	}
+
+	/// <summary>The least cost of all partitions of the sorted distinct heights into clusterCount runs.</summary>
+	double getBruteForceCost(const std::vector<double>& heights, size_t clusterCount) {
+		std::vector<double> distinct = heights;
+		std::sort(distinct.begin(), distinct.end());
+		distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+		size_t splitCount = clusterCount - 1;
+		double bestCost = std::numeric_limits<double>::infinity();
+		// Every subset of the gaps between distinct heights with splitCount members
+		for (uint32_t mask = 0; mask < (1u << (distinct.size() - 1)); ++mask) {
+			if ((size_t)std::popcount(mask) != splitCount) continue;
+			double cost = 0.0;
+			size_t first = 0;
+			for (size_t i = 0; i < distinct.size(); ++i) {
+				if (i + 1 == distinct.size() || (mask & (1u << i))) {
+					cost += getCost(heights, distinct[first], distinct[i]);
+					first = i + 1;
+				}
+			}
+			bestCost = (std::min)(bestCost, cost);
+		}
+		return bestCost;
+	}
+}
+
+TEST_CASE(ClustererPartitionMatchesBruteForce) {
+	std::mt19937 random(3);
+	for (size_t round = 0; round < 40; ++round) {
+		std::vector<double> heights;
+		size_t heightCount = 2 + random() % 10;
+		for (size_t i = 0; i < heightCount; ++i) {
+			// Whole tenths of a millimeter, so that the clusterer keeps the heights exactly
+			heights.push_back((double)(10 + random() % 40) * 0.01);
+		}
+		SketchTextHeightClusterer clusterer;
+		clusterer.build(makeRecords(heights));
+		CHECK_EQUAL(clusterer.getTextCount(), heights.size());
+
+		for (size_t clusterCount = 1; clusterCount <= clusterer.getHeightCount(); ++clusterCount) {
+			std::vector<HeightCluster> clusters;
+			clusterer.partition(clusterCount, clusters);
+			CHECK_EQUAL(clusters.size(), clusterCount);
+
+			double cost = 0.0;
+			size_t textCount = 0;
+			for (size_t i = 0; i < clusters.size(); ++i) {
+				cost += getCost(heights, clusters[i].minHeight, clusters[i].maxHeight);
+				textCount += clusters[i].textCount;
+				CHECK(i == 0 || clusters[i - 1].maxHeight < clusters[i].minHeight);
+			}
+			CHECK_EQUAL(textCount, heights.size());
+			CHECK_NEAR(cost, getBruteForceCost(heights, clusterCount), 1e-9);
+		}
+	}
+}
+
+TEST_CASE(ClustererSuggestsRoundSizes) {
+	// Three sizes drawn a little off 2, 3.5 and 5 mm
+	std::vector<double> heights = { 0.2, 0.2, 0.1995, 0.2004, 0.35, 0.3502, 0.3497, 0.5, 0.5003 };
+	SketchTextHeightClusterer clusterer;
+	clusterer.build(makeRecords(heights));
+
+	std::vector<HeightCluster> clusters;
+	CHECK(clusterer.suggest(0.005, SketchTextHeightClusterer::MAX_CLUSTERS, clusters));
+	CHECK_EQUAL(clusters.size(), 3u);
+	if (clusters.size() == 3) {
+		CHECK_NEAR(clusters[0].standardHeight, 0.2, 1e-12);
+		CHECK_NEAR(clusters[1].standardHeight, 0.35, 1e-12);
+		CHECK_NEAR(clusters[2].standardHeight, 0.5, 1e-12);
+		CHECK_EQUAL(clusters[0].textCount, 4u);
+		CHECK_EQUAL(clusters[0].heightCount, 3u);
+	}
+	for (const HeightCluster& cluster : clusters) {
+		CHECK(cluster.getDeviation() <= 0.005 + SketchTextHeightClusterer::HEIGHT_STEP / 2.0);
+	}
+
+	// Too few clusters for the tolerance
+	CHECK(!clusterer.suggest(0.005, 2, clusters));
+
+	clusterer.clear();
+	CHECK(clusterer.suggest(0.005, 4, clusters));
+	CHECK(clusters.empty());
+}
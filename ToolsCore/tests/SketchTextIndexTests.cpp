@@ -0,0 +1,144 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextSorter.h"
+#include "TestHarness.h"
+
+#include <random>
+
+using namespace implicatex::fusion;
+
+namespace {
+	std::vector<SketchTextRecord> makeRecords() {
+		static const char* const texts[] = {
+			"T-1", "t-10", "Bracket", "BRACKET LEFT", "Ma\xC3\x9F" "stab", "MASSSTAB", "ab", "", "a", "xT-1x", "Stra\xC3\x9F" "e"
+		};
+		std::vector<SketchTextRecord> records;
+		std::mt19937 random(11);
+		for (size_t i = 0; i < 120; ++i) {
+			SketchTextRecord record;
+			record.text = texts[i % std::size(texts)];
+			record.height = 0.05 * (double)(random() % 20);
+			double x = (double)(random() % 50) - 10.0;
+			double y = (double)(random() % 30);
+			record.bounds = Box3::of(Point3{ x, y, 0.0 }, Point3{ x + 2.0, y + record.height, 0.0 });
+			record.sketchIndex = (unsigned int)(i % 3);
+			records.push_back(record);
+		}
+		return records;
+	}
+
+	std::vector<uint32_t> scan(const std::vector<SketchTextRecord>& records, const std::string& query, bool prefixOnly) {
+		std::string pattern = SketchTextTrigramIndex::fold(query);
+		std::vector<uint32_t> ids;
+		for (uint32_t id = 0; id < (uint32_t)records.size(); ++id) {
+			std::string folded = SketchTextTrigramIndex::fold(records[id].text);
+			if (prefixOnly ? folded.starts_with(pattern) : folded.find(pattern) != std::string::npos) {
+				ids.push_back(id);
+			}
+		}
+		return ids;
+	}
+}
+
+TEST_CASE(TrigramFoldsCase) {
+	CHECK_EQUAL(SketchTextTrigramIndex::fold("BRACKET Left"), "bracket left");
+	// Full case folding maps the sharp s to "ss"
+	CHECK_EQUAL(SketchTextTrigramIndex::fold("Ma\xC3\x9F" "stab"), SketchTextTrigramIndex::fold("MASSSTAB"));
+}
+
+TEST_CASE(TrigramFindMatchesScan) {
+	std::vector<SketchTextRecord> records = makeRecords();
+	SketchTextTrigramIndex index;
+	index.build(records);
+	CHECK_EQUAL(index.size(), records.size());
+
+	const char* queries[] = { "t-1", "T-10", "bracket", "cket l", "massstab", "Ma\xC3\x9F", "a", "ab", "b", "x", "zzz", "" };
+	for (const char* query : queries) {
+		for (bool prefixOnly : { false, true }) {
+			std::vector<uint32_t> ids;
+			index.find(query, prefixOnly, ids);
+			std::vector<uint32_t> expected = scan(records, query, prefixOnly);
+			if (ids != expected) {
+				::implicatex::fusion::tests::fail(__FILE__, __LINE__, std::string("find '") + query + (prefixOnly ? "' as prefix" : "'")
+					+ " returned " + std::to_string(ids.size()) + " ids, a scan " + std::to_string(expected.size()));
+			}
+			CHECK(index.estimate(query, prefixOnly) >= expected.size());
+		}
+	}
+
+	index.clear();
+	CHECK(index.empty());
+}
+
+TEST_CASE(RangeIndexMatchesScan) {
+	std::vector<SketchTextRecord> records = makeRecords();
+	SketchTextRangeIndex index;
+	CHECK_EQUAL(index.getGeneration(), 0u);
+	index.build(records);
+	uint64_t generation = index.getGeneration();
+	CHECK(generation != 0);
+	index.build(records);
+	CHECK(index.getGeneration() > generation);
+
+	const std::pair<double, double> heightRanges[] = { { 0.2, 0.3 }, { 0.0, 0.0 }, { -1.0, 10.0 }, { 0.31, 0.34 }, { 0.5, 0.4 } };
+	for (auto [minHeight, maxHeight] : heightRanges) {
+		std::vector<uint32_t> expected;
+		for (uint32_t id = 0; id < (uint32_t)records.size(); ++id) {
+			if (records[id].height >= minHeight && records[id].height <= maxHeight) {
+				expected.push_back(id);
+			}
+		}
+		std::vector<uint32_t> ids;
+		index.findHeight(minHeight, maxHeight, ids);
+		CHECK(ids == expected);
+		CHECK_EQUAL(index.countHeight(minHeight, maxHeight), expected.size());
+	}
+
+	const std::pair<double, double> leftRanges[] = { { 0.0, 5.0 }, { -10.0, -10.0 }, { 39.5, 100.0 }, { 3.0, 2.0 } };
+	for (auto [minX, maxX] : leftRanges) {
+		std::vector<uint32_t> expected;
+		for (uint32_t id = 0; id < (uint32_t)records.size(); ++id) {
+			if (records[id].bounds.minPoint.x >= minX && records[id].bounds.minPoint.x <= maxX) {
+				expected.push_back(id);
+			}
+		}
+		std::vector<uint32_t> ids;
+		index.findLeft(minX, maxX, ids);
+		CHECK(ids == expected);
+		CHECK_EQUAL(index.countLeft(minX, maxX), expected.size());
+	}
+}
+
+TEST_CASE(SorterOrdersColumns) {
+	std::vector<SketchTextRecord> records = {
+		{ "b", 0.3, Box3::of(Point3{ 0.0, 0.0, 0.0 }, Point3{ 1.0, 0.3, 0.0 }), 0 },
+		{ "A10", 0.2, Box3::of(Point3{ 5.0, 2.0, 0.0 }, Point3{ 6.0, 2.2, 0.0 }), 0 },
+		{ "a2", 0.3, Box3::of(Point3{ 1.0, 2.0, 0.0 }, Point3{ 2.0, 2.2, 0.0 }), 0 },
+		{ "\xC3\xA4", 0.1, Box3::of(Point3{ 3.0, 0.0, 0.0 }, Point3{ 4.0, 0.3, 0.0 }), 0 }
+	};
+	SketchTextSorter sorter;
+	auto sorted = [&](SketchTextSortOrder order, bool descending) {
+		std::vector<uint32_t> ids = { 0, 1, 2, 3 };
+		sorter.sort(records, "en-US", order, descending, ids);
+		return ids;
+	};
+
+	CHECK((sorted(SketchTextSortOrder::Collection, false) == std::vector<uint32_t>{ 0, 1, 2, 3 }));
+	CHECK((sorted(SketchTextSortOrder::Collection, true) == std::vector<uint32_t>{ 3, 2, 1, 0 }));
+	// The collator sorts the umlaut with its base letter, ignores case and compares digits as text
+	CHECK((sorted(SketchTextSortOrder::Text, false) == std::vector<uint32_t>{ 3, 1, 2, 0 }));
+	CHECK((sorted(SketchTextSortOrder::Text, true) == std::vector<uint32_t>{ 0, 2, 1, 3 }));
+	// Ties keep the collection order in both directions
+	CHECK((sorted(SketchTextSortOrder::Height, false) == std::vector<uint32_t>{ 3, 1, 0, 2 }));
+	CHECK((sorted(SketchTextSortOrder::Height, true) == std::vector<uint32_t>{ 0, 2, 1, 3 }));
+	// Top to bottom, then left to right
+	CHECK((sorted(SketchTextSortOrder::Position, false) == std::vector<uint32_t>{ 2, 1, 0, 3 }));
+
+	// The second text sort reuses the collation keys of the first
+	CHECK_EQUAL(sorter.getCachedKeyCount(), 4u);
+	CHECK(sorter.getKeyHitCount() >= 4u);
+	sorter.reset(records.size());
+	CHECK_EQUAL(sorter.getCachedKeyCount(), 0u);
+}
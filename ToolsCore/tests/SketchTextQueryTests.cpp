@@ -0,0 +1,177 @@
+#include "CorePch.h"
+#include "SketchTextRecord.h"
+#include "SketchTextPredicate.h"
+#include "SketchTextTrigramIndex.h"
+#include "SketchTextRangeIndex.h"
+#include "SketchTextQuery.h"
+#include "TestHarness.h"
+
+#include <random>
+
+using namespace implicatex::fusion;
+
+namespace {
+	constexpr double INFINITE_HEIGHT = std::numeric_limits<double>::infinity();
+
+	SketchTextQuery parseValid(std::string_view text) {
+		SketchTextQuery query;
+		std::string error;
+		if (!SketchTextQuery::parse(text, query, error)) {
+			::implicatex::fusion::tests::fail(__FILE__, __LINE__, "'" + std::string(text) + "' is invalid: " + error);
+		}
+		return query;
+	}
+
+	std::string parseError(std::string_view text) {
+		SketchTextQuery query;
+		std::string error;
+		bool isValid = SketchTextQuery::parse(text, query, error);
+		return isValid ? "valid" : error;
+	}
+
+	SketchTextRecord makeRecord(const std::string& text, double height, double x, double y, unsigned int sketchIndex) {
+		return SketchTextRecord{ text, height, Box3::of(Point3{ x, y, 0.0 }, Point3{ x + 1.0, y + height, 0.0 }), sketchIndex };
+	}
+}
+
+TEST_CASE(QueryParseHeightRange) {
+	SketchTextQuery query = parseValid("height:2..3mm");
+	CHECK(query.hasHeight);
+	CHECK_NEAR(query.minHeight, 0.2, 1e-12);
+	CHECK_NEAR(query.maxHeight, 0.3, 1e-12);
+
+	// Millimeters without a unit, a unit only at the upper end applies to both
+	query = parseValid("height:2..3");
+	CHECK_NEAR(query.minHeight, 0.2, 1e-12);
+	CHECK_NEAR(query.maxHeight, 0.3, 1e-12);
+	query = parseValid("height:1..2cm");
+	CHECK_NEAR(query.minHeight, 1.0, 1e-12);
+	CHECK_NEAR(query.maxHeight, 2.0, 1e-12);
+	query = parseValid("height:..0.5in");
+	CHECK_EQUAL(query.minHeight, -INFINITE_HEIGHT);
+	CHECK_NEAR(query.maxHeight, 1.27, 1e-12);
+
+	// A single height allows the epsilon, several heights narrow the range
+	query = parseValid("height:2.5");
+	CHECK_NEAR(query.minHeight, 0.25 - SketchTextQuery::HEIGHT_EPSILON, 1e-12);
+	CHECK_NEAR(query.maxHeight, 0.25 + SketchTextQuery::HEIGHT_EPSILON, 1e-12);
+	query = parseValid("height:1..4 height:2..5");
+	CHECK_NEAR(query.minHeight, 0.2, 1e-12);
+	CHECK_NEAR(query.maxHeight, 0.4, 1e-12);
+}
+
+TEST_CASE(QueryParseHeightComparison) {
+	SketchTextQuery query = parseValid("height:>2");
+	CHECK(query.minHeight > 0.2);
+	CHECK_EQUAL(query.minHeight, std::nextafter(0.2, INFINITE_HEIGHT));
+	CHECK_EQUAL(query.maxHeight, INFINITE_HEIGHT);
+
+	query = parseValid("height:>=2mm");
+	CHECK_EQUAL(query.minHeight, 0.2);
+	query = parseValid("height:<3");
+	CHECK_EQUAL(query.minHeight, -INFINITE_HEIGHT);
+	CHECK(query.maxHeight < 0.3);
+	query = parseValid("height:<=3");
+	CHECK_EQUAL(query.maxHeight, 0.3);
+}
+
+TEST_CASE(QueryParseTerms) {
+	SketchTextQuery query = parseValid("T-1 text:\"A B\" text~\"^T-\\d+$\" sketch:\"Sketch 1*\" in:0,0,50,50mm");
+	CHECK_EQUAL(query.contents.size(), 2u);
+	CHECK_EQUAL(query.contents[0], "T-1");
+	CHECK_EQUAL(query.contents[1], "A B");
+	CHECK_EQUAL(query.patterns.size(), 1u);
+	CHECK_EQUAL(query.expressions.size(), 1u);
+	CHECK_EQUAL(query.sketchPatterns.size(), 1u);
+	CHECK_EQUAL(query.sketchPatterns[0], "Sketch 1*");
+	CHECK(query.hasRegion);
+	CHECK_NEAR(query.region.maxPoint.x, 5.0, 1e-12);
+	CHECK(!query.hasHeight);
+
+	// An escaped quote is part of the value, a colon without a field name is plain content
+	query = parseValid("\"say \\\"hi\\\"\" 12:30");
+	CHECK_EQUAL(query.contents.size(), 2u);
+	CHECK_EQUAL(query.contents[0], "say \"hi\"");
+	CHECK_EQUAL(query.contents[1], "12:30");
+
+	CHECK(parseValid("  ").empty());
+}
+
+TEST_CASE(QueryParseErrors) {
+	CHECK_EQUAL(parseError("height:2ft"), "Invalid height '2ft'");
+	CHECK_EQUAL(parseError("height:abc"), "Invalid height 'abc'");
+	CHECK_EQUAL(parseError("height:.."), "Invalid height '..'");
+	CHECK_EQUAL(parseError("text:\"open"), "Missing closing quote");
+	CHECK_EQUAL(parseError("\"open"), "Missing closing quote");
+	CHECK_EQUAL(parseError("height:"), "Missing value of 'height:'");
+	CHECK_EQUAL(parseError("text~\"(\""), "Invalid expression '('");
+	CHECK_EQUAL(parseError("sketch~A"), "'sketch' does not take an expression");
+	CHECK_EQUAL(parseError("color:red"), "Unknown field 'color'");
+	CHECK_EQUAL(parseError("in:0,0,50"), "Invalid region '0,0,50', expected x1,y1,x2,y2");
+	CHECK_EQUAL(parseError("in:0,0,50,50,60"), "Invalid region '0,0,50,50,60', expected x1,y1,x2,y2");
+}
+
+TEST_CASE(QueryMatchWildcard) {
+	CHECK(SketchTextQueryPlanner::matchWildcard("Sketch*", "Sketch12"));
+	CHECK(SketchTextQueryPlanner::matchWildcard("sketch*", "SKETCH"));
+	CHECK(SketchTextQueryPlanner::matchWildcard("Sketch?", "Sketch1"));
+	CHECK(!SketchTextQueryPlanner::matchWildcard("Sketch?", "Sketch12"));
+	CHECK(!SketchTextQueryPlanner::matchWildcard("Sketch?", "Sketch"));
+	CHECK(SketchTextQueryPlanner::matchWildcard("*", ""));
+	CHECK(SketchTextQueryPlanner::matchWildcard("", ""));
+	CHECK(!SketchTextQueryPlanner::matchWildcard("", "a"));
+	CHECK(SketchTextQueryPlanner::matchWildcard("*1*2*", "a1b2c"));
+	CHECK(!SketchTextQueryPlanner::matchWildcard("*1*2", "a1b2c"));
+	CHECK(SketchTextQueryPlanner::matchWildcard("a*b*c", "abbbc"));
+	CHECK(!SketchTextQueryPlanner::matchWildcard("Front", "Front view"));
+}
+
+TEST_CASE(QueryPlannerMatchesScan) {
+	std::vector<SketchTextRecord> records;
+	std::vector<std::string> sketchNames = { "Front", "Side", "Top 1", "Top 2" };
+	std::mt19937 random(7);
+	for (uint32_t i = 0; i < 400; ++i) {
+		std::string text = (i % 3 == 0 ? "T-" : "Label ") + std::to_string(i % 37);
+		records.push_back(makeRecord(text, 0.1 + 0.05 * (double)(random() % 10), (double)(random() % 20), (double)(random() % 20), i % 4));
+	}
+	SketchTextTrigramIndex textIndex;
+	textIndex.build(records);
+	SketchTextRangeIndex rangeIndex;
+	rangeIndex.build(records);
+
+	const char* queries[] = {
+		"height:2..3mm", "t-1", "label 2 height:>3", "sketch:Top*", "in:0,0,50,50mm", "text~\"^T-1\\d$\" in:20,20,200,200mm",
+		"sketch:front height:<=2", "T- label", "xyz"
+	};
+	for (const char* text : queries) {
+		SketchTextQuery query = parseValid(text);
+		SketchTextQueryPlan plan = SketchTextQueryPlanner::plan(query, textIndex, rangeIndex);
+		std::vector<uint32_t> ids;
+		SketchTextQueryPlanner::execute(query, plan, records, sketchNames, textIndex, rangeIndex, ids);
+
+		std::vector<uint32_t> expected;
+		for (uint32_t id = 0; id < (uint32_t)records.size(); ++id) {
+			const SketchTextRecord& record = records[id];
+			std::string folded = SketchTextTrigramIndex::fold(record.text);
+			bool isMatch = (!query.hasHeight || HeightInRange{ query.minHeight, query.maxHeight }(id, record))
+				&& (!query.hasRegion || BoundsWithin{ query.region }(id, record));
+			for (const std::string& content : query.contents) {
+				isMatch = isMatch && folded.find(SketchTextTrigramIndex::fold(content)) != std::string::npos;
+			}
+			for (const std::regex& expression : query.expressions) {
+				isMatch = isMatch && std::regex_search(record.text, expression);
+			}
+			for (const std::string& pattern : query.sketchPatterns) {
+				isMatch = isMatch && SketchTextQueryPlanner::matchWildcard(pattern, sketchNames[record.sketchIndex]);
+			}
+			if (isMatch) {
+				expected.push_back(id);
+			}
+		}
+		if (ids != expected) {
+			::implicatex::fusion::tests::fail(__FILE__, __LINE__, std::string("'") + text + "' (" + plan.describe(query) + ") returned "
+				+ std::to_string(ids.size()) + " ids, a scan " + std::to_string(expected.size()));
+		}
+		CHECK(plan.estimatedRows >= expected.size());
+	}
+}
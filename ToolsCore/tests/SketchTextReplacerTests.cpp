@@ -0,0 +1,52 @@
+#include "CorePch.h"
+#include "SketchTextReplacer.h"
+#include "TestHarness.h"
+
+using namespace implicatex::fusion;
+
+TEST_CASE(ReplacerReplacesLiterals) {
+	CHECK_EQUAL(SketchTextReplacer::replaceLiteral("T-1 T-2", "T-", "R-"), "R-1 R-2");
+	CHECK_EQUAL(SketchTextReplacer::replaceLiteral("aaa", "aa", "b"), "ba");
+	CHECK_EQUAL(SketchTextReplacer::replaceLiteral("abc", "x", "y"), "abc");
+	CHECK_EQUAL(SketchTextReplacer::replaceLiteral("abc", "b", ""), "ac");
+	CHECK_EQUAL(SketchTextReplacer::replaceLiteral("a.b", ".", "\\"), "a\\b");
+	CHECK_EQUAL(SketchTextReplacer::replaceLiteral("", "a", "b"), "");
+	// The replacement is not searched again
+	CHECK_EQUAL(SketchTextReplacer::replaceLiteral("ab", "a", "aa"), "aab");
+}
+
+TEST_CASE(ReplacerPlansChangedTexts) {
+	std::vector<SketchTextReplacement> texts = { { 4, "T-1" }, { 7, "X-2" }, { 9, "T-3 T-4" } };
+	std::atomic<uint64_t> currentGeneration = 5;
+
+	SketchTextReplacePlan plan = SketchTextReplacer::plan(texts, "T-", "R-", false, 5, currentGeneration);
+	CHECK(plan.isValid);
+	CHECK(!plan.isCancelled);
+	CHECK_EQUAL(plan.generation, 5u);
+	CHECK_EQUAL(plan.replacements.size(), 2u);
+	if (plan.replacements.size() == 2) {
+		CHECK_EQUAL(plan.replacements[0].id, 4u);
+		CHECK_EQUAL(plan.replacements[0].text, "R-1");
+		CHECK_EQUAL(plan.replacements[1].id, 9u);
+		CHECK_EQUAL(plan.replacements[1].text, "R-3 R-4");
+	}
+
+	plan = SketchTextReplacer::plan(texts, "([A-Z])-(\\d)", "$2$1", true, 5, currentGeneration);
+	CHECK_EQUAL(plan.replacements.size(), 3u);
+	if (plan.replacements.size() == 3) {
+		CHECK_EQUAL(plan.replacements[2].text, "3T 4T");
+	}
+
+	plan = SketchTextReplacer::plan(texts, "(", "", true, 5, currentGeneration);
+	CHECK(!plan.isValid);
+	CHECK(!plan.error.empty());
+
+	plan = SketchTextReplacer::plan(texts, "", "x", false, 5, currentGeneration);
+	CHECK(plan.isValid);
+	CHECK(plan.replacements.empty());
+
+	// A job of an older generation gives up
+	plan = SketchTextReplacer::plan(texts, "T-", "R-", false, 4, currentGeneration);
+	CHECK(plan.isCancelled);
+	CHECK(plan.replacements.empty());
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace implicatex {
+	namespace fusion {
+		namespace tests {
+			/// <summary>A named check function, registered by TEST_CASE before main runs.</summary>
+			struct TestCase {
+				const char* name;
+				void (*run)();
+			};
+
+			std::vector<TestCase>& getTestCases();
+			void fail(const char* file, int line, const std::string& message);
+			std::string getTempPath(const std::string& name);
+
+			struct TestRegistration {
+				TestRegistration(const char* name, void (*run)()) { getTestCases().push_back({ name, run }); }
+			};
+
+			template <typename Actual, typename Expected>
+			void checkEqual(const Actual& actual, const Expected& expected, const char* text, const char* file, int line) {
+				if (actual == expected) return;
+				std::ostringstream message;
+				message << text << ": " << actual << " != " << expected;
+				fail(file, line, message.str());
+			}
+		}
+	}
+}
+
+/// <summary>Defines and registers a test case; failed checks are reported and the case runs on.</summary>
+#define TEST_CASE(name) \
+	static void name(); \
+	static ::implicatex::fusion::tests::TestRegistration name##Registration(#name, &name); \
+	static void name()
+
+#define CHECK(condition) \
+	do { if (!(condition)) ::implicatex::fusion::tests::fail(__FILE__, __LINE__, #condition); } while (false)
+
+#define CHECK_EQUAL(actual, expected) \
+	::implicatex::fusion::tests::checkEqual((actual), (expected), #actual " == " #expected, __FILE__, __LINE__)
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+	CHECK(std::abs((actual) - (expected)) <= (tolerance))
@@ -0,0 +1,58 @@
+#include "CorePch.h"
+#include "TestHarness.h"
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace implicatex {
+	namespace fusion {
+		namespace tests {
+			namespace {
+				size_t failureCount = 0;
+			}
+
+			std::vector<TestCase>& getTestCases() {
+				static std::vector<TestCase> testCases;
+				return testCases;
+			}
+
+			void fail(const char* file, int line, const std::string& message) {
+				++failureCount;
+				std::cerr << file << ':' << line << ": " << message << '\n';
+			}
+
+			/// <summary>Returns the path of a file in the test directory below the temporary directory, removing an old one.</summary>
+			std::string getTempPath(const std::string& name) {
+				fs::path directory = fs::temp_directory_path() / "ImplicateXToolsCoreTests";
+				std::error_code error;
+				fs::create_directories(directory, error);
+				fs::path path = directory / name;
+				fs::remove(path, error);
+				return path.string();
+			}
+		}
+	}
+}
+
+/// <summary>
+/// <para>Runs the test cases whose name starts with the first argument, all without one.</para>
+/// <para>Exits with 1 if a check failed, 2 if no test case matched.</para>
+/// </summary>
+int main(int argc, char* argv[]) {
+	using namespace implicatex::fusion::tests;
+	std::string_view filter = argc > 1 ? argv[1] : "";
+	size_t runCount = 0;
+	for (const TestCase& testCase : getTestCases()) {
+		if (!std::string_view(testCase.name).starts_with(filter)) continue;
+		size_t failuresBefore = failureCount;
+		testCase.run();
+		++runCount;
+		std::cout << (failureCount == failuresBefore ? "ok     " : "FAILED ") << testCase.name << '\n';
+	}
+	if (runCount == 0) {
+		std::cerr << "No test case matches '" << filter << "'\n";
+		return 2;
+	}
+	std::cout << runCount << " test cases, " << failureCount << " failed checks\n";
+	return failureCount == 0 ? 0 : 1;
+}
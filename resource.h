@@ -19,6 +19,57 @@
 #define IDS_LABEL_TEXT_HEIGHT_TABLE     3010
 #define IDS_LABEL_TAB_SETTINGS          3011
 #define IDS_LABEL_TEXT_ZOOM_FACTOR      3012
+#define IDS_LABEL_TEXT_CONTENT_FILTER   3013
+#define IDS_LABEL_TEXT_CONTENT_PREFIX   3014
+#define IDS_LABEL_ALL_SKETCHES          3015
+#define IDS_LABEL_TEXT_SORT_ORDER       3016
+#define IDS_LABEL_SORT_COLLECTION       3017
+#define IDS_LABEL_SORT_TEXT             3018
+#define IDS_LABEL_SORT_HEIGHT           3019
+#define IDS_LABEL_SORT_POSITION         3020
+#define IDS_LABEL_TEXT_SORT_DESCENDING  3021
+#define IDS_LABEL_TEXT_FIND             3022
+#define IDS_LABEL_TEXT_REPLACE_WITH     3023
+#define IDS_LABEL_TEXT_FIND_REGEX       3024
+#define IDS_LABEL_TEXT_REPLACE_PREVIEW  3025
+#define IDS_LABEL_TEXT_CONTENT_REPLACE  3026
+#define IDS_MSG_INVALID_EXPRESSION      3027
+#define IDS_LABEL_TEXT_DUPLICATES_ONLY  3028
+#define IDS_LABEL_DUPLICATE_GROUPS      3029
+#define IDS_LABEL_TEXT_EXPORT_ALL       3030
+#define IDS_LABEL_TEXT_EXPORT           3031
+#define IDS_MSG_EXPORT_FAILED           3032
+#define IDS_LABEL_PROFILE_REPORT        3033
+#define IDS_LABEL_TRACE_RECORD          3034
+#define IDS_MSG_TRACE_WRITTEN           3035
+#define IDS_LABEL_TAB_DIAGNOSTICS       3036
+#define IDS_LABEL_DIAG_FILTER_TIME      3037
+#define IDS_LABEL_DIAG_TABLE_TIME       3038
+#define IDS_LABEL_DIAG_ROWS             3039
+#define IDS_LABEL_DIAG_CACHE_HITS       3040
+#define IDS_LABEL_DIAG_MEMORY           3041
+#define IDS_LABEL_DIAG_API_CALLS        3042
+#define IDS_LABEL_DIAG_CLEAR_CACHES     3043
+#define IDS_LABEL_DIAG_RESET_COUNTERS   3044
+#define IDS_LABEL_TEXT_HEIGHT_TOLERANCE 3045
+#define IDS_LABEL_TEXT_HEIGHT_SUGGEST   3046
+#define IDS_LABEL_TEXT_HEIGHT_SIZES     3047
+#define IDS_LABEL_TEXT_HEIGHT_SIZE_TEXTS 3048
+#define IDS_LABEL_TEXT_HEIGHT_PREVIEW   3049
+#define IDS_LABEL_TEXT_MATCH_MODE       3050
+#define IDS_LABEL_MATCH_IN_RANGE        3051
+#define IDS_LABEL_MATCH_OUTSIDE_RANGE   3052
+#define IDS_LABEL_MATCH_OFF_NEW_HEIGHT  3053
+#define IDS_LABEL_MATCH_CHECKED         3054
+#define IDS_LABEL_MATCH_SELECTED_SKETCH 3055
+#define IDS_LABEL_TEXT_QUERY            3056
+#define IDS_LABEL_TEXT_QUERY_TOOLTIP    3057
+#define IDS_MSG_INVALID_QUERY           3058
+#define IDS_LABEL_TEXT_QUERY_PRESET     3059
+#define IDS_LABEL_QUERY_PRESET_NONE     3060
+#define IDS_LABEL_TEXT_QUERY_PRESET_NAME 3061
+#define IDS_LABEL_TEXT_QUERY_PRESET_SAVE 3062
+#define IDS_LABEL_DIAG_REFRESH          3063
 #define IDS_CMD_NAME_IMPLICATEX         4000
 
 // Next default values for new objects